@@ -1,6 +1,7 @@
 #ifndef CAVALIERCONTOURS_HPP
 #define CAVALIERCONTOURS_HPP
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef CAVC_STATIC_LIB
@@ -47,6 +48,19 @@ typedef struct cavc_spatial_index cavc_spatial_index;
 
 typedef struct cavc_offset_loop_topology cavc_offset_loop_topology;
 
+typedef struct cavc_offset_islands_engine cavc_offset_islands_engine;
+// Opaque type that holds polylines stored contiguously (all vertexes in one array plus offsets)
+typedef struct cavc_pline_buffer cavc_pline_buffer;
+// Opaque type for a memory arena, objects created in an arena are all released by one reset
+typedef struct cavc_arena cavc_arena;
+// Opaque type for an asynchronous job running on the library's job thread pool
+typedef struct cavc_job cavc_job;
+
+// Allocation hooks, see cavc_set_allocator. malloc_fn must return memory aligned for any type (like
+// malloc) or null on failure.
+typedef void *(*cavc_malloc_fn)(size_t size, void *user_data);
+typedef void (*cavc_free_fn)(void *ptr, void *user_data);
+
 typedef struct cavc_vertex {
   cavc_real x;
   cavc_real y;
@@ -95,6 +109,21 @@ typedef enum cavc_offset_loop_role {
 } cavc_offset_loop_role;
 
 #define CAVC_OFFSET_LOOP_NO_PARENT UINT32_MAX
+// Job submit timeout_ms value for no latency budget.
+#define CAVC_JOB_NO_TIMEOUT UINT32_MAX
+
+typedef enum cavc_job_status {
+  CAVC_JOB_PENDING = 0,
+  CAVC_JOB_RUNNING = 1,
+  CAVC_JOB_COMPLETED = 2,
+  CAVC_JOB_CANCELLED = 3,
+  CAVC_JOB_TIMED_OUT = 4
+} cavc_job_status;
+
+// Called once on a job pool thread when a job finishes, status is CAVC_JOB_COMPLETED,
+// CAVC_JOB_CANCELLED or CAVC_JOB_TIMED_OUT. job is valid for the duration of the call (even if
+// cavc_job_delete was already called on it).
+typedef void (*cavc_job_callback)(cavc_job *job, cavc_job_status status, void *user_data);
 
 typedef struct cavc_offset_loop_topology_node {
   cavc_offset_loop_role role;
@@ -117,6 +146,14 @@ typedef struct cavc_parallel_offset_options {
 CAVC_API cavc_pline *cavc_pline_new(cavc_vertex const *vertex_data, uint32_t vertex_count,
                                     int is_closed);
 
+// Create/alloc a new cavc_pline from separate x, y and bulge arrays (structure of arrays). Each
+// stride is the number of bytes between consecutive values of that array, a stride of 0 means the
+// values are contiguous (sizeof(cavc_real)). bulge may be null in which case all bulges are 0.
+CAVC_API cavc_pline *cavc_pline_new_soa(cavc_real const *x, uint32_t x_stride, cavc_real const *y,
+                                        uint32_t y_stride, cavc_real const *bulge,
+                                        uint32_t bulge_stride, uint32_t vertex_count,
+                                        int is_closed);
+
 // Delete/free a cavc_pline that was created with cavc_pline_new or released from a cavc_pline_list.
 // NOTE: Do not call this function on cavc_pline's that are owned by a cavc_pline_list!
 CAVC_API void cavc_pline_delete(cavc_pline *pline);
@@ -124,6 +161,9 @@ CAVC_API void cavc_pline_delete(cavc_pline *pline);
 // Returns the current capacity of pline.
 CAVC_API uint32_t cavc_pline_capacity(cavc_pline const *pline);
 
+// Get the number of bytes of memory held by the cavc_pline (handle and vertex capacity).
+CAVC_API uint64_t cavc_pline_memory_usage(cavc_pline const *pline);
+
 // Reserves memory for size vertexes to be stored in the pline if size is greater than current
 // capacity, otherwise does nothing.
 CAVC_API void cavc_pline_set_capacity(cavc_pline *pline, uint32_t size);
@@ -136,6 +176,12 @@ CAVC_API uint32_t cavc_pline_vertex_count(cavc_pline const *pline);
 // determine size required.
 CAVC_API void cavc_pline_vertex_data(cavc_pline const *pline, cavc_vertex *vertex_data);
 
+// Same as cavc_pline_vertex_data but fills separate x, y and bulge arrays (strides as in
+// cavc_pline_new_soa). Any of x, y or bulge may be null to skip filling that array.
+CAVC_API void cavc_pline_vertex_data_soa(cavc_pline const *pline, cavc_real *x, uint32_t x_stride,
+                                         cavc_real *y, uint32_t y_stride, cavc_real *bulge,
+                                         uint32_t bulge_stride);
+
 // Returns whether the cavc_pline is closed or not.
 CAVC_API int cavc_pline_is_closed(cavc_pline const *pline);
 
@@ -144,6 +190,13 @@ CAVC_API int cavc_pline_is_closed(cavc_pline const *pline);
 CAVC_API void cavc_pline_set_vertex_data(cavc_pline *pline, cavc_vertex const *vertex_data,
                                          uint32_t vertex_count);
 
+// Same as cavc_pline_set_vertex_data but reads separate x, y and bulge arrays (strides as in
+// cavc_pline_new_soa, bulge may be null).
+CAVC_API void cavc_pline_set_vertex_data_soa(cavc_pline *pline, cavc_real const *x,
+                                             uint32_t x_stride, cavc_real const *y,
+                                             uint32_t y_stride, cavc_real const *bulge,
+                                             uint32_t bulge_stride, uint32_t vertex_count);
+
 // Adds a vertex to the cavc_pline.
 CAVC_API void cavc_pline_add_vertex(cavc_pline *pline, cavc_vertex vertex);
 
@@ -197,6 +250,78 @@ CAVC_API cavc_pline *cavc_pline_list_get(cavc_pline_list const *pline_list, uint
 // released cavc_pline!
 CAVC_API cavc_pline *cavc_pline_list_release(cavc_pline_list *pline_list, uint32_t index);
 
+// Get the total vertex count of all polylines in the cavc_pline_list.
+CAVC_API uint32_t cavc_pline_list_vertex_count(cavc_pline_list const *pline_list);
+
+// Get the number of bytes of memory held by the cavc_pline_list (the list handle, each polyline
+// handle and its vertex capacity).
+CAVC_API uint64_t cavc_pline_list_memory_usage(cavc_pline_list const *pline_list);
+
+// Export all polylines of the cavc_pline_list into separate x, y and bulge arrays (strides as in
+// cavc_pline_new_soa), each array must hold cavc_pline_list_vertex_count values. Polyline i is
+// written to indexes offsets[i] to offsets[i + 1] - 1, offsets must hold cavc_pline_list_count + 1
+// values and is_closed must hold cavc_pline_list_count values. Any of x, y, bulge, offsets or
+// is_closed may be null to skip filling that array.
+CAVC_API void cavc_pline_list_export_soa(cavc_pline_list const *pline_list, cavc_real *x,
+                                         uint32_t x_stride, cavc_real *y, uint32_t y_stride,
+                                         cavc_real *bulge, uint32_t bulge_stride,
+                                         uint32_t *offsets, int *is_closed);
+
+// Functions for working with cavc_pline_buffer
+
+// Create/alloc a new empty cavc_pline_buffer. A buffer may be passed as output to multiple calls,
+// each call replaces the contents while keeping the allocated memory (so reusing one buffer across
+// calls avoids allocations).
+CAVC_API cavc_pline_buffer *cavc_pline_buffer_new(void);
+
+// Create a new empty cavc_pline_buffer whose storage (including all vertexes and offsets written
+// to it) is allocated from the arena. The buffer must not be used after the arena is reset or
+// deleted, calling cavc_pline_buffer_delete on it is optional.
+CAVC_API cavc_pline_buffer *cavc_pline_buffer_new_in_arena(cavc_arena *arena);
+
+// Delete/free a cavc_pline_buffer.
+CAVC_API void cavc_pline_buffer_delete(cavc_pline_buffer *buffer);
+
+// Get the number of polylines held in the buffer.
+CAVC_API uint32_t cavc_pline_buffer_count(cavc_pline_buffer const *buffer);
+
+// Get the total number of vertexes held in the buffer (sum over all polylines).
+CAVC_API uint32_t cavc_pline_buffer_vertex_count(cavc_pline_buffer const *buffer);
+
+// Get the vertexes of all polylines as one contiguous array of cavc_pline_buffer_vertex_count
+// elements. The pointer is owned by the buffer and is valid until the buffer is next written to
+// or deleted. May be null if the buffer holds no vertexes.
+CAVC_API cavc_vertex const *cavc_pline_buffer_vertex_data(cavc_pline_buffer const *buffer);
+
+// Copy the vertexes of all polylines into separate x, y and bulge arrays (strides as in
+// cavc_pline_new_soa), each array must hold cavc_pline_buffer_vertex_count values. Any of x, y or
+// bulge may be null to skip filling that array.
+CAVC_API void cavc_pline_buffer_vertex_data_soa(cavc_pline_buffer const *buffer, cavc_real *x,
+                                                uint32_t x_stride, cavc_real *y,
+                                                uint32_t y_stride, cavc_real *bulge,
+                                                uint32_t bulge_stride);
+
+// Get the polyline offsets array of cavc_pline_buffer_count + 1 elements, polyline i has vertexes
+// [offsets[i], offsets[i + 1]) of the vertex data array. Same lifetime as the vertex data.
+CAVC_API uint32_t const *cavc_pline_buffer_offsets(cavc_pline_buffer const *buffer);
+
+// Returns whether polyline at index is closed (1) or open (0). No bounds checking is performed
+// (ensure index < cavc_pline_buffer_count).
+CAVC_API int cavc_pline_buffer_is_closed(cavc_pline_buffer const *buffer, uint32_t index);
+
+// Returns the index of the input polyline (or input pair for combine) that produced the polyline
+// at index when the buffer was filled by a batch function, 0 for single input functions. No bounds
+// checking is performed (ensure index < cavc_pline_buffer_count).
+CAVC_API uint32_t cavc_pline_buffer_source_index(cavc_pline_buffer const *buffer, uint32_t index);
+
+// Copy the buffer contents into caller provided arrays: vertex_out (capacity vertex_capacity),
+// offsets_out (capacity offsets_capacity, cavc_pline_buffer_count + 1 entries are written) and
+// optionally is_closed_out (may be null, cavc_pline_buffer_count entries). Returns 1 if the
+// contents fit and were written, otherwise 0 and nothing is written.
+CAVC_API int cavc_pline_buffer_copy_to(cavc_pline_buffer const *buffer, cavc_vertex *vertex_out,
+                                       uint32_t vertex_capacity, uint32_t *offsets_out,
+                                       uint32_t offsets_capacity, int *is_closed_out);
+
 // Functions for working with cavc_spatial_index
 
 // Build an approximate segment spatial index from the input polyline. Polyline must have at least
@@ -209,6 +334,9 @@ CAVC_API void cavc_spatial_index_delete(cavc_spatial_index *spatial_index);
 // Returns the number of indexed segments in cavc_spatial_index.
 CAVC_API uint32_t cavc_spatial_index_item_count(cavc_spatial_index const *spatial_index);
 
+// Get the number of bytes of memory held by the cavc_spatial_index (handle and index arrays).
+CAVC_API uint64_t cavc_spatial_index_memory_usage(cavc_spatial_index const *spatial_index);
+
 // Query the spatial index and return how many segment indexes overlap the given bounding box.
 CAVC_API uint32_t cavc_spatial_index_query_count(cavc_spatial_index const *spatial_index,
                                                  cavc_real min_x, cavc_real min_y, cavc_real max_x,
@@ -242,6 +370,35 @@ CAVC_API uint32_t cavc_offset_loop_topology_count(cavc_offset_loop_topology cons
 CAVC_API cavc_offset_loop_topology_node
 cavc_offset_loop_topology_get(cavc_offset_loop_topology const *topology, uint32_t index);
 
+// Functions for working with cavc_offset_islands_engine
+
+// Create/alloc a new island offset engine. The engine keeps its internal buffers between calls to
+// cavc_offset_islands_engine_compute so repeated calls (e.g. pocketing steps) avoid reallocating.
+// An engine must not be used by multiple threads at the same time.
+CAVC_API cavc_offset_islands_engine *cavc_offset_islands_engine_new(void);
+
+// Delete/free a cavc_offset_islands_engine.
+CAVC_API void cavc_offset_islands_engine_delete(cavc_offset_islands_engine *engine);
+
+// Set the maximum number of threads the engine may use, 0 uses the hardware thread count and 1
+// runs on the calling thread. Results do not depend on this value. Default is 0.
+CAVC_API void cavc_offset_islands_engine_set_max_threads(cavc_offset_islands_engine *engine,
+                                                         uint32_t max_threads);
+
+// Offset a set of closed loops with islands by abs(offset_delta) (offsetting inward for the
+// counter clockwise loops and outward for the clockwise island loops). ccw_loops must be counter
+// clockwise and cw_loops clockwise, all must be closed, non-self intersecting and contain at least
+// 2 vertices. ccw_output and cw_output are filled with the resulting counter clockwise and
+// clockwise loops (in stable geometry order, area-desc + bbox key). A non-finite offset_delta
+// produces allocated empty output lists.
+CAVC_API void cavc_offset_islands_engine_compute(cavc_offset_islands_engine *engine,
+                                                 cavc_pline const *const *ccw_loops,
+                                                 uint32_t ccw_loop_count,
+                                                 cavc_pline const *const *cw_loops,
+                                                 uint32_t cw_loop_count, cavc_real offset_delta,
+                                                 cavc_pline_list **ccw_output,
+                                                 cavc_pline_list **cw_output);
+
 // Algorithm functions
 
 // Returns default parallel offset options:
@@ -271,6 +428,33 @@ CAVC_API cavc_parallel_offset_options cavc_parallel_offset_default_options(void)
 CAVC_API void cavc_parallel_offset(cavc_pline const *pline, cavc_real delta,
                                    cavc_pline_list **output, cavc_parallel_offset_options options);
 
+// Same as cavc_parallel_offset but reads the input directly from the caller's vertex_data array
+// (vertex_count vertexes, is_closed 0 for open otherwise closed) without creating a cavc_pline, and
+// writes the results contiguously into output (previous contents are replaced). Invalid options
+// or a non-finite delta produce an empty output.
+CAVC_API void cavc_parallel_offset_view(cavc_vertex const *vertex_data, uint32_t vertex_count,
+                                        int is_closed, cavc_real delta,
+                                        cavc_parallel_offset_options options,
+                                        cavc_pline_buffer *output);
+
+// Same as cavc_parallel_offset_view but writes the results into caller provided arrays:
+// vertex_out (capacity vertex_capacity), offsets_out (capacity offsets_capacity, polyline i uses
+// vertexes [offsets_out[i], offsets_out[i + 1])) and optionally is_closed_out (may be null,
+// capacity offsets_capacity - 1). pline_count and total_vertex_count are always filled with the
+// sizes required by the result. Returns 1 if the result fit and was written, otherwise 0 and
+// nothing is written to the arrays. When the result does not fit and overflow is not null the
+// result is written to overflow instead (previous contents are replaced), so it can be read in
+// place or copied out with cavc_pline_buffer_copy_to without computing the offset again (offsets
+// require pline_count + 1 entries).
+CAVC_API int cavc_parallel_offset_view_to(cavc_vertex const *vertex_data, uint32_t vertex_count,
+                                          int is_closed, cavc_real delta,
+                                          cavc_parallel_offset_options options,
+                                          cavc_vertex *vertex_out, uint32_t vertex_capacity,
+                                          uint32_t *offsets_out, uint32_t offsets_capacity,
+                                          int *is_closed_out, uint32_t *pline_count,
+                                          uint32_t *total_vertex_count,
+                                          cavc_pline_buffer *overflow);
+
 // Combines two non-self intersecting closed polylines, pline_a and pline_b.
 // For union combine_mode = 0
 // For exclude combine_mode = 1
@@ -285,6 +469,53 @@ CAVC_API void cavc_combine_plines(cavc_pline const *pline_a, cavc_pline const *p
                                   int combine_mode, cavc_pline_list **remaining,
                                   cavc_pline_list **subtracted);
 
+// Batch functions
+// Batch functions run one operation over many inputs in a single call to amortize call overhead.
+// Packed polyline input: polyline i has vertexes [offsets[i], offsets[i + 1]) of vertex_data
+// (offsets has pline_count + 1 entries) and is closed if is_closed[i] != 0, this is the same
+// layout as cavc_pline_buffer so results can be passed back in. thread_count limits the threads
+// used (0 uses the hardware thread count, 1 runs on the calling thread), results do not depend on
+// it. Output order always follows input order.
+
+// Parallel offset every packed polyline by delta (same options and validation as
+// cavc_parallel_offset_view). output is filled with all results, cavc_pline_buffer_source_index
+// gives the input polyline each result came from.
+CAVC_API void cavc_parallel_offset_batch(cavc_vertex const *vertex_data, uint32_t const *offsets,
+                                         int const *is_closed, uint32_t pline_count,
+                                         cavc_real delta, cavc_parallel_offset_options options,
+                                         uint32_t thread_count, cavc_pline_buffer *output);
+
+// Combine pairs of closed polylines (pair i is polyline i of a with polyline i of b, both packed
+// with the layout described above but without is_closed arrays since all must be closed).
+// combine_mode is as in cavc_combine_plines. remaining and subtracted are filled with all results,
+// cavc_pline_buffer_source_index gives the pair each result came from.
+CAVC_API void cavc_combine_plines_batch(cavc_vertex const *vertex_data_a, uint32_t const *offsets_a,
+                                        cavc_vertex const *vertex_data_b, uint32_t const *offsets_b,
+                                        uint32_t pair_count, int combine_mode,
+                                        uint32_t thread_count, cavc_pline_buffer *remaining,
+                                        cavc_pline_buffer *subtracted);
+
+// Compute the extents of every packed polyline, extents_out must hold 4 * pline_count values and
+// is filled with min_x, min_y, max_x, max_y for each polyline (same as cavc_get_extents).
+CAVC_API void cavc_get_extents_batch(cavc_vertex const *vertex_data, uint32_t const *offsets,
+                                     int const *is_closed, uint32_t pline_count,
+                                     uint32_t thread_count, cavc_real *extents_out);
+
+// Compute the winding number of every point relative to the polyline given by vertex_data (same
+// as cavc_get_winding_number), winding_numbers_out must hold point_count values.
+CAVC_API void cavc_get_winding_numbers(cavc_vertex const *vertex_data, uint32_t vertex_count,
+                                       int is_closed, cavc_point const *points,
+                                       uint32_t point_count, uint32_t thread_count,
+                                       int *winding_numbers_out);
+
+// Classify every point against the polyline given by vertex_data (same as
+// cavc_get_point_containment), containment_out must hold point_count values.
+CAVC_API void cavc_get_point_containments(cavc_vertex const *vertex_data, uint32_t vertex_count,
+                                          int is_closed, cavc_point const *points,
+                                          uint32_t point_count, cavc_real boundary_epsilon,
+                                          uint32_t thread_count,
+                                          cavc_point_containment *containment_out);
+
 // Returns the path length of the cavc_pline given. If pline vertex count is less than 2 then 0 is
 // returned.
 CAVC_API cavc_real cavc_get_path_length(cavc_pline const *pline);
@@ -328,6 +559,105 @@ CAVC_API void cavc_set_tolerances(cavc_tolerances const *tolerances);
 // Reset geometry tolerances to default values.
 CAVC_API void cavc_reset_tolerances(void);
 
+// Functions for memory allocation
+
+// Set the functions used to allocate all handles (cavc_pline, cavc_pline_list, cavc_spatial_index,
+// etc.), cavc_pline vertex storage, cavc_pline_list/cavc_pline_buffer/topology arrays and arena
+// blocks. user_data is passed to both functions. Pass null functions to restore
+// std::malloc/std::free. Memory is always freed with the free_fn that was set when it was
+// allocated. NOTE: Not thread safe, call before other threads use the library.
+// NOTE: Only memory owned by C API objects is covered. Working memory of the algorithms
+// (cavc_parallel_offset, cavc_combine_plines, offset islands, spatial index construction, jobs,
+// etc.) including intermediate polylines, intersect lists and spatial indexes, and the temporary
+// polyline copy made for functions that read a cavc_pline (e.g. cavc_get_area,
+// cavc_combine_plines) is allocated with the default C++ allocator. Peak memory of those calls is
+// therefore not visible to the hooks or to an arena.
+CAVC_API void cavc_set_allocator(cavc_malloc_fn malloc_fn, cavc_free_fn free_fn, void *user_data);
+
+// Create/alloc a new cavc_arena, block_size is the size in bytes of the blocks requested from the
+// allocator (0 uses a default of 64 KiB, larger allocations get their own block). An arena is not
+// thread safe, use one arena per thread or request.
+CAVC_API cavc_arena *cavc_arena_new(uint32_t block_size);
+
+// Delete/free a cavc_arena and all memory allocated from it.
+CAVC_API void cavc_arena_delete(cavc_arena *arena);
+
+// Release everything allocated from the arena at once (objects created in it must no longer be
+// used), blocks are kept and reused by later allocations.
+CAVC_API void cavc_arena_reset(cavc_arena *arena);
+
+// Get the number of bytes allocated from the arena since it was created or last reset.
+CAVC_API uint64_t cavc_arena_bytes_used(cavc_arena const *arena);
+
+// Get the number of bytes the arena holds in blocks requested from the allocator.
+CAVC_API uint64_t cavc_arena_bytes_reserved(cavc_arena const *arena);
+
+// Functions for asynchronous jobs
+
+// (Re)create the job thread pool with thread_count threads (0 uses the hardware thread count).
+// Waits for running jobs of an existing pool to finish and cancels its pending jobs. Submitting a
+// job without calling this first creates a pool using the hardware thread count. NOTE: Must not be
+// called from a job callback.
+CAVC_API void cavc_job_pool_init(uint32_t thread_count);
+
+// Stop the job thread pool, waits for running jobs to finish and cancels pending jobs. Jobs
+// submitted while it is stopping (e.g. from a job callback) go to a new pool. NOTE: Must not be
+// called from a job callback.
+CAVC_API void cavc_job_pool_shutdown(void);
+
+// All submit functions take a latency budget of timeout_ms milliseconds counted from the submit
+// call (CAVC_JOB_NO_TIMEOUT for none). A job still pending when the budget runs out does not run, a
+// running job stops at the next cancellation check. Either way the job finishes with status
+// CAVC_JOB_TIMED_OUT and empty results. The job may still complete if it finishes before observing
+// the deadline.
+
+// Submit a parallel offset of pline (same as cavc_parallel_offset) to the job pool. The input is
+// copied so it may be modified or deleted after submitting, tolerances in effect when submitting
+// are used. callback may be null. Result 0 holds the offset polylines.
+CAVC_API cavc_job *cavc_job_submit_parallel_offset(cavc_pline const *pline, cavc_real delta,
+                                                   cavc_parallel_offset_options options,
+                                                   uint32_t timeout_ms, cavc_job_callback callback,
+                                                   void *user_data);
+
+// Submit combining two closed polylines (same as cavc_combine_plines) to the job pool, inputs are
+// copied. Result 0 holds the remaining polylines and result 1 the subtracted polylines.
+CAVC_API cavc_job *cavc_job_submit_combine_plines(cavc_pline const *pline_a,
+                                                  cavc_pline const *pline_b, int combine_mode,
+                                                  uint32_t timeout_ms, cavc_job_callback callback,
+                                                  void *user_data);
+
+// Submit an island offset (same as cavc_offset_islands_engine_compute) to the job pool, inputs are
+// copied. max_threads limits the threads used within the job (0 uses the hardware thread count).
+// Result 0 holds the counter clockwise loops and result 1 the clockwise loops.
+CAVC_API cavc_job *cavc_job_submit_offset_islands(cavc_pline const *const *ccw_loops,
+                                                  uint32_t ccw_loop_count,
+                                                  cavc_pline const *const *cw_loops,
+                                                  uint32_t cw_loop_count, cavc_real offset_delta,
+                                                  uint32_t max_threads, uint32_t timeout_ms,
+                                                  cavc_job_callback callback, void *user_data);
+
+// Get the current status of the job without blocking.
+CAVC_API cavc_job_status cavc_job_poll(cavc_job const *job);
+
+// Block until the job has finished (and its callback has returned), returns the final status.
+// NOTE: Must not be called from the job's own callback.
+CAVC_API cavc_job_status cavc_job_wait(cavc_job *job);
+
+// Request cooperative cancellation of the job. A pending job will not run, a running job stops at
+// the next check (between its phases and inside the intersect, slice validation and stitch loops).
+// The job may still complete if it finishes before observing the request.
+CAVC_API void cavc_job_cancel(cavc_job *job);
+
+// Release result index (0 or 1, see submit functions) of a finished job as a new cavc_pline_list
+// that must be deleted by the caller. Cancelled or timed out jobs and results already released give
+// an empty list. NOTE: job status must be CAVC_JOB_COMPLETED, CAVC_JOB_CANCELLED or
+// CAVC_JOB_TIMED_OUT.
+CAVC_API cavc_pline_list *cavc_job_release_result(cavc_job *job, uint32_t index);
+
+// Delete/free a cavc_job handle. If the job has not finished it is cancelled and freed once the
+// pool is done with it (this function does not block).
+CAVC_API void cavc_job_delete(cavc_job *job);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,188 @@
+#ifndef CAVC_CANCELLATION_HPP
+#define CAVC_CANCELLATION_HPP
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <limits>
+
+// Cooperative cancellation for long running operations. A token is installed for the current
+// thread with ScopedCancellationToken, algorithms check it between their phases (e.g. after
+// finding intersects, before stitching) and at loop granularity inside the intersect, slice
+// validation and stitch loops, and return early with an empty result once cancellation has been
+// requested or the token's deadline has passed.
+//
+// The first check that stops an operation records why on the token (OperationStatus::Cancelled or
+// OperationStatus::TimedOut), read it back with CancellationToken::status() to tell a timed out
+// (or cancelled) operation apart from one that completed with an empty result. runCancellable
+// wraps installing the token and reading the status.
+
+namespace cavc {
+/// Outcome of an operation run with a cancellation token installed.
+enum class OperationStatus : int {
+  /// Ran to completion, the result is valid.
+  Completed = 0,
+  /// Stopped early because cancellation was requested, the result is empty.
+  Cancelled = 1,
+  /// Stopped early because the token's deadline passed, the result is empty.
+  TimedOut = 2
+};
+
+/// Flag and optional deadline shared between the thread requesting cancellation (or setting the
+/// latency budget) and the thread(s) running an operation.
+class CancellationToken {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  CancellationToken() = default;
+  CancellationToken(CancellationToken const &) = delete;
+  CancellationToken &operator=(CancellationToken const &) = delete;
+
+  /// Request cancellation, safe to call from any thread.
+  void requestCancel() noexcept { m_cancelled.store(true, std::memory_order_relaxed); }
+  bool isCancelled() const noexcept { return m_cancelled.load(std::memory_order_relaxed); }
+
+  /// Set the point in time after which operations checking this token stop with
+  /// OperationStatus::TimedOut, safe to call from any thread.
+  void setDeadline(Clock::time_point deadline) noexcept {
+    m_deadline.store(deadline.time_since_epoch().count(), std::memory_order_relaxed);
+  }
+
+  /// Set the deadline to timeout from now.
+  template <typename Rep, typename Period>
+  void setTimeout(std::chrono::duration<Rep, Period> timeout) noexcept {
+    setDeadline(Clock::now() + std::chrono::duration_cast<Clock::duration>(timeout));
+  }
+
+  void clearDeadline() noexcept { m_deadline.store(noDeadline, std::memory_order_relaxed); }
+  bool hasDeadline() const noexcept {
+    return m_deadline.load(std::memory_order_relaxed) != noDeadline;
+  }
+
+  /// True if a deadline is set and has passed (reads the clock).
+  bool deadlineExpired() const noexcept {
+    auto const deadline = m_deadline.load(std::memory_order_relaxed);
+    return deadline != noDeadline && Clock::now().time_since_epoch().count() >= deadline;
+  }
+
+  /// Why the first operation that stopped early because of this token stopped, Completed if no
+  /// operation has stopped early.
+  OperationStatus status() const noexcept {
+    return static_cast<OperationStatus>(m_status.load(std::memory_order_relaxed));
+  }
+
+  /// Clears the cancel flag, deadline and recorded status so the token can be reused.
+  void reset() noexcept {
+    m_cancelled.store(false, std::memory_order_relaxed);
+    clearDeadline();
+    m_status.store(static_cast<int>(OperationStatus::Completed), std::memory_order_relaxed);
+  }
+
+  /// Checks the cancel flag then the deadline, returns the reason to stop (Completed to keep
+  /// going) and records it as the token status. Called by algorithms, safe from any thread.
+  OperationStatus check() const noexcept {
+    OperationStatus reason = OperationStatus::Completed;
+    if (isCancelled()) {
+      reason = OperationStatus::Cancelled;
+    } else if (deadlineExpired()) {
+      reason = OperationStatus::TimedOut;
+    } else {
+      return reason;
+    }
+
+    // first recorded reason wins
+    int expected = static_cast<int>(OperationStatus::Completed);
+    m_status.compare_exchange_strong(expected, static_cast<int>(reason),
+                                     std::memory_order_relaxed);
+    return reason;
+  }
+
+private:
+  using Ticks = Clock::duration::rep;
+  static constexpr Ticks noDeadline = std::numeric_limits<Ticks>::max();
+
+  std::atomic<bool> m_cancelled{false};
+  std::atomic<Ticks> m_deadline{noDeadline};
+  mutable std::atomic<int> m_status{static_cast<int>(OperationStatus::Completed)};
+};
+
+namespace internal {
+/// Token checked by algorithms running on the current thread (null if none installed).
+inline CancellationToken const *&activeCancellationToken() {
+  thread_local CancellationToken const *token = nullptr;
+  return token;
+}
+
+/// True if the token installed for the current thread has been cancelled or its deadline has
+/// passed.
+inline bool cancellationRequested() {
+  CancellationToken const *token = activeCancellationToken();
+  return token != nullptr && token->check() != OperationStatus::Completed;
+}
+
+/// True if a check of the token installed for the current thread has already stopped an operation
+/// (reads the recorded status, not the clock). Used to discard partial results.
+inline bool cancellationStopped() {
+  CancellationToken const *token = activeCancellationToken();
+  return token != nullptr && token->status() != OperationStatus::Completed;
+}
+
+/// Loop granularity cancellation check for hot loops. The token installed when the poll is
+/// constructed is only checked (and the clock only read) every interval calls, once stopped it
+/// stays stopped. Costs a null check per call when no token is installed.
+class CancellationPoll {
+public:
+  explicit CancellationPoll(std::size_t interval = 32) noexcept
+      : m_token(activeCancellationToken()), m_interval(interval), m_count(interval) {}
+
+  bool operator()() noexcept {
+    if (m_token == nullptr || m_stopped) {
+      return m_stopped;
+    }
+    if (++m_count < m_interval) {
+      return false;
+    }
+    m_count = 0;
+    m_stopped = m_token->check() != OperationStatus::Completed;
+    return m_stopped;
+  }
+
+private:
+  CancellationToken const *m_token;
+  std::size_t m_interval;
+  std::size_t m_count;
+  bool m_stopped = false;
+};
+} // namespace internal
+
+/// RAII guard that installs a cancellation token for the current thread and restores the
+/// previously installed token on destruction.
+class ScopedCancellationToken {
+public:
+  explicit ScopedCancellationToken(CancellationToken const *token)
+      : m_previous(internal::activeCancellationToken()) {
+    internal::activeCancellationToken() = token;
+  }
+  ~ScopedCancellationToken() { internal::activeCancellationToken() = m_previous; }
+  ScopedCancellationToken(ScopedCancellationToken const &) = delete;
+  ScopedCancellationToken &operator=(ScopedCancellationToken const &) = delete;
+
+private:
+  CancellationToken const *m_previous;
+};
+
+/// Runs fn() with token installed for the current thread and returns why it stopped, e.g.
+///   CancellationToken token;
+///   token.setTimeout(std::chrono::milliseconds(50));
+///   std::vector<Polyline<double>> result;
+///   if (runCancellable(token, [&] { result = parallelOffset(pline, 1.0); }) ==
+///       OperationStatus::TimedOut) { ... }
+/// The status is read from the token so it also reports a stop recorded by an earlier operation
+/// run with the same token (reset() the token to reuse it).
+template <typename Fn> OperationStatus runCancellable(CancellationToken const &token, Fn &&fn) {
+  ScopedCancellationToken scope(&token);
+  fn();
+  return token.status();
+}
+} // namespace cavc
+
+#endif // CAVC_CANCELLATION_HPP
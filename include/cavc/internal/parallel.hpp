@@ -0,0 +1,110 @@
+#ifndef CAVC_INTERNAL_PARALLEL_HPP
+#define CAVC_INTERNAL_PARALLEL_HPP
+#include "../cancellation.hpp"
+#include "../mathutils.hpp"
+#include "../tracing.hpp"
+#include "common.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Minimal fork/join helpers used by algorithms that have independent units of work. Results must
+// be written to per task slots by the caller so output order never depends on thread scheduling.
+
+namespace cavc {
+namespace internal {
+
+/// Number of hardware threads available (never returns 0).
+inline std::size_t hardwareThreadCount() {
+  std::size_t count = std::thread::hardware_concurrency();
+  return count == 0 ? 1 : count;
+}
+
+/// Number of workers to use for taskCount tasks. maxThreads of 0 means use the hardware thread
+/// count, minTasksPerWorker limits the number of workers so small inputs stay on the calling
+/// thread (avoids thread start up cost dominating).
+inline std::size_t parallelWorkerCount(std::size_t taskCount, std::size_t minTasksPerWorker = 1,
+                                       std::size_t maxThreads = 0) {
+  std::size_t const threadLimit = maxThreads == 0 ? hardwareThreadCount() : maxThreads;
+  std::size_t const grain = std::max<std::size_t>(minTasksPerWorker, 1);
+  std::size_t const byTasks = std::max<std::size_t>(taskCount / grain, 1);
+  return std::min(threadLimit, byTasks);
+}
+
+/// Invoke fn(taskIndex, workerIndex) for every taskIndex in [0, taskCount) using workerCount
+/// workers (the calling thread is worker 0). Tasks are handed out dynamically so uneven task costs
+/// balance across workers, workerIndex is always < workerCount and may be used to index per worker
+/// scratch buffers. Runs inline when workerCount <= 1. The calling thread's cancellation token and
+/// Real tolerances (see utils::currentEpsilonConfig) are installed on every worker, remaining tasks
+/// are skipped once the token stops the operation. If fn throws no further tasks are started and
+/// the first exception is rethrown on the calling thread after all workers have joined.
+template <typename Real, typename Fn>
+void parallelFor(std::size_t taskCount, std::size_t workerCount, Fn &&fn) {
+  if (taskCount == 0) {
+    return;
+  }
+
+  utils::EpsilonConfig<Real> const eps = utils::currentEpsilonConfig<Real>();
+  workerCount = std::min(workerCount, taskCount);
+  if (workerCount <= 1) {
+    utils::ScopedEpsilonContext<Real> epsContext(eps);
+    for (std::size_t i = 0; i < taskCount; ++i) {
+      if (cancellationRequested()) {
+        return;
+      }
+      fn(i, std::size_t(0));
+    }
+    return;
+  }
+
+  CancellationToken const *token = activeCancellationToken();
+  std::atomic<std::size_t> nextTask{0};
+  std::atomic<bool> failed{false};
+  std::exception_ptr firstException;
+  std::mutex exceptionMutex;
+  auto runWorker = [&](std::size_t workerIndex) {
+    CAVC_TRACE_SCOPE("parallelFor worker");
+    ScopedCancellationToken cancelScope(token);
+    utils::ScopedEpsilonContext<Real> epsContext(eps);
+    try {
+      while (!failed.load(std::memory_order_relaxed)) {
+        std::size_t const i = nextTask.fetch_add(1, std::memory_order_relaxed);
+        if (i >= taskCount || cancellationRequested()) {
+          break;
+        }
+        fn(i, workerIndex);
+      }
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(exceptionMutex);
+      if (!firstException) {
+        firstException = std::current_exception();
+      }
+      failed.store(true, std::memory_order_relaxed);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(workerCount - 1);
+  for (std::size_t w = 1; w < workerCount; ++w) {
+    threads.emplace_back(runWorker, w);
+  }
+
+  runWorker(0);
+
+  for (auto &t : threads) {
+    t.join();
+  }
+
+  if (firstException) {
+    std::rethrow_exception(firstException);
+  }
+}
+
+} // namespace internal
+} // namespace cavc
+
+#endif // CAVC_INTERNAL_PARALLEL_HPP
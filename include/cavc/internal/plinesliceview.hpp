@@ -62,6 +62,7 @@ template <typename Real> struct PlineSliceViewData {
   void appendTo(Polyline<Real> &target, Polyline<Real> const &source,
                 Real joinThreshold = utils::sliceJoinThreshold<Real>()) const {
     target.vertexes().reserve(target.size() + vertexCount());
+    CAVC_STATS_ADD(stitchVertexesAppended, vertexCount());
     for (std::size_t i = 0; i < vertexCount(); ++i) {
       addOrReplaceIfSamePos(target, getVertex(source, i), joinThreshold);
     }
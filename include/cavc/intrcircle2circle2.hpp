@@ -23,27 +23,28 @@ template <typename Real> struct IntrCircle2Circle2Result {
   Vector2<Real> point2;
 };
 
-// Find intersect between two circles in 2D.
+// Find intersect between two circles in 2D, epsilon is the fuzzy compare threshold used for the
+// coincident, tangent and no intersect tests.
 template <typename Real>
 IntrCircle2Circle2Result<Real> intrCircle2Circle2(Real radius1, Vector2<Real> const &center1,
-                                                  Real radius2, Vector2<Real> const &center2) {
+                                                  Real radius2, Vector2<Real> const &center2,
+                                                  Real epsilon = utils::realThreshold<Real>()) {
   // Reference algorithm: http://paulbourke.net/geometry/circlesphere/
 
   IntrCircle2Circle2Result<Real> result;
   Vector2<Real> cv = center2 - center1;
   Real d2 = dot(cv, cv);
   Real d = std::sqrt(d2);
-  if (d < utils::realThreshold<Real>()) {
+  if (d < epsilon) {
     // same center position
-    if (utils::fuzzyEqual(radius1, radius2)) {
+    if (utils::fuzzyEqual(radius1, radius2, epsilon)) {
       result.intrType = Circle2Circle2IntrType::Coincident;
     } else {
       result.intrType = Circle2Circle2IntrType::NoIntersect;
     }
   } else {
     // different center position
-    if (d > radius1 + radius2 + utils::realThreshold<Real>() ||
-        d + utils::realThreshold<Real>() < std::abs(radius1 - radius2)) {
+    if (d > radius1 + radius2 + epsilon || d + epsilon < std::abs(radius1 - radius2)) {
       result.intrType = Circle2Circle2IntrType::NoIntersect;
     } else {
       Real rad1Sq = radius1 * radius1;
@@ -64,7 +65,7 @@ IntrCircle2Circle2Result<Real> intrCircle2Circle2(Real radius1, Vector2<Real> co
         Real y2 = midPoint.y() + yTerm;
         result.point1 = Vector2<Real>(x1, y1);
         result.point2 = Vector2<Real>(x2, y2);
-        if (fuzzyEqual(result.point1, result.point2)) {
+        if (fuzzyEqual(result.point1, result.point2, epsilon)) {
           result.intrType = Circle2Circle2IntrType::OneIntersect;
         } else {
           result.intrType = Circle2Circle2IntrType::TwoIntersects;
@@ -1,6 +1,9 @@
 #ifndef CAVC_INTRLINESEG2CIRCLE2_HPP
 #define CAVC_INTRLINESEG2CIRCLE2_HPP
+#include "predicates.hpp"
 #include "vector2.hpp"
+#include <algorithm>
+#include <cmath>
 
 namespace cavc {
 template <typename Real> struct IntrLineSeg2Circle2Result {
@@ -16,32 +19,25 @@ template <typename Real> struct IntrLineSeg2Circle2Result {
 // segment equation P(t) = v1 + t * (v2 - v1) for t = 0 to t = 1, if t < 0 or t > 1 then intersect
 // occurs only when extending the segment out past the points given (if t < 0 intersect nearest v1,
 // if t > 0 then intersect nearest v2), intersects are "sticky" and "snap" to tangent points, e.g. a
-// segment very close to being a tangent will be returned as a single intersect point
+// segment very close to being a tangent will be returned as a single intersect point, epsilon is the
+// fuzzy compare threshold used for the tangent and degenerate segment tests
 template <typename Real>
-IntrLineSeg2Circle2Result<Real> intrLineSeg2Circle2(Vector2<Real> const &p0,
-                                                    Vector2<Real> const &p1, Real radius,
-                                                    Vector2<Real> const &circleCenter) {
-  // This function solves for the line/circle intersects using the line equation rather than
-  // directly solving for the parametric variable with the quadratic formula. This is more stable
-  // in cases where the line is nearly vertical/horizontal.
+IntrLineSeg2Circle2Result<Real>
+intrLineSeg2Circle2(Vector2<Real> const &p0, Vector2<Real> const &p1, Real radius,
+                    Vector2<Real> const &circleCenter, Real epsilon = utils::realThreshold<Real>()) {
+  // Both the miss/tangent/secant classification and the solution are taken from the same line
+  // model, the segment direction d = p1 - p0 and the circle center relative to p0: the center
+  // distance to the line is perpDot(d, center - p0) / |d| and the intersects lie either side of
+  // the center's projection onto the line. The classification compares that distance against
+  // radius +/- epsilon with compareLineDistance, so it is exact for the given inputs and does not
+  // flip between nearly identical segments. Solving in parametric form avoids the slope of nearly
+  // vertical lines.
   IntrLineSeg2Circle2Result<Real> result;
-  Real dx = p1.x() - p0.x();
-  Real dy = p1.y() - p0.y();
-  Real h = circleCenter.x();
-  Real k = circleCenter.y();
-  Real const epsilon = utils::realThreshold<Real>();
-
-  auto parametricFromPoint = [&](Vector2<Real> const &point) {
-    if (std::abs(dx) < std::abs(dy)) {
-      return (point.y() - p0.y()) / dy;
-    }
-    return (point.x() - p0.x()) / dx;
-  };
 
   if (fuzzyEqual(p0, p1, epsilon)) {
     // v1 = v2, test if point is on the circle
-    Real xh = (p0.x() + p1.x()) / Real(2) - h;
-    Real yk = (p0.y() + p1.y()) / Real(2) - k;
+    Real xh = (p0.x() + p1.x()) / Real(2) - circleCenter.x();
+    Real yk = (p0.y() + p1.y()) / Real(2) - circleCenter.y();
     if (utils::fuzzyEqual(xh * xh + yk * yk, radius * radius, epsilon)) {
       result.numIntersects = 1;
       result.t0 = Real(0);
@@ -49,53 +45,30 @@ IntrLineSeg2Circle2Result<Real> intrLineSeg2Circle2(Vector2<Real> const &p0,
       result.numIntersects = 0;
     }
   } else {
-    Real p0ShiftX = p0.x() - h;
-    Real p1ShiftX = p1.x() - h;
-    Real p1ShiftY = p1.y() - k;
-
-    Real a;
-    Real b;
-    Real c;
-    if (std::abs(dx) < epsilon) {
-      // vertical line, using average x value for fuzziness
-      Real xPos = (p0ShiftX + p1ShiftX) / Real(2);
-      a = Real(1);
-      b = Real(0);
-      c = -xPos;
-    } else {
-      Real m = dy / dx;
-      a = m;
-      b = Real(-1);
-      c = p1ShiftY - m * p1ShiftX;
-    }
-
-    Real a2 = a * a;
-    Real b2 = b * b;
-    Real c2 = c * c;
-    Real r2 = radius * radius;
-    Real a2_b2 = a2 + b2;
-    Real shortestDist = std::abs(c) / std::sqrt(a2_b2);
-
-    if (shortestDist > radius + epsilon) {
+    int const outerCompare = compareLineDistance(p0, p1, circleCenter, radius + epsilon);
+    if (outerCompare > 0) {
       result.numIntersects = 0;
     } else {
-      // adding h and k back to solution terms (shifting from origin back to real coordinates)
-      Real x0 = -a * c / a2_b2 + h;
-      Real y0 = -b * c / a2_b2 + k;
+      Vector2<Real> const d = p1 - p0;
+      Vector2<Real> const toCenter = circleCenter - p0;
+      Real const lengthSquared = dot(d, d);
+      // parametric value of the circle center projected onto the line
+      Real const tProjected = dot(toCenter, d) / lengthSquared;
 
-      if (utils::fuzzyEqual(shortestDist, radius, epsilon)) {
+      bool const isTangent =
+          outerCompare < 0 && (radius - epsilon < Real(0) ||
+                               compareLineDistance(p0, p1, circleCenter, radius - epsilon) > 0);
+      if (isTangent) {
         result.numIntersects = 1;
-        result.t0 = parametricFromPoint(Vector2<Real>(x0, y0));
+        result.t0 = tProjected;
       } else {
-        Real d = r2 - c2 / a2_b2;
-        Real mult = std::sqrt(std::abs(d / a2_b2));
-        Real xSol1 = x0 + b * mult;
-        Real xSol2 = x0 - b * mult;
-        Real ySol1 = y0 - a * mult;
-        Real ySol2 = y0 + a * mult;
+        Real const centerDist = perpDot(d, toCenter);
+        // half chord length squared scaled by |d|^2, then the half chord in parametric units
+        Real const halfChordSquared = radius * radius * lengthSquared - centerDist * centerDist;
+        Real const tHalfChord = std::sqrt(std::max(halfChordSquared, Real(0))) / lengthSquared;
         result.numIntersects = 2;
-        result.t0 = parametricFromPoint(Vector2<Real>(xSol1, ySol1));
-        result.t1 = parametricFromPoint(Vector2<Real>(xSol2, ySol2));
+        result.t0 = tProjected - tHalfChord;
+        result.t1 = tProjected + tHalfChord;
       }
     }
   }
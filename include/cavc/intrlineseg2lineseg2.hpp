@@ -27,10 +27,11 @@ template <typename Real> struct IntrLineSeg2LineSeg2Result {
   Vector2<Real> point;
 };
 
+// epsilon is the fuzzy compare threshold used for parallel, degenerate and end point tests
 template <typename Real>
 IntrLineSeg2LineSeg2Result<Real>
 intrLineSeg2LineSeg2(Vector2<Real> const &u1, Vector2<Real> const &u2, Vector2<Real> const &v1,
-                     Vector2<Real> const &v2) {
+                     Vector2<Real> const &v2, Real epsilon = utils::realThreshold<Real>()) {
   // This implementation works by processing the segments in parametric equation form and using
   // perpendicular products
   // see: http://geomalgorithms.com/a05-_intersect-1.html and
@@ -42,26 +43,25 @@ intrLineSeg2LineSeg2(Vector2<Real> const &u1, Vector2<Real> const &u2, Vector2<R
   Real d = perpDot(u, v);
   Real const uLength = length(u);
   Real const vLength = length(v);
-  Real const epsilon = utils::realThreshold<Real>();
 
   Vector2<Real> w = u1 - v1;
 
   // Test if point is inside a segment, NOTE: assumes points are aligned
-  auto isInSegment = [](Vector2<Real> const &pt, Vector2<Real> const &segStart,
-                        Vector2<Real> const &segEnd) {
-    if (utils::fuzzyEqual(segStart.x(), segEnd.x())) {
+  auto isInSegment = [epsilon](Vector2<Real> const &pt, Vector2<Real> const &segStart,
+                               Vector2<Real> const &segEnd) {
+    if (utils::fuzzyEqual(segStart.x(), segEnd.x(), epsilon)) {
       // vertical segment, test y coordinate
       auto minMax = std::minmax({segStart.y(), segEnd.y()});
-      return utils::fuzzyInRange(minMax.first, pt.y(), minMax.second);
+      return utils::fuzzyInRange(minMax.first, pt.y(), minMax.second, epsilon);
     }
 
     // else just test x coordinate
     auto minMax = std::minmax({segStart.x(), segEnd.x()});
-    return utils::fuzzyInRange(minMax.first, pt.x(), minMax.second);
+    return utils::fuzzyInRange(minMax.first, pt.x(), minMax.second, epsilon);
   };
 
   // threshold check here to avoid almost parallel lines resulting in very distant intersection
-  if (std::abs(d) > utils::realThreshold<Real>()) {
+  if (std::abs(d) > epsilon) {
     // segments not parallel or collinear
     result.t0 = perpDot(v, w) / d;
     result.t1 = perpDot(u, w) / d;
@@ -79,16 +79,16 @@ intrLineSeg2LineSeg2(Vector2<Real> const &u1, Vector2<Real> const &u2, Vector2<R
     Real a = perpDot(u, w);
     Real b = perpDot(v, w);
     // threshold check here, we consider almost parallel lines to be parallel
-    if (std::abs(a) > utils::realThreshold<Real>() || std::abs(b) > utils::realThreshold<Real>()) {
+    if (std::abs(a) > epsilon || std::abs(b) > epsilon) {
       // parallel and not collinear so no intersect
       result.intrType = LineSeg2LineSeg2IntrType::None;
     } else {
       // either collinear or degenerate (segments are single points)
-      bool uIsPoint = fuzzyEqual(u1, u2);
-      bool vIsPoint = fuzzyEqual(v1, v2);
+      bool uIsPoint = fuzzyEqual(u1, u2, epsilon);
+      bool vIsPoint = fuzzyEqual(v1, v2, epsilon);
       if (uIsPoint && vIsPoint) {
         // both segments are just points
-        if (fuzzyEqual(u1, v1)) {
+        if (fuzzyEqual(u1, v1, epsilon)) {
           // same point
           result.point = u1;
           result.intrType = LineSeg2LineSeg2IntrType::True;
@@ -115,7 +115,7 @@ intrLineSeg2LineSeg2(Vector2<Real> const &u1, Vector2<Real> const &u2, Vector2<R
       } else {
         // neither segment is a point, check if they overlap
         Vector2<Real> w2 = u2 - v1;
-        if (std::abs(v.x()) < utils::realThreshold<Real>()) {
+        if (std::abs(v.x()) < epsilon) {
           result.t0 = w.y() / v.y();
           result.t1 = w2.y() / v.y();
         } else {
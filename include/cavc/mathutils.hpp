@@ -2,6 +2,7 @@
 #define CAVC_MATHUTILS_HPP
 
 #include "internal/common.hpp"
+#include "stats.hpp"
 #include <atomic>
 #include <cmath>
 #include <iterator>
@@ -68,24 +69,77 @@ template <typename Real> void resetEpsilonConfig() {
   setEpsilonConfig(defaultEpsilonConfig<Real>());
 }
 
+// Per thread tolerance context, when set the tolerance accessors below read from it instead of the
+// global config. Algorithm entry points (parallelOffset, combinePolylines, findIntersects, etc.)
+// accept an EpsilonConfig and install it for the duration of the call, so the global config is
+// read once per call and different threads may run with different tolerances at the same time.
+template <typename Real> EpsilonConfig<Real> const *&activeEpsilonContext() {
+  thread_local EpsilonConfig<Real> const *context = nullptr;
+  return context;
+}
+
+/// RAII helper that installs config as the calling thread's tolerance context and restores the
+/// previous context on destruction, config must outlive the scope.
+template <typename Real> class ScopedEpsilonContext {
+public:
+  explicit ScopedEpsilonContext(EpsilonConfig<Real> const &config)
+      : m_previous(activeEpsilonContext<Real>()) {
+    activeEpsilonContext<Real>() = &config;
+  }
+
+  ~ScopedEpsilonContext() { activeEpsilonContext<Real>() = m_previous; }
+
+  ScopedEpsilonContext(ScopedEpsilonContext const &) = delete;
+  ScopedEpsilonContext &operator=(ScopedEpsilonContext const &) = delete;
+
+private:
+  EpsilonConfig<Real> const *m_previous;
+};
+
+/// Returns the tolerances in effect for the calling thread (the active context if one is installed
+/// otherwise a snapshot of the global config).
+template <typename Real> EpsilonConfig<Real> currentEpsilonConfig() {
+  if (EpsilonConfig<Real> const *context = activeEpsilonContext<Real>()) {
+    return *context;
+  }
+
+  return getEpsilonConfig<Real>();
+}
+
 // absolute threshold to be used for comparing reals generally
 template <typename Real> Real realThreshold() {
+  if (EpsilonConfig<Real> const *context = activeEpsilonContext<Real>()) {
+    return context->realThreshold;
+  }
+
   return epsilonConfig<Real>().realThreshold.load(std::memory_order_relaxed);
 }
 
 // absolute threshold to be used for reals in common geometric computation (e.g. to check for
 // singularities)
 template <typename Real> Real realPrecision() {
+  if (EpsilonConfig<Real> const *context = activeEpsilonContext<Real>()) {
+    return context->realPrecision;
+  }
+
   return epsilonConfig<Real>().realPrecision.load(std::memory_order_relaxed);
 }
 
 // absolute threshold to be used for joining slices together at end points
 template <typename Real> Real sliceJoinThreshold() {
+  if (EpsilonConfig<Real> const *context = activeEpsilonContext<Real>()) {
+    return context->sliceJoinThreshold;
+  }
+
   return epsilonConfig<Real>().sliceJoinThreshold.load(std::memory_order_relaxed);
 }
 
 // absolute threshold to be used for pruning invalid slices for offset
 template <typename Real> Real offsetThreshold() {
+  if (EpsilonConfig<Real> const *context = activeEpsilonContext<Real>()) {
+    return context->offsetThreshold;
+  }
+
   return epsilonConfig<Real>().offsetThreshold.load(std::memory_order_relaxed);
 }
 
@@ -94,6 +148,7 @@ template <typename Real> constexpr Real pi() { return Real(3.1415926535897932384
 template <typename Real> constexpr Real tau() { return Real(2) * pi<Real>(); }
 
 template <typename Real> bool fuzzyEqual(Real x, Real y, Real epsilon = realThreshold<Real>()) {
+  CAVC_STATS_INC(fuzzyEqualCalls);
   return std::abs(x - y) < epsilon;
 }
 
@@ -89,6 +89,48 @@ ArcRadiusAndCenter<Real> arcRadiusAndCenter(PlineVertex<Real> const &v1,
   return ArcRadiusAndCenter<Real>{r, c};
 }
 
+/// Arc radius and center plus the normalized start and end angles and the signed sweep angle of a
+/// segment. Computing it once per segment (see ArcGeometryCache in polyline.hpp) lets repeated
+/// queries against the same segment skip recomputing the center and the start and end angles.
+/// Line segments and degenerate arcs (end points on top of each other) have a radius and sweep
+/// angle of 0.
+template <typename Real> struct ArcGeometry : ArcRadiusAndCenter<Real> {
+  Real startAngle;
+  Real endAngle;
+  Real sweepAngle;
+
+  bool isArc() const { return this->radius != Real(0); }
+};
+
+namespace internal {
+/// Compute the ArcGeometry of the arc segment defined by v1 to v2.
+template <typename Real>
+ArcGeometry<Real> computeArcGeometry(PlineVertex<Real> const &v1, PlineVertex<Real> const &v2) {
+  auto arc = arcRadiusAndCenter(v1, v2);
+  Real startAngle = utils::normalizeRadians(angle(arc.center, v1.pos()));
+  Real endAngle = utils::normalizeRadians(angle(arc.center, v2.pos()));
+  Real sweepAngle = utils::deltaAngle(startAngle, endAngle);
+  if (v1.bulgeIsNeg() && sweepAngle > Real(0)) {
+    sweepAngle -= utils::tau<Real>();
+  } else if (v1.bulgeIsPos() && sweepAngle < Real(0)) {
+    sweepAngle += utils::tau<Real>();
+  }
+
+  return ArcGeometry<Real>{{arc.radius, arc.center}, startAngle, endAngle, sweepAngle};
+}
+} // namespace internal
+
+/// Compute the ArcGeometry of the segment defined by v1 to v2 (radius and sweep angle are 0 if it is
+/// a line segment or degenerate arc).
+template <typename Real>
+ArcGeometry<Real> arcGeometry(PlineVertex<Real> const &v1, PlineVertex<Real> const &v2) {
+  if (v1.bulgeIsZero() || fuzzyEqual(v1.pos(), v2.pos(), utils::realPrecision<Real>())) {
+    return ArcGeometry<Real>{{Real(0), v1.pos()}, Real(0), Real(0), Real(0)};
+  }
+
+  return internal::computeArcGeometry(v1, v2);
+}
+
 /// Result of splitting a segment v1 to v2.
 template <typename Real> struct SplitResult {
   /// Updated starting vertex.
@@ -100,16 +142,16 @@ template <typename Real> struct SplitResult {
 /// Split the segment defined by v1 to v2 at some point defined along it.
 template <typename Real>
 SplitResult<Real> splitAtPoint(PlineVertex<Real> const &v1, PlineVertex<Real> const &v2,
-                               Vector2<Real> const &point) {
+                               Vector2<Real> const &point,
+                               Real epsilon = utils::realPrecision<Real>()) {
   SplitResult<Real> result;
-  if (v1.bulgeIsZero()) {
+  if (v1.bulgeIsZero(epsilon)) {
     result.updatedStart = v1;
     result.splitVertex = PlineVertex<Real>(point, Real(0));
-  } else if (fuzzyEqual(v1.pos(), v2.pos(), utils::realPrecision<Real>()) ||
-             fuzzyEqual(v1.pos(), point, utils::realPrecision<Real>())) {
+  } else if (fuzzyEqual(v1.pos(), v2.pos(), epsilon) || fuzzyEqual(v1.pos(), point, epsilon)) {
     result.updatedStart = PlineVertex<Real>(point, Real(0));
     result.splitVertex = PlineVertex<Real>(point, v1.bulge());
-  } else if (fuzzyEqual(v2.pos(), point, utils::realPrecision<Real>())) {
+  } else if (fuzzyEqual(v2.pos(), point, epsilon)) {
     result.updatedStart = v1;
     result.splitVertex = PlineVertex<Real>(v2.pos(), Real(0));
   } else {
@@ -130,6 +172,28 @@ SplitResult<Real> splitAtPoint(PlineVertex<Real> const &v1, PlineVertex<Real> co
   return result;
 }
 
+/// Same as splitAtPoint above but uses the precomputed arc geometry of the segment.
+template <typename Real>
+SplitResult<Real> splitAtPoint(PlineVertex<Real> const &v1, PlineVertex<Real> const &v2,
+                               ArcGeometry<Real> const &arc, Vector2<Real> const &point,
+                               Real epsilon = utils::realPrecision<Real>()) {
+  if (!arc.isArc() || fuzzyEqual(v1.pos(), point, epsilon) ||
+      fuzzyEqual(v2.pos(), point, epsilon)) {
+    return splitAtPoint(v1, v2, point, epsilon);
+  }
+
+  Real a = angle(arc.center, point);
+  Real theta1 = utils::deltaAngle(arc.startAngle, a);
+  Real bulge1 = std::tan(theta1 / Real(4));
+  Real theta2 = utils::deltaAngle(a, arc.endAngle);
+  Real bulge2 = std::tan(theta2 / Real(4));
+
+  SplitResult<Real> result;
+  result.updatedStart = PlineVertex<Real>(v1.pos(), bulge1);
+  result.splitVertex = PlineVertex<Real>(point, bulge2);
+  return result;
+}
+
 template <typename Real>
 Vector2<Real> segTangentVector(PlineVertex<Real> const &v1, PlineVertex<Real> const &v2,
                                Vector2<Real> const &pointOnSeg) {
@@ -147,17 +211,12 @@ Vector2<Real> segTangentVector(PlineVertex<Real> const &v1, PlineVertex<Real> co
   return Vector2<Real>(pointOnSeg.y() - arc.center.y(), -(pointOnSeg.x() - arc.center.x()));
 }
 
-/// Compute the closest point on a segment defined by v1 to v2 to the point given.
-template <typename Real>
-Vector2<Real> closestPointOnSeg(PlineVertex<Real> const &v1, PlineVertex<Real> const &v2,
-                                Vector2<Real> const &point,
-                                Real epsilon = utils::realPrecision<Real>()) {
-  if (v1.bulgeIsZero()) {
-    return closestPointOnLineSeg(v1.pos(), v2.pos(), point);
-  }
-
-  auto arc = arcRadiusAndCenter(v1, v2);
-
+namespace internal {
+/// Closest point on the arc segment v1 to v2 with the arc given (ArcRadiusAndCenter or
+/// ArcGeometry) to the point given.
+template <typename Real, typename Arc>
+Vector2<Real> closestPointOnArcSeg(PlineVertex<Real> const &v1, PlineVertex<Real> const &v2,
+                                   Arc const &arc, Vector2<Real> const &point, Real epsilon) {
   if (fuzzyEqual(point, arc.center, epsilon)) {
     // avoid normalizing zero length vector (point is at center, just return start point)
     return v1.pos();
@@ -179,13 +238,39 @@ Vector2<Real> closestPointOnSeg(PlineVertex<Real> const &v1, PlineVertex<Real> c
 
   return v2.pos();
 }
+} // namespace internal
+
+/// Compute the closest point on a segment defined by v1 to v2 to the point given.
+template <typename Real>
+Vector2<Real> closestPointOnSeg(PlineVertex<Real> const &v1, PlineVertex<Real> const &v2,
+                                Vector2<Real> const &point,
+                                Real epsilon = utils::realPrecision<Real>()) {
+  if (v1.bulgeIsZero(epsilon)) {
+    return closestPointOnLineSeg(v1.pos(), v2.pos(), point);
+  }
+
+  return internal::closestPointOnArcSeg(v1, v2, arcRadiusAndCenter(v1, v2), point, epsilon);
+}
+
+/// Same as closestPointOnSeg above but uses the precomputed arc geometry of the segment.
+template <typename Real>
+Vector2<Real> closestPointOnSeg(PlineVertex<Real> const &v1, PlineVertex<Real> const &v2,
+                                ArcGeometry<Real> const &arc, Vector2<Real> const &point,
+                                Real epsilon = utils::realPrecision<Real>()) {
+  if (v1.bulgeIsZero(epsilon) || !arc.isArc()) {
+    return closestPointOnSeg(v1, v2, point, epsilon);
+  }
+
+  return internal::closestPointOnArcSeg(v1, v2, arc, point, epsilon);
+}
 
 /// Computes a fast approximate AABB of a segment described by v1 to v2, bounding box may be larger
 /// than the true bounding box for the segment
 template <typename Real>
-AABB<Real> createFastApproxBoundingBox(PlineVertex<Real> const &v1, PlineVertex<Real> const &v2) {
+AABB<Real> createFastApproxBoundingBox(PlineVertex<Real> const &v1, PlineVertex<Real> const &v2,
+                                       Real epsilon = utils::realPrecision<Real>()) {
   AABB<Real> result;
-  if (v1.bulgeIsZero()) {
+  if (v1.bulgeIsZero(epsilon)) {
     if (v1.x() < v2.x()) {
       result.xMin = v1.x();
       result.xMax = v2.x();
@@ -278,8 +363,9 @@ template <typename Real> Real segLength(PlineVertex<Real> const &v1, PlineVertex
 
 /// Return the mid point along a segment path.
 template <typename Real>
-Vector2<Real> segMidpoint(PlineVertex<Real> const &v1, PlineVertex<Real> const &v2) {
-  if (v1.bulgeIsZero()) {
+Vector2<Real> segMidpoint(PlineVertex<Real> const &v1, PlineVertex<Real> const &v2,
+                          Real epsilon = utils::realPrecision<Real>()) {
+  if (v1.bulgeIsZero(epsilon)) {
     return midpoint(v1.pos(), v2.pos());
   }
 
@@ -307,19 +393,37 @@ template <typename Real> struct IntrPlineSegsResult {
   Vector2<Real> point2;
 };
 
-template <typename Real>
-IntrPlineSegsResult<Real> intrPlineSegs(PlineVertex<Real> const &v1, PlineVertex<Real> const &v2,
-                                        PlineVertex<Real> const &u1, PlineVertex<Real> const &u2) {
+namespace internal {
+/// Intersect of the segments v1 to v2 and u1 to u2, vArc() and uArc() return the arc of the
+/// segments (ArcRadiusAndCenter or ArcGeometry) and are only called for arc segments. epsilon is
+/// used for the segment sweep and end point tests and threshold by the line/circle intersect
+/// functions.
+template <typename Real, typename VArcFn, typename UArcFn>
+IntrPlineSegsResult<Real> intrPlineSegsImpl(PlineVertex<Real> const &v1,
+                                            PlineVertex<Real> const &v2,
+                                            PlineVertex<Real> const &u1,
+                                            PlineVertex<Real> const &u2, Real epsilon,
+                                            Real threshold, VArcFn &&vArc, UArcFn &&uArc) {
   IntrPlineSegsResult<Real> result;
-  const bool vIsLine = v1.bulgeIsZero();
-  const bool uIsLine = u1.bulgeIsZero();
+  const bool vIsLine = v1.bulgeIsZero(epsilon);
+  const bool uIsLine = u1.bulgeIsZero(epsilon);
+  if (vIsLine && uIsLine) {
+    CAVC_STATS_INC(intrLineLineCalls);
+  } else if (vIsLine) {
+    CAVC_STATS_INC(intrLineArcCalls);
+  } else if (uIsLine) {
+    CAVC_STATS_INC(intrArcLineCalls);
+  } else {
+    CAVC_STATS_INC(intrArcArcCalls);
+  }
 
   // helper function to process line arc intersect
-  auto processLineArcIntr = [&result](Vector2<Real> const &p0, Vector2<Real> const &p1,
-                                      PlineVertex<Real> const &a1, PlineVertex<Real> const &a2) {
-    Real const epsilon = utils::realPrecision<Real>();
-    auto arc = arcRadiusAndCenter(a1, a2);
-    auto intrResult = intrLineSeg2Circle2(p0, p1, arc.radius, arc.center);
+  auto processLineArcIntr = [&result, epsilon, threshold](Vector2<Real> const &p0,
+                                                          Vector2<Real> const &p1,
+                                                          PlineVertex<Real> const &a1,
+                                                          PlineVertex<Real> const &a2,
+                                                          auto const &arc) {
+    auto intrResult = intrLineSeg2Circle2(p0, p1, arc.radius, arc.center, threshold);
     Real const lineLength = length(p1 - p0);
 
     // helper function to test and get point within arc sweep
@@ -366,7 +470,7 @@ IntrPlineSegsResult<Real> intrPlineSegs(PlineVertex<Real> const &v1, PlineVertex
   };
 
   if (vIsLine && uIsLine) {
-    auto intrResult = intrLineSeg2LineSeg2(v1.pos(), v2.pos(), u1.pos(), u2.pos());
+    auto intrResult = intrLineSeg2LineSeg2(v1.pos(), v2.pos(), u1.pos(), u2.pos(), threshold);
     switch (intrResult.intrType) {
     case LineSeg2LineSeg2IntrType::None:
       result.intrType = PlineSegIntrType::NoIntersect;
@@ -387,12 +491,12 @@ IntrPlineSegsResult<Real> intrPlineSegs(PlineVertex<Real> const &v1, PlineVertex
     }
 
   } else if (vIsLine) {
-    processLineArcIntr(v1.pos(), v2.pos(), u1, u2);
+    processLineArcIntr(v1.pos(), v2.pos(), u1, u2, uArc());
   } else if (uIsLine) {
-    processLineArcIntr(u1.pos(), u2.pos(), v1, v2);
+    processLineArcIntr(u1.pos(), u2.pos(), v1, v2, vArc());
   } else {
-    auto arc1 = arcRadiusAndCenter(v1, v2);
-    auto arc2 = arcRadiusAndCenter(u1, u2);
+    auto const arc1 = vArc();
+    auto const arc2 = uArc();
 
     auto startAndSweepAngle = [](Vector2<Real> const &sp, Vector2<Real> const &center, Real bulge) {
       Real startAngle = utils::normalizeRadians(angle(center, sp));
@@ -400,13 +504,13 @@ IntrPlineSegsResult<Real> intrPlineSegs(PlineVertex<Real> const &v1, PlineVertex
       return std::make_pair(startAngle, sweepAngle);
     };
 
-    Real const epsilon = utils::realPrecision<Real>();
     auto bothArcsSweepPoint = [&](Vector2<Real> const &pt) {
       return pointWithinArcSweepAngle(arc1.center, v1.pos(), v2.pos(), v1.bulge(), pt, epsilon) &&
              pointWithinArcSweepAngle(arc2.center, u1.pos(), u2.pos(), u1.bulge(), pt, epsilon);
     };
 
-    auto intrResult = intrCircle2Circle2(arc1.radius, arc1.center, arc2.radius, arc2.center);
+    auto intrResult =
+        intrCircle2Circle2(arc1.radius, arc1.center, arc2.radius, arc2.center, threshold);
 
     switch (intrResult.intrType) {
     case Circle2Circle2IntrType::NoIntersect:
@@ -504,6 +608,33 @@ IntrPlineSegsResult<Real> intrPlineSegs(PlineVertex<Real> const &v1, PlineVertex
 
   return result;
 }
+} // namespace internal
+
+/// Intersect of the segments v1 to v2 and u1 to u2, epsilon is used for the segment sweep and end
+/// point tests and threshold by the underlying line/circle intersect functions.
+template <typename Real>
+IntrPlineSegsResult<Real> intrPlineSegs(PlineVertex<Real> const &v1, PlineVertex<Real> const &v2,
+                                        PlineVertex<Real> const &u1, PlineVertex<Real> const &u2,
+                                        Real epsilon = utils::realPrecision<Real>(),
+                                        Real threshold = utils::realThreshold<Real>()) {
+  return internal::intrPlineSegsImpl(
+      v1, v2, u1, u2, epsilon, threshold, [&] { return arcRadiusAndCenter(v1, v2); },
+      [&] { return arcRadiusAndCenter(u1, u2); });
+}
+
+/// Same as intrPlineSegs above but uses the precomputed arc geometry of the segments (vArc for v1
+/// to v2 and uArc for u1 to u2).
+template <typename Real>
+IntrPlineSegsResult<Real> intrPlineSegs(PlineVertex<Real> const &v1, PlineVertex<Real> const &v2,
+                                        ArcGeometry<Real> const &vArc, PlineVertex<Real> const &u1,
+                                        PlineVertex<Real> const &u2, ArcGeometry<Real> const &uArc,
+                                        Real epsilon = utils::realPrecision<Real>(),
+                                        Real threshold = utils::realThreshold<Real>()) {
+  return internal::intrPlineSegsImpl(
+      v1, v2, u1, u2, epsilon, threshold,
+      [&] { return vArc.isArc() ? vArc : internal::computeArcGeometry(v1, v2); },
+      [&] { return uArc.isArc() ? uArc : internal::computeArcGeometry(u1, u2); });
+}
 
 } // namespace cavc
 #endif // CAVC_PLINESEGMENT_HPP
@@ -35,6 +35,10 @@ public:
   std::vector<PVertex> &vertexes() { return m_vertexes; }
   std::vector<PVertex> const &vertexes() const { return m_vertexes; }
 
+  /// Bytes of heap memory held by the polyline (vertex capacity), not including
+  /// sizeof(Polyline).
+  std::size_t memoryUsage() const { return m_vertexes.capacity() * sizeof(PVertex); }
+
   /// Iterate the segment indices of the polyline. visitor function is invoked for each segment
   /// index pair, stops when all indices have been visited or visitor returns false. visitor
   /// signature is bool(std::size_t, std::size_t).
@@ -63,6 +67,79 @@ private:
   std::vector<PVertex> m_vertexes;
 };
 
+namespace internal {
+/// Bytes of heap memory held by a vector of objects that have a memoryUsage() method (vector
+/// capacity plus each element's memoryUsage()).
+template <typename T> std::size_t elementsMemoryUsage(std::vector<T> const &values) {
+  std::size_t result = values.capacity() * sizeof(T);
+  for (auto const &value : values) {
+    result += value.memoryUsage();
+  }
+  return result;
+}
+} // namespace internal
+
+/// Non owning, read only view of polyline vertexes held in externally owned memory (e.g. interop
+/// buffers). Each vertex component (x, y, bulge) is read through its own pointer using a byte
+/// stride between consecutive vertexes, so both packed (x, y, bulge) structs and separate component
+/// arrays can be viewed without copying. If bulge is null all bulge values are 0. The viewed
+/// memory must outlive the view and not be modified while in use.
+template <typename Real> class PolylineView {
+public:
+  using PVertex = PlineVertex<Real>;
+
+  PolylineView(std::size_t size, bool isClosed, Real const *x, Real const *y, Real const *bulge,
+               std::size_t xStride, std::size_t yStride, std::size_t bulgeStride)
+      : m_size(size), m_isClosed(isClosed), m_x(reinterpret_cast<char const *>(x)),
+        m_y(reinterpret_cast<char const *>(y)), m_bulge(reinterpret_cast<char const *>(bulge)),
+        m_xStride(xStride), m_yStride(yStride), m_bulgeStride(bulgeStride) {
+    CAVC_ASSERT(size == 0 || (x != nullptr && y != nullptr), "x and y must be given");
+  }
+
+  /// View over packed vertexes where x, y and bulge are consecutive Real values and vertexes are
+  /// stride bytes apart (e.g. an array of {x, y, bulge} structs).
+  static PolylineView packed(Real const *xyb, std::size_t size, bool isClosed,
+                             std::size_t stride = 3 * sizeof(Real)) {
+    return PolylineView(size, isClosed, xyb, xyb + 1, xyb + 2, stride, stride, stride);
+  }
+
+  inline PVertex operator[](std::size_t i) const {
+    Real const bulge = m_bulge == nullptr ? Real(0) : component(m_bulge, m_bulgeStride, i);
+    return PVertex(component(m_x, m_xStride, i), component(m_y, m_yStride, i), bulge);
+  }
+
+  bool isClosed() const { return m_isClosed; }
+  std::size_t size() const { return m_size; }
+  PVertex lastVertex() const { return (*this)[m_size - 1]; }
+
+private:
+  static Real component(char const *base, std::size_t stride, std::size_t i) {
+    return *reinterpret_cast<Real const *>(base + i * stride);
+  }
+
+  std::size_t m_size;
+  bool m_isClosed;
+  char const *m_x;
+  char const *m_y;
+  char const *m_bulge;
+  std::size_t m_xStride;
+  std::size_t m_yStride;
+  std::size_t m_bulgeStride;
+};
+
+/// Copy the vertexes of a view into a new polyline.
+template <typename Real> Polyline<Real> toPolyline(PolylineView<Real> const &view) {
+  Polyline<Real> result;
+  result.isClosed() = view.isClosed();
+  result.vertexes().reserve(view.size());
+  for (std::size_t i = 0; i < view.size(); ++i) {
+    result.addVertex(view[i]);
+  }
+  return result;
+}
+
+template <typename Real> Polyline<Real> toPolyline(Polyline<Real> const &pline) { return pline; }
+
 /// Scale X and Y of polyline by scaleFactor.
 template <typename Real> void scalePolyline(Polyline<Real> &pline, Real scaleFactor) {
   for (auto &v : pline.vertexes()) {
@@ -78,9 +155,48 @@ void translatePolyline(Polyline<Real> &pline, Vector2<Real> const &offset) {
   }
 }
 
-/// Compute the extents of a polyline, if there are no vertexes than -infinity to infinity bounding
-/// box is returned.
-template <typename Real> AABB<Real> getExtents(Polyline<Real> const &pline) {
+/// Arc geometry (center, radius, start/end angles and sweep angle, see ArcGeometry) of every segment
+/// of a polyline computed once so algorithms run repeatedly against the same polyline (extents,
+/// area and closest point queries, segment intersects and splits, raw offset segments) do not
+/// recompute it per call. Opt in: build the cache for a polyline and pass it to the overloads
+/// taking an ArcGeometryCache (the winding number overloads accept it for convenience but give the
+/// same results as the uncached functions). Entry i is the segment starting at vertex i (entries
+/// for line segments have a radius of 0). The cache does not track changes to the polyline, build
+/// it again after modifying the polyline.
+template <typename Real> class ArcGeometryCache {
+public:
+  ArcGeometryCache() = default;
+  explicit ArcGeometryCache(Polyline<Real> const &pline) { build(pline); }
+
+  /// Compute the arc geometry of every segment of pline (reuses the allocated capacity).
+  void build(Polyline<Real> const &pline) {
+    m_segments.clear();
+    m_segments.reserve(pline.size());
+    for (std::size_t i = 0; i < pline.size(); ++i) {
+      m_segments.push_back(arcGeometry(pline[i], pline[utils::nextWrappingIndex(i, pline)]));
+    }
+  }
+
+  /// Arc geometry of the segment starting at vertex segStartIndex.
+  ArcGeometry<Real> const &operator[](std::size_t segStartIndex) const {
+    return m_segments[segStartIndex];
+  }
+
+  /// Number of entries, equal to the size of the polyline the cache was built for.
+  std::size_t size() const { return m_segments.size(); }
+
+  /// Bytes of heap memory held by the cache, not including sizeof(ArcGeometryCache).
+  std::size_t memoryUsage() const { return m_segments.capacity() * sizeof(ArcGeometry<Real>); }
+
+private:
+  std::vector<ArcGeometry<Real>> m_segments;
+};
+
+namespace internal {
+/// Extents of a polyline, arcAt(i, j) returns the arc radius and center (ArcRadiusAndCenter or
+/// ArcGeometry) of the arc segment from vertex i to j.
+template <typename Real, typename ArcAtFn>
+AABB<Real> getExtentsImpl(Polyline<Real> const &pline, ArcAtFn &&arcAt) {
   if (pline.size() == 0) {
     return {std::numeric_limits<Real>::infinity(), std::numeric_limits<Real>::infinity(),
             -std::numeric_limits<Real>::infinity(), -std::numeric_limits<Real>::infinity()};
@@ -98,8 +214,9 @@ template <typename Real> AABB<Real> getExtents(Polyline<Real> const &pline) {
       result.yMax = p.y();
   };
 
-  constexpr Real cardinalAngles[] = {Real(0), Real(0.5) * utils::pi<Real>(), utils::pi<Real>(),
-                                      Real(1.5) * utils::pi<Real>()};
+  Vector2<Real> const cardinalDirections[] = {
+      Vector2<Real>(Real(1), Real(0)), Vector2<Real>(Real(0), Real(1)),
+      Vector2<Real>(Real(-1), Real(0)), Vector2<Real>(Real(0), Real(-1))};
 
   auto visitor = [&](std::size_t i, std::size_t j) {
     PlineVertex<Real> const &v1 = pline[i];
@@ -111,21 +228,11 @@ template <typename Real> AABB<Real> getExtents(Polyline<Real> const &pline) {
         fuzzyEqual(v1.pos(), v2.pos(), utils::realPrecision<Real>())) {
       // line segment or degenerate arc, endpoints already accounted for
     } else {
-      auto arc = arcRadiusAndCenter(v1, v2);
-      Real startAngle = utils::normalizeRadians(angle(arc.center, v1.pos()));
-      Real endAngle = utils::normalizeRadians(angle(arc.center, v2.pos()));
-      Real sweepAngle = utils::deltaAngle(startAngle, endAngle);
-      if (v1.bulgeIsNeg() && sweepAngle > Real(0)) {
-        sweepAngle -= utils::tau<Real>();
-      } else if (v1.bulgeIsPos() && sweepAngle < Real(0)) {
-        sweepAngle += utils::tau<Real>();
-      }
-
-      for (Real angleValue : cardinalAngles) {
-        if (utils::angleIsWithinSweep(startAngle, sweepAngle, angleValue,
-                                      utils::realPrecision<Real>())) {
-          Vector2<Real> arcPoint = pointOnCircle(arc.radius, arc.center, angleValue);
-          updateWithPoint(arcPoint);
+      auto const &arc = arcAt(i, j);
+      for (Vector2<Real> const &direction : cardinalDirections) {
+        if (pointWithinArcSweepAngle(arc.center, v1.pos(), v2.pos(), v1.bulge(),
+                                     arc.center + direction, utils::realPrecision<Real>())) {
+          updateWithPoint(arc.center + arc.radius * direction);
         }
       }
     }
@@ -138,6 +245,23 @@ template <typename Real> AABB<Real> getExtents(Polyline<Real> const &pline) {
 
   return result;
 }
+} // namespace internal
+
+/// Compute the extents of a polyline, if there are no vertexes than -infinity to infinity bounding
+/// box is returned.
+template <typename Real> AABB<Real> getExtents(Polyline<Real> const &pline) {
+  return internal::getExtentsImpl(
+      pline, [&](std::size_t i, std::size_t j) { return arcRadiusAndCenter(pline[i], pline[j]); });
+}
+
+/// Same as getExtents above but uses the polyline's arc geometry cache.
+template <typename Real>
+AABB<Real> getExtents(Polyline<Real> const &pline, ArcGeometryCache<Real> const &arcCache) {
+  CAVC_ASSERT(arcCache.size() == pline.size(), "arc geometry cache does not match polyline");
+  return internal::getExtentsImpl(pline, [&](std::size_t i, std::size_t) -> auto const & {
+    return arcCache[i];
+  });
+}
 
 /// Compute the area of a closed polyline, assumes no self intersects, returns positive number if
 /// polyline direction is counter clockwise, negative if clockwise, zero if not closed
@@ -183,6 +307,43 @@ template <typename Real> Real getArea(Polyline<Real> const &pline) {
   return doubleAreaTotal / Real(2);
 }
 
+/// Same as getArea above but uses the polyline's arc geometry cache (arc segment areas are computed
+/// from the cached radius, center and sweep angle).
+template <typename Real>
+Real getArea(Polyline<Real> const &pline, ArcGeometryCache<Real> const &arcCache) {
+  if (!pline.isClosed() || pline.size() < 2) {
+    return Real(0);
+  }
+
+  CAVC_ASSERT(arcCache.size() == pline.size(), "arc geometry cache does not match polyline");
+  Real doubleAreaTotal = Real(0);
+  for (std::size_t i = 0, j = pline.size() - 1; i < pline.size(); j = i++) {
+    PlineVertex<Real> const &v1 = pline[j];
+    PlineVertex<Real> const &v2 = pline[i];
+    Real doubleArea = v1.x() * v2.y() - v1.y() * v2.x();
+    ArcGeometry<Real> const &arc = arcCache[j];
+    if (arc.isArc()) {
+      // add arc segment area (sector minus the triangle defined by the chord and center, the
+      // triangle area is negative when the arc sweeps more than half a circle)
+      Real doubleSectorArea = std::abs(arc.sweepAngle) * arc.radius * arc.radius;
+      Real doubleTriangleArea = perpDot(v1.pos() - arc.center, v2.pos() - arc.center);
+      if (v1.bulgeIsNeg()) {
+        doubleTriangleArea = -doubleTriangleArea;
+      }
+      Real doubleArcSegArea = doubleSectorArea - doubleTriangleArea;
+      if (v1.bulgeIsNeg()) {
+        doubleArcSegArea = -doubleArcSegArea;
+      }
+
+      doubleArea += doubleArcSegArea;
+    }
+
+    doubleAreaTotal += doubleArea;
+  }
+
+  return doubleAreaTotal / Real(2);
+}
+
 /// Class to compute the closest point and starting vertex index from a polyline to a point given.
 template <typename Real> class ClosestPoint {
 public:
@@ -191,7 +352,41 @@ public:
     compute(pline, point);
   }
 
+  /// Same as above but uses the polyline's arc geometry cache.
+  ClosestPoint(Polyline<Real> const &pline, ArcGeometryCache<Real> const &arcCache,
+               Vector2<Real> const &point) {
+    compute(pline, arcCache, point);
+  }
+
   void compute(Polyline<Real> const &pline, Vector2<Real> const &point) {
+    computeImpl(pline, point, [&](std::size_t i, std::size_t j) {
+      return closestPointOnSeg(pline[i], pline[j], point);
+    });
+  }
+
+  void compute(Polyline<Real> const &pline, ArcGeometryCache<Real> const &arcCache,
+               Vector2<Real> const &point) {
+    CAVC_ASSERT(arcCache.size() == pline.size(), "arc geometry cache does not match polyline");
+    computeImpl(pline, point, [&](std::size_t i, std::size_t j) {
+      return closestPointOnSeg(pline[i], pline[j], arcCache[i], point);
+    });
+  }
+
+  /// Starting vertex index of the segment that has the closest point
+  std::size_t index() const { return m_index; }
+  /// The closest point
+  Vector2<Real> const &point() const { return m_point; }
+  /// Distance between the points
+  Real distance() const { return m_distance; }
+
+private:
+  std::size_t m_index = 0;
+  Vector2<Real> m_point = Vector2<Real>::zero();
+  Real m_distance;
+
+  template <typename SegClosestPointFn>
+  void computeImpl(Polyline<Real> const &pline, Vector2<Real> const &point,
+                   SegClosestPointFn &&segClosestPoint) {
     CAVC_ASSERT(pline.vertexes().size() > 0, "empty polyline has no closest point");
     if (pline.vertexes().size() == 1) {
       m_index = 0;
@@ -203,7 +398,7 @@ public:
     m_distance = std::numeric_limits<Real>::infinity();
 
     auto visitor = [&](std::size_t i, std::size_t j) {
-      Vector2<Real> cp = closestPointOnSeg(pline[i], pline[j], point);
+      Vector2<Real> cp = segClosestPoint(i, j);
       auto diffVec = point - cp;
       Real dist2 = dot(diffVec, diffVec);
       if (dist2 < m_distance) {
@@ -228,18 +423,6 @@ public:
     // we used the squared distance while iterating and comparing, take sqrt for actual distance
     m_distance = std::sqrt(m_distance);
   }
-
-  /// Starting vertex index of the segment that has the closest point
-  std::size_t index() const { return m_index; }
-  /// The closest point
-  Vector2<Real> const &point() const { return m_point; }
-  /// Distance between the points
-  Real distance() const { return m_distance; }
-
-private:
-  std::size_t m_index = 0;
-  Vector2<Real> m_point = Vector2<Real>::zero();
-  Real m_distance;
 };
 
 /// Returns a new polyline with all arc segments converted to line segments, error is the maximum
@@ -329,17 +512,15 @@ Polyline<Real> pruneSingularities(Polyline<Real> const &pline, Real epsilon) {
   return result;
 }
 
-/// Returns a new polyline with redundant vertexes removed. Redundant vertexes can arise from
-/// repeating positions, collinear line segments that continue in the same direction, or concentric
-/// arc segments with the same orientation whose combined sweep remains under PI.
-template <typename Real>
-Polyline<Real> removeRedundant(Polyline<Real> const &pline,
-                               Real epsilon = utils::realPrecision<Real>()) {
+namespace internal {
+// removeRedundant implementation shared by Polyline and PolylineView sources
+template <typename Real, typename PlineSource>
+Polyline<Real> removeRedundantImpl(PlineSource const &pline, Real epsilon) {
   using PVertex = PlineVertex<Real>;
 
   std::size_t const vertexCount = pline.size();
   if (vertexCount < 2) {
-    return pline;
+    return toPolyline(pline);
   }
 
   if (vertexCount == 2) {
@@ -349,7 +530,7 @@ Polyline<Real> removeRedundant(Polyline<Real> const &pline,
       result.addVertex(pline[1]);
       return result;
     }
-    return pline;
+    return toPolyline(pline);
   }
 
   auto makeCopy = [&](std::size_t endExclusive) {
@@ -400,7 +581,7 @@ Polyline<Real> removeRedundant(Polyline<Real> const &pline,
     if (result) {
       return std::move(*result);
     }
-    return pline;
+    return toPolyline(pline);
   }
 
   std::optional<ArcRadiusAndCenter<Real>> v1V2Arc;
@@ -443,8 +624,11 @@ Polyline<Real> removeRedundant(Polyline<Real> const &pline,
         Real const angle1 = angle(v1V2Arc->center, v1.pos());
         Real const angle2 = angle(v1V2Arc->center, v2.pos());
         Real const angle3 = angle(v1V2Arc->center, v3.pos());
-        Real const totalSweep =
-            std::abs(utils::deltaAngle(angle1, angle2)) + std::abs(utils::deltaAngle(angle2, angle3));
+        // clamped since sweeps within epsilon above a half circle are accepted below (bulge must
+        // stay within [-1, 1])
+        Real const totalSweep = std::min(std::abs(utils::deltaAngle(angle1, angle2)) +
+                                             std::abs(utils::deltaAngle(angle2, angle3)),
+                                         utils::pi<Real>());
         Real const avgRadius = (v1V2Arc->radius + arc2.radius) / Real(2);
         if (avgRadius * totalSweep < avgRadius * utils::pi<Real>() + epsilon) {
           updatedBulge =
@@ -498,12 +682,12 @@ Polyline<Real> removeRedundant(Polyline<Real> const &pline,
       result->vertexes().pop_back();
     }
 
-    Polyline<Real> const &curr = result ? *result : pline;
-    if (curr.size() < 2) {
-      return curr;
+    std::size_t const currSize = result ? result->size() : pline.size();
+    if (currSize < 2) {
+      return result ? std::move(*result) : toPolyline(pline);
     }
 
-    PVertex const wrapV3 = curr.size() > 1 ? curr[1] : curr[0];
+    PVertex const wrapV3 = result ? (*result)[1] : pline[1];
 
     if (v1BulgeIsZero && v2BulgeIsZero && isCollinearSameDir(v1, v2, wrapV3)) {
       auto &copy = ensureCopy();
@@ -521,8 +705,11 @@ Polyline<Real> removeRedundant(Polyline<Real> const &pline,
         Real const angle1 = angle(v1V2Arc->center, v1.pos());
         Real const angle2 = angle(v1V2Arc->center, v2.pos());
         Real const angle3 = angle(v1V2Arc->center, wrapV3.pos());
-        Real const totalSweep =
-            std::abs(utils::deltaAngle(angle1, angle2)) + std::abs(utils::deltaAngle(angle2, angle3));
+        // clamped since sweeps within epsilon above a half circle are accepted below (bulge must
+        // stay within [-1, 1])
+        Real const totalSweep = std::min(std::abs(utils::deltaAngle(angle1, angle2)) +
+                                             std::abs(utils::deltaAngle(angle2, angle3)),
+                                         utils::pi<Real>());
         Real const avgRadius = (v1V2Arc->radius + arc2.radius) / Real(2);
         if (avgRadius * totalSweep < avgRadius * utils::pi<Real>() + epsilon) {
           Real const bulge =
@@ -553,7 +740,24 @@ Polyline<Real> removeRedundant(Polyline<Real> const &pline,
   if (result) {
     return std::move(*result);
   }
-  return pline;
+  return toPolyline(pline);
+}
+} // namespace internal
+
+/// Returns a new polyline with redundant vertexes removed. Redundant vertexes can arise from
+/// repeating positions, collinear line segments that continue in the same direction, or concentric
+/// arc segments with the same orientation whose combined sweep remains under PI.
+template <typename Real>
+Polyline<Real> removeRedundant(Polyline<Real> const &pline,
+                               Real epsilon = utils::realPrecision<Real>()) {
+  return internal::removeRedundantImpl(pline, epsilon);
+}
+
+/// Same as removeRedundant for a polyline but reads the vertexes directly from the view.
+template <typename Real>
+Polyline<Real> removeRedundant(PolylineView<Real> const &pline,
+                               Real epsilon = utils::realPrecision<Real>()) {
+  return internal::removeRedundantImpl(pline, epsilon);
 }
 
 /// Inverts the direction of the polyline given. If polyline is closed then this just changes the
@@ -657,136 +861,236 @@ template <typename Real> Real getPathLength(Polyline<Real> const &pline) {
   return result;
 }
 
-/// Compute the winding number for the point in relation to the polyline. If polyline is open and
-/// the first vertex does not overlap the last vertex then 0 is always returned. This algorithm is
-/// adapted from http://geomalgorithms.com/a03-_inclusion.html to support arc segments. NOTE: The
-/// result is not defined if the point lies ontop of the polyline.
+namespace internal {
+/// Test if point is strictly inside the circle of the arc segment v1 to v2 (matches
+/// arcRadiusAndCenter(v1, v2) without computing the chord length sqrt for the radius).
 template <typename Real>
-int getWindingNumber(Polyline<Real> const &pline, Vector2<Real> const &point) {
-  if (!pline.isClosed() || pline.size() < 2) {
-    return 0;
-  }
+bool pointInsideArcCircle(PlineVertex<Real> const &v1, PlineVertex<Real> const &v2,
+                          Vector2<Real> const &point) {
+  CAVC_ASSERT(!fuzzyEqual(v1.pos(), v2.pos()), "v1 must not be ontop of v2");
+
+  const Real v1X = v1.x();
+  const Real v1Y = v1.y();
+  const Real v2X = v2.x();
+  const Real v2Y = v2.y();
+  const Real bulge = v1.bulge();
+  const Real bulgeSq = bulge * bulge;
+  const Real chordX = v2X - v1X;
+  const Real chordY = v2Y - v1Y;
+  const Real chordLenSq = chordX * chordX + chordY * chordY;
+  const Real centerOffsetFactor = (Real(1) - bulgeSq) / (Real(4) * bulge);
+  const Real midX = (v1X + v2X) / Real(2);
+  const Real midY = (v1Y + v2Y) / Real(2);
+  const Real centerX = midX - chordY * centerOffsetFactor;
+  const Real centerY = midY + chordX * centerOffsetFactor;
+  const Real radiusFactor = Real(1) + bulgeSq;
+  const Real radiusSq = chordLenSq * radiusFactor * radiusFactor / (Real(16) * bulgeSq);
+  const Real pointToCenterX = point.x() - centerX;
+  const Real pointToCenterY = point.y() - centerY;
+  const Real distSq = pointToCenterX * pointToCenterX + pointToCenterY * pointToCenterY;
+  return distSq < radiusSq;
+}
 
-  const std::size_t plineSize = pline.size();
+/// Same as segWindingNumber below but pointIsInsideArcCircle() is called to test if the point is
+/// inside the arc's circle.
+template <typename Real, typename InsideArcCircleFn>
+int segWindingNumber(PlineVertex<Real> const &v1, PlineVertex<Real> const &v2,
+                     Vector2<Real> const &point, InsideArcCircleFn &&pointIsInsideArcCircle) {
   const Real pointX = point.x();
   const Real pointY = point.y();
-  int windingNumber = 0;
-  for (std::size_t i = 0, j = plineSize - 1; i < plineSize; j = i++) {
-    PlineVertex<Real> const &v1 = pline[j];
-    PlineVertex<Real> const &v2 = pline[i];
-    const Real v1X = v1.x();
-    const Real v1Y = v1.y();
-    const Real v2X = v2.x();
-    const Real v2Y = v2.y();
-
-    if (v1.bulgeIsZero()) {
-      if (v1Y <= pointY) {
-        if (v2Y > pointY && isLeft(v1.pos(), v2.pos(), point)) {
-          // left and upward crossing
-          windingNumber += 1;
-        }
-      } else if (v2Y <= pointY && !(isLeft(v1.pos(), v2.pos(), point))) {
-        // right and downward crossing
-        windingNumber -= 1;
+  const Real v1X = v1.x();
+  const Real v1Y = v1.y();
+  const Real v2X = v2.x();
+  const Real v2Y = v2.y();
+  int result = 0;
+
+  if (v1.bulgeIsZero()) {
+    if (v1Y <= pointY) {
+      if (v2Y > pointY && isLeft(v1.pos(), v2.pos(), point)) {
+        // left and upward crossing
+        result += 1;
       }
-      continue;
+    } else if (v2Y <= pointY && !(isLeft(v1.pos(), v2.pos(), point))) {
+      // right and downward crossing
+      result -= 1;
     }
+    return result;
+  }
 
-    const bool isCCW = v1.bulgeIsPos();
-    const bool startsBelowOrOnPoint = v1Y <= pointY;
-    const bool upwardCrossing = startsBelowOrOnPoint && v2Y > pointY;
-    const bool downwardCrossing = !startsBelowOrOnPoint && v2Y <= pointY;
-    // to robustly handle the case where point is on the chord of an x axis aligned arc we must
-    // count it as left going one direction and not left going the other (similar to using <= for
-    // end points)
-    const bool pointIsLeft =
-        isCCW ? isLeft(v1.pos(), v2.pos(), point) : isLeftOrEqual(v1.pos(), v2.pos(), point);
-    auto pointIsInsideArcCircle = [&]() {
-      CAVC_ASSERT(!fuzzyEqual(v1.pos(), v2.pos()), "v1 must not be ontop of v2");
-
-      // Match arcRadiusAndCenter(v1, v2) without computing chord length sqrt for the radius check.
-      const Real bulge = v1.bulge();
-      const Real bulgeSq = bulge * bulge;
-      const Real chordX = v2X - v1X;
-      const Real chordY = v2Y - v1Y;
-      const Real chordLenSq = chordX * chordX + chordY * chordY;
-      const Real centerOffsetFactor = (Real(1) - bulgeSq) / (Real(4) * bulge);
-      const Real midX = (v1X + v2X) / Real(2);
-      const Real midY = (v1Y + v2Y) / Real(2);
-      const Real centerX = midX - chordY * centerOffsetFactor;
-      const Real centerY = midY + chordX * centerOffsetFactor;
-      const Real radiusFactor = Real(1) + bulgeSq;
-      const Real radiusSq =
-          chordLenSq * radiusFactor * radiusFactor / (Real(16) * bulgeSq);
-      const Real pointToCenterX = pointX - centerX;
-      const Real pointToCenterY = pointY - centerY;
-      const Real distSq = pointToCenterX * pointToCenterX + pointToCenterY * pointToCenterY;
-      return distSq < radiusSq;
-    };
-
-    if (startsBelowOrOnPoint) {
-      if (upwardCrossing) {
-        // upward crossing of arc chord
-        if (isCCW) {
-          if (pointIsLeft) {
-            // counter clockwise arc left of chord
-            windingNumber += 1;
-          } else if (pointIsInsideArcCircle()) {
-            // counter clockwise arc right of chord
-            windingNumber += 1;
-          }
-        } else if (pointIsLeft) {
-          // clockwise arc left of chord
-          if (!pointIsInsideArcCircle()) {
-            windingNumber += 1;
-          }
-          // else clockwise arc right of chord, no crossing
-        }
-      } else {
-        // not crossing arc chord and chord is below, check if point is inside arc sector
-        if (isCCW && !pointIsLeft) {
-          if (v2X < pointX && pointX < v1X && pointIsInsideArcCircle()) {
-            windingNumber += 1;
-          }
-        } else if (!isCCW && pointIsLeft) {
-          if (v1X < pointX && pointX < v2X && pointIsInsideArcCircle()) {
-            windingNumber -= 1;
-          }
-        }
-      }
-    } else if (downwardCrossing) {
-      // downward crossing of arc chord
+  const bool isCCW = v1.bulgeIsPos();
+  const bool startsBelowOrOnPoint = v1Y <= pointY;
+  const bool upwardCrossing = startsBelowOrOnPoint && v2Y > pointY;
+  const bool downwardCrossing = !startsBelowOrOnPoint && v2Y <= pointY;
+  // to robustly handle the case where point is on the chord of an x axis aligned arc we must
+  // count it as left going one direction and not left going the other (similar to using <= for
+  // end points)
+  const bool pointIsLeft =
+      isCCW ? isLeft(v1.pos(), v2.pos(), point) : isLeftOrEqual(v1.pos(), v2.pos(), point);
+
+  if (startsBelowOrOnPoint) {
+    if (upwardCrossing) {
+      // upward crossing of arc chord
       if (isCCW) {
-        if (!pointIsLeft) {
+        if (pointIsLeft) {
+          // counter clockwise arc left of chord
+          result += 1;
+        } else if (pointIsInsideArcCircle()) {
           // counter clockwise arc right of chord
-          if (!pointIsInsideArcCircle()) {
-            windingNumber -= 1;
-          }
+          result += 1;
         }
-        // else counter clockwise arc left of chord, no crossing
       } else if (pointIsLeft) {
         // clockwise arc left of chord
-        if (pointIsInsideArcCircle()) {
-          windingNumber -= 1;
+        if (!pointIsInsideArcCircle()) {
+          result += 1;
         }
-      } else {
-        // clockwise arc right of chord
-        windingNumber -= 1;
+        // else clockwise arc right of chord, no crossing
       }
     } else {
-      // not crossing arc chord and chord is above, check if point is inside arc sector
+      // not crossing arc chord and chord is below, check if point is inside arc sector
       if (isCCW && !pointIsLeft) {
-        if (v1X < pointX && pointX < v2X && pointIsInsideArcCircle()) {
-          windingNumber += 1;
+        if (v2X < pointX && pointX < v1X && pointIsInsideArcCircle()) {
+          result += 1;
         }
       } else if (!isCCW && pointIsLeft) {
-        if (v2X < pointX && pointX < v1X && pointIsInsideArcCircle()) {
-          windingNumber -= 1;
+        if (v1X < pointX && pointX < v2X && pointIsInsideArcCircle()) {
+          result -= 1;
+        }
+      }
+    }
+  } else if (downwardCrossing) {
+    // downward crossing of arc chord
+    if (isCCW) {
+      if (!pointIsLeft) {
+        // counter clockwise arc right of chord
+        if (!pointIsInsideArcCircle()) {
+          result -= 1;
         }
       }
+      // else counter clockwise arc left of chord, no crossing
+    } else if (pointIsLeft) {
+      // clockwise arc left of chord
+      if (pointIsInsideArcCircle()) {
+        result -= 1;
+      }
+    } else {
+      // clockwise arc right of chord
+      result -= 1;
+    }
+  } else {
+    // not crossing arc chord and chord is above, check if point is inside arc sector
+    if (isCCW && !pointIsLeft) {
+      if (v1X < pointX && pointX < v2X && pointIsInsideArcCircle()) {
+        result += 1;
+      }
+    } else if (!isCCW && pointIsLeft) {
+      if (v2X < pointX && pointX < v1X && pointIsInsideArcCircle()) {
+        result -= 1;
+      }
     }
   }
 
+  return result;
+}
+
+/// Winding number contribution of the segment from v1 to v2 for the point given, summing this over
+/// all segments of a closed polyline gives the winding number (see getWindingNumber). Only
+/// segments that cross the ray cast from the point in the positive x direction contribute.
+template <typename Real>
+int segWindingNumber(PlineVertex<Real> const &v1, PlineVertex<Real> const &v2,
+                     Vector2<Real> const &point) {
+  return segWindingNumber(v1, v2, point, [&] { return pointInsideArcCircle(v1, v2, point); });
+}
+
+/// Same as segWindingNumber above but tests against the cached arc center and radius of the
+/// segment rather than recomputing them from the bulge.
+template <typename Real>
+int segWindingNumber(PlineVertex<Real> const &v1, PlineVertex<Real> const &v2,
+                     ArcGeometry<Real> const &arc, Vector2<Real> const &point) {
+  return segWindingNumber(v1, v2, point, [&] {
+    return distSquared(point, arc.center) < arc.radius * arc.radius;
+  });
+}
+} // namespace internal
+
+/// Compute the winding number for the point in relation to the polyline. If polyline is open and
+/// the first vertex does not overlap the last vertex then 0 is always returned. This algorithm is
+/// adapted from http://geomalgorithms.com/a03-_inclusion.html to support arc segments. NOTE: The
+/// result is not defined if the point lies ontop of the polyline.
+template <typename Real>
+int getWindingNumber(Polyline<Real> const &pline, Vector2<Real> const &point) {
+  if (!pline.isClosed() || pline.size() < 2) {
+    return 0;
+  }
+
+  const std::size_t plineSize = pline.size();
+  int windingNumber = 0;
+  for (std::size_t i = 0, j = plineSize - 1; i < plineSize; j = i++) {
+    windingNumber += internal::segWindingNumber(pline[j], pline[i], point);
+  }
+
+  return windingNumber;
+}
+
+/// Same as getWindingNumber above but uses the polyline's arc geometry cache.
+template <typename Real>
+int getWindingNumber(Polyline<Real> const &pline, ArcGeometryCache<Real> const &arcCache,
+                     Vector2<Real> const &point) {
+  if (!pline.isClosed() || pline.size() < 2) {
+    return 0;
+  }
+
+  CAVC_ASSERT(arcCache.size() == pline.size(), "arc geometry cache does not match polyline");
+  const std::size_t plineSize = pline.size();
+  int windingNumber = 0;
+  for (std::size_t i = 0, j = plineSize - 1; i < plineSize; j = i++) {
+    windingNumber += internal::segWindingNumber(pline[j], pline[i], arcCache[j], point);
+  }
+
+  return windingNumber;
+}
+
+/// Same as getWindingNumber above but uses the polyline's approximate spatial index (as created by
+/// createApproxSpatialIndex) so only segments crossing the ray cast from the point in the positive
+/// x direction are visited (useful when computing winding numbers for many points). queryStack is
+/// used as the spatial index query stack.
+template <typename Real, std::size_t N>
+int getWindingNumber(Polyline<Real> const &pline, StaticSpatialIndex<Real, N> const &spatialIndex,
+                     Vector2<Real> const &point, std::vector<std::size_t> &queryStack) {
+  if (!pline.isClosed() || pline.size() < 2) {
+    return 0;
+  }
+
+  int windingNumber = 0;
+  auto windingVisitor = [&](std::size_t i) {
+    std::size_t j = utils::nextWrappingIndex(i, pline);
+    windingNumber += internal::segWindingNumber(pline[i], pline[j], point);
+    return true;
+  };
+
+  spatialIndex.visitQuery(point.x(), point.y(), spatialIndex.maxX(), point.y(), windingVisitor,
+                          queryStack);
+  return windingNumber;
+}
+
+/// Same as getWindingNumber above but also uses the polyline's arc geometry cache.
+template <typename Real, std::size_t N>
+int getWindingNumber(Polyline<Real> const &pline, ArcGeometryCache<Real> const &arcCache,
+                     StaticSpatialIndex<Real, N> const &spatialIndex, Vector2<Real> const &point,
+                     std::vector<std::size_t> &queryStack) {
+  if (!pline.isClosed() || pline.size() < 2) {
+    return 0;
+  }
+
+  CAVC_ASSERT(arcCache.size() == pline.size(), "arc geometry cache does not match polyline");
+  int windingNumber = 0;
+  auto windingVisitor = [&](std::size_t i) {
+    std::size_t j = utils::nextWrappingIndex(i, pline);
+    windingNumber += internal::segWindingNumber(pline[i], pline[j], arcCache[i], point);
+    return true;
+  };
+
+  spatialIndex.visitQuery(point.x(), point.y(), spatialIndex.maxX(), point.y(), windingVisitor,
+                          queryStack);
   return windingNumber;
 }
 
@@ -819,6 +1123,54 @@ PointContainment getPointContainment(Polyline<Real> const &pline, Vector2<Real>
   return getWindingNumber(pline, point) == 0 ? PointContainment::Outside : PointContainment::Inside;
 }
 
+/// Same as getPointContainment above but uses the polyline's approximate spatial index (as created
+/// by createApproxSpatialIndex) so only segments near the point or crossing the ray cast from the
+/// point are visited. queryStack is used as the spatial index query stack.
+template <typename Real, std::size_t N>
+PointContainment getPointContainment(Polyline<Real> const &pline,
+                                     StaticSpatialIndex<Real, N> const &spatialIndex,
+                                     Vector2<Real> const &point, Real boundaryEpsilon,
+                                     std::vector<std::size_t> &queryStack) {
+  CAVC_ASSERT(boundaryEpsilon >= Real(0), "boundaryEpsilon must be >= 0");
+  if (pline.size() < 2) {
+    return PointContainment::Outside;
+  }
+
+  bool onBoundary = false;
+  auto boundaryVisitor = [&](std::size_t i) {
+    std::size_t j = utils::nextWrappingIndex(i, pline);
+    Vector2<Real> cp = closestPointOnSeg(pline[i], pline[j], point);
+    auto diffVec = point - cp;
+    onBoundary = std::sqrt(dot(diffVec, diffVec)) <= boundaryEpsilon;
+    // stop as soon as a segment is within the boundary epsilon
+    return !onBoundary;
+  };
+
+  spatialIndex.visitQuery(point.x() - boundaryEpsilon, point.y() - boundaryEpsilon,
+                          point.x() + boundaryEpsilon, point.y() + boundaryEpsilon,
+                          boundaryVisitor, queryStack);
+  if (onBoundary) {
+    return PointContainment::OnBoundary;
+  }
+
+  if (!pline.isClosed()) {
+    return PointContainment::Outside;
+  }
+
+  return getWindingNumber(pline, spatialIndex, point, queryStack) == 0
+             ? PointContainment::Outside
+             : PointContainment::Inside;
+}
+
+template <typename Real, std::size_t N>
+PointContainment getPointContainment(Polyline<Real> const &pline,
+                                     StaticSpatialIndex<Real, N> const &spatialIndex,
+                                     Vector2<Real> const &point,
+                                     Real boundaryEpsilon = utils::realPrecision<Real>()) {
+  std::vector<std::size_t> queryStack;
+  return getPointContainment(pline, spatialIndex, point, boundaryEpsilon, queryStack);
+}
+
 namespace internal {
 template <typename Real>
 void addOrReplaceIfSamePos(Polyline<Real> &pline, PlineVertex<Real> const &vertex,
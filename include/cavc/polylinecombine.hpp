@@ -1,7 +1,9 @@
 #ifndef CAVC_POLYLINECOMBINE_HPP
 #define CAVC_POLYLINECOMBINE_HPP
+#include "cancellation.hpp"
 #include "polyline.hpp"
 #include "polylineintersects.hpp"
+#include "tracing.hpp"
 #include <cstdint>
 #include <unordered_map>
 #include <vector>
@@ -32,6 +34,7 @@ template <typename Real, std::size_t N>
 ProcessForCombineResult<Real>
 processForCombine(Polyline<Real> const &pline1, Polyline<Real> const &pline2,
                   StaticSpatialIndex<Real, N> const &pline1SpatialIndex) {
+  CAVC_TRACE_SCOPE("processForCombine");
 
   CAVC_ASSERT(pline1.isClosed() && pline2.isClosed(), "combining only works with closed polylines");
 
@@ -134,7 +137,11 @@ void sliceAtIntersects(Polyline<Real> const &pline,
     result.push_back({*slice, !useSecondIndex, coincident});
   };
 
+  internal::CancellationPoll cancelPoll;
   for (auto const &kvp : intersectsLookup) {
+    if (cancelPoll()) {
+      break;
+    }
     // start index for the slice we're about to build
     std::size_t sIndex = kvp.first;
     // intersect list for this start index
@@ -214,6 +221,7 @@ CollectedSlices<Real> collectSlices(Polyline<Real> const &plineA, Polyline<Real>
                                     PlineAPointOnSlicePred &&plineAPointOnSlicePred,
                                     PlineBPointOnSlicePred &&plineBPointOnSlicePred,
                                     bool setOpposingOrientation) {
+  CAVC_TRACE_SCOPE("collectSlices");
   CollectedSlices<Real> result;
   auto &slicesRemaining = result.slicesRemaining;
 
@@ -274,6 +282,7 @@ std::vector<Polyline<Real>>
 stitchOrderedSlicesIntoClosedPolylines(std::vector<Polyline<Real>> const &slices,
                                        StitchSelector stitchSelector = StitchFirstAvailable(),
                                        Real joinThreshold = utils::sliceJoinThreshold<Real>()) {
+  CAVC_TRACE_SCOPE("stitchOrderedSlicesIntoClosedPolylines");
   std::vector<Polyline<Real>> result;
   if (slices.size() == 0) {
     return result;
@@ -311,16 +320,21 @@ stitchOrderedSlicesIntoClosedPolylines(std::vector<Polyline<Real>> const &slices
   };
 
   // loop through all slice indexes
+  internal::CancellationPoll cancelPoll;
   for (std::size_t i = 0; i < slices.size(); ++i) {
     if (visitedSliceIndexes[i] != 0) {
       continue;
     }
+    if (cancelPoll()) {
+      break;
+    }
     visitedSliceIndexes[i] = 1;
 
     // create new polyline
     Polyline<Real> currPline;
     currPline.vertexes().insert(currPline.vertexes().end(), slices[i].vertexes().begin(),
                                 slices[i].vertexes().end());
+    CAVC_STATS_ADD(stitchVertexesAppended, slices[i].size());
 
     const std::size_t beginningSliceIndex = i;
     std::size_t currSliceIndex = i;
@@ -362,6 +376,7 @@ stitchOrderedSlicesIntoClosedPolylines(std::vector<Polyline<Real>> const &slices
       currPline.vertexes().pop_back();
       currPline.vertexes().insert(currPline.vertexes().end(), connectedSlice.vertexes().begin(),
                                   connectedSlice.vertexes().end());
+      CAVC_STATS_ADD(stitchVertexesAppended, connectedSlice.size());
       visitedSliceIndexes[connectedSliceIndex] = 1;
 
       // else continue stitching slices to current polyline, using last stitched index to find next
@@ -378,6 +393,7 @@ stitchCombineSlicesIntoClosedPolylines(Polyline<Real> const &plineA, Polyline<Re
                                        std::vector<CombineSliceRef<Real>> const &slices,
                                        StitchSelector stitchSelector = StitchFirstAvailable(),
                                        Real joinThreshold = utils::sliceJoinThreshold<Real>()) {
+  CAVC_TRACE_SCOPE("stitchCombineSlicesIntoClosedPolylines");
   std::vector<Polyline<Real>> result;
   if (slices.empty()) {
     return result;
@@ -412,10 +428,14 @@ stitchCombineSlicesIntoClosedPolylines(Polyline<Real> const &plineA, Polyline<Re
     swap(pline, result.back());
   };
 
+  internal::CancellationPoll cancelPoll;
   for (std::size_t i = 0; i < slices.size(); ++i) {
     if (visitedSliceIndexes[i] != 0) {
       continue;
     }
+    if (cancelPoll()) {
+      break;
+    }
     visitedSliceIndexes[i] = 1;
 
     Polyline<Real> currPline;
@@ -480,14 +500,25 @@ enum class PlineCombineMode { Union, Exclude, Intersect, XOR };
 template <typename Real> struct CombineResult {
   std::vector<Polyline<Real>> remaining;
   std::vector<Polyline<Real>> subtracted;
+
+  /// Bytes of heap memory held by the result (polyline vectors and each polyline's vertexes).
+  std::size_t memoryUsage() const {
+    return internal::elementsMemoryUsage(remaining) + internal::elementsMemoryUsage(subtracted);
+  }
 };
 
-/// Combine two closed polylines applying a particular combine mode (boolean operation).
+/// Combine two closed polylines applying a particular combine mode (boolean operation). eps holds
+/// the tolerances used for the call (installed as the thread's epsilon context). Returns an empty
+/// result if the thread's cancellation token is cancelled or its deadline passes during the call
+/// (the token status then reports why, see cancellation.hpp).
 template <typename Real>
 CombineResult<Real> combinePolylines(Polyline<Real> const &plineA, Polyline<Real> const &plineB,
-                                     PlineCombineMode combineMode) {
+                                     PlineCombineMode combineMode,
+                                     utils::EpsilonConfig<Real> const &eps) {
+  CAVC_TRACE_SCOPE("combinePolylines");
   CAVC_ASSERT(plineA.isClosed() && plineB.isClosed(), "combining only supports closed polylines");
   using namespace internal;
+  utils::ScopedEpsilonContext<Real> epsContext(eps);
 
   auto plinesExactlyEqual = [&] {
     if (plineA.isClosed() != plineB.isClosed() || plineA.size() != plineB.size()) {
@@ -522,6 +553,9 @@ CombineResult<Real> combinePolylines(Polyline<Real> const &plineA, Polyline<Real
   ProcessForCombineResult<Real> combineInfo = processForCombine(plineA, plineB, plASpatialIndex);
 
   CombineResult<Real> result;
+  if (cancellationRequested()) {
+    return result;
+  }
 
   // helper function test if point is inside A
   auto pointInA = [&](Vector2<Real> const &pt) { return getWindingNumber(plineA, pt) != 0; };
@@ -788,7 +822,20 @@ CombineResult<Real> combinePolylines(Polyline<Real> const &plineA, Polyline<Real
     break;
   }
 
+  if (cancellationStopped()) {
+    // a loop level check stopped slicing or stitching part way, discard the partial result
+    return CombineResult<Real>();
+  }
+
   return result;
 }
+
+/// Combine two closed polylines using the tolerances currently in effect (global config unless an
+/// epsilon context is active).
+template <typename Real>
+CombineResult<Real> combinePolylines(Polyline<Real> const &plineA, Polyline<Real> const &plineB,
+                                     PlineCombineMode combineMode) {
+  return combinePolylines(plineA, plineB, combineMode, utils::currentEpsilonConfig<Real>());
+}
 } // namespace cavc
 #endif // CAVC_POLYLINECOMBINE_HPP
@@ -1,8 +1,10 @@
 #ifndef CAVC_POLYLINEINTERSECTS_HPP
 #define CAVC_POLYLINEINTERSECTS_HPP
+#include "cancellation.hpp"
 #include "internal/plinesliceview.hpp"
 #include "mathutils.hpp"
 #include "polyline.hpp"
+#include "tracing.hpp"
 #include "vector2.hpp"
 #include <unordered_set>
 #include <vector>
@@ -58,7 +60,8 @@ template <typename Real> struct CoincidentSlicesResult {
 template <typename Real>
 CoincidentSlicesResult<Real>
 sortAndjoinCoincidentSlices(std::vector<PlineCoincidentIntersect<Real>> &coincidentIntrs,
-                            Polyline<Real> const &pline1, Polyline<Real> const &pline2) {
+                            Polyline<Real> const &pline1, Polyline<Real> const &pline2,
+                            Real epsilon = utils::realPrecision<Real>()) {
   CoincidentSlicesResult<Real> result;
 
   if (coincidentIntrs.size() == 0) {
@@ -94,13 +97,13 @@ sortAndjoinCoincidentSlices(std::vector<PlineCoincidentIntersect<Real>> &coincid
   auto makeSliceStart = [&](PlineCoincidentIntersect<Real> const &intr) {
     PlineIntersect<Real> sliceStart;
     sliceStart.pos = intr.point1;
-    if (fuzzyEqual(pline1[intr.sIndex1].pos(), intr.point1, utils::realPrecision<Real>())) {
+    if (fuzzyEqual(pline1[intr.sIndex1].pos(), intr.point1, epsilon)) {
       sliceStart.sIndex1 = utils::prevWrappingIndex(intr.sIndex1, pline1);
     } else {
       sliceStart.sIndex1 = intr.sIndex1;
     }
 
-    if (fuzzyEqual(pline2[intr.sIndex2].pos(), intr.point1, utils::realPrecision<Real>())) {
+    if (fuzzyEqual(pline2[intr.sIndex2].pos(), intr.point1, epsilon)) {
       sliceStart.sIndex2 = utils::prevWrappingIndex(intr.sIndex2, pline2);
     } else {
       sliceStart.sIndex2 = intr.sIndex2;
@@ -112,7 +115,7 @@ sortAndjoinCoincidentSlices(std::vector<PlineCoincidentIntersect<Real>> &coincid
     PlineIntersect<Real> sliceEnd;
     sliceEnd.pos = intr.point2;
     sliceEnd.sIndex1 = intr.sIndex1;
-    if (fuzzyEqual(pline2[intr.sIndex2].pos(), intr.point2, utils::realPrecision<Real>())) {
+    if (fuzzyEqual(pline2[intr.sIndex2].pos(), intr.point2, epsilon)) {
       sliceEnd.sIndex2 = utils::prevWrappingIndex(intr.sIndex2, pline2);
     } else {
       sliceEnd.sIndex2 = intr.sIndex2;
@@ -158,7 +161,7 @@ sortAndjoinCoincidentSlices(std::vector<PlineCoincidentIntersect<Real>> &coincid
     const auto &intr = coincidentIntrs[i];
     auto const &prevIntr = coincidentIntrs[i - 1];
 
-    if (!fuzzyEqual(intr.point1, prevIntr.point2, utils::realPrecision<Real>())) {
+    if (!fuzzyEqual(intr.point1, prevIntr.point2, epsilon)) {
       emitCoincidentSlice(i - 1);
       currSliceStartIndex = i;
       currOpposingDirection = opposingDirectionAt(intr);
@@ -171,8 +174,7 @@ sortAndjoinCoincidentSlices(std::vector<PlineCoincidentIntersect<Real>> &coincid
     // check if last coincident slice connects with first
     auto const &firstSlice = coincidentSlices.front();
     auto &lastSlice = coincidentSlices.back();
-    if (fuzzyEqual(lastSlice.endPointOnA.pos, firstSlice.startPointOnA.pos,
-                   utils::realPrecision<Real>())) {
+    if (fuzzyEqual(lastSlice.endPointOnA.pos, firstSlice.startPointOnA.pos, epsilon)) {
       lastSlice.endPointOnA = firstSlice.endPointOnA;
       if (lastSlice.opposingDirection) {
         lastSlice.startPointOnB = firstSlice.startPointOnB;
@@ -194,16 +196,21 @@ sortAndjoinCoincidentSlices(std::vector<PlineCoincidentIntersect<Real>> &coincid
 /// Finds all local self intersects of the polyline, local self intersects are defined as between
 /// two polyline segments that share a vertex. NOTES:
 /// - Singularities (repeating vertexes) are returned as coincident intersects
+/// - eps holds the tolerances used for the call (installed as the thread's epsilon context)
 template <typename Real>
-void localSelfIntersects(Polyline<Real> const &pline, std::vector<PlineIntersect<Real>> &output) {
+void localSelfIntersects(Polyline<Real> const &pline, std::vector<PlineIntersect<Real>> &output,
+                         utils::EpsilonConfig<Real> const &eps) {
   if (pline.size() < 2) {
     return;
   }
 
+  utils::ScopedEpsilonContext<Real> epsContext(eps);
+  Real const precision = eps.realPrecision;
+
   if (pline.size() == 2) {
     if (pline.isClosed()) {
       // check if overlaps on itself from vertex 1 to vertex 2
-      if (utils::fuzzyEqual(pline[0].bulge(), -pline[1].bulge())) {
+      if (utils::fuzzyEqual(pline[0].bulge(), -pline[1].bulge(), eps.realThreshold)) {
         // coincident
         output.emplace_back(0, 1, pline[1].pos());
         output.emplace_back(1, 0, pline[0].pos());
@@ -218,26 +225,27 @@ void localSelfIntersects(Polyline<Real> const &pline, std::vector<PlineIntersect
     const PlineVertex<Real> &v3 = pline[k];
     // testing intersection between v1->v2 and v2->v3 segments
 
-    if (fuzzyEqual(v1.pos(), v2.pos(), utils::realPrecision<Real>())) {
+    if (fuzzyEqual(v1.pos(), v2.pos(), precision)) {
       // singularity
       // coincident
       output.emplace_back(i, j, v1.pos());
     } else {
-      IntrPlineSegsResult<Real> intrResult = intrPlineSegs(v1, v2, v2, v3);
+      IntrPlineSegsResult<Real> intrResult =
+          intrPlineSegs(v1, v2, v2, v3, precision, eps.realThreshold);
       switch (intrResult.intrType) {
       case PlineSegIntrType::NoIntersect:
         break;
       case PlineSegIntrType::TangentIntersect:
       case PlineSegIntrType::OneIntersect:
-        if (!fuzzyEqual(intrResult.point1, v2.pos(), utils::realPrecision<Real>())) {
+        if (!fuzzyEqual(intrResult.point1, v2.pos(), precision)) {
           output.emplace_back(i, j, intrResult.point1);
         }
         break;
       case PlineSegIntrType::TwoIntersects:
-        if (!fuzzyEqual(intrResult.point1, v2.pos(), utils::realPrecision<Real>())) {
+        if (!fuzzyEqual(intrResult.point1, v2.pos(), precision)) {
           output.emplace_back(i, j, intrResult.point1);
         }
-        if (!fuzzyEqual(intrResult.point2, v2.pos(), utils::realPrecision<Real>())) {
+        if (!fuzzyEqual(intrResult.point2, v2.pos(), precision)) {
           output.emplace_back(i, j, intrResult.point2);
         }
         break;
@@ -263,6 +271,11 @@ void localSelfIntersects(Polyline<Real> const &pline, std::vector<PlineIntersect
   }
 }
 
+template <typename Real>
+void localSelfIntersects(Polyline<Real> const &pline, std::vector<PlineIntersect<Real>> &output) {
+  localSelfIntersects(pline, output, utils::currentEpsilonConfig<Real>());
+}
+
 /// Finds all global self intersects of the polyline, global self intersects are defined as all
 /// intersects between polyline segments that DO NOT share a vertex (use the localSelfIntersects
 /// function to find those). A spatial index is used to minimize the intersect comparisons required,
@@ -270,13 +283,19 @@ void localSelfIntersects(Polyline<Real> const &pline, std::vector<PlineIntersect
 /// NOTES:
 /// - We never include intersects at a segment's start point, the matching intersect from the
 /// previous segment's end point is included (no sense in including both)
+/// - eps holds the tolerances used for the call (installed as the thread's epsilon context)
 template <typename Real, std::size_t N>
 void globalSelfIntersects(Polyline<Real> const &pline, std::vector<PlineIntersect<Real>> &output,
-                          StaticSpatialIndex<Real, N> const &spatialIndex) {
+                          StaticSpatialIndex<Real, N> const &spatialIndex,
+                          utils::EpsilonConfig<Real> const &eps) {
   if (pline.size() < 3) {
     return;
   }
 
+  utils::ScopedEpsilonContext<Real> epsContext(eps);
+  Real const threshold = eps.realThreshold;
+  Real const precision = eps.realPrecision;
+
   std::unordered_set<std::pair<std::size_t, std::size_t>, internal::IndexPairHash>
       visitedSegmentPairs;
   visitedSegmentPairs.reserve(pline.size());
@@ -284,12 +303,17 @@ void globalSelfIntersects(Polyline<Real> const &pline, std::vector<PlineIntersec
   std::vector<std::size_t> queryStack;
   queryStack.reserve(8);
 
+  // stops early (partial output) if the thread's cancellation token stops the operation
+  internal::CancellationPoll cancelPoll;
   auto visitor = [&](std::size_t i, Real minX, Real minY, Real maxX, Real maxY) {
+    if (cancelPoll()) {
+      return false;
+    }
     std::size_t j = utils::nextWrappingIndex(i, pline);
     const PlineVertex<Real> &v1 = pline[i];
     const PlineVertex<Real> &v2 = pline[j];
     AABB<Real> envelope{minX, minY, maxX, maxY};
-    envelope.expand(utils::realThreshold<Real>());
+    envelope.expand(threshold);
     auto indexVisitor = [&](std::size_t hitIndexStart) {
       std::size_t hitIndexEnd = utils::nextWrappingIndex(hitIndexStart, pline);
       // skip/filter already visited intersects
@@ -309,10 +333,10 @@ void globalSelfIntersects(Polyline<Real> const &pline, std::vector<PlineIntersec
       const PlineVertex<Real> &u2 = pline[hitIndexEnd];
 
       auto intrAtStartPt = [&](Vector2<Real> const &intr) {
-        return fuzzyEqual(v1.pos(), intr) || fuzzyEqual(u1.pos(), intr);
+        return fuzzyEqual(v1.pos(), intr, threshold) || fuzzyEqual(u1.pos(), intr, threshold);
       };
 
-      IntrPlineSegsResult<Real> intrResult = intrPlineSegs(v1, v2, u1, u2);
+      IntrPlineSegsResult<Real> intrResult = intrPlineSegs(v1, v2, u1, u2, precision, threshold);
       switch (intrResult.intrType) {
       case PlineSegIntrType::NoIntersect:
         break;
@@ -355,20 +379,40 @@ void globalSelfIntersects(Polyline<Real> const &pline, std::vector<PlineIntersec
   spatialIndex.visitItemBoxes(visitor);
 }
 
+template <typename Real, std::size_t N>
+void globalSelfIntersects(Polyline<Real> const &pline, std::vector<PlineIntersect<Real>> &output,
+                          StaticSpatialIndex<Real, N> const &spatialIndex) {
+  globalSelfIntersects(pline, output, spatialIndex, utils::currentEpsilonConfig<Real>());
+}
+
 /// Finds all self intersects of the polyline (equivalent to calling localSelfIntersects and
 /// globalSelfIntersects).
+template <typename Real, std::size_t N>
+void allSelfIntersects(Polyline<Real> const &pline, std::vector<PlineIntersect<Real>> &output,
+                       StaticSpatialIndex<Real, N> const &spatialIndex,
+                       utils::EpsilonConfig<Real> const &eps) {
+  CAVC_TRACE_SCOPE("allSelfIntersects");
+  localSelfIntersects(pline, output, eps);
+  globalSelfIntersects(pline, output, spatialIndex, eps);
+}
+
 template <typename Real, std::size_t N>
 void allSelfIntersects(Polyline<Real> const &pline, std::vector<PlineIntersect<Real>> &output,
                        StaticSpatialIndex<Real, N> const &spatialIndex) {
-  localSelfIntersects(pline, output);
-  globalSelfIntersects(pline, output, spatialIndex);
+  allSelfIntersects(pline, output, spatialIndex, utils::currentEpsilonConfig<Real>());
 }
 
-/// Finds all intersects between pline1 and pline2.
+/// Finds all intersects between pline1 and pline2, eps holds the tolerances used for the call
+/// (installed as the thread's epsilon context).
 template <typename Real, std::size_t N>
 void findIntersects(Polyline<Real> const &pline1, Polyline<Real> const &pline2,
                     StaticSpatialIndex<Real, N> const &pline1SpatialIndex,
-                    PlineIntersectsResult<Real> &output) {
+                    PlineIntersectsResult<Real> &output, utils::EpsilonConfig<Real> const &eps) {
+  CAVC_TRACE_SCOPE("findIntersects");
+  utils::ScopedEpsilonContext<Real> epsContext(eps);
+  Real const threshold = eps.realThreshold;
+  Real const precision = eps.realPrecision;
+
   std::vector<std::size_t> queryResults;
   std::vector<std::size_t> queryStack;
   queryStack.reserve(8);
@@ -378,17 +422,21 @@ void findIntersects(Polyline<Real> const &pline1, Polyline<Real> const &pline2,
   auto &intrs = output.intersects;
   auto &coincidentIntrs = output.coincidentIntersects;
 
+  // stops early (partial output) if the thread's cancellation token stops the operation
+  internal::CancellationPoll cancelPoll;
   auto pline2SegVisitor = [&](std::size_t i2, std::size_t j2) {
+    if (cancelPoll()) {
+      return false;
+    }
     PlineVertex<Real> const &p2v1 = pline2[i2];
     PlineVertex<Real> const &p2v2 = pline2[j2];
 
     queryResults.clear();
 
-    AABB<Real> bb = createFastApproxBoundingBox(p2v1, p2v2);
+    AABB<Real> bb = createFastApproxBoundingBox(p2v1, p2v2, precision);
     // expand bounding box by threshold amount to ensure finding intersects at segment end points
-    Real fuzz = cavc::utils::realPrecision<Real>();
-    pline1SpatialIndex.query(bb.xMin - fuzz, bb.yMin - fuzz, bb.xMax + fuzz, bb.yMax + fuzz,
-                             queryResults, queryStack);
+    pline1SpatialIndex.query(bb.xMin - precision, bb.yMin - precision, bb.xMax + precision,
+                             bb.yMax + precision, queryResults, queryStack);
 
     for (std::size_t i1 : queryResults) {
       std::size_t j1 = utils::nextWrappingIndex(i1, pline1);
@@ -403,8 +451,8 @@ void findIntersects(Polyline<Real> const &pline1, Polyline<Real> const &pline2,
         bool isPline1FirstOpenSeg = (!pline1.isClosed()) && (i1 == 0);
         bool isPline2FirstOpenSeg = (!pline2.isClosed()) && (i2 == 0);
 
-        bool atPline1Start = fuzzyEqual(p1v1.pos(), intr);
-        bool atPline2Start = fuzzyEqual(p2v1.pos(), intr);
+        bool atPline1Start = fuzzyEqual(p1v1.pos(), intr, threshold);
+        bool atPline2Start = fuzzyEqual(p2v1.pos(), intr, threshold);
 
         if (atPline1Start && isPline1FirstOpenSeg) {
           return false;
@@ -416,7 +464,7 @@ void findIntersects(Polyline<Real> const &pline1, Polyline<Real> const &pline2,
         return atPline1Start || atPline2Start;
       };
 
-      auto intrResult = intrPlineSegs(p1v1, p1v2, p2v1, p2v2);
+      auto intrResult = intrPlineSegs(p1v1, p1v2, p2v1, p2v2, precision, threshold);
       switch (intrResult.intrType) {
       case PlineSegIntrType::NoIntersect:
         break;
@@ -437,12 +485,12 @@ void findIntersects(Polyline<Real> const &pline1, Polyline<Real> const &pline2,
       case PlineSegIntrType::SegmentOverlap:
       case PlineSegIntrType::ArcOverlap:
         coincidentIntrs.emplace_back(i1, i2, intrResult.point1, intrResult.point2);
-        if (fuzzyEqual(p1v1.pos(), intrResult.point1) ||
-            fuzzyEqual(p1v1.pos(), intrResult.point2)) {
+        if (fuzzyEqual(p1v1.pos(), intrResult.point1, threshold) ||
+            fuzzyEqual(p1v1.pos(), intrResult.point2, threshold)) {
           possibleDuplicates.insert({utils::prevWrappingIndex(i1, pline1), i2});
         }
-        if (fuzzyEqual(p2v1.pos(), intrResult.point1) ||
-            fuzzyEqual(p2v1.pos(), intrResult.point2)) {
+        if (fuzzyEqual(p2v1.pos(), intrResult.point1, threshold) ||
+            fuzzyEqual(p2v1.pos(), intrResult.point2, threshold)) {
           possibleDuplicates.insert({i1, utils::prevWrappingIndex(i2, pline2)});
         }
         break;
@@ -465,16 +513,23 @@ void findIntersects(Polyline<Real> const &pline1, Polyline<Real> const &pline2,
 
                                auto const &endPt1 =
                                    pline1[utils::nextWrappingIndex(intr.sIndex1, pline1)].pos();
-                               if (fuzzyEqual(intr.pos, endPt1)) {
+                               if (fuzzyEqual(intr.pos, endPt1, threshold)) {
                                  return true;
                                }
 
                                auto const &endPt2 =
                                    pline2[utils::nextWrappingIndex(intr.sIndex2, pline2)].pos();
-                               return fuzzyEqual(intr.pos, endPt2);
+                               return fuzzyEqual(intr.pos, endPt2, threshold);
                              }),
               intrs.end());
 }
 
+template <typename Real, std::size_t N>
+void findIntersects(Polyline<Real> const &pline1, Polyline<Real> const &pline2,
+                    StaticSpatialIndex<Real, N> const &pline1SpatialIndex,
+                    PlineIntersectsResult<Real> &output) {
+  findIntersects(pline1, pline2, pline1SpatialIndex, output, utils::currentEpsilonConfig<Real>());
+}
+
 } // namespace cavc
 #endif // CAVC_POLYLINEINTERSECTS_HPP
@@ -5,9 +5,11 @@
 #include <cmath>
 #include <functional>
 
+#include "cancellation.hpp"
 #include "internal/plinesliceview.hpp"
 #include "polyline.hpp"
 #include "polylineintersects.hpp"
+#include "tracing.hpp"
 #include <limits>
 #include <map>
 #include <unordered_map>
@@ -36,10 +38,12 @@ template <typename Real> struct PlineOffsetSegment {
   bool collapsedArc;
 };
 
-/// Creates all the raw polyline offset segments.
-template <typename Real>
-std::vector<PlineOffsetSegment<Real>> createUntrimmedOffsetSegments(Polyline<Real> const &pline,
-                                                                    Real offset) {
+/// Creates all the raw polyline offset segments, arcAt(i, v1, v2) returns the arc radius and center
+/// of the arc segment v1 to v2 starting at vertex i.
+template <typename Real, typename ArcAtFn>
+std::vector<PlineOffsetSegment<Real>>
+createUntrimmedOffsetSegmentsImpl(Polyline<Real> const &pline, Real offset,
+                                  utils::EpsilonConfig<Real> const &eps, ArcAtFn &&arcAt) {
   std::size_t segmentCount = pline.isClosed() ? pline.size() : pline.size() - 1;
 
   std::vector<PlineOffsetSegment<Real>> result;
@@ -51,21 +55,21 @@ std::vector<PlineOffsetSegment<Real>> createUntrimmedOffsetSegments(Polyline<Rea
     seg.collapsedArc = false;
     seg.origV2Pos = v2.pos();
     Vector2<Real> edge = v2.pos() - v1.pos();
-    Vector2<Real> offsetV = offset * safeUnitPerp(edge);
+    Vector2<Real> offsetV = offset * safeUnitPerp(edge, eps.realThreshold);
     seg.v1.pos() = v1.pos() + offsetV;
     seg.v1.bulge() = v1.bulge();
     seg.v2.pos() = v2.pos() + offsetV;
     seg.v2.bulge() = v2.bulge();
   };
 
-  auto arcVisitor = [&](PlineVertex<Real> const &v1, PlineVertex<Real> const &v2) {
-    auto arc = arcRadiusAndCenter(v1, v2);
+  auto arcVisitor = [&](std::size_t i, PlineVertex<Real> const &v1, PlineVertex<Real> const &v2) {
+    ArcRadiusAndCenter<Real> const arc = arcAt(i, v1, v2);
     Real offs = v1.bulgeIsNeg() ? offset : -offset;
     Real radiusAfterOffset = arc.radius + offs;
     Vector2<Real> v1ToCenter = v1.pos() - arc.center;
-    safeNormalize(v1ToCenter);
+    safeNormalize(v1ToCenter, eps.realThreshold);
     Vector2<Real> v2ToCenter = v2.pos() - arc.center;
-    safeNormalize(v2ToCenter);
+    safeNormalize(v2ToCenter, eps.realThreshold);
 
     result.emplace_back();
     PlineOffsetSegment<Real> &seg = result.back();
@@ -74,7 +78,7 @@ std::vector<PlineOffsetSegment<Real>> createUntrimmedOffsetSegments(Polyline<Rea
     seg.v2.pos() = offs * v2ToCenter + v2.pos();
     seg.v2.bulge() = v2.bulge();
 
-    if (radiusAfterOffset < utils::realThreshold<Real>()) {
+    if (radiusAfterOffset < eps.realThreshold) {
       // collapsed arc, offset arc start and end points towards arc center and turn into line
       // handles case where offset vertexes are equal and simplifies path for clipping algorithm
       seg.collapsedArc = true;
@@ -85,25 +89,55 @@ std::vector<PlineOffsetSegment<Real>> createUntrimmedOffsetSegments(Polyline<Rea
     }
   };
 
-  auto offsetVisitor = [&](PlineVertex<Real> const &v1, PlineVertex<Real> const &v2) {
-    if (v1.bulgeIsZero()) {
+  auto offsetVisitor = [&](std::size_t i, PlineVertex<Real> const &v1,
+                           PlineVertex<Real> const &v2) {
+    if (v1.bulgeIsZero(eps.realPrecision)) {
       lineVisitor(v1, v2);
     } else {
-      arcVisitor(v1, v2);
+      arcVisitor(i, v1, v2);
     }
   };
 
   for (std::size_t i = 1; i < pline.size(); ++i) {
-    offsetVisitor(pline[i - 1], pline[i]);
+    offsetVisitor(i - 1, pline[i - 1], pline[i]);
   }
 
   if (pline.isClosed()) {
-    offsetVisitor(pline.lastVertex(), pline[0]);
+    offsetVisitor(pline.size() - 1, pline.lastVertex(), pline[0]);
   }
 
   return result;
 }
 
+/// Creates all the raw polyline offset segments.
+template <typename Real>
+std::vector<PlineOffsetSegment<Real>>
+createUntrimmedOffsetSegments(Polyline<Real> const &pline, Real offset,
+                              utils::EpsilonConfig<Real> const &eps =
+                                  utils::currentEpsilonConfig<Real>()) {
+  return createUntrimmedOffsetSegmentsImpl(
+      pline, offset, eps,
+      [](std::size_t, PlineVertex<Real> const &v1, PlineVertex<Real> const &v2) {
+        return arcRadiusAndCenter(v1, v2);
+      });
+}
+
+/// Same as createUntrimmedOffsetSegments above but uses the polyline's arc geometry cache.
+template <typename Real>
+std::vector<PlineOffsetSegment<Real>>
+createUntrimmedOffsetSegments(Polyline<Real> const &pline, ArcGeometryCache<Real> const &arcCache,
+                              Real offset,
+                              utils::EpsilonConfig<Real> const &eps =
+                                  utils::currentEpsilonConfig<Real>()) {
+  CAVC_ASSERT(arcCache.size() == pline.size(), "arc geometry cache does not match polyline");
+  return createUntrimmedOffsetSegmentsImpl(
+      pline, offset, eps,
+      [&](std::size_t i, PlineVertex<Real> const &v1, PlineVertex<Real> const &v2) {
+        return arcCache[i].isArc() ? static_cast<ArcRadiusAndCenter<Real>>(arcCache[i])
+                                   : arcRadiusAndCenter(v1, v2);
+      });
+}
+
 template <typename Real> bool falseIntersect(Real t) { return t < 0.0 || t > 1.0; }
 
 // Gets the bulge to describe the arc going from start point to end point with the given arc center
@@ -125,7 +159,7 @@ Real bulgeForConnection(Vector2<Real> const &arcCenter, Vector2<Real> const &sp,
 template <typename Real>
 void lineToLineJoin(PlineOffsetSegment<Real> const &s1, PlineOffsetSegment<Real> const &s2,
                     bool connectionArcsAreCCW, OffsetJoinType joinType, Real miterLimit,
-                    Polyline<Real> &result) {
+                    utils::EpsilonConfig<Real> const &eps, Polyline<Real> &result) {
   const auto &v1 = s1.v1;
   const auto &v2 = s1.v2;
   const auto &u1 = s2.v1;
@@ -141,13 +175,13 @@ void lineToLineJoin(PlineOffsetSegment<Real> const &s1, PlineOffsetSegment<Real>
     auto const &sp = v2.pos();
     auto const &ep = u1.pos();
     Real bulge = bulgeForConnection(arcCenter, sp, ep, connectionArcsAreCCW);
-    addOrReplaceIfSamePos(result, PlineVertex<Real>(sp, bulge));
-    addOrReplaceIfSamePos(result, PlineVertex<Real>(ep, Real(0)));
+    addOrReplaceIfSamePos(result, PlineVertex<Real>(sp, bulge), eps.realPrecision);
+    addOrReplaceIfSamePos(result, PlineVertex<Real>(ep, Real(0)), eps.realPrecision);
   };
 
   auto miterRatio = [&](Vector2<Real> const &miter_point) {
     Real offset_dist = length(v2.pos() - s1.origV2Pos);
-    if (offset_dist <= utils::realThreshold<Real>()) {
+    if (offset_dist <= eps.realThreshold) {
       return std::numeric_limits<Real>::infinity();
     }
 
@@ -159,7 +193,8 @@ void lineToLineJoin(PlineOffsetSegment<Real> const &s1, PlineOffsetSegment<Real>
     // connecting to/from collapsed arc, always connect using arc
     connectUsingArc();
   } else {
-    auto intrResult = intrLineSeg2LineSeg2(v1.pos(), v2.pos(), u1.pos(), u2.pos());
+    auto intrResult =
+        intrLineSeg2LineSeg2(v1.pos(), v2.pos(), u1.pos(), u2.pos(), eps.realThreshold);
 
     switch (intrResult.intrType) {
     case LineSeg2LineSeg2IntrType::None:
@@ -168,15 +203,16 @@ void lineToLineJoin(PlineOffsetSegment<Real> const &s1, PlineOffsetSegment<Real>
         // a straight chord.
         connectUsingArc();
       } else {
-        addOrReplaceIfSamePos(result, PlineVertex<Real>(v2.pos(), Real(0)));
-        addOrReplaceIfSamePos(result, u1);
+        addOrReplaceIfSamePos(result, PlineVertex<Real>(v2.pos(), Real(0)), eps.realPrecision);
+        addOrReplaceIfSamePos(result, u1, eps.realPrecision);
       }
       break;
     case LineSeg2LineSeg2IntrType::True:
-      addOrReplaceIfSamePos(result, PlineVertex<Real>(intrResult.point, Real(0)));
+      addOrReplaceIfSamePos(result, PlineVertex<Real>(intrResult.point, Real(0)),
+                            eps.realPrecision);
       break;
     case LineSeg2LineSeg2IntrType::Coincident:
-      addOrReplaceIfSamePos(result, PlineVertex<Real>(v2.pos(), Real(0)));
+      addOrReplaceIfSamePos(result, PlineVertex<Real>(v2.pos(), Real(0)), eps.realPrecision);
       break;
     case LineSeg2LineSeg2IntrType::False:
       if (joinType == OffsetJoinType::Round) {
@@ -184,15 +220,16 @@ void lineToLineJoin(PlineOffsetSegment<Real> const &s1, PlineOffsetSegment<Real>
           // extend and join the lines together using an arc
           connectUsingArc();
         } else {
-          addOrReplaceIfSamePos(result, PlineVertex<Real>(v2.pos(), Real(0)));
-          addOrReplaceIfSamePos(result, u1);
+          addOrReplaceIfSamePos(result, PlineVertex<Real>(v2.pos(), Real(0)), eps.realPrecision);
+          addOrReplaceIfSamePos(result, u1, eps.realPrecision);
         }
       } else if (joinType == OffsetJoinType::Miter && intrResult.t0 > Real(1) &&
                  intrResult.t1 < Real(0) && miterRatio(intrResult.point) <= miterLimit) {
-        addOrReplaceIfSamePos(result, PlineVertex<Real>(intrResult.point, Real(0)));
+        addOrReplaceIfSamePos(result, PlineVertex<Real>(intrResult.point, Real(0)),
+                              eps.realPrecision);
       } else {
-        addOrReplaceIfSamePos(result, PlineVertex<Real>(v2.pos(), Real(0)));
-        addOrReplaceIfSamePos(result, u1);
+        addOrReplaceIfSamePos(result, PlineVertex<Real>(v2.pos(), Real(0)), eps.realPrecision);
+        addOrReplaceIfSamePos(result, u1, eps.realPrecision);
       }
       break;
     }
@@ -200,8 +237,9 @@ void lineToLineJoin(PlineOffsetSegment<Real> const &s1, PlineOffsetSegment<Real>
 }
 
 template <typename Real>
-Vector2<Real> joinSegmentTangent(PlineOffsetSegment<Real> const &segment, bool atEndPoint) {
-  if (segment.v1.bulgeIsZero()) {
+Vector2<Real> joinSegmentTangent(PlineOffsetSegment<Real> const &segment, bool atEndPoint,
+                                 utils::EpsilonConfig<Real> const &eps) {
+  if (segment.v1.bulgeIsZero(eps.realPrecision)) {
     return segment.v2.pos() - segment.v1.pos();
   }
 
@@ -211,10 +249,12 @@ Vector2<Real> joinSegmentTangent(PlineOffsetSegment<Real> const &segment, bool a
 
 template <typename Real>
 bool tryComputeMiterPointForArcJoin(PlineOffsetSegment<Real> const &s1,
-                                    PlineOffsetSegment<Real> const &s2, Vector2<Real> &miterPoint) {
-  Vector2<Real> t1 = joinSegmentTangent(s1, true);
-  Vector2<Real> t2 = joinSegmentTangent(s2, false);
-  if (fuzzyZero(t1) || fuzzyZero(t2)) {
+                                    PlineOffsetSegment<Real> const &s2,
+                                    utils::EpsilonConfig<Real> const &eps,
+                                    Vector2<Real> &miterPoint) {
+  Vector2<Real> t1 = joinSegmentTangent(s1, true, eps);
+  Vector2<Real> t2 = joinSegmentTangent(s2, false, eps);
+  if (fuzzyZero(t1, eps.realThreshold) || fuzzyZero(t2, eps.realThreshold)) {
     return false;
   }
 
@@ -225,15 +265,15 @@ bool tryComputeMiterPointForArcJoin(PlineOffsetSegment<Real> const &s1,
   Vector2<Real> r = t1;
   Vector2<Real> s = -t2;
   Real denom = perpDot(r, s);
-  if (std::abs(denom) <= utils::realThreshold<Real>()) {
+  if (std::abs(denom) <= eps.realThreshold) {
     return false;
   }
 
   Vector2<Real> qp = q - p;
   Real t = perpDot(qp, s) / denom;
   Real u = perpDot(qp, r) / denom;
-  Real eps = utils::realPrecision<Real>();
-  if (t < -eps || u < -eps) {
+  Real const precision = eps.realPrecision;
+  if (t < -precision || u < -precision) {
     return false;
   }
 
@@ -243,12 +283,14 @@ bool tryComputeMiterPointForArcJoin(PlineOffsetSegment<Real> const &s1,
 
 template <typename Real>
 void trimPreviousJoinSegmentAtPoint(PlineOffsetSegment<Real> const &s1, Vector2<Real> const &point,
+                                    utils::EpsilonConfig<Real> const &eps,
                                     Polyline<Real> &result) {
   CAVC_ASSERT(result.size() > 0, "join result must contain previous segment start");
 
-  if (!s1.v1.bulgeIsZero()) {
+  if (!s1.v1.bulgeIsZero(eps.realPrecision)) {
     PlineVertex<Real> &prevVertex = result.lastVertex();
-    if (!prevVertex.bulgeIsZero() && !fuzzyEqual(prevVertex.pos(), s1.v2.pos())) {
+    if (!prevVertex.bulgeIsZero(eps.realPrecision) &&
+        !fuzzyEqual(prevVertex.pos(), s1.v2.pos(), eps.realThreshold)) {
       auto prevArc = arcRadiusAndCenter(prevVertex, s1.v2);
       Real prevArcStartAngle = angle(prevArc.center, prevVertex.pos());
       Real updatedPrevTheta = utils::deltaAngle(prevArcStartAngle, angle(prevArc.center, point));
@@ -258,13 +300,14 @@ void trimPreviousJoinSegmentAtPoint(PlineOffsetSegment<Real> const &s1, Vector2<
     }
   }
 
-  addOrReplaceIfSamePos(result, PlineVertex<Real>(point, Real(0)));
+  addOrReplaceIfSamePos(result, PlineVertex<Real>(point, Real(0)), eps.realPrecision);
 }
 
 template <typename Real>
 PlineVertex<Real> createTrimmedNextJoinStart(PlineOffsetSegment<Real> const &s2,
-                                             Vector2<Real> const &point) {
-  if (s2.v1.bulgeIsZero()) {
+                                             Vector2<Real> const &point,
+                                             utils::EpsilonConfig<Real> const &eps) {
+  if (s2.v1.bulgeIsZero(eps.realPrecision)) {
     return PlineVertex<Real>(point, Real(0));
   }
 
@@ -281,26 +324,27 @@ PlineVertex<Real> createTrimmedNextJoinStart(PlineOffsetSegment<Real> const &s2,
 
 template <typename Real>
 bool miterLimitAllowsPoint(PlineOffsetSegment<Real> const &s1, Vector2<Real> const &point,
-                           Real miterLimit) {
+                           Real miterLimit, utils::EpsilonConfig<Real> const &eps) {
   Real offsetDist = length(s1.v2.pos() - s1.origV2Pos);
-  if (offsetDist <= utils::realThreshold<Real>()) {
+  if (offsetDist <= eps.realThreshold) {
     return false;
   }
 
   Real miterDist = length(point - s1.origV2Pos);
-  return miterDist / offsetDist <= miterLimit + utils::realPrecision<Real>();
+  return miterDist / offsetDist <= miterLimit + eps.realPrecision;
 }
 
 template <typename Real>
 bool tryAddExactNonRoundArcJoin(PlineOffsetSegment<Real> const &s1,
                                 PlineOffsetSegment<Real> const &s2, Real miterLimit,
+                                utils::EpsilonConfig<Real> const &eps,
                                 Polyline<Real> &result) {
-  const bool s1IsLine = s1.v1.bulgeIsZero();
-  const bool s2IsLine = s2.v1.bulgeIsZero();
-  Real const eps = utils::realPrecision<Real>();
+  const bool s1IsLine = s1.v1.bulgeIsZero(eps.realPrecision);
+  const bool s2IsLine = s2.v1.bulgeIsZero(eps.realPrecision);
+  Real const precision = eps.realPrecision;
 
   auto betterCandidate = [&](bool &found, Vector2<Real> &best, Vector2<Real> const &candidate) {
-    if (!miterLimitAllowsPoint(s1, candidate, miterLimit)) {
+    if (!miterLimitAllowsPoint(s1, candidate, miterLimit, eps)) {
       return;
     }
 
@@ -316,18 +360,19 @@ bool tryAddExactNonRoundArcJoin(PlineOffsetSegment<Real> const &s1,
   if (s1IsLine && !s2IsLine) {
     auto arc = arcRadiusAndCenter(s2.v1, s2.v2);
     auto addIfValid = [&](Real t) {
-      if (t < -eps) {
+      if (t < -precision) {
         return;
       }
 
       Vector2<Real> candidate = pointFromParametric(s1.v1.pos(), s1.v2.pos(), t);
       if (pointWithinArcSweepAngle(arc.center, s2.v1.pos(), s2.v2.pos(), s2.v1.bulge(),
-                                   candidate, eps)) {
+                                   candidate, precision)) {
         betterCandidate(found, best, candidate);
       }
     };
 
-    auto intrResult = intrLineSeg2Circle2(s1.v1.pos(), s1.v2.pos(), arc.radius, arc.center);
+    auto intrResult = intrLineSeg2Circle2(s1.v1.pos(), s1.v2.pos(), arc.radius, arc.center,
+                                          eps.realThreshold);
     if (intrResult.numIntersects > 0) {
       addIfValid(intrResult.t0);
     }
@@ -336,7 +381,7 @@ bool tryAddExactNonRoundArcJoin(PlineOffsetSegment<Real> const &s1,
     }
 
     if (found) {
-      addOrReplaceIfSamePos(result, createTrimmedNextJoinStart(s2, best));
+      addOrReplaceIfSamePos(result, createTrimmedNextJoinStart(s2, best, eps), eps.realPrecision);
       return true;
     }
 
@@ -346,18 +391,19 @@ bool tryAddExactNonRoundArcJoin(PlineOffsetSegment<Real> const &s1,
   if (!s1IsLine && s2IsLine) {
     auto arc = arcRadiusAndCenter(s1.v1, s1.v2);
     auto addIfValid = [&](Real t) {
-      if (t > Real(1) + eps) {
+      if (t > Real(1) + precision) {
         return;
       }
 
       Vector2<Real> candidate = pointFromParametric(s2.v1.pos(), s2.v2.pos(), t);
       if (pointWithinArcSweepAngle(arc.center, s1.v1.pos(), s1.v2.pos(), s1.v1.bulge(),
-                                   candidate, eps)) {
+                                   candidate, precision)) {
         betterCandidate(found, best, candidate);
       }
     };
 
-    auto intrResult = intrLineSeg2Circle2(s2.v1.pos(), s2.v2.pos(), arc.radius, arc.center);
+    auto intrResult = intrLineSeg2Circle2(s2.v1.pos(), s2.v2.pos(), arc.radius, arc.center,
+                                          eps.realThreshold);
     if (intrResult.numIntersects > 0) {
       addIfValid(intrResult.t0);
     }
@@ -366,7 +412,7 @@ bool tryAddExactNonRoundArcJoin(PlineOffsetSegment<Real> const &s1,
     }
 
     if (found) {
-      trimPreviousJoinSegmentAtPoint(s1, best, result);
+      trimPreviousJoinSegmentAtPoint(s1, best, eps, result);
       return true;
     }
 
@@ -378,14 +424,15 @@ bool tryAddExactNonRoundArcJoin(PlineOffsetSegment<Real> const &s1,
     auto arc2 = arcRadiusAndCenter(s2.v1, s2.v2);
     auto addIfValid = [&](Vector2<Real> const &candidate) {
       if (pointWithinArcSweepAngle(arc1.center, s1.v1.pos(), s1.v2.pos(), s1.v1.bulge(),
-                                   candidate, eps) &&
+                                   candidate, precision) &&
           pointWithinArcSweepAngle(arc2.center, s2.v1.pos(), s2.v2.pos(), s2.v1.bulge(),
-                                   candidate, eps)) {
+                                   candidate, precision)) {
         betterCandidate(found, best, candidate);
       }
     };
 
-    auto intrResult = intrCircle2Circle2(arc1.radius, arc1.center, arc2.radius, arc2.center);
+    auto intrResult = intrCircle2Circle2(arc1.radius, arc1.center, arc2.radius, arc2.center,
+                                         eps.realThreshold);
     switch (intrResult.intrType) {
     case Circle2Circle2IntrType::NoIntersect:
     case Circle2Circle2IntrType::Coincident:
@@ -400,8 +447,8 @@ bool tryAddExactNonRoundArcJoin(PlineOffsetSegment<Real> const &s1,
     }
 
     if (found) {
-      trimPreviousJoinSegmentAtPoint(s1, best, result);
-      addOrReplaceIfSamePos(result, createTrimmedNextJoinStart(s2, best));
+      trimPreviousJoinSegmentAtPoint(s1, best, eps, result);
+      addOrReplaceIfSamePos(result, createTrimmedNextJoinStart(s2, best, eps), eps.realPrecision);
       return true;
     }
   }
@@ -411,12 +458,13 @@ bool tryAddExactNonRoundArcJoin(PlineOffsetSegment<Real> const &s1,
 
 template <typename Real>
 void nonRoundArcJoin(PlineOffsetSegment<Real> const &s1, PlineOffsetSegment<Real> const &s2,
-                     OffsetJoinType joinType, Real miterLimit, Polyline<Real> &result) {
+                     OffsetJoinType joinType, Real miterLimit,
+                     utils::EpsilonConfig<Real> const &eps, Polyline<Real> &result) {
   CAVC_ASSERT(joinType != OffsetJoinType::Round, "use round join functions for round joins");
 
   auto connectUsingBevel = [&] {
-    addOrReplaceIfSamePos(result, PlineVertex<Real>(s1.v2.pos(), Real(0)));
-    addOrReplaceIfSamePos(result, s2.v1);
+    addOrReplaceIfSamePos(result, PlineVertex<Real>(s1.v2.pos(), Real(0)), eps.realPrecision);
+    addOrReplaceIfSamePos(result, s2.v1, eps.realPrecision);
   };
 
   if (joinType == OffsetJoinType::Bevel || s1.collapsedArc || s2.collapsedArc) {
@@ -425,17 +473,17 @@ void nonRoundArcJoin(PlineOffsetSegment<Real> const &s1, PlineOffsetSegment<Real
   }
 
   CAVC_ASSERT(joinType == OffsetJoinType::Miter, "unsupported non-round join type");
-  if (tryAddExactNonRoundArcJoin(s1, s2, miterLimit, result)) {
+  if (tryAddExactNonRoundArcJoin(s1, s2, miterLimit, eps, result)) {
     return;
   }
 
   Vector2<Real> miterPoint;
-  if (!tryComputeMiterPointForArcJoin(s1, s2, miterPoint)) {
+  if (!tryComputeMiterPointForArcJoin(s1, s2, eps, miterPoint)) {
     connectUsingBevel();
     return;
   }
 
-  if (!miterLimitAllowsPoint(s1, miterPoint, miterLimit)) {
+  if (!miterLimitAllowsPoint(s1, miterPoint, miterLimit, eps)) {
     connectUsingBevel();
     return;
   }
@@ -444,14 +492,14 @@ void nonRoundArcJoin(PlineOffsetSegment<Real> const &s1, PlineOffsetSegment<Real
   // Using it as an arc endpoint corrupts the bulge representation and can generate unstable
   // spikes/self-intersections after slicing. Preserve arc endpoints and connect them with straight
   // miter bridge legs; line segments are still extended/trimmed directly to the miter point.
-  if (!s1.v1.bulgeIsZero()) {
-    addOrReplaceIfSamePos(result, PlineVertex<Real>(s1.v2.pos(), Real(0)));
+  if (!s1.v1.bulgeIsZero(eps.realPrecision)) {
+    addOrReplaceIfSamePos(result, PlineVertex<Real>(s1.v2.pos(), Real(0)), eps.realPrecision);
   }
 
-  addOrReplaceIfSamePos(result, PlineVertex<Real>(miterPoint, Real(0)));
+  addOrReplaceIfSamePos(result, PlineVertex<Real>(miterPoint, Real(0)), eps.realPrecision);
 
-  if (!s2.v1.bulgeIsZero()) {
-    addOrReplaceIfSamePos(result, s2.v1);
+  if (!s2.v1.bulgeIsZero(eps.realPrecision)) {
+    addOrReplaceIfSamePos(result, s2.v1, eps.realPrecision);
   }
 }
 
@@ -539,7 +587,8 @@ void applySquareEndCapToRawOpenOffset(Polyline<Real> const &originalPline, Real
 
 template <typename Real>
 void lineToArcJoin(PlineOffsetSegment<Real> const &s1, PlineOffsetSegment<Real> const &s2,
-                   bool connectionArcsAreCCW, Polyline<Real> &result) {
+                   bool connectionArcsAreCCW, utils::EpsilonConfig<Real> const &eps,
+                   Polyline<Real> &result) {
 
   const auto &v1 = s1.v1;
   const auto &v2 = s1.v2;
@@ -553,8 +602,8 @@ void lineToArcJoin(PlineOffsetSegment<Real> const &s1, PlineOffsetSegment<Real>
     auto const &sp = v2.pos();
     auto const &ep = u1.pos();
     Real bulge = bulgeForConnection(arcCenter, sp, ep, connectionArcsAreCCW);
-    addOrReplaceIfSamePos(result, PlineVertex<Real>(sp, bulge));
-    addOrReplaceIfSamePos(result, u1);
+    addOrReplaceIfSamePos(result, PlineVertex<Real>(sp, bulge), eps.realPrecision);
+    addOrReplaceIfSamePos(result, u1, eps.realPrecision);
   };
 
   const auto arc = arcRadiusAndCenter(u1, u2);
@@ -563,7 +612,7 @@ void lineToArcJoin(PlineOffsetSegment<Real> const &s1, PlineOffsetSegment<Real>
     const bool trueSegIntersect = !falseIntersect(t);
     const bool trueArcIntersect =
         pointWithinArcSweepAngle(arc.center, u1.pos(), u2.pos(), u1.bulge(), intersect,
-                                 utils::realPrecision<Real>());
+                                 eps.realPrecision);
     if (trueSegIntersect && trueArcIntersect) {
       // trim at intersect
       Real a = angle(arc.center, intersect);
@@ -572,9 +621,10 @@ void lineToArcJoin(PlineOffsetSegment<Real> const &s1, PlineOffsetSegment<Real>
       // ensure the sign matches (may get flipped if intersect is at the very end of the arc, in
       // which case we do not want to update the bulge)
       if ((theta > Real(0)) == u1.bulgeIsPos()) {
-        addOrReplaceIfSamePos(result, PlineVertex<Real>(intersect, std::tan(theta / Real(4))));
+        addOrReplaceIfSamePos(result, PlineVertex<Real>(intersect, std::tan(theta / Real(4))),
+                              eps.realPrecision);
       } else {
-        addOrReplaceIfSamePos(result, PlineVertex<Real>(intersect, u1.bulge()));
+        addOrReplaceIfSamePos(result, PlineVertex<Real>(intersect, u1.bulge()), eps.realPrecision);
       }
     } else if (t > Real(1) && !trueArcIntersect) {
       connectUsingArc();
@@ -583,12 +633,13 @@ void lineToArcJoin(PlineOffsetSegment<Real> const &s1, PlineOffsetSegment<Real>
       connectUsingArc();
     } else {
       // connect using line
-      addOrReplaceIfSamePos(result, PlineVertex<Real>(v2.pos(), Real(0)));
-      addOrReplaceIfSamePos(result, u1);
+      addOrReplaceIfSamePos(result, PlineVertex<Real>(v2.pos(), Real(0)), eps.realPrecision);
+      addOrReplaceIfSamePos(result, u1, eps.realPrecision);
     }
   };
 
-  auto intrResult = intrLineSeg2Circle2(v1.pos(), v2.pos(), arc.radius, arc.center);
+  auto intrResult =
+      intrLineSeg2Circle2(v1.pos(), v2.pos(), arc.radius, arc.center, eps.realThreshold);
   if (intrResult.numIntersects == 0) {
     connectUsingArc();
   } else if (intrResult.numIntersects == 1) {
@@ -611,7 +662,8 @@ void lineToArcJoin(PlineOffsetSegment<Real> const &s1, PlineOffsetSegment<Real>
 
 template <typename Real>
 void arcToLineJoin(PlineOffsetSegment<Real> const &s1, PlineOffsetSegment<Real> const &s2,
-                   bool connectionArcsAreCCW, Polyline<Real> &result) {
+                   bool connectionArcsAreCCW, utils::EpsilonConfig<Real> const &eps,
+                   Polyline<Real> &result) {
 
   const auto &v1 = s1.v1;
   const auto &v2 = s1.v2;
@@ -625,8 +677,8 @@ void arcToLineJoin(PlineOffsetSegment<Real> const &s1, PlineOffsetSegment<Real>
     auto const &sp = v2.pos();
     auto const &ep = u1.pos();
     Real bulge = bulgeForConnection(arcCenter, sp, ep, connectionArcsAreCCW);
-    addOrReplaceIfSamePos(result, PlineVertex<Real>(sp, bulge));
-    addOrReplaceIfSamePos(result, u1);
+    addOrReplaceIfSamePos(result, PlineVertex<Real>(sp, bulge), eps.realPrecision);
+    addOrReplaceIfSamePos(result, u1, eps.realPrecision);
   };
 
   const auto arc = arcRadiusAndCenter(v1, v2);
@@ -635,11 +687,12 @@ void arcToLineJoin(PlineOffsetSegment<Real> const &s1, PlineOffsetSegment<Real>
     const bool trueSegIntersect = !falseIntersect(t);
     const bool trueArcIntersect =
         pointWithinArcSweepAngle(arc.center, v1.pos(), v2.pos(), v1.bulge(), intersect,
-                                 utils::realPrecision<Real>());
+                                 eps.realPrecision);
     if (trueSegIntersect && trueArcIntersect) {
       PlineVertex<Real> &prevVertex = result.lastVertex();
 
-      if (!prevVertex.bulgeIsZero() && !fuzzyEqual(prevVertex.pos(), v2.pos())) {
+      if (!prevVertex.bulgeIsZero(eps.realPrecision) &&
+          !fuzzyEqual(prevVertex.pos(), v2.pos(), eps.realThreshold)) {
         // modify previous bulge and trim at intersect
         Real a = angle(arc.center, intersect);
         auto prevArc = arcRadiusAndCenter(prevVertex, v2);
@@ -653,14 +706,15 @@ void arcToLineJoin(PlineOffsetSegment<Real> const &s1, PlineOffsetSegment<Real>
         }
       }
 
-      addOrReplaceIfSamePos(result, PlineVertex<Real>(intersect, Real(0)));
+      addOrReplaceIfSamePos(result, PlineVertex<Real>(intersect, Real(0)), eps.realPrecision);
 
     } else {
       connectUsingArc();
     }
   };
 
-  auto intrResult = intrLineSeg2Circle2(u1.pos(), u2.pos(), arc.radius, arc.center);
+  auto intrResult =
+      intrLineSeg2Circle2(u1.pos(), u2.pos(), arc.radius, arc.center, eps.realThreshold);
   if (intrResult.numIntersects == 0) {
     connectUsingArc();
   } else if (intrResult.numIntersects == 1) {
@@ -683,7 +737,8 @@ void arcToLineJoin(PlineOffsetSegment<Real> const &s1, PlineOffsetSegment<Real>
 
 template <typename Real>
 void arcToArcJoin(PlineOffsetSegment<Real> const &s1, PlineOffsetSegment<Real> const &s2,
-                  bool connectionArcsAreCCW, Polyline<Real> &result) {
+                  bool connectionArcsAreCCW, utils::EpsilonConfig<Real> const &eps,
+                  Polyline<Real> &result) {
 
   const auto &v1 = s1.v1;
   const auto &v2 = s1.v2;
@@ -699,21 +754,22 @@ void arcToArcJoin(PlineOffsetSegment<Real> const &s1, PlineOffsetSegment<Real> c
     auto const &sp = v2.pos();
     auto const &ep = u1.pos();
     Real bulge = bulgeForConnection(arcCenter, sp, ep, connectionArcsAreCCW);
-    addOrReplaceIfSamePos(result, PlineVertex<Real>(sp, bulge));
-    addOrReplaceIfSamePos(result, u1);
+    addOrReplaceIfSamePos(result, PlineVertex<Real>(sp, bulge), eps.realPrecision);
+    addOrReplaceIfSamePos(result, u1, eps.realPrecision);
   };
 
   auto processIntersect = [&](Vector2<Real> const &intersect) {
     const bool trueArcIntersect1 =
         pointWithinArcSweepAngle(arc1.center, v1.pos(), v2.pos(), v1.bulge(), intersect,
-                                 utils::realPrecision<Real>());
+                                 eps.realPrecision);
     const bool trueArcIntersect2 =
         pointWithinArcSweepAngle(arc2.center, u1.pos(), u2.pos(), u1.bulge(), intersect,
-                                 utils::realPrecision<Real>());
+                                 eps.realPrecision);
 
     if (trueArcIntersect1 && trueArcIntersect2) {
       PlineVertex<Real> &prevVertex = result.lastVertex();
-      if (!prevVertex.bulgeIsZero() && !fuzzyEqual(prevVertex.pos(), v2.pos())) {
+      if (!prevVertex.bulgeIsZero(eps.realPrecision) &&
+          !fuzzyEqual(prevVertex.pos(), v2.pos(), eps.realThreshold)) {
         // modify previous bulge and trim at intersect
         Real a1 = angle(arc1.center, intersect);
         auto prevArc = arcRadiusAndCenter(prevVertex, v2);
@@ -735,9 +791,10 @@ void arcToArcJoin(PlineOffsetSegment<Real> const &s1, PlineOffsetSegment<Real> c
       // ensure the sign matches (may get flipped if intersect is at the very end of the arc, in
       // which case we do not want to update the bulge)
       if ((theta > Real(0)) == u1.bulgeIsPos()) {
-        addOrReplaceIfSamePos(result, PlineVertex<Real>(intersect, std::tan(theta / Real(4))));
+        addOrReplaceIfSamePos(result, PlineVertex<Real>(intersect, std::tan(theta / Real(4))),
+                              eps.realPrecision);
       } else {
-        addOrReplaceIfSamePos(result, PlineVertex<Real>(intersect, u1.bulge()));
+        addOrReplaceIfSamePos(result, PlineVertex<Real>(intersect, u1.bulge()), eps.realPrecision);
       }
 
     } else {
@@ -745,7 +802,8 @@ void arcToArcJoin(PlineOffsetSegment<Real> const &s1, PlineOffsetSegment<Real> c
     }
   };
 
-  const auto intrResult = intrCircle2Circle2(arc1.radius, arc1.center, arc2.radius, arc2.center);
+  const auto intrResult = intrCircle2Circle2(arc1.radius, arc1.center, arc2.radius, arc2.center,
+                                             eps.realThreshold);
   switch (intrResult.intrType) {
   case Circle2Circle2IntrType::NoIntersect:
     connectUsingArc();
@@ -764,7 +822,7 @@ void arcToArcJoin(PlineOffsetSegment<Real> const &s1, PlineOffsetSegment<Real> c
   } break;
   case Circle2Circle2IntrType::Coincident:
     // same constant arc radius and center, just add the vertex (nothing to trim/extend)
-    addOrReplaceIfSamePos(result, u1);
+    addOrReplaceIfSamePos(result, u1, eps.realPrecision);
     break;
   }
 }
@@ -775,7 +833,8 @@ void offsetCircleIntersectsWithPline(Polyline<Real> const &pline, Real offset,
                                      StaticSpatialIndex<Real> const &spatialIndex,
                                      std::vector<std::pair<std::size_t, Vector2<Real>>> &output,
                                      std::vector<std::size_t> &queryResults,
-                                     std::vector<std::size_t> &queryStack) {
+                                     std::vector<std::size_t> &queryStack,
+                                     utils::EpsilonConfig<Real> const &eps) {
 
   const Real circleRadius = std::abs(offset);
 
@@ -784,24 +843,24 @@ void offsetCircleIntersectsWithPline(Polyline<Real> const &pline, Real offset,
                      circleCenter.x() + circleRadius, circleCenter.y() + circleRadius, queryResults,
                      queryStack);
 
-  auto validLineSegIntersect = [](Real t) {
-    return !falseIntersect(t) && std::abs(t) > utils::realPrecision<Real>();
+  auto validLineSegIntersect = [&eps](Real t) {
+    return !falseIntersect(t) && std::abs(t) > eps.realPrecision;
   };
 
-  auto validArcSegIntersect = [](Vector2<Real> const &arcCenter, Vector2<Real> const &arcStart,
-                                 Vector2<Real> const &arcEnd, Real bulge,
-                                 Vector2<Real> const &intrPoint) {
-    return !fuzzyEqual(arcStart, intrPoint, utils::realPrecision<Real>()) &&
+  auto validArcSegIntersect = [&eps](Vector2<Real> const &arcCenter,
+                                     Vector2<Real> const &arcStart, Vector2<Real> const &arcEnd,
+                                     Real bulge, Vector2<Real> const &intrPoint) {
+    return !fuzzyEqual(arcStart, intrPoint, eps.realPrecision) &&
            pointWithinArcSweepAngle(arcCenter, arcStart, arcEnd, bulge, intrPoint,
-                                    utils::realPrecision<Real>());
+                                    eps.realPrecision);
   };
 
   for (std::size_t sIndex : queryResults) {
     PlineVertex<Real> const &v1 = pline[sIndex];
     PlineVertex<Real> const &v2 = pline[sIndex + 1];
-    if (v1.bulgeIsZero()) {
+    if (v1.bulgeIsZero(eps.realPrecision)) {
       IntrLineSeg2Circle2Result<Real> intrResult =
-          intrLineSeg2Circle2(v1.pos(), v2.pos(), circleRadius, circleCenter);
+          intrLineSeg2Circle2(v1.pos(), v2.pos(), circleRadius, circleCenter, eps.realThreshold);
       if (intrResult.numIntersects == 0) {
         continue;
       } else if (intrResult.numIntersects == 1) {
@@ -820,7 +879,7 @@ void offsetCircleIntersectsWithPline(Polyline<Real> const &pline, Real offset,
     } else {
       auto arc = arcRadiusAndCenter(v1, v2);
       IntrCircle2Circle2Result<Real> intrResult =
-          intrCircle2Circle2(arc.radius, arc.center, circleRadius, circleCenter);
+          intrCircle2Circle2(arc.radius, arc.center, circleRadius, circleCenter, eps.realThreshold);
       switch (intrResult.intrType) {
       case Circle2Circle2IntrType::NoIntersect:
         break;
@@ -847,7 +906,8 @@ void offsetCircleIntersectsWithPline(Polyline<Real> const &pline, Real offset,
 template <typename Real>
 void offsetLineIntersectsWithPline(Polyline<Real> const &pline, Vector2<Real> const &linePoint,
                                    Vector2<Real> const &lineNormal,
-                                   std::vector<std::pair<std::size_t, Vector2<Real>>> &output) {
+                                   std::vector<std::pair<std::size_t, Vector2<Real>>> &output,
+                                   utils::EpsilonConfig<Real> const &eps) {
   if (pline.size() < 2) {
     return;
   }
@@ -857,16 +917,16 @@ void offsetLineIntersectsWithPline(Polyline<Real> const &pline, Vector2<Real> co
   normalize(normalizedNormal);
   Vector2<Real> lineDirection = unitPerp(normalizedNormal);
 
-  auto validLineSegIntersect = [](Real t) {
-    return !falseIntersect(t) && std::abs(t) > utils::realPrecision<Real>();
+  auto validLineSegIntersect = [&eps](Real t) {
+    return !falseIntersect(t) && std::abs(t) > eps.realPrecision;
   };
 
-  auto validArcSegIntersect = [](Vector2<Real> const &arcCenter, Vector2<Real> const &arcStart,
-                                 Vector2<Real> const &arcEnd, Real bulge,
-                                 Vector2<Real> const &intrPoint) {
-    return !fuzzyEqual(arcStart, intrPoint, utils::realPrecision<Real>()) &&
+  auto validArcSegIntersect = [&eps](Vector2<Real> const &arcCenter,
+                                     Vector2<Real> const &arcStart, Vector2<Real> const &arcEnd,
+                                     Real bulge, Vector2<Real> const &intrPoint) {
+    return !fuzzyEqual(arcStart, intrPoint, eps.realPrecision) &&
            pointWithinArcSweepAngle(arcCenter, arcStart, arcEnd, bulge, intrPoint,
-                                    utils::realPrecision<Real>());
+                                    eps.realPrecision);
   };
 
   std::size_t const segCount = pline.isClosed() ? pline.size() : pline.size() - 1;
@@ -876,10 +936,10 @@ void offsetLineIntersectsWithPline(Polyline<Real> const &pline, Vector2<Real> co
     PlineVertex<Real> const &v1 = pline[sIndex];
     PlineVertex<Real> const &v2 = pline[nextIndex];
 
-    if (v1.bulgeIsZero()) {
+    if (v1.bulgeIsZero(eps.realPrecision)) {
       Vector2<Real> segDelta = v2.pos() - v1.pos();
       Real const denom = dot(segDelta, normalizedNormal);
-      if (std::abs(denom) <= utils::realThreshold<Real>()) {
+      if (std::abs(denom) <= eps.realThreshold) {
         continue;
       }
 
@@ -893,7 +953,7 @@ void offsetLineIntersectsWithPline(Polyline<Real> const &pline, Vector2<Real> co
     auto arc = arcRadiusAndCenter(v1, v2);
     Real signedDistance = dot(arc.center - linePoint, normalizedNormal);
     Real absDistance = std::abs(signedDistance);
-    if (absDistance > arc.radius + utils::realPrecision<Real>()) {
+    if (absDistance > arc.radius + eps.realPrecision) {
       continue;
     }
 
@@ -905,7 +965,7 @@ void offsetLineIntersectsWithPline(Polyline<Real> const &pline, Vector2<Real> co
       }
     };
 
-    if (utils::fuzzyEqual(absDistance, arc.radius, utils::realPrecision<Real>())) {
+    if (utils::fuzzyEqual(absDistance, arc.radius, eps.realPrecision)) {
       addArcIntersectIfValid(projectedPoint);
       continue;
     }
@@ -920,12 +980,14 @@ void offsetLineIntersectsWithPline(Polyline<Real> const &pline, Vector2<Real> co
   }
 }
 
-/// Function to test if a point is a valid distance from the original polyline.
-template <typename Real, std::size_t N>
-bool pointValidForOffset(Polyline<Real> const &pline, Real offset,
-                         StaticSpatialIndex<Real, N> const &spatialIndex,
-                         Vector2<Real> const &point, std::vector<std::size_t> &queryStack,
-                         Real offsetTol = utils::offsetThreshold<Real>()) {
+/// Test if a point is a valid distance from the original polyline, segClosestPoint(i, j) returns
+/// the closest point to point on the segment from vertex i to j.
+template <typename Real, std::size_t N, typename SegClosestPointFn>
+bool pointValidForOffsetImpl(Polyline<Real> const &pline, Real offset,
+                             StaticSpatialIndex<Real, N> const &spatialIndex,
+                             Vector2<Real> const &point, std::vector<std::size_t> &queryStack,
+                             Real offsetTol, SegClosestPointFn &&segClosestPoint) {
+  CAVC_STATS_INC(pointValidForOffsetCalls);
   const Real absOffset = std::abs(offset) - offsetTol;
   const Real minDist = absOffset * absOffset;
 
@@ -933,7 +995,7 @@ bool pointValidForOffset(Polyline<Real> const &pline, Real offset,
 
   auto visitor = [&](std::size_t i) {
     std::size_t j = utils::nextWrappingIndex(i, pline.vertexes());
-    auto closestPoint = closestPointOnSeg(pline[i], pline[j], point, utils::realPrecision<Real>());
+    auto closestPoint = segClosestPoint(i, j);
     Real dist = distSquared(closestPoint, point);
     pointValid = dist > minDist;
     return pointValid;
@@ -944,6 +1006,33 @@ bool pointValidForOffset(Polyline<Real> const &pline, Real offset,
   return pointValid;
 }
 
+/// Function to test if a point is a valid distance from the original polyline.
+template <typename Real, std::size_t N>
+bool pointValidForOffset(Polyline<Real> const &pline, Real offset,
+                         StaticSpatialIndex<Real, N> const &spatialIndex,
+                         Vector2<Real> const &point, std::vector<std::size_t> &queryStack,
+                         Real offsetTol = utils::offsetThreshold<Real>(),
+                         Real epsilon = utils::realPrecision<Real>()) {
+  return pointValidForOffsetImpl(pline, offset, spatialIndex, point, queryStack, offsetTol,
+                                 [&](std::size_t i, std::size_t j) {
+                                   return closestPointOnSeg(pline[i], pline[j], point, epsilon);
+                                 });
+}
+
+/// Same as pointValidForOffset above but uses the original polyline's arc geometry cache.
+template <typename Real, std::size_t N>
+bool pointValidForOffset(Polyline<Real> const &pline, ArcGeometryCache<Real> const &arcCache,
+                         Real offset, StaticSpatialIndex<Real, N> const &spatialIndex,
+                         Vector2<Real> const &point, std::vector<std::size_t> &queryStack,
+                         Real offsetTol = utils::offsetThreshold<Real>(),
+                         Real epsilon = utils::realPrecision<Real>()) {
+  return pointValidForOffsetImpl(pline, offset, spatialIndex, point, queryStack, offsetTol,
+                                 [&](std::size_t i, std::size_t j) {
+                                   return closestPointOnSeg(pline[i], pline[j], arcCache[i], point,
+                                                            epsilon);
+                                 });
+}
+
 template <typename Real>
 Real slicePathLength(Polyline<Real> const &source, PlineSliceViewData<Real> const &slice) {
   Real result = Real(0);
@@ -967,7 +1056,7 @@ template <typename Real, typename PointValidF, typename PointValidAtRawIndexF,
 bool offsetSliceIsValid(Polyline<Real> const &rawOffsetPline, PlineSliceViewData<Real> const &slice,
                         PointValidF &&pointValid, PointValidAtRawIndexF &&pointValidAtRawIndex,
                         SegmentIntersectsF &&segmentIntersectsOrig,
-                        RawSegmentIntersectsF &&rawSegmentIntersectsOrig) {
+                        RawSegmentIntersectsF &&rawSegmentIntersectsOrig, Real posEqualEps) {
   if (slice.endIndexOffset == 0) {
     PlineVertex<Real> const &sliceStart = slice.updatedStart;
     PlineVertex<Real> sliceEnd(slice.endPoint, Real(0));
@@ -975,12 +1064,13 @@ bool offsetSliceIsValid(Polyline<Real> const &rawOffsetPline, PlineSliceViewData
       return false;
     }
 
-    Vector2<Real> midpoint = segMidpoint(sliceStart, sliceEnd);
+    Vector2<Real> midpoint = segMidpoint(sliceStart, sliceEnd, posEqualEps);
     return pointValid(midpoint) && !segmentIntersectsOrig(sliceStart, sliceEnd);
   }
 
   std::size_t const nextIndex = utils::nextWrappingIndex(slice.startIndex, rawOffsetPline);
-  Vector2<Real> startSegMidpoint = segMidpoint(slice.updatedStart, rawOffsetPline[nextIndex]);
+  Vector2<Real> startSegMidpoint =
+      segMidpoint(slice.updatedStart, rawOffsetPline[nextIndex], posEqualEps);
   if (!pointValid(startSegMidpoint)) {
     return false;
   }
@@ -991,12 +1081,12 @@ bool offsetSliceIsValid(Polyline<Real> const &rawOffsetPline, PlineSliceViewData
   }
   PlineVertex<Real> endSegStart = rawOffsetPline[endIndex];
   endSegStart.bulge() = slice.updatedEndBulge;
-  Vector2<Real> endSegMidpoint = segMidpoint(endSegStart, PlineVertex<Real>(slice.endPoint, Real(0)));
+  Vector2<Real> endSegMidpoint =
+      segMidpoint(endSegStart, PlineVertex<Real>(slice.endPoint, Real(0)), posEqualEps);
   if (!pointValid(endSegMidpoint)) {
     return false;
   }
 
-  Real const posEqualEps = utils::realPrecision<Real>();
   bool const startIsRawVertex =
       fuzzyEqual(slice.updatedStart.pos(), rawOffsetPline[slice.startIndex].pos(), posEqualEps);
   bool const startPointValid =
@@ -1029,14 +1119,17 @@ bool offsetSliceIsValid(Polyline<Real> const &rawOffsetPline, PlineSliceViewData
 /// Creates the raw offset polyline.
 template <typename Real>
 Polyline<Real> createRawOffsetPline(Polyline<Real> const &pline, Real offset,
-                                    ParallelOffsetOptions<Real> const &options) {
+                                    ParallelOffsetOptions<Real> const &options,
+                                    utils::EpsilonConfig<Real> const &eps) {
+  CAVC_TRACE_SCOPE("createRawOffsetPline");
 
   Polyline<Real> result;
   if (pline.size() < 2) {
     return result;
   }
 
-  std::vector<PlineOffsetSegment<Real>> rawOffsets = createUntrimmedOffsetSegments(pline, offset);
+  std::vector<PlineOffsetSegment<Real>> rawOffsets =
+      createUntrimmedOffsetSegments(pline, offset, eps);
   if (rawOffsets.size() == 0) {
     return result;
   }
@@ -1052,35 +1145,35 @@ Polyline<Real> createRawOffsetPline(Polyline<Real> const &pline, Real offset,
 
   const bool connectionArcsAreCCW = offset < Real(0);
 
-  auto joinResultVisitor = [&options, connectionArcsAreCCW](PlineOffsetSegment<Real> const &s1,
-                                                            PlineOffsetSegment<Real> const &s2,
-                                                            Polyline<Real> &p_result) {
-    const bool s1IsLine = s1.v1.bulgeIsZero();
-    const bool s2IsLine = s2.v1.bulgeIsZero();
+  auto joinResultVisitor = [&options, &eps, connectionArcsAreCCW](
+                               PlineOffsetSegment<Real> const &s1,
+                               PlineOffsetSegment<Real> const &s2, Polyline<Real> &p_result) {
+    const bool s1IsLine = s1.v1.bulgeIsZero(eps.realPrecision);
+    const bool s2IsLine = s2.v1.bulgeIsZero(eps.realPrecision);
     if (s1IsLine && s2IsLine) {
       if (options.joinType == OffsetJoinType::Round || (!s1.collapsedArc && !s2.collapsedArc)) {
         internal::lineToLineJoin(s1, s2, connectionArcsAreCCW, options.joinType, options.miterLimit,
-                                 p_result);
+                                 eps, p_result);
       } else {
-        internal::nonRoundArcJoin(s1, s2, options.joinType, options.miterLimit, p_result);
+        internal::nonRoundArcJoin(s1, s2, options.joinType, options.miterLimit, eps, p_result);
       }
     } else if (s1IsLine) {
       if (options.joinType == OffsetJoinType::Round) {
-        internal::lineToArcJoin(s1, s2, connectionArcsAreCCW, p_result);
+        internal::lineToArcJoin(s1, s2, connectionArcsAreCCW, eps, p_result);
       } else {
-        internal::nonRoundArcJoin(s1, s2, options.joinType, options.miterLimit, p_result);
+        internal::nonRoundArcJoin(s1, s2, options.joinType, options.miterLimit, eps, p_result);
       }
     } else if (s2IsLine) {
       if (options.joinType == OffsetJoinType::Round) {
-        internal::arcToLineJoin(s1, s2, connectionArcsAreCCW, p_result);
+        internal::arcToLineJoin(s1, s2, connectionArcsAreCCW, eps, p_result);
       } else {
-        internal::nonRoundArcJoin(s1, s2, options.joinType, options.miterLimit, p_result);
+        internal::nonRoundArcJoin(s1, s2, options.joinType, options.miterLimit, eps, p_result);
       }
     } else {
       if (options.joinType == OffsetJoinType::Round) {
-        internal::arcToArcJoin(s1, s2, connectionArcsAreCCW, p_result);
+        internal::arcToArcJoin(s1, s2, connectionArcsAreCCW, eps, p_result);
       } else {
-        internal::nonRoundArcJoin(s1, s2, options.joinType, options.miterLimit, p_result);
+        internal::nonRoundArcJoin(s1, s2, options.joinType, options.miterLimit, eps, p_result);
       }
     }
   };
@@ -1123,7 +1216,7 @@ Polyline<Real> createRawOffsetPline(Polyline<Real> const &pline, Real offset,
     // update first vertex (only if it has not already been updated/replaced)
     if (!firstVertexReplaced) {
       const Vector2<Real> &updatedFirstPos = closingPartResult.lastVertex().pos();
-      if (result[0].bulgeIsZero()) {
+      if (result[0].bulgeIsZero(eps.realPrecision)) {
         // just update position
         result[0].pos() = updatedFirstPos;
       } else if (result.size() > 1) {
@@ -1147,12 +1240,12 @@ Polyline<Real> createRawOffsetPline(Polyline<Real> const &pline, Real offset,
     // must do final singularity prune between first and second vertex after joining curves (n, 0)
     // and (0, 1)
     if (result.size() > 1) {
-      if (fuzzyEqual(result[0].pos(), result[1].pos(), utils::realPrecision<Real>())) {
+      if (fuzzyEqual(result[0].pos(), result[1].pos(), eps.realPrecision)) {
         result.vertexes().erase(result.vertexes().begin());
       }
     }
   } else {
-    internal::addOrReplaceIfSamePos(result, rawOffsets.back().v2);
+    internal::addOrReplaceIfSamePos(result, rawOffsets.back().v2, eps.realPrecision);
   }
 
   if (!pline.isClosed() && options.endCapType == OffsetEndCapType::Square && result.size() > 1) {
@@ -1170,61 +1263,157 @@ Polyline<Real> createRawOffsetPline(Polyline<Real> const &pline, Real offset,
 
 template <typename Real> using OpenPolylineSlice = OffsetSliceRef<Real>;
 
-/// Slices a raw offset polyline at all of its self intersects.
-template <typename Real>
-std::vector<OpenPolylineSlice<Real>>
-slicesFromRawOffset(Polyline<Real> const &originalPline, Polyline<Real> const &rawOffsetPline,
-                    Real offset, bool enforceMinDistance = true,
-                    bool skipOrigIntersectionCheck = false) {
-  CAVC_ASSERT(originalPline.isClosed(), "use dual slice at intersects for open polylines");
-
-  std::vector<OpenPolylineSlice<Real>> result;
-  if (rawOffsetPline.size() < 2) {
-    return result;
-  }
-
-  StaticSpatialIndex<Real> origPlineSpatialIndex = createApproxSpatialIndex(originalPline);
-  StaticSpatialIndex<Real> rawOffsetPlineSpatialIndex = createApproxSpatialIndex(rawOffsetPline);
-
+/// Intersect data of a raw offset polyline shared by the primary slicing pass and the relaxed
+/// recovery passes of one parallelOffset call. The original polyline, raw offset (and its dual)
+/// and offset do not change between passes so the spatial indexes and intersects are computed once
+/// on construction. The validity caches are filled lazily and hold the geometric test results, so
+/// they stay valid for every pass regardless of its enforceMinDistance and
+/// skipOrigIntersectionCheck settings.
+template <typename Real> struct RawOffsetIntersectContext {
+  Polyline<Real> const &originalPline;
+  Polyline<Real> const &rawOffsetPline;
+  Real offset;
+  /// Tolerances of the parallelOffset call, read by the slicing and validation loops.
+  utils::EpsilonConfig<Real> eps;
+  /// Arc geometry of the original polyline used by the point validity and original polyline
+  /// intersect tests (empty if the original polyline has no arc segments).
+  ArcGeometryCache<Real> origPlineArcGeometry;
+  StaticSpatialIndex<Real> origPlineSpatialIndex;
+  StaticSpatialIndex<Real> rawOffsetPlineSpatialIndex;
   std::vector<PlineIntersect<Real>> selfIntersects;
-  allSelfIntersects(rawOffsetPline, selfIntersects, rawOffsetPlineSpatialIndex);
-
+  /// Intersects between the raw offset and its dual (empty if constructed without a dual).
+  PlineIntersectsResult<Real> dualIntersects;
+  /// pointValidForOffset results by point position.
+  std::unordered_map<std::pair<Real, Real>, std::uint8_t, PointPairHash<Real>> pointValidCache;
+  /// pointValidForOffset results by raw offset vertex index (-1 if not computed yet).
+  std::vector<std::int8_t> rawVertexPointValidCache;
+  /// Raw offset segment (by start index) intersects original polyline results (-1 if not computed
+  /// yet).
+  std::vector<std::int8_t> rawSegmentIntersectsOrigCache;
   std::vector<std::size_t> queryStack;
-  queryStack.reserve(8);
-  std::unordered_map<std::pair<Real, Real>, std::uint8_t, PointPairHash<Real>>
-      intersectPointValidCache;
-  if (selfIntersects.size() != 0) {
-    intersectPointValidCache.reserve(2 * selfIntersects.size());
-  }
-  std::vector<std::int8_t> rawVertexPointValidCache(rawOffsetPline.size(), -1);
-  std::vector<std::int8_t> rawSegmentIntersectsOrigCache(rawOffsetPline.size(), -1);
-  auto pointValid = [&](Vector2<Real> const &p) {
-    if (!enforceMinDistance) {
-      return true;
-    }
 
-    return pointValidForOffset(originalPline, offset, origPlineSpatialIndex, p, queryStack);
-  };
-  auto intersectPointValid = [&](Vector2<Real> const &p) {
+  RawOffsetIntersectContext(Polyline<Real> const &p_originalPline,
+                            Polyline<Real> const &p_rawOffsetPline, Real p_offset,
+                            utils::EpsilonConfig<Real> const &p_eps,
+                            Polyline<Real> const *dualRawOffsetPline = nullptr)
+      : originalPline(p_originalPline), rawOffsetPline(p_rawOffsetPline), offset(p_offset),
+        eps(p_eps),
+        origPlineSpatialIndex(createApproxSpatialIndex(p_originalPline)),
+        rawOffsetPlineSpatialIndex(createApproxSpatialIndex(p_rawOffsetPline)),
+        rawVertexPointValidCache(p_rawOffsetPline.size(), -1),
+        rawSegmentIntersectsOrigCache(p_rawOffsetPline.size(), -1) {
+    CAVC_TRACE_SCOPE("RawOffsetIntersectContext");
+    CAVC_STATS_INC(offsetIntersectContexts);
+    queryStack.reserve(8);
+    bool const hasArcs = std::any_of(originalPline.vertexes().begin(),
+                                     originalPline.vertexes().end(),
+                                     [this](PlineVertex<Real> const &v) {
+                                       return !v.bulgeIsZero(eps.realPrecision);
+                                     });
+    if (hasArcs) {
+      origPlineArcGeometry.build(originalPline);
+    }
+    allSelfIntersects(rawOffsetPline, selfIntersects, rawOffsetPlineSpatialIndex, eps);
+    if (dualRawOffsetPline) {
+      findIntersects(rawOffsetPline, *dualRawOffsetPline, rawOffsetPlineSpatialIndex,
+                     dualIntersects, eps);
+    }
+  }
+
+  RawOffsetIntersectContext(RawOffsetIntersectContext const &) = delete;
+  RawOffsetIntersectContext &operator=(RawOffsetIntersectContext const &) = delete;
+
+  bool pointValid(Vector2<Real> const &p) {
+    if (origPlineArcGeometry.size() != 0) {
+      return pointValidForOffset(originalPline, origPlineArcGeometry, offset,
+                                 origPlineSpatialIndex, p, queryStack, eps.offsetThreshold,
+                                 eps.realPrecision);
+    }
+    return pointValidForOffset(originalPline, offset, origPlineSpatialIndex, p, queryStack,
+                               eps.offsetThreshold, eps.realPrecision);
+  }
+
+  bool cachedPointValid(Vector2<Real> const &p) {
     auto const key = std::make_pair(p.x(), p.y());
-    auto const iter = intersectPointValidCache.find(key);
-    if (iter != intersectPointValidCache.end()) {
+    auto const iter = pointValidCache.find(key);
+    if (iter != pointValidCache.end()) {
       return iter->second != 0;
     }
 
     bool const valid = pointValid(p);
-    intersectPointValidCache.emplace(key, valid ? 1 : 0);
+    pointValidCache.emplace(key, valid ? 1 : 0);
     return valid;
-  };
-  auto pointValidAtRawIndex = [&](std::size_t index) {
+  }
+
+  bool pointValidAtRawIndex(std::size_t index) {
     std::int8_t &cached = rawVertexPointValidCache[index];
-    if (cached != -1) {
-      return cached != 0;
+    if (cached == -1) {
+      cached = pointValid(rawOffsetPline[index].pos()) ? 1 : 0;
     }
+    return cached != 0;
+  }
 
-    bool const valid = pointValid(rawOffsetPline[index].pos());
-    cached = valid ? 1 : 0;
-    return valid;
+  bool segmentIntersectsOrig(PlineVertex<Real> const &v1, PlineVertex<Real> const &v2) {
+    AABB<Real> approxBB = createFastApproxBoundingBox(v1, v2, eps.realPrecision);
+    bool hasIntersect = false;
+    auto visitor = [&](std::size_t i) {
+      using namespace internal;
+      std::size_t j = utils::nextWrappingIndex(i, originalPline);
+      PlineVertex<Real> const &u1 = originalPline[i];
+      PlineVertex<Real> const &u2 = originalPline[j];
+      IntrPlineSegsResult<Real> intrResult;
+      if (origPlineArcGeometry.size() != 0 && origPlineArcGeometry[i].isArc()) {
+        intrResult = intrPlineSegsImpl(
+            v1, v2, u1, u2, eps.realPrecision, eps.realThreshold,
+            [&] { return arcRadiusAndCenter(v1, v2); },
+            [&]() -> auto const & { return origPlineArcGeometry[i]; });
+      } else {
+        intrResult = intrPlineSegs(v1, v2, u1, u2, eps.realPrecision, eps.realThreshold);
+      }
+      hasIntersect = intrResult.intrType != PlineSegIntrType::NoIntersect;
+      return !hasIntersect;
+    };
+
+    origPlineSpatialIndex.visitQuery(approxBB.xMin, approxBB.yMin, approxBB.xMax, approxBB.yMax,
+                                     visitor, queryStack);
+
+    return hasIntersect;
+  }
+
+  bool rawSegmentIntersectsOrig(std::size_t index) {
+    std::int8_t &cached = rawSegmentIntersectsOrigCache[index];
+    if (cached == -1) {
+      std::size_t const nextIndex = utils::nextWrappingIndex(index, rawOffsetPline);
+      cached = segmentIntersectsOrig(rawOffsetPline[index], rawOffsetPline[nextIndex]) ? 1 : 0;
+    }
+    return cached != 0;
+  }
+};
+
+/// Slices a raw offset polyline at all of its self intersects. The intersect context holds the
+/// original polyline, raw offset and offset (the dual intersects are not used).
+template <typename Real>
+std::vector<OpenPolylineSlice<Real>>
+slicesFromRawOffset(RawOffsetIntersectContext<Real> &context, bool enforceMinDistance = true,
+                    bool skipOrigIntersectionCheck = false) {
+  CAVC_TRACE_SCOPE("slicesFromRawOffset");
+  Polyline<Real> const &rawOffsetPline = context.rawOffsetPline;
+  utils::EpsilonConfig<Real> const &eps = context.eps;
+  CAVC_ASSERT(context.originalPline.isClosed(), "use dual slice at intersects for open polylines");
+
+  std::vector<OpenPolylineSlice<Real>> result;
+  std::vector<PlineIntersect<Real>> const &selfIntersects = context.selfIntersects;
+  if (selfIntersects.size() != 0) {
+    context.pointValidCache.reserve(2 * selfIntersects.size());
+  }
+  auto pointValid = [&](Vector2<Real> const &p) {
+    return !enforceMinDistance || context.pointValid(p);
+  };
+  auto intersectPointValid = [&](Vector2<Real> const &p) {
+    return !enforceMinDistance || context.cachedPointValid(p);
+  };
+  auto pointValidAtRawIndex = [&](std::size_t index) {
+    return !enforceMinDistance || context.pointValidAtRawIndex(index);
   };
 
   if (selfIntersects.size() == 0) {
@@ -1258,49 +1447,27 @@ slicesFromRawOffset(Polyline<Real> const &originalPline, Polyline<Real> const &r
   }
 
   auto intersectsOrigPline = [&](PlineVertex<Real> const &v1, PlineVertex<Real> const &v2) {
-    if (skipOrigIntersectionCheck) {
-      return false;
-    }
-
-    AABB<Real> approxBB = createFastApproxBoundingBox(v1, v2);
-    bool hasIntersect = false;
-    auto visitor = [&](std::size_t i) {
-      using namespace internal;
-      std::size_t j = utils::nextWrappingIndex(i, originalPline);
-      IntrPlineSegsResult<Real> intrResult =
-          intrPlineSegs(v1, v2, originalPline[i], originalPline[j]);
-      hasIntersect = intrResult.intrType != PlineSegIntrType::NoIntersect;
-      return !hasIntersect;
-    };
-
-    origPlineSpatialIndex.visitQuery(approxBB.xMin, approxBB.yMin, approxBB.xMax, approxBB.yMax,
-                                     visitor, queryStack);
-
-    return hasIntersect;
+    return !skipOrigIntersectionCheck && context.segmentIntersectsOrig(v1, v2);
   };
   auto rawSegmentIntersectsOrig = [&](std::size_t index) {
-    std::int8_t &cached = rawSegmentIntersectsOrigCache[index];
-    if (cached != -1) {
-      return cached != 0;
-    }
-
-    std::size_t const nextIndex = utils::nextWrappingIndex(index, rawOffsetPline);
-    bool const intersects = intersectsOrigPline(rawOffsetPline[index], rawOffsetPline[nextIndex]);
-    cached = intersects ? 1 : 0;
-    return intersects;
+    return !skipOrigIntersectionCheck && context.rawSegmentIntersectsOrig(index);
   };
   auto rawVertexSegmentIntersectsOrig = [&](PlineVertex<Real> const &v1, std::size_t endIndex) {
     std::size_t prevIndex = utils::prevWrappingIndex(endIndex, rawOffsetPline);
-    if (fuzzyEqual(v1.pos(), rawOffsetPline[prevIndex].pos(), utils::realPrecision<Real>()) &&
+    if (fuzzyEqual(v1.pos(), rawOffsetPline[prevIndex].pos(), eps.realPrecision) &&
         utils::fuzzyEqual(v1.bulge(), rawOffsetPline[prevIndex].bulge(),
-                          utils::realPrecision<Real>())) {
+                          eps.realPrecision)) {
       return rawSegmentIntersectsOrig(prevIndex);
     }
 
     return intersectsOrigPline(v1, rawOffsetPline[endIndex]);
   };
 
+  internal::CancellationPoll cancelPoll;
   for (auto const &kvp : intersectsLookup) {
+    if (cancelPoll()) {
+      break;
+    }
     // start index for the slice we're about to build
     std::size_t sIndex = kvp.first;
     // self intersect list for this start index
@@ -1313,15 +1480,16 @@ slicesFromRawOffset(Polyline<Real> const &originalPline, Polyline<Real> const &r
     if (siList.size() != 1) {
       // build all the segments between the N intersects in siList (N > 1), skipping the first
       // segment (to be processed at the end)
-      SplitResult<Real> firstSplit = splitAtPoint(startVertex, endVertex, siList[0]);
+      SplitResult<Real> firstSplit =
+          splitAtPoint(startVertex, endVertex, siList[0], eps.realPrecision);
       auto prevVertex = firstSplit.splitVertex;
       for (std::size_t i = 1; i < siList.size(); ++i) {
-        SplitResult<Real> split = splitAtPoint(prevVertex, endVertex, siList[i]);
+        SplitResult<Real> split = splitAtPoint(prevVertex, endVertex, siList[i], eps.realPrecision);
         // update prevVertex for next loop iteration
         prevVertex = split.splitVertex;
         // skip if they're ontop of each other
         if (fuzzyEqual(split.updatedStart.pos(), split.splitVertex.pos(),
-                       utils::realPrecision<Real>())) {
+                       eps.realPrecision)) {
           continue;
         }
 
@@ -1336,7 +1504,7 @@ slicesFromRawOffset(Polyline<Real> const &originalPline, Polyline<Real> const &r
         }
 
         // test mid point
-        auto midpoint = segMidpoint(split.updatedStart, split.splitVertex);
+        auto midpoint = segMidpoint(split.updatedStart, split.splitVertex, eps.realPrecision);
         if (!pointValid(midpoint)) {
           continue;
         }
@@ -1347,7 +1515,7 @@ slicesFromRawOffset(Polyline<Real> const &originalPline, Polyline<Real> const &r
         }
 
         auto slice = PlineSliceViewData<Real>::createOnSingleSegment(
-            rawOffsetPline, sIndex, split.updatedStart, split.splitVertex.pos());
+            rawOffsetPline, sIndex, split.updatedStart, split.splitVertex.pos(), eps.realPrecision);
         if (slice) {
           result.push_back({sIndex, *slice});
         }
@@ -1356,7 +1524,8 @@ slicesFromRawOffset(Polyline<Real> const &originalPline, Polyline<Real> const &r
 
     std::size_t index = nextIndex;
     bool isValidSlice = intersectPointValid(siList.back());
-    SplitResult<Real> sliceStartSplit = splitAtPoint(startVertex, endVertex, siList.back());
+    SplitResult<Real> sliceStartSplit =
+        splitAtPoint(startVertex, endVertex, siList.back(), eps.realPrecision);
     PlineVertex<Real> currLastVertex = sliceStartSplit.splitVertex;
     std::size_t vertexCount = 1;
     std::size_t loopCount = 0;
@@ -1372,7 +1541,7 @@ slicesFromRawOffset(Polyline<Real> const &originalPline, Polyline<Real> const &r
       }
 
       if (fuzzyEqual(currLastVertex.pos(), rawOffsetPline[index].pos(),
-                     utils::realPrecision<Real>())) {
+                     eps.realPrecision)) {
         currLastVertex.bulge() = rawOffsetPline[index].bulge();
       } else {
         currLastVertex = rawOffsetPline[index];
@@ -1389,19 +1558,20 @@ slicesFromRawOffset(Polyline<Real> const &originalPline, Polyline<Real> const &r
 
         std::size_t l_nextIndex = utils::nextWrappingIndex(index, rawOffsetPline);
         SplitResult<Real> l_split =
-            splitAtPoint(currLastVertex, rawOffsetPline[l_nextIndex], intersectPos);
+            splitAtPoint(currLastVertex, rawOffsetPline[l_nextIndex], intersectPos,
+                         eps.realPrecision);
         PlineVertex<Real> sliceEndVertex(intersectPos, Real(0));
-        if (!pointValid(segMidpoint(l_split.updatedStart, sliceEndVertex))) {
+        if (!pointValid(segMidpoint(l_split.updatedStart, sliceEndVertex, eps.realPrecision))) {
           isValidSlice = false;
           break;
         }
 
         auto slice = PlineSliceViewData<Real>::createFromSlicePoints(
-            rawOffsetPline, siList.back(), sIndex, intersectPos, index);
+            rawOffsetPline, siList.back(), sIndex, intersectPos, index, eps.realPrecision);
         if (isValidSlice && slice) {
           if (vertexCount > 1 &&
               fuzzyEqual(slice->firstPoint(rawOffsetPline), slice->lastPoint(rawOffsetPline),
-                         utils::realPrecision<Real>()) &&
+                         eps.realPrecision) &&
               slicePathLength(rawOffsetPline, *slice) <= Real(1e-2)) {
             isValidSlice = false;
           }
@@ -1419,28 +1589,37 @@ slicesFromRawOffset(Polyline<Real> const &originalPline, Polyline<Real> const &r
   return result;
 }
 
-/// Slices a raw offset polyline at all of its self intersects and intersects with its dual.
 template <typename Real>
 std::vector<OpenPolylineSlice<Real>>
-dualSliceAtIntersectsForOffset(Polyline<Real> const &originalPline,
-                               Polyline<Real> const &rawOffsetPline,
-                               Polyline<Real> const &dualRawOffsetPline, Real offset,
-                               ParallelOffsetOptions<Real> const &options,
-                               bool enforceMinDistance = true,
-                               bool skipOrigIntersectionCheck = false) {
-  std::vector<OpenPolylineSlice<Real>> result;
+slicesFromRawOffset(Polyline<Real> const &originalPline, Polyline<Real> const &rawOffsetPline,
+                    Real offset, bool enforceMinDistance = true,
+                    bool skipOrigIntersectionCheck = false) {
   if (rawOffsetPline.size() < 2) {
-    return result;
+    return {};
   }
 
-  StaticSpatialIndex<Real> origPlineSpatialIndex = createApproxSpatialIndex(originalPline);
-  StaticSpatialIndex<Real> rawOffsetPlineSpatialIndex = createApproxSpatialIndex(rawOffsetPline);
-
-  std::vector<PlineIntersect<Real>> selfIntersects;
-  allSelfIntersects(rawOffsetPline, selfIntersects, rawOffsetPlineSpatialIndex);
+  RawOffsetIntersectContext<Real> context(originalPline, rawOffsetPline, offset,
+                                          utils::currentEpsilonConfig<Real>());
+  return slicesFromRawOffset(context, enforceMinDistance, skipOrigIntersectionCheck);
+}
 
-  PlineIntersectsResult<Real> dualIntersects;
-  findIntersects(rawOffsetPline, dualRawOffsetPline, rawOffsetPlineSpatialIndex, dualIntersects);
+/// Slices a raw offset polyline at all of its self intersects and intersects with its dual. The
+/// intersect context must have been constructed with the dual raw offset polyline.
+template <typename Real>
+std::vector<OpenPolylineSlice<Real>>
+dualSliceAtIntersectsForOffset(RawOffsetIntersectContext<Real> &context,
+                               ParallelOffsetOptions<Real> const &options,
+                               bool enforceMinDistance = true,
+                               bool skipOrigIntersectionCheck = false) {
+  CAVC_TRACE_SCOPE("dualSliceAtIntersectsForOffset");
+  Polyline<Real> const &originalPline = context.originalPline;
+  Polyline<Real> const &rawOffsetPline = context.rawOffsetPline;
+  Real const offset = context.offset;
+  utils::EpsilonConfig<Real> const &eps = context.eps;
+  std::vector<OpenPolylineSlice<Real>> result;
+  std::vector<PlineIntersect<Real>> const &selfIntersects = context.selfIntersects;
+  PlineIntersectsResult<Real> const &dualIntersects = context.dualIntersects;
+  StaticSpatialIndex<Real> const &rawOffsetPlineSpatialIndex = context.rawOffsetPlineSpatialIndex;
 
   // using map rather than unordered map since we want to construct the slices in vertex index order
   // and we do so by looping through all intersects (required later when slices are stitched
@@ -1450,45 +1629,21 @@ dualSliceAtIntersectsForOffset(Polyline<Real> const &originalPline,
   auto addIntersect = [&](std::size_t sIndex, Vector2<Real> const &pos) {
     intersectsLookup[sIndex].push_back(pos);
   };
-  std::vector<std::size_t> queryStack;
-  queryStack.reserve(8);
-  std::unordered_map<std::pair<Real, Real>, std::uint8_t, PointPairHash<Real>>
-      intersectPointValidCache;
-  std::vector<std::int8_t> rawVertexPointValidCache(rawOffsetPline.size(), -1);
-  std::vector<std::int8_t> rawSegmentIntersectsOrigCache(rawOffsetPline.size(), -1);
+  std::vector<std::size_t> &queryStack = context.queryStack;
   auto pointValid = [&](Vector2<Real> const &p) {
     if (!enforceMinDistance) {
       return true;
     }
-    if (!originalPline.isClosed()) {
-      auto const key = std::make_pair(p.x(), p.y());
-      auto const iter = intersectPointValidCache.find(key);
-      if (iter != intersectPointValidCache.end()) {
-        return iter->second != 0;
-      }
-
-      bool const valid =
-          pointValidForOffset(originalPline, offset, origPlineSpatialIndex, p, queryStack);
-      intersectPointValidCache.emplace(key, valid ? 1 : 0);
-      return valid;
-    }
-
-    return pointValidForOffset(originalPline, offset, origPlineSpatialIndex, p, queryStack);
+    // open polyline end cap slices revisit the same points, worth caching
+    return originalPline.isClosed() ? context.pointValid(p) : context.cachedPointValid(p);
   };
   auto pointValidAtRawIndex = [&](std::size_t index) {
-    std::int8_t &cached = rawVertexPointValidCache[index];
-    if (cached != -1) {
-      return cached != 0;
-    }
-
-    bool const valid = pointValid(rawOffsetPline[index].pos());
-    cached = valid ? 1 : 0;
-    return valid;
+    return !enforceMinDistance || context.pointValidAtRawIndex(index);
   };
   if (!originalPline.isClosed()) {
-    intersectPointValidCache.reserve(2 * selfIntersects.size() + dualIntersects.intersects.size() +
-                                     2 * dualIntersects.coincidentIntersects.size() +
-                                     rawOffsetPline.size());
+    context.pointValidCache.reserve(2 * selfIntersects.size() + dualIntersects.intersects.size() +
+                                    2 * dualIntersects.coincidentIntersects.size() +
+                                    rawOffsetPline.size());
   }
 
   if (!originalPline.isClosed()) {
@@ -1499,9 +1654,9 @@ dualSliceAtIntersectsForOffset(Polyline<Real> const &originalPline,
       Vector2<Real> start_tangent = internal::openPolylineEndpointTangent(originalPline, true);
       Vector2<Real> end_tangent = internal::openPolylineEndpointTangent(originalPline, false);
       internal::offsetLineIntersectsWithPline(rawOffsetPline, originalPline[0].pos(), start_tangent,
-                                              intersects);
+                                              intersects, eps);
       internal::offsetLineIntersectsWithPline(rawOffsetPline, originalPline.lastVertex().pos(),
-                                              end_tangent, intersects);
+                                              end_tangent, intersects, eps);
     } else {
       Vector2<Real> start_circle_center =
           internal::openPolylineEndCapCircleCenter(originalPline, offset, true, options.endCapType);
@@ -1511,10 +1666,10 @@ dualSliceAtIntersectsForOffset(Polyline<Real> const &originalPline,
       circleQueryResults.reserve(rawOffsetPline.size());
       internal::offsetCircleIntersectsWithPline(rawOffsetPline, offset, start_circle_center,
                                                 rawOffsetPlineSpatialIndex, intersects,
-                                                circleQueryResults, queryStack);
+                                                circleQueryResults, queryStack, eps);
       internal::offsetCircleIntersectsWithPline(rawOffsetPline, offset, end_circle_center,
                                                 rawOffsetPlineSpatialIndex, intersects,
-                                                circleQueryResults, queryStack);
+                                                circleQueryResults, queryStack, eps);
     }
     for (auto const &pair : intersects) {
       addIntersect(pair.first, pair.second);
@@ -1554,41 +1709,15 @@ dualSliceAtIntersectsForOffset(Polyline<Real> const &originalPline,
   }
 
   auto intersectsOrigPline = [&](PlineVertex<Real> const &v1, PlineVertex<Real> const &v2) {
-    if (skipOrigIntersectionCheck) {
-      return false;
-    }
-
-    AABB<Real> approxBB = createFastApproxBoundingBox(v1, v2);
-    bool intersects = false;
-    auto visitor = [&](std::size_t i) {
-      using namespace internal;
-      std::size_t j = utils::nextWrappingIndex(i, originalPline);
-      IntrPlineSegsResult<Real> intrResult =
-          intrPlineSegs(v1, v2, originalPline[i], originalPline[j]);
-      intersects = intrResult.intrType != PlineSegIntrType::NoIntersect;
-      return !intersects;
-    };
-
-    origPlineSpatialIndex.visitQuery(approxBB.xMin, approxBB.yMin, approxBB.xMax, approxBB.yMax,
-                                     visitor, queryStack);
-
-    return intersects;
+    return !skipOrigIntersectionCheck && context.segmentIntersectsOrig(v1, v2);
   };
   auto rawSegmentIntersectsOrig = [&](std::size_t index) {
-    std::int8_t &cached = rawSegmentIntersectsOrigCache[index];
-    if (cached != -1) {
-      return cached != 0;
-    }
-
-    std::size_t const nextIndex = utils::nextWrappingIndex(index, rawOffsetPline);
-    bool const intersects = intersectsOrigPline(rawOffsetPline[index], rawOffsetPline[nextIndex]);
-    cached = intersects ? 1 : 0;
-    return intersects;
+    return !skipOrigIntersectionCheck && context.rawSegmentIntersectsOrig(index);
   };
 
   auto sliceIsValid = [&](PlineSliceViewData<Real> const &slice) {
     return offsetSliceIsValid(rawOffsetPline, slice, pointValid, pointValidAtRawIndex,
-                              intersectsOrigPline, rawSegmentIntersectsOrig);
+                              intersectsOrigPline, rawSegmentIntersectsOrig, eps.realPrecision);
   };
   auto maybeAppendSlice = [&](std::size_t sIndex,
                               std::optional<PlineSliceViewData<Real>> const &slice) {
@@ -1605,12 +1734,17 @@ dualSliceAtIntersectsForOffset(Polyline<Real> const &originalPline,
     auto iter = intersectsLookup.begin();
     if (iter != intersectsLookup.end()) {
       auto slice = PlineSliceViewData<Real>::createFromSlicePoints(
-          rawOffsetPline, rawOffsetPline[0].pos(), 0, iter->second[0], iter->first);
+          rawOffsetPline, rawOffsetPline[0].pos(), 0, iter->second[0], iter->first,
+          eps.realPrecision);
       maybeAppendSlice(0, slice);
     }
   }
 
+  internal::CancellationPoll cancelPoll;
   for (auto const &kvp : intersectsLookup) {
+    if (cancelPoll()) {
+      break;
+    }
     // start index for the slice we're about to build
     std::size_t sIndex = kvp.first;
     // self intersect list for this start index
@@ -1623,15 +1757,16 @@ dualSliceAtIntersectsForOffset(Polyline<Real> const &originalPline,
     if (siList.size() != 1) {
       // build all the segments between the N intersects in siList (N > 1), skipping the first
       // segment (to be processed at the end)
-      SplitResult<Real> firstSplit = splitAtPoint(startVertex, endVertex, siList[0]);
+      SplitResult<Real> firstSplit =
+          splitAtPoint(startVertex, endVertex, siList[0], eps.realPrecision);
       auto prevVertex = firstSplit.splitVertex;
       for (std::size_t i = 1; i < siList.size(); ++i) {
-        SplitResult<Real> split = splitAtPoint(prevVertex, endVertex, siList[i]);
+        SplitResult<Real> split = splitAtPoint(prevVertex, endVertex, siList[i], eps.realPrecision);
         // update prevVertex for next loop iteration
         prevVertex = split.splitVertex;
         // skip if they're ontop of each other
         if (fuzzyEqual(split.updatedStart.pos(), split.splitVertex.pos(),
-                       utils::realPrecision<Real>())) {
+                       eps.realPrecision)) {
           continue;
         }
 
@@ -1646,7 +1781,7 @@ dualSliceAtIntersectsForOffset(Polyline<Real> const &originalPline,
         }
 
         // test mid point
-        auto midpoint = segMidpoint(split.updatedStart, split.splitVertex);
+        auto midpoint = segMidpoint(split.updatedStart, split.splitVertex, eps.realPrecision);
         if (!pointValid(midpoint)) {
           continue;
         }
@@ -1657,7 +1792,7 @@ dualSliceAtIntersectsForOffset(Polyline<Real> const &originalPline,
         }
 
         auto slice = PlineSliceViewData<Real>::createOnSingleSegment(
-            rawOffsetPline, sIndex, split.updatedStart, split.splitVertex.pos());
+            rawOffsetPline, sIndex, split.updatedStart, split.splitVertex.pos(), eps.realPrecision);
         maybeAppendSlice(sIndex, slice);
       }
     }
@@ -1665,7 +1800,8 @@ dualSliceAtIntersectsForOffset(Polyline<Real> const &originalPline,
     auto nextIntr = intersectsLookup.lower_bound(nextIndex);
     if (nextIntr != intersectsLookup.end()) {
       auto slice = PlineSliceViewData<Real>::createFromSlicePoints(
-          rawOffsetPline, siList.back(), sIndex, nextIntr->second[0], nextIntr->first);
+          rawOffsetPline, siList.back(), sIndex, nextIntr->second[0], nextIntr->first,
+          eps.realPrecision);
       maybeAppendSlice(sIndex, slice);
       continue;
     }
@@ -1674,7 +1810,8 @@ dualSliceAtIntersectsForOffset(Polyline<Real> const &originalPline,
       auto wrapIntr = intersectsLookup.begin();
       if (wrapIntr != intersectsLookup.end()) {
         auto slice = PlineSliceViewData<Real>::createFromSlicePoints(
-            rawOffsetPline, siList.back(), sIndex, wrapIntr->second[0], wrapIntr->first);
+            rawOffsetPline, siList.back(), sIndex, wrapIntr->second[0], wrapIntr->first,
+            eps.realPrecision);
         maybeAppendSlice(sIndex, slice);
       }
       continue;
@@ -1682,13 +1819,31 @@ dualSliceAtIntersectsForOffset(Polyline<Real> const &originalPline,
 
     auto tailSlice = PlineSliceViewData<Real>::createFromSlicePoints(
         rawOffsetPline, siList.back(), sIndex, rawOffsetPline.lastVertex().pos(),
-        rawOffsetPline.size() - 1);
+        rawOffsetPline.size() - 1, eps.realPrecision);
     maybeAppendSlice(sIndex, tailSlice);
   }
 
   return result;
 }
 
+template <typename Real>
+std::vector<OpenPolylineSlice<Real>>
+dualSliceAtIntersectsForOffset(Polyline<Real> const &originalPline,
+                               Polyline<Real> const &rawOffsetPline,
+                               Polyline<Real> const &dualRawOffsetPline, Real offset,
+                               ParallelOffsetOptions<Real> const &options,
+                               bool enforceMinDistance = true,
+                               bool skipOrigIntersectionCheck = false) {
+  if (rawOffsetPline.size() < 2) {
+    return {};
+  }
+
+  RawOffsetIntersectContext<Real> context(originalPline, rawOffsetPline, offset,
+                                          utils::currentEpsilonConfig<Real>(), &dualRawOffsetPline);
+  return dualSliceAtIntersectsForOffset(context, options, enforceMinDistance,
+                                        skipOrigIntersectionCheck);
+}
+
 /// Stitches raw offset polyline slices together, discarding any that are not valid.
 template <typename Real>
 std::vector<Polyline<Real>>
@@ -1696,6 +1851,7 @@ stitchOffsetSlicesTogether(Polyline<Real> const &sourcePline,
                            std::vector<OpenPolylineSlice<Real>> const &slices, bool closedPolyline,
                            std::size_t origMaxIndex,
                            Real joinThreshold = utils::sliceJoinThreshold<Real>()) {
+  CAVC_TRACE_SCOPE("stitchOffsetSlicesTogether");
   std::vector<Polyline<Real>> result;
   if (slices.size() == 0) {
     return result;
@@ -1733,11 +1889,16 @@ stitchOffsetSlicesTogether(Polyline<Real> const &sourcePline,
   queryResults.reserve(8);
   std::vector<std::size_t> queryStack;
   queryStack.reserve(8);
+  internal::CancellationPoll cancelPoll;
   for (std::size_t i = 0; i < slices.size(); ++i) {
     if (visitedIndexes[i] != 0) {
       continue;
     }
 
+    if (cancelPoll()) {
+      break;
+    }
+
     visitedIndexes[i] = 1;
 
     Polyline<Real> currPline;
@@ -1870,16 +2031,17 @@ template <typename Real> Real polylineLengthScale(Polyline<Real> const &pline) {
 }
 
 template <typename Real>
-OffsetResultQualityThresholds<Real> offsetResultQualityThresholds(Polyline<Real> const &reference,
-                                                                  Real offset) {
+OffsetResultQualityThresholds<Real>
+offsetResultQualityThresholds(Polyline<Real> const &reference, Real offset,
+                              utils::EpsilonConfig<Real> const &eps) {
   Real const lengthScale = std::max(polylineLengthScale(reference), std::abs(offset));
   // Keep the floor tied to runtime tolerances so small-coordinate workloads can still produce
   // usable open offsets after callers tighten the epsilon config.
   Real const tolerancePathFloor =
-      std::max({utils::realPrecision<Real>() * Real(10), utils::sliceJoinThreshold<Real>(),
-                utils::realThreshold<Real>() * Real(100)});
+      std::max({eps.realPrecision * Real(10), eps.sliceJoinThreshold,
+                eps.realThreshold * Real(100)});
   Real const minPathLength =
-      std::max(tolerancePathFloor, lengthScale * utils::realThreshold<Real>() * Real(100));
+      std::max(tolerancePathFloor, lengthScale * eps.realThreshold * Real(100));
   Real const referenceAbsArea = std::abs(getArea(reference));
   Real const offsetAbsAreaScale = std::abs(offset * offset);
   Real const minClosedAbsArea =
@@ -1918,6 +2080,7 @@ template <typename Real>
 std::vector<Polyline<Real>> filterClosedLoopsAllowingEndpointTouches(
     std::vector<Polyline<Real>> const &candidates,
     OffsetResultQualityThresholds<Real> const &qualityThresholds) {
+  CAVC_TRACE_SCOPE("filterClosedLoopsAllowingEndpointTouches");
   std::vector<Polyline<Real>> filtered;
   filtered.reserve(candidates.size());
   for (auto const &candidate : candidates) {
@@ -2041,47 +2204,54 @@ stitchSlicesIntoSimpleClosedLoops(Polyline<Real> const &sourcePline,
                                   std::size_t origMaxIndex,
                                   Real joinThreshold = utils::sliceJoinThreshold<Real>());
 
+/// Relaxed recovery for open polylines, re-slices using the primary pass intersect context
+/// (constructed with the dual raw offset) so only validation and stitching are repeated.
 template <typename Real>
 std::vector<Polyline<Real>> recoverOpenOffsetPolylinesFromRelaxedSlices(
-    Polyline<Real> const &cleaned, Polyline<Real> const &rawOffset,
-    Polyline<Real> const &dualRawOffset, Real offset,
-    ParallelOffsetOptions<Real> const &options) {
+    RawOffsetIntersectContext<Real> &context, ParallelOffsetOptions<Real> const &options) {
+  CAVC_TRACE_SCOPE("recoverOpenOffsetPolylinesFromRelaxedSlices");
+  Polyline<Real> const &cleaned = context.originalPline;
+  Polyline<Real> const &rawOffset = context.rawOffsetPline;
   CAVC_ASSERT(!cleaned.isClosed(), "relaxed open-offset recovery requires an open polyline");
 
-  auto const qualityThresholds = offsetResultQualityThresholds(cleaned, offset);
+  auto const qualityThresholds =
+      offsetResultQualityThresholds(cleaned, context.offset, context.eps);
   auto recoverFromSlices = [&](bool skipOrigIntersectionCheck) {
-    auto relaxedSlices = dualSliceAtIntersectsForOffset(cleaned, rawOffset, dualRawOffset, offset,
-                                                        options, false, skipOrigIntersectionCheck);
-    auto relaxedResult =
-        stitchOffsetSlicesTogether(rawOffset, relaxedSlices, cleaned.isClosed(), rawOffset.size() - 1);
+    auto relaxedSlices =
+        dualSliceAtIntersectsForOffset(context, options, false, skipOrigIntersectionCheck);
+    auto relaxedResult = stitchOffsetSlicesTogether(rawOffset, relaxedSlices, cleaned.isClosed(),
+                                                    rawOffset.size() - 1,
+                                                    context.eps.sliceJoinThreshold);
     return keepDominantOpenOffsetPolyline(
         filterUsableOpenOffsetPolylines(relaxedResult, qualityThresholds), qualityThresholds);
   };
 
   auto recovered = recoverFromSlices(false);
-  if (!recovered.empty()) {
+  if (!recovered.empty() || cancellationRequested()) {
     return recovered;
   }
 
   return recoverFromSlices(true);
 }
 
+/// Relaxed recovery for closed polylines, re-slices using the primary pass intersect context so
+/// only validation and stitching are repeated.
 template <typename Real>
-std::vector<Polyline<Real>> recoverClosedOffsetLoopsFromRelaxedSlices(
-    Polyline<Real> const &cleaned, Polyline<Real> const &rawOffset, Real offset) {
+std::vector<Polyline<Real>>
+recoverClosedOffsetLoopsFromRelaxedSlices(RawOffsetIntersectContext<Real> &context) {
+  CAVC_TRACE_SCOPE("recoverClosedOffsetLoopsFromRelaxedSlices");
+  Polyline<Real> const &cleaned = context.originalPline;
+  Polyline<Real> const &rawOffset = context.rawOffsetPline;
   CAVC_ASSERT(cleaned.isClosed(), "relaxed closed-loop recovery requires a closed polyline");
-  if (rawOffset.size() < 2) {
-    return {};
-  }
 
-  auto qualityThresholds = offsetResultQualityThresholds(cleaned, offset);
+  auto qualityThresholds = offsetResultQualityThresholds(cleaned, context.offset, context.eps);
   qualityThresholds.minClosedAbsArea = qualityThresholds.minRelaxedClosedAbsArea;
 
   auto recoverFromSlices = [&](bool skipOrigIntersectionCheck) {
-    auto relaxedSlices =
-        slicesFromRawOffset(cleaned, rawOffset, offset, false, skipOrigIntersectionCheck);
-    auto relaxedStitched =
-        stitchOffsetSlicesTogether(rawOffset, relaxedSlices, true, rawOffset.size() - 1);
+    auto relaxedSlices = slicesFromRawOffset(context, false, skipOrigIntersectionCheck);
+    auto relaxedStitched = stitchOffsetSlicesTogether(rawOffset, relaxedSlices, true,
+                                                      rawOffset.size() - 1,
+                                                      context.eps.sliceJoinThreshold);
 
     auto simpleRecovered = filterClosedLoopsWithMinimumAbsArea(
         filterSimpleClosedLoops(relaxedStitched), qualityThresholds);
@@ -2089,7 +2259,8 @@ std::vector<Polyline<Real>> recoverClosedOffsetLoopsFromRelaxedSlices(
       return simpleRecovered;
     }
 
-    auto graphRecovered = stitchSlicesIntoSimpleClosedLoops(rawOffset, relaxedSlices, rawOffset.size() - 1);
+    auto graphRecovered = stitchSlicesIntoSimpleClosedLoops(
+        rawOffset, relaxedSlices, rawOffset.size() - 1, context.eps.sliceJoinThreshold);
     auto graphFiltered = filterClosedLoopsWithMinimumAbsArea(graphRecovered, qualityThresholds);
     if (!graphFiltered.empty()) {
       return graphFiltered;
@@ -2103,7 +2274,7 @@ std::vector<Polyline<Real>> recoverClosedOffsetLoopsFromRelaxedSlices(
   // First keep the original-intersection rejection enabled. If that still fails, relax only that
   // final check, while retaining the non-round raw join geometry and area/path/finite filters.
   auto recovered = recoverFromSlices(false);
-  if (!recovered.empty()) {
+  if (!recovered.empty() || cancellationRequested()) {
     return recovered;
   }
 
@@ -2112,6 +2283,7 @@ std::vector<Polyline<Real>> recoverClosedOffsetLoopsFromRelaxedSlices(
 
 template <typename Real>
 std::vector<Polyline<Real>> filterCollapsedLineLoops(std::vector<Polyline<Real>> const &candidates) {
+  CAVC_TRACE_SCOPE("filterCollapsedLineLoops");
   if (candidates.size() != 1) {
     return {};
   }
@@ -2129,6 +2301,7 @@ stitchSlicesIntoSimpleClosedLoops(Polyline<Real> const &sourcePline,
                                   std::vector<OpenPolylineSlice<Real>> const &slices,
                                   std::size_t origMaxIndex,
                                   Real joinThreshold) {
+  CAVC_TRACE_SCOPE("stitchSlicesIntoSimpleClosedLoops");
   std::vector<Polyline<Real>> result;
   if (slices.empty()) {
     return result;
@@ -2209,7 +2382,11 @@ stitchSlicesIntoSimpleClosedLoops(Polyline<Real> const &sourcePline,
     return pline;
   };
 
+  internal::CancellationPoll cancelPoll;
   auto dfs = [&](auto &&self, std::size_t currIndex) -> bool {
+    if (cancelPoll()) {
+      return false;
+    }
     Polyline<Real> candidate = materializePath(path);
     if (candidate.size() > 2 &&
         fuzzyEqual(candidate[0].pos(), candidate.lastVertex().pos(), joinThreshold)) {
@@ -2244,6 +2421,10 @@ stitchSlicesIntoSimpleClosedLoops(Polyline<Real> const &sourcePline,
       continue;
     }
 
+    if (cancelPoll()) {
+      break;
+    }
+
     path.clear();
     path.push_back(i);
     std::fill(localUsed.begin(), localUsed.end(), false);
@@ -2261,69 +2442,89 @@ stitchSlicesIntoSimpleClosedLoops(Polyline<Real> const &sourcePline,
 
   return result;
 }
-} // namespace internal
 
-/// Creates the paralell offset polylines to the polyline given.
+/// Offset implementation after the input has had redundant vertexes removed, eps holds the
+/// tolerances of the call.
 template <typename Real>
-std::vector<Polyline<Real>> parallelOffset(Polyline<Real> const &pline, Real offset,
-                                           ParallelOffsetOptions<Real> const &options = {}) {
-  using namespace internal;
-  if (options.joinType == OffsetJoinType::Miter) {
-    CAVC_ASSERT(options.miterLimit >= Real(1), "miterLimit must be >= 1");
-  }
-
-  Polyline<Real> cleaned = removeRedundant(pline, utils::realPrecision<Real>());
+std::vector<Polyline<Real>> parallelOffsetCleaned(Polyline<Real> const &cleaned, Real offset,
+                                                  ParallelOffsetOptions<Real> const &options,
+                                                  utils::EpsilonConfig<Real> const &eps) {
+  CAVC_TRACE_SCOPE("parallelOffset");
   if (cleaned.size() < 2) {
+    CAVC_STATS_INC(offsetEmptyResults);
     return std::vector<Polyline<Real>>();
   }
-  auto rawOffset = createRawOffsetPline(cleaned, offset, options);
-  if (rawOffset.size() < 2) {
+  auto rawOffset = createRawOffsetPline(cleaned, offset, options, eps);
+  if (rawOffset.size() < 2 || cancellationRequested()) {
+    CAVC_STATS_INC(offsetEmptyResults);
     return std::vector<Polyline<Real>>();
   }
-  auto const qualityThresholds = offsetResultQualityThresholds(cleaned, offset);
+  auto const qualityThresholds = offsetResultQualityThresholds(cleaned, offset, eps);
   if (cleaned.isClosed() && !options.hasSelfIntersects) {
-    auto slices = slicesFromRawOffset(cleaned, rawOffset, offset);
-    auto result =
-        stitchOffsetSlicesTogether(rawOffset, slices, cleaned.isClosed(), rawOffset.size() - 1);
+    // intersects computed once, shared with the relaxed recovery passes
+    RawOffsetIntersectContext<Real> intersectContext(cleaned, rawOffset, offset, eps);
+    auto slices = slicesFromRawOffset(intersectContext);
+    if (cancellationRequested()) {
+      CAVC_STATS_INC(offsetEmptyResults);
+      return std::vector<Polyline<Real>>();
+    }
+    auto result = stitchOffsetSlicesTogether(rawOffset, slices, cleaned.isClosed(),
+                                             rawOffset.size() - 1, eps.sliceJoinThreshold);
     auto filteredResult = filterSimpleClosedLoops(result);
     if (!filteredResult.empty()) {
+      CAVC_STATS_INC(offsetStitchedResults);
       return filteredResult;
     }
 
     auto collapsedLineResult = filterCollapsedLineLoops(result);
     if (!collapsedLineResult.empty()) {
+      CAVC_STATS_INC(offsetCollapsedLineResults);
       return collapsedLineResult;
     }
 
-    auto rescuedResult = stitchSlicesIntoSimpleClosedLoops(rawOffset, slices, rawOffset.size() - 1);
+    if (cancellationRequested()) {
+      CAVC_STATS_INC(offsetEmptyResults);
+      return std::vector<Polyline<Real>>();
+    }
+
+    auto rescuedResult = stitchSlicesIntoSimpleClosedLoops(rawOffset, slices, rawOffset.size() - 1,
+                                                           eps.sliceJoinThreshold);
     if (!rescuedResult.empty()) {
+      CAVC_STATS_INC(offsetLoopRescueResults);
       return rescuedResult;
     }
 
     auto endpointTouchResult = filterClosedLoopsAllowingEndpointTouches(result, qualityThresholds);
     if (!endpointTouchResult.empty()) {
+      CAVC_STATS_INC(offsetEndpointTouchResults);
       return endpointTouchResult;
     }
 
-    if (options.joinType != OffsetJoinType::Round) {
-      auto relaxedRecoveredResult =
-          recoverClosedOffsetLoopsFromRelaxedSlices(cleaned, rawOffset, offset);
+    if (options.joinType != OffsetJoinType::Round && !cancellationRequested()) {
+      auto relaxedRecoveredResult = recoverClosedOffsetLoopsFromRelaxedSlices(intersectContext);
       if (!relaxedRecoveredResult.empty()) {
+        CAVC_STATS_INC(offsetRelaxedRecoveryResults);
         return relaxedRecoveredResult;
       }
     }
 
+    CAVC_STATS_INC(offsetEmptyResults);
     return std::vector<Polyline<Real>>();
   }
 
   // not closed polyline or has self intersects, must apply dual clipping
-  auto dualRawOffset = createRawOffsetPline(cleaned, -offset, options);
+  auto dualRawOffset = createRawOffsetPline(cleaned, -offset, options, eps);
   bool const enforceMinDistance =
       !cleaned.isClosed() || options.joinType == OffsetJoinType::Round;
-  auto slices = dualSliceAtIntersectsForOffset(cleaned, rawOffset, dualRawOffset, offset, options,
-                                               enforceMinDistance);
-  auto result =
-      stitchOffsetSlicesTogether(rawOffset, slices, cleaned.isClosed(), rawOffset.size() - 1);
+  RawOffsetIntersectContext<Real> intersectContext(cleaned, rawOffset, offset, eps,
+                                                   &dualRawOffset);
+  auto slices = dualSliceAtIntersectsForOffset(intersectContext, options, enforceMinDistance);
+  if (cancellationRequested()) {
+    CAVC_STATS_INC(offsetEmptyResults);
+    return std::vector<Polyline<Real>>();
+  }
+  auto result = stitchOffsetSlicesTogether(rawOffset, slices, cleaned.isClosed(),
+                                           rawOffset.size() - 1, eps.sliceJoinThreshold);
   if (!cleaned.isClosed()) {
     auto filteredOpenResult = filterUsableOpenOffsetPolylines(result, qualityThresholds);
     if (options.joinType != OffsetJoinType::Round) {
@@ -2331,50 +2532,121 @@ std::vector<Polyline<Real>> parallelOffset(Polyline<Real> const &pline, Real off
           keepDominantOpenOffsetPolyline(filteredOpenResult, qualityThresholds);
     }
     if (!filteredOpenResult.empty()) {
+      CAVC_STATS_INC(offsetStitchedResults);
       return filteredOpenResult;
     }
 
-    if (options.joinType != OffsetJoinType::Round) {
-      auto relaxedOpenResult = recoverOpenOffsetPolylinesFromRelaxedSlices(
-          cleaned, rawOffset, dualRawOffset, offset, options);
+    if (options.joinType != OffsetJoinType::Round && !cancellationRequested()) {
+      auto relaxedOpenResult =
+          recoverOpenOffsetPolylinesFromRelaxedSlices(intersectContext, options);
       if (!relaxedOpenResult.empty()) {
+        CAVC_STATS_INC(offsetRelaxedRecoveryResults);
         return relaxedOpenResult;
       }
     }
 
+    CAVC_STATS_INC(offsetEmptyResults);
     return {};
   }
 
   auto filteredResult = filterSimpleClosedLoops(result);
   if (!filteredResult.empty()) {
+    CAVC_STATS_INC(offsetStitchedResults);
     return filteredResult;
   }
 
   auto collapsedLineResult = filterCollapsedLineLoops(result);
   if (!collapsedLineResult.empty()) {
+    CAVC_STATS_INC(offsetCollapsedLineResults);
     return collapsedLineResult;
   }
 
-  auto rescuedResult = stitchSlicesIntoSimpleClosedLoops(rawOffset, slices, rawOffset.size() - 1);
+  if (cancellationRequested()) {
+    CAVC_STATS_INC(offsetEmptyResults);
+    return std::vector<Polyline<Real>>();
+  }
+
+  auto rescuedResult = stitchSlicesIntoSimpleClosedLoops(rawOffset, slices, rawOffset.size() - 1,
+                                                         eps.sliceJoinThreshold);
   if (!rescuedResult.empty()) {
+    CAVC_STATS_INC(offsetLoopRescueResults);
     return rescuedResult;
   }
 
   auto endpointTouchResult = filterClosedLoopsAllowingEndpointTouches(result, qualityThresholds);
   if (!endpointTouchResult.empty()) {
+    CAVC_STATS_INC(offsetEndpointTouchResults);
     return endpointTouchResult;
   }
 
-  if (cleaned.isClosed() && options.joinType != OffsetJoinType::Round) {
-    auto relaxedRecoveredResult =
-        recoverClosedOffsetLoopsFromRelaxedSlices(cleaned, rawOffset, offset);
+  if (cleaned.isClosed() && options.joinType != OffsetJoinType::Round &&
+      !cancellationRequested()) {
+    auto relaxedRecoveredResult = recoverClosedOffsetLoopsFromRelaxedSlices(intersectContext);
     if (!relaxedRecoveredResult.empty()) {
+      CAVC_STATS_INC(offsetRelaxedRecoveryResults);
       return relaxedRecoveredResult;
     }
   }
 
+  CAVC_STATS_INC(offsetEmptyResults);
   return std::vector<Polyline<Real>>();
 }
 
+/// Shared implementation of the parallelOffset overloads taking an EpsilonConfig, PlineInput is a
+/// Polyline or a PolylineView (anything removeRedundant accepts).
+template <typename Real, typename PlineInput>
+std::vector<Polyline<Real>> parallelOffsetInput(PlineInput const &pline, Real offset,
+                                                ParallelOffsetOptions<Real> const &options,
+                                                utils::EpsilonConfig<Real> const &eps) {
+  if (options.joinType == OffsetJoinType::Miter) {
+    CAVC_ASSERT(options.miterLimit >= Real(1), "miterLimit must be >= 1");
+  }
+
+  utils::ScopedEpsilonContext<Real> epsContext(eps);
+  auto result =
+      internal::parallelOffsetCleaned(removeRedundant(pline, eps.realPrecision), offset, options,
+                                      eps);
+  if (internal::cancellationStopped()) {
+    // a loop level check stopped a phase part way, discard the partial result
+    result.clear();
+  }
+  return result;
+}
+} // namespace internal
+
+/// Creates the paralell offset polylines to the polyline given. eps holds the tolerances used for
+/// the call (installed as the thread's epsilon context so all nested helpers agree on them).
+/// Returns no polylines if the thread's cancellation token is cancelled or its deadline passes
+/// during the call (the token status then reports why, see cancellation.hpp).
+template <typename Real>
+std::vector<Polyline<Real>> parallelOffset(Polyline<Real> const &pline, Real offset,
+                                           ParallelOffsetOptions<Real> const &options,
+                                           utils::EpsilonConfig<Real> const &eps) {
+  return internal::parallelOffsetInput(pline, offset, options, eps);
+}
+
+/// Creates the paralell offset polylines to the polyline given using the tolerances currently in
+/// effect (global config unless an epsilon context is active).
+template <typename Real>
+std::vector<Polyline<Real>> parallelOffset(Polyline<Real> const &pline, Real offset,
+                                           ParallelOffsetOptions<Real> const &options = {}) {
+  return parallelOffset(pline, offset, options, utils::currentEpsilonConfig<Real>());
+}
+
+/// Creates the paralell offset polylines reading the input vertexes directly from the view (no
+/// intermediate Polyline copy of the input is made).
+template <typename Real>
+std::vector<Polyline<Real>> parallelOffset(PolylineView<Real> const &pline, Real offset,
+                                           ParallelOffsetOptions<Real> const &options,
+                                           utils::EpsilonConfig<Real> const &eps) {
+  return internal::parallelOffsetInput(pline, offset, options, eps);
+}
+
+template <typename Real>
+std::vector<Polyline<Real>> parallelOffset(PolylineView<Real> const &pline, Real offset,
+                                           ParallelOffsetOptions<Real> const &options = {}) {
+  return parallelOffset(pline, offset, options, utils::currentEpsilonConfig<Real>());
+}
+
 } // namespace cavc
 #endif // CAVC_POLYLINEOFFSET_HPP
@@ -3,9 +3,11 @@
 #include "polyline.hpp"
 #include "polylinecombine.hpp"
 #include "polylineoffset.hpp"
+#include "internal/parallel.hpp"
+#include "tracing.hpp"
 #include <algorithm>
 #include <limits>
-#include <unordered_map>
+#include <type_traits>
 #include <vector>
 
 namespace cavc {
@@ -13,11 +15,19 @@ template <typename Real> struct OffsetLoop {
   std::size_t parentLoopIndex;
   Polyline<Real> polyline;
   StaticSpatialIndex<Real> spatialIndex;
+
+  /// Bytes of heap memory held by the loop's polyline and spatial index.
+  std::size_t memoryUsage() const { return polyline.memoryUsage() + spatialIndex.memoryUsage(); }
 };
 
 template <typename Real> struct OffsetLoopSet {
   std::vector<OffsetLoop<Real>> ccwLoops;
   std::vector<OffsetLoop<Real>> cwLoops;
+
+  /// Bytes of heap memory held by the loop set (loop vectors and each loop's memory).
+  std::size_t memoryUsage() const {
+    return internal::elementsMemoryUsage(ccwLoops) + internal::elementsMemoryUsage(cwLoops);
+  }
 };
 
 enum class OffsetLoopRole {
@@ -66,10 +76,17 @@ template <typename Real> void sortOffsetLoopSetStable(OffsetLoopSet<Real> &loopS
   sortOffsetLoopsStable(loopSet.cwLoops);
 }
 
+/// Build the containment topology of the loops in loopSet. Loops are ordered by area descending
+/// (ties broken by bounding box, role then source index) and each loop's parent is the smallest
+/// loop of the opposite role that contains its first vertex. Candidate parents are found with a
+/// spatial index over the loop extents and containment is tested using each candidate's
+/// OffsetLoop::spatialIndex. maxThreads limits the threads used (0 uses the hardware thread
+/// count, 1 runs on the calling thread), the result does not depend on it.
 template <typename Real>
 std::vector<OffsetLoopTopologyNode<Real>>
 buildOffsetLoopTopology(OffsetLoopSet<Real> const &loopSet,
-                        Real boundaryEpsilon = utils::realPrecision<Real>()) {
+                        Real boundaryEpsilon = utils::realPrecision<Real>(),
+                        std::size_t maxThreads = 0) {
   CAVC_ASSERT(boundaryEpsilon >= Real(0), "boundaryEpsilon must be >= 0");
 
   struct FlattenedLoopRef {
@@ -123,55 +140,75 @@ buildOffsetLoopTopology(OffsetLoopSet<Real> const &loopSet,
     result[i].sourceIndex = flattened[i].sourceIndex;
   }
 
-  auto pointInsideExpandedLoopBounds = [&](FlattenedLoopRef const &loop_ref,
-                                           Vector2<Real> const &point) {
-    Real const min_x = loop_ref.loop->spatialIndex.minX() - boundaryEpsilon;
-    Real const min_y = loop_ref.loop->spatialIndex.minY() - boundaryEpsilon;
-    Real const max_x = loop_ref.loop->spatialIndex.maxX() + boundaryEpsilon;
-    Real const max_y = loop_ref.loop->spatialIndex.maxY() + boundaryEpsilon;
-    return point.x() >= min_x && point.x() <= max_x && point.y() >= min_y && point.y() <= max_y;
+  if (flattened.size() < 2) {
+    return result;
+  }
+
+  // index of all loop extents (expanded by boundaryEpsilon) in sorted order so item index maps to
+  // flattened index
+  StaticSpatialIndex<Real> loopsIndex(flattened.size());
+  for (auto const &loop_ref : flattened) {
+    auto const &i = loop_ref.loop->spatialIndex;
+    loopsIndex.add(i.minX() - boundaryEpsilon, i.minY() - boundaryEpsilon,
+                   i.maxX() + boundaryEpsilon, i.maxY() + boundaryEpsilon);
+  }
+  loopsIndex.finish();
+
+  struct WorkerBuffers {
+    std::vector<std::size_t> candidates;
+    std::vector<std::size_t> queryStack;
+    std::vector<std::size_t> containmentQueryStack;
   };
 
-  for (std::size_t i = 0; i < flattened.size(); ++i) {
+  // minimum number of loops given to each worker
+  constexpr std::size_t minLoopsPerWorker = 64;
+  std::size_t const workerCount =
+      internal::parallelWorkerCount(flattened.size(), minLoopsPerWorker, maxThreads);
+  std::vector<WorkerBuffers> workerBuffers(workerCount);
+
+  auto findParent = [&](std::size_t i, std::size_t worker) {
     auto const &child = flattened[i];
     if (child.loop->polyline.size() == 0) {
-      continue;
+      return;
     }
 
+    WorkerBuffers &buffers = workerBuffers[worker];
     Vector2<Real> samplePoint = child.loop->polyline[0].pos();
-    std::size_t parentIndex = kNoParentOffsetLoop;
-    Real parentAbsArea = std::numeric_limits<Real>::max();
-
-    for (std::size_t j = 0; j < flattened.size(); ++j) {
-      if (i == j) {
-        continue;
-      }
-
+    buffers.candidates.clear();
+    auto candidateVisitor = [&](std::size_t j) {
       auto const &candidate = flattened[j];
-      if (candidate.role == child.role) {
-        continue;
-      }
-      if (candidate.absArea <= child.absArea) {
-        continue;
-      }
-      if (!pointInsideExpandedLoopBounds(candidate, samplePoint)) {
-        continue;
+      if (j != i && candidate.role != child.role && candidate.absArea > child.absArea) {
+        buffers.candidates.push_back(j);
       }
+      return true;
+    };
 
-      PointContainment containment =
-          getPointContainment(candidate.loop->polyline, samplePoint, boundaryEpsilon);
-      if (containment == PointContainment::Outside) {
-        continue;
-      }
+    loopsIndex.visitQuery(samplePoint.x(), samplePoint.y(), samplePoint.x(), samplePoint.y(),
+                          candidateVisitor, buffers.queryStack);
 
-      if (candidate.absArea < parentAbsArea) {
-        parentIndex = j;
-        parentAbsArea = candidate.absArea;
+    // test smallest candidates first (lowest sorted index on ties), first containing candidate is
+    // the parent
+    std::sort(buffers.candidates.begin(), buffers.candidates.end(),
+              [&](std::size_t lhs, std::size_t rhs) {
+                if (flattened[lhs].absArea != flattened[rhs].absArea) {
+                  return flattened[lhs].absArea < flattened[rhs].absArea;
+                }
+                return lhs < rhs;
+              });
+
+    for (std::size_t j : buffers.candidates) {
+      auto const &candidate = flattened[j];
+      PointContainment containment =
+          getPointContainment(candidate.loop->polyline, candidate.loop->spatialIndex, samplePoint,
+                              boundaryEpsilon, buffers.containmentQueryStack);
+      if (containment != PointContainment::Outside) {
+        result[i].parentIndex = j;
+        return;
       }
     }
+  };
 
-    result[i].parentIndex = parentIndex;
-  }
+  internal::parallelFor<Real>(flattened.size(), workerCount, findParent);
 
   return result;
 }
@@ -179,7 +216,29 @@ buildOffsetLoopTopology(OffsetLoopSet<Real> const &loopSet,
 template <typename Real> class ParallelOffsetIslands {
 public:
   ParallelOffsetIslands() {}
+  /// Offset the loops in input by abs(offsetDelta). Returns an empty set if the calling thread's
+  /// cancellation token is cancelled or its deadline passes (checked between phases and inside the
+  /// intersect, validation and stitch loops, the token status reports why, see cancellation.hpp).
   OffsetLoopSet<Real> compute(OffsetLoopSet<Real> const &input, Real offsetDelta);
+  /// Same as compute(input, offsetDelta) but using the tolerances in eps (installed as the
+  /// epsilon context for the calling thread and all worker threads for the duration of the call).
+  OffsetLoopSet<Real> compute(OffsetLoopSet<Real> const &input, Real offsetDelta,
+                              utils::EpsilonConfig<Real> const &eps);
+
+  /// Offset input stepCount times, each step offsetting the result of the previous step (e.g. for
+  /// pocketing). sink(stepIndex, stepResult) is called with each step's result, stepResult is only
+  /// valid for the duration of the call. If sink returns a bool then returning false stops further
+  /// steps. Stops early if a step produces no loops. Internal buffers and the result loops'
+  /// spatial indexes are reused between steps so memory is bounded by the two most recent steps.
+  /// Returns the number of steps computed.
+  template <typename StepSink>
+  std::size_t computeSteps(OffsetLoopSet<Real> const &input, Real offsetDelta,
+                           std::size_t stepCount, StepSink &&sink);
+
+  /// Maximum number of threads used for independent work (0 uses the hardware thread count, 1
+  /// runs everything on the calling thread). Results do not depend on this value.
+  std::size_t maxThreads() const { return m_maxThreads; }
+  void setMaxThreads(std::size_t maxThreads) { m_maxThreads = maxThreads; }
 
 private:
   // type to represent a slice point (intersect) on an OffsetLoop
@@ -205,36 +264,63 @@ private:
                                        : m_cwOffsetLoops[i - m_ccwOffsetLoops.size()];
   }
 
-  OffsetLoop<Real> const &getParentLoop(std::size_t i) {
+  OffsetLoop<Real> const &getOffsetLoop(std::size_t i) const {
+    return i < m_ccwOffsetLoops.size() ? m_ccwOffsetLoops[i]
+                                       : m_cwOffsetLoops[i - m_ccwOffsetLoops.size()];
+  }
+
+  OffsetLoop<Real> const &getParentLoop(std::size_t i) const {
     return i < m_inputSet->ccwLoops.size() ? m_inputSet->ccwLoops[i]
                                            : m_inputSet->cwLoops[i - m_inputSet->ccwLoops.size()];
   }
 
+  void computeInto(OffsetLoopSet<Real> const &input, Real offsetDelta, OffsetLoopSet<Real> &result);
   void createOffsetLoops(const OffsetLoopSet<Real> &input, Real absDelta);
   void createOffsetLoopsIndex();
   void createSlicePoints();
 
   struct DissectionPoint {
+    // index of the segment on the loop being dissected that the point lies on
+    std::size_t segIndex;
+    // squared distance from the segment start vertex (orders points along the segment)
+    Real distSq;
+    // index of the loop that intersected to form the point
     std::size_t otherLoopIndex;
     Vector2<Real> pos;
   };
 
+  // slice of an offset loop between two dissection points, the slice polyline is only built (see
+  // buildSlice) for validation and once the slice is known to be valid
   struct DissectedSlice {
-    // open polyline representing the slice
-    Polyline<Real> pline;
     // index of the loop the slice is from
     std::size_t sliceParentIndex;
     // index of the loop that intersected the parent loop to form the start of the slice
     std::size_t startLoopIndex;
     // index of the loop that intersected the parent loop to form the end of the slice
     std::size_t endLoopIndex;
+    // index of the parent loop segment the slice starts on and the segment it ends on
+    std::size_t startSegIndex;
+    std::size_t endSegIndex;
+    // true if the slice lies between two dissection points on the same segment (startVertex to
+    // endVertex), otherwise it follows the parent loop from startSegIndex to endSegIndex
+    bool withinSegment;
+    // first vertex (split from the start segment) and last vertex of the slice
+    PlineVertex<Real> startVertex;
+    PlineVertex<Real> endVertex;
   };
 
-  bool pointOnOffsetValid(std::size_t skipIndex, Vector2<Real> const &pt, Real absDelta);
-  void createSlicesFromLoop(std::size_t loopIndex, Real absDelta,
-                            std::vector<DissectedSlice> &result);
+  bool pointOnOffsetValid(std::size_t skipIndex, Vector2<Real> const &pt, Real absDelta,
+                          std::vector<std::size_t> &queryStack) const;
+  void buildSlice(DissectedSlice const &slice, Polyline<Real> &result,
+                  std::size_t maxVertexCount) const;
+  bool sliceValid(DissectedSlice const &slice, Real absDelta, Polyline<Real> &scratch,
+                  std::vector<std::size_t> &queryStack) const;
+  void createSlicesFromLoop(std::size_t loopIndex, std::vector<DissectedSlice> &result);
+  void validateSlices(std::vector<DissectedSlice> const &slices, Real absDelta);
 
-  OffsetLoopSet<Real> const *m_inputSet;
+  OffsetLoopSet<Real> const *m_inputSet = nullptr;
+  // tolerances for the current compute call, installed as the epsilon context on every worker
+  utils::EpsilonConfig<Real> m_epsilon = utils::defaultEpsilonConfig<Real>();
 
   // counter clockwise offset loops, these surround the clockwise offset loops
   std::vector<OffsetLoop<Real>> m_ccwOffsetLoops;
@@ -244,8 +330,12 @@ private:
   // spatial index of all the offset loops
   std::unique_ptr<StaticSpatialIndex<Real>> m_offsetLoopsIndex;
   using IndexPair = std::pair<std::size_t, std::size_t>;
-  // set to keep track of already visited pairs of loops when finding intersects
-  std::unordered_set<IndexPair, internal::IndexPairHash> m_visitedLoopPairs;
+  // candidate pairs of loops (i < j) with overlapping bounding boxes
+  std::vector<IndexPair> m_candidateLoopPairs;
+  // slice point set for each candidate pair (same order as m_candidateLoopPairs)
+  std::vector<SlicePointSet> m_pairSlicePointSets;
+  // intersect buffers for each worker used while finding intersects between loop pairs
+  std::vector<PlineIntersectsResult<Real>> m_workerIntrsResults;
   // buffers to use for querying spatial indexes
   std::vector<std::size_t> m_queryStack;
   std::vector<std::size_t> m_queryResults;
@@ -254,13 +344,28 @@ private:
   // lookup used to get slice points for a particular loop index (holds indexes to sets in
   // m_slicePointSets)
   std::vector<std::vector<std::size_t>> m_slicePointsLookup;
-  // dissection points used to form slices for a particular loop in createSlicesFromLoop
-  std::unordered_map<std::size_t, std::vector<DissectionPoint>> m_loopDissectionPoints;
+  // dissection points used to form slices for a particular loop in createSlicesFromLoop, sorted
+  // by segment index then distance along the segment
+  std::vector<DissectionPoint> m_loopDissectionPoints;
+  // validation result for each dissected slice (char rather than bool so workers may write
+  // concurrently)
+  std::vector<char> m_sliceValid;
+  // query stack and partial slice polyline for each worker used while validating slices
+  std::vector<std::vector<std::size_t>> m_workerQueryStacks;
+  std::vector<Polyline<Real>> m_workerSliceScratch;
+  // slices formed from all loops, the polylines of the valid slices and the stitched closed loops
+  // (kept as members to reuse allocations across calls)
+  std::vector<DissectedSlice> m_dissectedSlices;
+  std::vector<Polyline<Real>> m_validSlices;
+  std::vector<Polyline<Real>> m_stitchedCcwLoops;
+  std::vector<Polyline<Real>> m_stitchedCwLoops;
+  std::size_t m_maxThreads = 0;
 };
 
 template <typename Real>
 void ParallelOffsetIslands<Real>::createOffsetLoops(const OffsetLoopSet<Real> &input,
                                                     Real absDelta) {
+  CAVC_TRACE_SCOPE("ParallelOffsetIslands::createOffsetLoops");
   std::size_t const expected_loop_count = input.ccwLoops.size() + input.cwLoops.size();
   // create counter clockwise offset loops
   m_ccwOffsetLoops.clear();
@@ -286,7 +391,7 @@ void ParallelOffsetIslands<Real>::createOffsetLoops(const OffsetLoopSet<Real> &i
 
   std::size_t parentIndex = 0;
   for (auto const &loop : input.ccwLoops) {
-    auto offsets = parallelOffset(loop.polyline, absDelta);
+    auto offsets = parallelOffset(loop.polyline, absDelta, {}, m_epsilon);
     std::vector<Polyline<Real>> ccwOffsets;
     ccwOffsets.reserve(offsets.size());
     for (auto &offset : offsets) {
@@ -303,7 +408,7 @@ void ParallelOffsetIslands<Real>::createOffsetLoops(const OffsetLoopSet<Real> &i
 
   // create clockwise offset loops (note counter clockwise loops may result from outward offset)
   for (auto const &loop : input.cwLoops) {
-    auto offsets = parallelOffset(loop.polyline, absDelta);
+    auto offsets = parallelOffset(loop.polyline, absDelta, {}, m_epsilon);
     std::vector<Polyline<Real>> cwOffsets;
     std::vector<Polyline<Real>> ccwOffsets;
     cwOffsets.reserve(offsets.size());
@@ -323,8 +428,14 @@ void ParallelOffsetIslands<Real>::createOffsetLoops(const OffsetLoopSet<Real> &i
 }
 
 template <typename Real> void ParallelOffsetIslands<Real>::createOffsetLoopsIndex() {
-  // create spatial index for all offset loop bounding boxes
-  m_offsetLoopsIndex = std::make_unique<StaticSpatialIndex<Real>>(totalOffsetLoopsCount());
+  CAVC_TRACE_SCOPE("ParallelOffsetIslands::createOffsetLoopsIndex");
+  // create spatial index for all offset loop bounding boxes, the index storage is kept between
+  // calls so repeated computes (e.g. computeSteps) do not reallocate it
+  if (m_offsetLoopsIndex) {
+    m_offsetLoopsIndex->reset(totalOffsetLoopsCount());
+  } else {
+    m_offsetLoopsIndex = std::make_unique<StaticSpatialIndex<Real>>(totalOffsetLoopsCount());
+  }
   for (auto const &posC : m_ccwOffsetLoops) {
     auto const &i = posC.spatialIndex;
     m_offsetLoopsIndex->add(i.minX(), i.minY(), i.maxX(), i.maxY());
@@ -338,73 +449,99 @@ template <typename Real> void ParallelOffsetIslands<Real>::createOffsetLoopsInde
 }
 
 template <typename Real> void ParallelOffsetIslands<Real>::createSlicePoints() {
+  CAVC_TRACE_SCOPE("ParallelOffsetIslands::createSlicePoints");
+  // minimum number of loop pairs given to each worker, avoids spinning up threads for a handful
+  // of cheap intersect tests
+  constexpr std::size_t minPairsPerWorker = 4;
   std::size_t const totalOffsetCount = totalOffsetLoopsCount();
 
-  m_visitedLoopPairs.clear();
-  m_visitedLoopPairs.reserve(totalOffsetCount * 2);
   m_slicePointSets.clear();
   m_slicePointSets.reserve(totalOffsetCount);
   m_slicePointsLookup.clear();
+  m_slicePointsLookup.resize(totalOffsetCount);
   m_queryResults.clear();
   m_queryResults.reserve(totalOffsetCount);
 
-  // find all intersects between all offsets
-  m_slicePointsLookup.resize(totalOffsetCount);
-  PlineIntersectsResult<Real> intrsResults;
+  // gather candidate pairs once, bounding box overlap is symmetric so only keep i < j (same pair
+  // order as visiting loops in index order and skipping already visited pairs)
+  m_candidateLoopPairs.clear();
   for (std::size_t i = 0; i < totalOffsetCount; ++i) {
-    auto const &loop1 = getOffsetLoop(i);
-    auto const &index1 = loop1.spatialIndex;
+    auto const &index1 = getOffsetLoop(i).spatialIndex;
     m_queryResults.clear();
     m_offsetLoopsIndex->query(index1.minX(), index1.minY(), index1.maxX(), index1.maxY(),
                               m_queryResults, m_queryStack);
 
     for (std::size_t j : m_queryResults) {
-      // skip same index (no self intersects among the offset loops)
-      if (i == j) {
-        continue;
-      }
-      // skip reversed index order (would end up comparing the same loops)
-      if (m_visitedLoopPairs.find({j, i}) != m_visitedLoopPairs.end()) {
-        continue;
+      if (i < j) {
+        m_candidateLoopPairs.emplace_back(i, j);
       }
-      m_visitedLoopPairs.emplace(i, j);
-
-      auto const &loop2 = getOffsetLoop(j);
-      intrsResults.intersects.clear();
-      intrsResults.coincidentIntersects.clear();
-      // finding intersects
-      findIntersects(loop1.polyline, loop2.polyline, index1, intrsResults);
-      if (intrsResults.hasIntersects()) {
-        m_slicePointSets.emplace_back();
-        auto &slicePointSet = m_slicePointSets.back();
-        slicePointSet.loopIndex1 = i;
-        slicePointSet.loopIndex2 = j;
-        for (auto &intr : intrsResults.intersects) {
-          slicePointSet.slicePoints.push_back({std::move(intr), false});
-        }
+    }
+  }
 
-        // add coincident start and end points
-        if (intrsResults.coincidentIntersects.size() != 0) {
-          auto coinSliceResult = sortAndjoinCoincidentSlices(intrsResults.coincidentIntersects,
-                                                             loop1.polyline, loop2.polyline);
-          for (auto &sp : coinSliceResult.sliceStartPoints) {
-            slicePointSet.slicePoints.push_back({std::move(sp), false});
-          }
-          for (auto &ep : coinSliceResult.sliceEndPoints) {
-            slicePointSet.slicePoints.push_back({std::move(ep), true});
-          }
-        }
+  std::size_t const pairCount = m_candidateLoopPairs.size();
+  m_pairSlicePointSets.resize(pairCount);
+  std::size_t const workerCount =
+      internal::parallelWorkerCount(pairCount, minPairsPerWorker, m_maxThreads);
+  m_workerIntrsResults.resize(std::max(m_workerIntrsResults.size(), workerCount));
+
+  // find all intersects between all offsets, loops and their indexes are not modified here so
+  // each pair may be processed independently
+  auto intersectPair = [&](std::size_t pairIndex, std::size_t worker) {
+    std::size_t const i = m_candidateLoopPairs[pairIndex].first;
+    std::size_t const j = m_candidateLoopPairs[pairIndex].second;
+    auto const &loop1 = getOffsetLoop(i);
+    auto const &loop2 = getOffsetLoop(j);
+
+    auto &slicePointSet = m_pairSlicePointSets[pairIndex];
+    slicePointSet.loopIndex1 = i;
+    slicePointSet.loopIndex2 = j;
+    slicePointSet.slicePoints.clear();
+
+    PlineIntersectsResult<Real> &intrsResults = m_workerIntrsResults[worker];
+    intrsResults.intersects.clear();
+    intrsResults.coincidentIntersects.clear();
+    findIntersects(loop1.polyline, loop2.polyline, loop1.spatialIndex, intrsResults, m_epsilon);
+    if (!intrsResults.hasIntersects()) {
+      return;
+    }
+
+    for (auto &intr : intrsResults.intersects) {
+      slicePointSet.slicePoints.push_back({std::move(intr), false});
+    }
 
-        m_slicePointsLookup[i].push_back(m_slicePointSets.size() - 1);
-        m_slicePointsLookup[j].push_back(m_slicePointSets.size() - 1);
+    // add coincident start and end points
+    if (intrsResults.coincidentIntersects.size() != 0) {
+      auto coinSliceResult =
+          sortAndjoinCoincidentSlices(intrsResults.coincidentIntersects, loop1.polyline,
+                                      loop2.polyline, m_epsilon.realPrecision);
+      for (auto &sp : coinSliceResult.sliceStartPoints) {
+        slicePointSet.slicePoints.push_back({std::move(sp), false});
+      }
+      for (auto &ep : coinSliceResult.sliceEndPoints) {
+        slicePointSet.slicePoints.push_back({std::move(ep), true});
       }
     }
+  };
+
+  internal::parallelFor<Real>(pairCount, workerCount, intersectPair);
+
+  // merge in candidate pair order so set indexes and lookups are deterministic
+  for (auto &pairSet : m_pairSlicePointSets) {
+    if (pairSet.slicePoints.size() == 0) {
+      continue;
+    }
+
+    std::size_t const setIndex = m_slicePointSets.size();
+    m_slicePointsLookup[pairSet.loopIndex1].push_back(setIndex);
+    m_slicePointsLookup[pairSet.loopIndex2].push_back(setIndex);
+    m_slicePointSets.push_back(std::move(pairSet));
   }
 }
 
 template <typename Real>
 bool ParallelOffsetIslands<Real>::pointOnOffsetValid(std::size_t skipIndex, const Vector2<Real> &pt,
-                                                     Real absDelta) {
+                                                     Real absDelta,
+                                                     std::vector<std::size_t> &queryStack) const {
   // test distance against input polylines
   std::size_t const inputTotalCount = m_inputSet->ccwLoops.size() + m_inputSet->cwLoops.size();
   for (std::size_t i = 0; i < inputTotalCount; ++i) {
@@ -413,7 +550,8 @@ bool ParallelOffsetIslands<Real>::pointOnOffsetValid(std::size_t skipIndex, cons
     }
     auto const &parentLoop = getParentLoop(i);
     if (!internal::pointValidForOffset(parentLoop.polyline, absDelta, parentLoop.spatialIndex, pt,
-                                       m_queryStack)) {
+                                       queryStack, m_epsilon.offsetThreshold,
+                                       m_epsilon.realPrecision)) {
       return false;
     }
   }
@@ -422,175 +560,271 @@ bool ParallelOffsetIslands<Real>::pointOnOffsetValid(std::size_t skipIndex, cons
 }
 
 template <typename Real>
-void ParallelOffsetIslands<Real>::createSlicesFromLoop(std::size_t loopIndex, Real absDelta,
-                                                       std::vector<DissectedSlice> &result) {
-  OffsetLoop<Real> const &offsetLoop = getOffsetLoop(loopIndex);
-  std::size_t const parentIndex = offsetLoop.parentLoopIndex;
-  Polyline<Real> const &pline = offsetLoop.polyline;
-  auto sliceMidpointsValid = [&](Polyline<Real> const &slice) {
-    CAVC_ASSERT(slice.size() > 1, "slice must contain at least one segment");
-
-    auto midpointValid = [&](std::size_t startIndex) {
-      auto midpoint = segMidpoint(slice[startIndex], slice[startIndex + 1]);
-      return pointOnOffsetValid(parentIndex, midpoint, absDelta);
-    };
+void ParallelOffsetIslands<Real>::buildSlice(DissectedSlice const &slice, Polyline<Real> &result,
+                                             std::size_t maxVertexCount) const {
+  result.vertexes().clear();
+  result.addVertex(slice.startVertex);
+  if (slice.withinSegment) {
+    result.addVertex(slice.endVertex);
+    return;
+  }
 
-    // Avoid validating only against a segment created directly by intersection points. If an
-    // interior segment exists, prefer that midpoint; otherwise validate both edge segments.
-    if (slice.size() > 3) {
-      return midpointValid(1);
+  Polyline<Real> const &pline = getOffsetLoop(slice.sliceParentIndex).polyline;
+  std::size_t index = utils::nextWrappingIndex(slice.startSegIndex, pline);
+  std::size_t loopCount = 0;
+  const std::size_t maxLoopCount = pline.size();
+  while (true) {
+    if (loopCount++ > maxLoopCount) {
+      CAVC_ASSERT(false, "Bug detected, should never loop this many times!");
+      // break to avoid infinite loop
+      break;
     }
-    if (slice.size() == 3) {
-      return midpointValid(0) && midpointValid(1);
+    // add vertex
+    internal::addOrReplaceIfSamePos(result, pline[index], m_epsilon.realPrecision);
+
+    // check if segment that starts at vertex we just added has the end intersect
+    if (index == slice.endSegIndex) {
+      // trim last added vertex and add final intersect position
+      std::size_t nextIndex = utils::nextWrappingIndex(index, pline);
+      SplitResult<Real> split =
+          splitAtPoint(result.lastVertex(), pline[nextIndex], slice.endVertex.pos(),
+                       m_epsilon.realPrecision);
+      result.lastVertex() = split.updatedStart;
+      internal::addOrReplaceIfSamePos(result, slice.endVertex, m_epsilon.realPrecision);
+      break;
+    }
+
+    // only the last vertex may still be replaced or trimmed, all vertexes before it are final
+    if (result.size() >= maxVertexCount) {
+      break;
     }
-    return midpointValid(0);
+
+    index = utils::nextWrappingIndex(index, pline);
+  }
+}
+
+template <typename Real>
+bool ParallelOffsetIslands<Real>::sliceValid(DissectedSlice const &dissectedSlice, Real absDelta,
+                                             Polyline<Real> &scratch,
+                                             std::vector<std::size_t> &queryStack) const {
+  // validation only looks at the first two segments, so build at most 4 vertexes (the first 3
+  // are then final and a 4th vertex means the complete slice has more than 3)
+  buildSlice(dissectedSlice, scratch, 4);
+  Polyline<Real> const &slice = scratch;
+  if (slice.size() < 2) {
+    // collapsed to a point
+    return false;
+  }
+
+  std::size_t const parentIndex = getOffsetLoop(dissectedSlice.sliceParentIndex).parentLoopIndex;
+
+  auto midpointValid = [&](std::size_t startIndex) {
+    auto midpoint = segMidpoint(slice[startIndex], slice[startIndex + 1], m_epsilon.realPrecision);
+    return pointOnOffsetValid(parentIndex, midpoint, absDelta, queryStack);
   };
 
+  // Avoid validating only against a segment created directly by intersection points. If an
+  // interior segment exists, prefer that midpoint; otherwise validate both edge segments.
+  if (slice.size() > 3) {
+    return midpointValid(1);
+  }
+  if (slice.size() == 3) {
+    return midpointValid(0) && midpointValid(1);
+  }
+  return midpointValid(0);
+}
+
+template <typename Real>
+void ParallelOffsetIslands<Real>::createSlicesFromLoop(std::size_t loopIndex,
+                                                       std::vector<DissectedSlice> &result) {
+  OffsetLoop<Real> const &offsetLoop = getOffsetLoop(loopIndex);
+  Polyline<Real> const &pline = offsetLoop.polyline;
+
   m_loopDissectionPoints.clear();
   for (auto const &setIndex : m_slicePointsLookup[loopIndex]) {
     auto const &set = m_slicePointSets[setIndex];
     bool isFirstIndex = loopIndex == set.loopIndex1;
-    if (isFirstIndex) {
-      for (auto const &p : set.slicePoints) {
-        m_loopDissectionPoints[p.intr.sIndex1].push_back({set.loopIndex2, p.intr.pos});
-      }
-    } else {
-      for (auto const &p : set.slicePoints) {
-        m_loopDissectionPoints[p.intr.sIndex2].push_back({set.loopIndex1, p.intr.pos});
-      }
+    for (auto const &p : set.slicePoints) {
+      std::size_t const segIndex = isFirstIndex ? p.intr.sIndex1 : p.intr.sIndex2;
+      std::size_t const otherLoopIndex = isFirstIndex ? set.loopIndex2 : set.loopIndex1;
+      m_loopDissectionPoints.push_back(
+          {segIndex, distSquared(p.intr.pos, pline[segIndex].pos()), otherLoopIndex, p.intr.pos});
     }
   }
 
-  // sort points by distance from start vertex
-  for (auto &kvp : m_loopDissectionPoints) {
-    Vector2<Real> startPos = pline[kvp.first].pos();
-    auto cmp = [&](DissectionPoint const &p1, DissectionPoint const &p2) {
-      return distSquared(p1.pos, startPos) < distSquared(p2.pos, startPos);
-    };
-    std::sort(kvp.second.begin(), kvp.second.end(), cmp);
-  }
-
-  for (auto const &kvp : m_loopDissectionPoints) {
+  // sort points by segment index then distance from segment start vertex
+  std::sort(m_loopDissectionPoints.begin(), m_loopDissectionPoints.end(),
+            [](DissectionPoint const &p1, DissectionPoint const &p2) {
+              if (p1.segIndex != p2.segIndex) {
+                return p1.segIndex < p2.segIndex;
+              }
+              return p1.distSq < p2.distSq;
+            });
+
+  // walk each run of points sharing a segment index, the run that follows (wrapping around) holds
+  // the next intersect along the loop
+  std::size_t const pointCount = m_loopDissectionPoints.size();
+  std::size_t runStart = 0;
+  while (runStart < pointCount) {
     // start index for the slice we're about to build
-    std::size_t sIndex = kvp.first;
-    // self intersect list for this start index
-    std::vector<DissectionPoint> const &intrsList = kvp.second;
+    std::size_t const sIndex = m_loopDissectionPoints[runStart].segIndex;
+    std::size_t runEnd = runStart + 1;
+    while (runEnd < pointCount && m_loopDissectionPoints[runEnd].segIndex == sIndex) {
+      ++runEnd;
+    }
+    DissectionPoint const &nextRunFirst = m_loopDissectionPoints[runEnd == pointCount ? 0 : runEnd];
+    DissectionPoint const &runLast = m_loopDissectionPoints[runEnd - 1];
 
     const auto &firstSegStartVertex = pline[sIndex];
     std::size_t nextIndex = utils::nextWrappingIndex(sIndex, pline);
     const auto &firstSegEndVertex = pline[nextIndex];
 
-    if (intrsList.size() != 1) {
-      // build all the segments between the N intersects in siList (N > 1), skipping the first
-      // segment (to be processed at the end)
+    if (runEnd - runStart != 1) {
+      // build all the segments between the N intersects on this segment (N > 1), skipping the
+      // first segment (to be processed at the end)
       SplitResult<Real> firstSplit =
-          splitAtPoint(firstSegStartVertex, firstSegEndVertex, intrsList[0].pos);
+          splitAtPoint(firstSegStartVertex, firstSegEndVertex,
+                       m_loopDissectionPoints[runStart].pos, m_epsilon.realPrecision);
       auto prevVertex = firstSplit.splitVertex;
-      for (std::size_t i = 1; i < intrsList.size(); ++i) {
-        std::size_t const sliceStartIndex = intrsList[i - 1].otherLoopIndex;
-        std::size_t const sliceEndIndex = intrsList[i].otherLoopIndex;
-        SplitResult<Real> split = splitAtPoint(prevVertex, firstSegEndVertex, intrsList[i].pos);
+      for (std::size_t i = runStart + 1; i < runEnd; ++i) {
+        std::size_t const sliceStartIndex = m_loopDissectionPoints[i - 1].otherLoopIndex;
+        std::size_t const sliceEndIndex = m_loopDissectionPoints[i].otherLoopIndex;
+        SplitResult<Real> split =
+            splitAtPoint(prevVertex, firstSegEndVertex, m_loopDissectionPoints[i].pos,
+                         m_epsilon.realPrecision);
         // update prevVertex for next loop iteration
         prevVertex = split.splitVertex;
 
         if (fuzzyEqual(split.updatedStart.pos(), split.splitVertex.pos(),
-                       utils::realPrecision<Real>())) {
-          continue;
-        }
-
-        auto sMidpoint = segMidpoint(split.updatedStart, split.splitVertex);
-        if (!pointOnOffsetValid(parentIndex, sMidpoint, absDelta)) {
-          // skip slice
+                       m_epsilon.realPrecision)) {
           continue;
         }
 
-        result.emplace_back();
-        result.back().pline.addVertex(split.updatedStart);
-        result.back().pline.addVertex(split.splitVertex);
-        result.back().sliceParentIndex = loopIndex;
-        result.back().startLoopIndex = sliceStartIndex;
-        result.back().endLoopIndex = sliceEndIndex;
+        result.push_back({loopIndex, sliceStartIndex, sliceEndIndex, sIndex, sIndex, true,
+                          split.updatedStart, split.splitVertex});
       }
     }
 
-    // build the segment between the last intersect in instrsList and the next intersect found
-    SplitResult<Real> split =
-        splitAtPoint(firstSegStartVertex, firstSegEndVertex, intrsList.back().pos);
-
-    DissectedSlice currSlice;
-    currSlice.pline.addVertex(split.splitVertex);
-    currSlice.sliceParentIndex = loopIndex;
-    currSlice.startLoopIndex = intrsList.back().otherLoopIndex;
-
-    std::size_t index = nextIndex;
-    std::size_t loopCount = 0;
-    const std::size_t maxLoopCount = pline.size();
-    while (true) {
-      if (loopCount++ > maxLoopCount) {
-        CAVC_ASSERT(false, "Bug detected, should never loop this many times!");
-        // break to avoid infinite loop
-        break;
-      }
-      // add vertex
-      internal::addOrReplaceIfSamePos(currSlice.pline, pline[index]);
-
-      // check if segment that starts at vertex we just added has an intersect
-      auto nextIntr = m_loopDissectionPoints.find(index);
-      if (nextIntr != m_loopDissectionPoints.end()) {
-        // there is an intersect, slice is done
-        Vector2<Real> const &intersectPos = nextIntr->second[0].pos;
-
-        // trim last added vertex and add final intersect position
-        PlineVertex<Real> endVertex = PlineVertex<Real>(intersectPos, Real(0));
-        std::size_t l_nextIndex = utils::nextWrappingIndex(index, pline);
-        SplitResult<Real> l_split =
-            splitAtPoint(currSlice.pline.lastVertex(), pline[l_nextIndex], intersectPos);
-        currSlice.pline.lastVertex() = l_split.updatedStart;
-        internal::addOrReplaceIfSamePos(currSlice.pline, endVertex);
-        currSlice.endLoopIndex = nextIntr->second[0].otherLoopIndex;
+    SplitResult<Real> split = splitAtPoint(firstSegStartVertex, firstSegEndVertex, runLast.pos,
+                                           m_epsilon.realPrecision);
+
+    // slice from the last intersect on this segment along the loop to the next intersect found,
+    // slices that collapse to a point are dropped when validated
+    result.push_back({loopIndex, runLast.otherLoopIndex, nextRunFirst.otherLoopIndex, sIndex,
+                      nextRunFirst.segIndex, false, split.splitVertex,
+                      PlineVertex<Real>(nextRunFirst.pos, Real(0))});
+
+    runStart = runEnd;
+  }
+}
+
+template <typename Real>
+void ParallelOffsetIslands<Real>::validateSlices(std::vector<DissectedSlice> const &slices,
+                                                 Real absDelta) {
+  CAVC_TRACE_SCOPE("ParallelOffsetIslands::validateSlices");
+  // minimum number of slices given to each worker
+  constexpr std::size_t minSlicesPerWorker = 8;
+  std::size_t const workerCount =
+      internal::parallelWorkerCount(slices.size(), minSlicesPerWorker, m_maxThreads);
+  if (m_workerQueryStacks.size() < workerCount) {
+    m_workerQueryStacks.resize(workerCount);
+    m_workerSliceScratch.resize(workerCount);
+  }
+
+  m_sliceValid.assign(slices.size(), 0);
+  internal::parallelFor<Real>(slices.size(), workerCount, [&](std::size_t i, std::size_t worker) {
+    bool const valid =
+        sliceValid(slices[i], absDelta, m_workerSliceScratch[worker], m_workerQueryStacks[worker]);
+    m_sliceValid[i] = valid ? 1 : 0;
+  });
+}
+
+template <typename Real>
+OffsetLoopSet<Real> ParallelOffsetIslands<Real>::compute(const OffsetLoopSet<Real> &input,
+                                                         Real offsetDelta) {
+  return compute(input, offsetDelta, utils::currentEpsilonConfig<Real>());
+}
+
+template <typename Real>
+OffsetLoopSet<Real>
+ParallelOffsetIslands<Real>::compute(const OffsetLoopSet<Real> &input, Real offsetDelta,
+                                     utils::EpsilonConfig<Real> const &eps) {
+  m_epsilon = eps;
+  OffsetLoopSet<Real> result;
+  computeInto(input, offsetDelta, result);
+  return result;
+}
+
+template <typename Real>
+template <typename StepSink>
+std::size_t ParallelOffsetIslands<Real>::computeSteps(OffsetLoopSet<Real> const &input,
+                                                      Real offsetDelta, std::size_t stepCount,
+                                                      StepSink &&sink) {
+  // tolerances are read once for all steps
+  m_epsilon = utils::currentEpsilonConfig<Real>();
+  // ping pong between two sets, the previous step's result (with its spatial indexes) is the input
+  // for the next step
+  OffsetLoopSet<Real> sets[2];
+  OffsetLoopSet<Real> const *stepInput = &input;
+  std::size_t stepIndex = 0;
+  while (stepIndex < stepCount) {
+    OffsetLoopSet<Real> &stepResult = sets[stepIndex % 2];
+    computeInto(*stepInput, offsetDelta, stepResult);
+    stepIndex += 1;
+
+    if constexpr (std::is_same_v<std::invoke_result_t<StepSink &, std::size_t,
+                                                      OffsetLoopSet<Real> const &>,
+                                 bool>) {
+      if (!sink(stepIndex - 1, static_cast<OffsetLoopSet<Real> const &>(stepResult))) {
         break;
       }
-      // else there is not an intersect, increment index and continue
-      index = utils::nextWrappingIndex(index, pline);
+    } else {
+      sink(stepIndex - 1, static_cast<OffsetLoopSet<Real> const &>(stepResult));
     }
 
-    if (currSlice.pline.size() > 1) {
-      if (!sliceMidpointsValid(currSlice.pline)) {
-        // skip slice
-        continue;
-      }
-      result.push_back(std::move(currSlice));
+    if (stepResult.ccwLoops.size() == 0 && stepResult.cwLoops.size() == 0) {
+      break;
     }
+
+    stepInput = &stepResult;
   }
+
+  return stepIndex;
 }
 
 template <typename Real>
-OffsetLoopSet<Real> ParallelOffsetIslands<Real>::compute(const OffsetLoopSet<Real> &input,
-                                                         Real offsetDelta) {
+void ParallelOffsetIslands<Real>::computeInto(OffsetLoopSet<Real> const &input, Real offsetDelta,
+                                              OffsetLoopSet<Real> &result) {
+  CAVC_TRACE_SCOPE("ParallelOffsetIslands::compute");
+  CAVC_ASSERT(&input != &result, "input and result must be different sets");
+  utils::ScopedEpsilonContext<Real> epsContext(m_epsilon);
   m_inputSet = &input;
-  OffsetLoopSet<Real> result;
+  // clear rather than replace so loop vector capacity is reused
+  result.ccwLoops.clear();
+  result.cwLoops.clear();
   Real absDelta = std::abs(offsetDelta);
   createOffsetLoops(input, absDelta);
-  if (totalOffsetLoopsCount() == 0) {
-    return result;
+  if (totalOffsetLoopsCount() == 0 || internal::cancellationRequested()) {
+    return;
   }
 
   createOffsetLoopsIndex();
   createSlicePoints();
+  if (internal::cancellationRequested()) {
+    return;
+  }
 
-  std::vector<DissectedSlice> slices;
   std::size_t totalOffsetsCount = totalOffsetLoopsCount();
-  slices.reserve(totalOffsetsCount * 2);
-
-  std::vector<Polyline<Real>> resultSlices;
-  resultSlices.reserve(totalOffsetsCount * 2);
+  m_dissectedSlices.clear();
+  m_dissectedSlices.reserve(totalOffsetsCount * 2);
 
   for (std::size_t i = 0; i < totalOffsetsCount; ++i) {
     if (m_slicePointsLookup[i].size() == 0) {
       // no intersects but still must test distance of one vertex position since it may be inside
       // another offset (completely eclipsed by island offset)
       auto &loop = getOffsetLoop(i);
-      if (!pointOnOffsetValid(loop.parentLoopIndex, loop.polyline[0].pos(), absDelta)) {
+      if (!pointOnOffsetValid(loop.parentLoopIndex, loop.polyline[0].pos(), absDelta,
+                              m_queryStack)) {
         continue;
       }
       if (i < m_ccwOffsetLoops.size()) {
@@ -600,22 +834,44 @@ OffsetLoopSet<Real> ParallelOffsetIslands<Real>::compute(const OffsetLoopSet<Rea
       }
       continue;
     }
-    createSlicesFromLoop(i, absDelta, slices);
+    createSlicesFromLoop(i, m_dissectedSlices);
   }
 
-  for (auto &slice : slices) {
-    resultSlices.push_back(std::move(slice.pline));
+  // slices are independent of each other, validate them all at once
+  validateSlices(m_dissectedSlices, absDelta);
+  if (internal::cancellationRequested()) {
+    result.ccwLoops.clear();
+    result.cwLoops.clear();
+    return;
+  }
+  // only valid slices are built into polylines (resize keeps the vertex storage of slices built
+  // by previous calls)
+  std::size_t const validCount =
+      static_cast<std::size_t>(std::count(m_sliceValid.begin(), m_sliceValid.end(), char(1)));
+  m_validSlices.resize(validCount);
+  std::size_t validIndex = 0;
+  for (std::size_t i = 0; i < m_dissectedSlices.size(); ++i) {
+    if (m_sliceValid[i]) {
+      buildSlice(m_dissectedSlices[i], m_validSlices[validIndex++],
+                 std::numeric_limits<std::size_t>::max());
+    }
   }
 
   std::vector<Polyline<Real>> stitched =
-      internal::stitchOrderedSlicesIntoClosedPolylines(resultSlices);
+      internal::stitchOrderedSlicesIntoClosedPolylines(m_validSlices);
+  if (internal::cancellationStopped()) {
+    // stitching stopped part way
+    result.ccwLoops.clear();
+    result.cwLoops.clear();
+    return;
+  }
   result.ccwLoops.reserve(result.ccwLoops.size() + stitched.size());
   result.cwLoops.reserve(result.cwLoops.size() + stitched.size());
 
-  std::vector<Polyline<Real>> stitchedCcwLoops;
-  std::vector<Polyline<Real>> stitchedCwLoops;
-  stitchedCcwLoops.reserve(stitched.size());
-  stitchedCwLoops.reserve(stitched.size());
+  m_stitchedCcwLoops.clear();
+  m_stitchedCwLoops.clear();
+  m_stitchedCcwLoops.reserve(stitched.size());
+  m_stitchedCwLoops.reserve(stitched.size());
 
   for (auto &r : stitched) {
     Real area = getArea(r);
@@ -623,9 +879,9 @@ OffsetLoopSet<Real> ParallelOffsetIslands<Real>::compute(const OffsetLoopSet<Rea
       continue;
     }
     if (area < Real(0)) {
-      stitchedCwLoops.push_back(std::move(r));
+      m_stitchedCwLoops.push_back(std::move(r));
     } else {
-      stitchedCcwLoops.push_back(std::move(r));
+      m_stitchedCcwLoops.push_back(std::move(r));
     }
   }
 
@@ -644,11 +900,10 @@ OffsetLoopSet<Real> ParallelOffsetIslands<Real>::compute(const OffsetLoopSet<Rea
     }
   };
 
-  appendStitchedWithBatchIndex(stitchedCcwLoops, result.ccwLoops);
-  appendStitchedWithBatchIndex(stitchedCwLoops, result.cwLoops);
+  appendStitchedWithBatchIndex(m_stitchedCcwLoops, result.ccwLoops);
+  appendStitchedWithBatchIndex(m_stitchedCwLoops, result.cwLoops);
 
   sortOffsetLoopSetStable(result);
-  return result;
 }
 
 } // namespace cavc
@@ -0,0 +1,214 @@
+#ifndef CAVC_PREDICATES_HPP
+#define CAVC_PREDICATES_HPP
+#include "stats.hpp"
+#include "vector.hpp"
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+// Adaptive precision orientation and line distance predicates (floating point filter with an exact
+// fallback, see Shewchuk, "Adaptive Precision Floating-Point Arithmetic and Fast Robust Geometric
+// Predicates"). The value is first evaluated in plain floating point, its sign is returned as is
+// when the rounding error bound proves it correct (the common case), otherwise it is recomputed
+// exactly from the input coordinates as a floating point expansion. Assumes binary floating point
+// Real with round to nearest and no overflow or underflow in the products.
+
+namespace cavc {
+namespace internal {
+/// Exact sum a + b = x + y with x = fl(a + b).
+template <typename Real> void twoSum(Real a, Real b, Real &x, Real &y) {
+  x = a + b;
+  Real const bVirtual = x - a;
+  Real const aVirtual = x - bVirtual;
+  y = (a - aVirtual) + (b - bVirtual);
+}
+
+/// Exact product a * b = x + y with x = fl(a * b).
+template <typename Real> void twoProduct(Real a, Real b, Real &x, Real &y) {
+  x = a * b;
+  y = std::fma(a, b, -x);
+}
+
+/// Adds value to the nonoverlapping expansion components[0, count) (increasing magnitude, zero
+/// components eliminated), the caller provides capacity for one more component.
+template <typename Real> void growExpansion(Real *components, std::size_t &count, Real value) {
+  Real q = value;
+  std::size_t nextCount = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    Real sum;
+    Real err;
+    twoSum(q, components[i], sum, err);
+    q = sum;
+    if (err != Real(0)) {
+      components[nextCount++] = err;
+    }
+  }
+  if (q != Real(0)) {
+    components[nextCount++] = q;
+  }
+  count = nextCount;
+}
+
+/// Orientation determinant of (p0, p1, point) computed exactly as a nonoverlapping expansion in
+/// components, returns the component count.
+template <typename Real>
+std::size_t orient2dExpansion(Vector<Real, 2> const &p0, Vector<Real, 2> const &p1,
+                              Vector<Real, 2> const &point, std::array<Real, 12> &components) {
+  // (p1x - p0x)(py - p0y) - (p1y - p0y)(px - p0x) expanded into six products of input coordinates
+  // so no rounded differences are involved
+  Real const products[6][2] = {{p1.x(), point.y()},  {-p1.x(), p0.y()}, {-p0.x(), point.y()},
+                               {-p1.y(), point.x()}, {p1.y(), p0.x()},  {p0.y(), point.x()}};
+
+  std::size_t count = 0;
+  for (auto const &product : products) {
+    Real x;
+    Real y;
+    twoProduct(product[0], product[1], x, y);
+    growExpansion(components.data(), count, y);
+    growExpansion(components.data(), count, x);
+  }
+
+  return count;
+}
+
+/// Orientation determinant of (p0, p1, point) computed exactly, returns the most significant
+/// component of the exact expansion (so the sign is exact and the magnitude approximate).
+template <typename Real>
+Real orient2dExact(Vector<Real, 2> const &p0, Vector<Real, 2> const &p1,
+                   Vector<Real, 2> const &point) {
+  std::array<Real, 12> expansion;
+  std::size_t const count = orient2dExpansion(p0, p1, point, expansion);
+  return count == 0 ? Real(0) : expansion[count - 1];
+}
+
+/// Sign of det^2 - distance^2 * |p1 - p0|^2 computed exactly, det is the orientation determinant
+/// of (p0, p1, point).
+template <typename Real>
+int compareLineDistanceExact(Vector<Real, 2> const &p0, Vector<Real, 2> const &p1,
+                             Vector<Real, 2> const &point, Real distance) {
+  std::array<Real, 12> det;
+  std::size_t const detCount = orient2dExpansion(p0, p1, point, det);
+  Real dx[2];
+  Real dy[2];
+  twoSum(p1.x(), -p0.x(), dx[1], dx[0]);
+  twoSum(p1.y(), -p0.y(), dy[1], dy[0]);
+  Real distanceSquared[2];
+  twoProduct(distance, distance, distanceSquared[1], distanceSquared[0]);
+
+  // every partial product is added to one expansion: 2 * 12 * 12 for det^2 and 2 * 2 * 2 * 2 * 2
+  // for each of the delta terms
+  std::array<Real, 2 * 12 * 12 + 2 * 32 + 1> expansion;
+  std::size_t count = 0;
+  auto addProduct = [&](Real a, Real b) {
+    Real x;
+    Real y;
+    twoProduct(a, b, x, y);
+    growExpansion(expansion.data(), count, y);
+    growExpansion(expansion.data(), count, x);
+  };
+
+  for (std::size_t i = 0; i < detCount; ++i) {
+    for (std::size_t j = 0; j < detCount; ++j) {
+      addProduct(det[i], det[j]);
+    }
+  }
+
+  for (Real const *delta : {dx, dy}) {
+    for (Real const ds : distanceSquared) {
+      for (std::size_t i = 0; i < 2; ++i) {
+        Real x;
+        Real y;
+        twoProduct(-ds, delta[i], x, y);
+        for (std::size_t j = 0; j < 2; ++j) {
+          addProduct(x, delta[j]);
+          addProduct(y, delta[j]);
+        }
+      }
+    }
+  }
+
+  if (count == 0) {
+    return 0;
+  }
+  return expansion[count - 1] > Real(0) ? 1 : -1;
+}
+} // namespace internal
+
+/// Orientation determinant of (p0, p1, point), twice the signed area of the triangle: positive if
+/// point is left of the line pointing in the direction of (p1 - p0), negative if right and zero if
+/// the three points are collinear. The sign is always exact, the value returned is the plain
+/// floating point determinant when the error filter certifies its sign, otherwise an approximation
+/// of the exact determinant (counted by the orientationExactFallbacks stat).
+template <typename Real>
+Real orient2d(Vector<Real, 2> const &p0, Vector<Real, 2> const &p1, Vector<Real, 2> const &point) {
+  CAVC_STATS_INC(orientationPredicateCalls);
+  Real const detLeft = (p1.x() - p0.x()) * (point.y() - p0.y());
+  Real const detRight = (p1.y() - p0.y()) * (point.x() - p0.x());
+  Real const det = detLeft - detRight;
+
+  Real detSum;
+  if (detLeft > Real(0)) {
+    if (detRight <= Real(0)) {
+      return det;
+    }
+    detSum = detLeft + detRight;
+  } else if (detLeft < Real(0)) {
+    if (detRight >= Real(0)) {
+      return det;
+    }
+    detSum = -detLeft - detRight;
+  } else {
+    return det;
+  }
+
+  // error bound for the filtered determinant (Shewchuk's ccwerrboundA)
+  constexpr Real u = std::numeric_limits<Real>::epsilon() / Real(2);
+  constexpr Real errorBoundFactor = (Real(3) + Real(16) * u) * u;
+  if (det >= errorBoundFactor * detSum || -det >= errorBoundFactor * detSum) {
+    return det;
+  }
+
+  CAVC_STATS_INC(orientationExactFallbacks);
+  return internal::orient2dExact(p0, p1, point);
+}
+
+/// Compares the distance from point to the line through p0 and p1 (p0 != p1) with distance >= 0,
+/// returns 1 if point is farther from the line, -1 if closer and 0 if exactly at the distance.
+/// Evaluated with the same floating point filter and exact fallback as orient2d, the comparison is
+/// made on det^2 against distance^2 * |p1 - p0|^2 (det the orientation determinant) so it is exact
+/// for the given inputs as long as the squared terms do not underflow (counted by the
+/// lineDistanceExactFallbacks stat when the filter cannot certify it).
+template <typename Real>
+int compareLineDistance(Vector<Real, 2> const &p0, Vector<Real, 2> const &p1,
+                        Vector<Real, 2> const &point, Real distance) {
+  CAVC_STATS_INC(lineDistanceComparisons);
+  Real const dx = p1.x() - p0.x();
+  Real const dy = p1.y() - p0.y();
+  Real const detLeft = dx * (point.y() - p0.y());
+  Real const detRight = dy * (point.x() - p0.x());
+  Real const det = detLeft - detRight;
+  Real const rhs = distance * distance * (dx * dx + dy * dy);
+
+  // det is within errorBoundFactor * (|detLeft| + |detRight|) of the exact determinant (see
+  // orient2d), the remaining roundings (deltas, squares, products and sum) are covered by a
+  // relative slack on both sides
+  constexpr Real u = std::numeric_limits<Real>::epsilon() / Real(2);
+  constexpr Real errorBoundFactor = (Real(3) + Real(16) * u) * u;
+  constexpr Real slack = Real(16) * u;
+  Real const detError = errorBoundFactor * (std::abs(detLeft) + std::abs(detRight));
+  Real const absDet = std::abs(det);
+  Real const detLow = absDet > detError ? absDet - detError : Real(0);
+  Real const detHigh = absDet + detError;
+  if (detLow * detLow * (Real(1) - slack) > rhs * (Real(1) + slack)) {
+    return 1;
+  }
+  if (detHigh * detHigh * (Real(1) + slack) < rhs * (Real(1) - slack)) {
+    return -1;
+  }
+  CAVC_STATS_INC(lineDistanceExactFallbacks);
+  return internal::compareLineDistanceExact(p0, p1, point, distance);
+}
+} // namespace cavc
+
+#endif // CAVC_PREDICATES_HPP
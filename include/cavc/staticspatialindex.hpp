@@ -1,6 +1,7 @@
 #ifndef CAVC_STATICSPATIALINDEX_HPP
 #define CAVC_STATICSPATIALINDEX_HPP
 #include "internal/common.hpp"
+#include "stats.hpp"
 #include <algorithm>
 #include <cmath>
 #include <limits>
@@ -11,8 +12,15 @@ namespace cavc {
 template <typename Real, std::size_t NodeSize = 16> class StaticSpatialIndex {
 public:
   StaticSpatialIndex(std::size_t numItems) {
-    CAVC_ASSERT(numItems > 0, "number of items must be greater than 0");
     static_assert(NodeSize >= 2 && NodeSize <= 65535, "node size must be between 2 and 65535");
+    reset(numItems);
+  }
+
+  /// Discard all items and size the index for numItems new items (add and finish them as after
+  /// construction). Existing storage is reused when it is large enough so an index rebuilt many
+  /// times (e.g. once per offset step) does not reallocate.
+  void reset(std::size_t numItems) {
+    CAVC_ASSERT(numItems > 0, "number of items must be greater than 0");
     // calculate the total number of nodes in the R-tree to allocate space for
     // and the index of each tree level (used in search later)
     m_numItems = numItems;
@@ -20,7 +28,10 @@ public:
     std::size_t numNodes = numItems;
 
     m_numLevels = computeNumLevels(numItems);
-    m_levelBounds = std::unique_ptr<std::size_t[]>(new std::size_t[m_numLevels]);
+    if (m_numLevels > m_levelBoundsCapacity) {
+      m_levelBounds = std::unique_ptr<std::size_t[]>(new std::size_t[m_numLevels]);
+      m_levelBoundsCapacity = m_numLevels;
+    }
     m_levelBounds[0] = n * 4;
     // now populate level bounds and numNodes
     std::size_t i = 1;
@@ -32,8 +43,11 @@ public:
     } while (n != 1);
 
     m_numNodes = numNodes;
-    m_boxes = std::unique_ptr<Real[]>(new Real[numNodes * 4]);
-    m_indices = std::unique_ptr<std::size_t[]>(new std::size_t[numNodes]);
+    if (numNodes > m_nodesCapacity) {
+      m_boxes = std::unique_ptr<Real[]>(new Real[numNodes * 4]);
+      m_indices = std::unique_ptr<std::size_t[]>(new std::size_t[numNodes]);
+      m_nodesCapacity = numNodes;
+    }
     m_pos = 0;
     m_minX = std::numeric_limits<Real>::infinity();
     m_minY = std::numeric_limits<Real>::infinity();
@@ -41,6 +55,22 @@ public:
     m_maxY = -std::numeric_limits<Real>::infinity();
   }
 
+  /// Bytes of heap memory held by the index (level bounds, boxes and indices arrays), not
+  /// including sizeof(StaticSpatialIndex).
+  std::size_t memoryUsage() const {
+    std::size_t result = 0;
+    if (m_levelBounds) {
+      result += m_levelBoundsCapacity * sizeof(std::size_t);
+    }
+    if (m_boxes) {
+      result += m_nodesCapacity * 4 * sizeof(Real);
+    }
+    if (m_indices) {
+      result += m_nodesCapacity * sizeof(std::size_t);
+    }
+    return result;
+  }
+
   Real minX() const { return m_minX; }
   Real minY() const { return m_minY; }
   Real maxX() const { return m_maxX; }
@@ -260,6 +290,8 @@ public:
     while (!done) {
       // find the end index of the node
       auto end = std::min(nodeIndex + NodeSize * 4, m_levelBounds[level]);
+      CAVC_STATS_INC(spatialIndexNodesVisited);
+      CAVC_STATS_ADD(spatialIndexBoxesTested, (end - nodeIndex) / 4);
 
       // search through child nodes
       for (std::size_t pos = nodeIndex; pos < end; pos += 4) {
@@ -358,9 +390,12 @@ private:
   std::size_t m_numLevels;
   // using std::unique_ptr arrays for uninitialized memory optimization
   std::unique_ptr<std::size_t[]> m_levelBounds;
+  std::size_t m_levelBoundsCapacity = 0;
   std::size_t m_numNodes;
   std::unique_ptr<Real[]> m_boxes;
   std::unique_ptr<std::size_t[]> m_indices;
+  // number of nodes m_boxes and m_indices have space for (may exceed m_numNodes after reset)
+  std::size_t m_nodesCapacity = 0;
   std::size_t m_pos;
 
   static std::size_t computeNumLevels(std::size_t numItems) {
@@ -0,0 +1,83 @@
+#ifndef CAVC_STATS_HPP
+#define CAVC_STATS_HPP
+#include <cstdint>
+
+// Hot path instrumentation counters. Counting is compiled in only when CAVC_ENABLE_STATS is
+// defined (CMake option CAVC_ENABLE_STATS), otherwise the counting macros expand to nothing and
+// statsSnapshot() always returns zeroed counters.
+//
+// Counters are thread local, work done on other threads (e.g. ParallelOffsetIslands worker
+// threads) is counted on those threads, use maxThreads = 1 to attribute all work to the calling
+// thread.
+
+namespace cavc {
+/// Counter values for the current thread, see statsSnapshot().
+struct Stats {
+  /// Spatial index nodes visited by visitQuery (including leaf level nodes).
+  std::uint64_t spatialIndexNodesVisited = 0;
+  /// Child bounding boxes tested against the query box by visitQuery.
+  std::uint64_t spatialIndexBoxesTested = 0;
+  /// intrPlineSegs calls by segment type pair (first segment, second segment).
+  std::uint64_t intrLineLineCalls = 0;
+  std::uint64_t intrLineArcCalls = 0;
+  std::uint64_t intrArcLineCalls = 0;
+  std::uint64_t intrArcArcCalls = 0;
+  /// pointValidForOffset calls (offset and offset islands slice validation).
+  std::uint64_t pointValidForOffsetCalls = 0;
+  /// Scalar utils::fuzzyEqual calls (vector fuzzyEqual counts once per component).
+  std::uint64_t fuzzyEqualCalls = 0;
+  /// Vertexes appended while stitching slices into result polylines.
+  std::uint64_t stitchVertexesAppended = 0;
+  /// parallelOffset calls by the path that produced the result: primary stitched slices,
+  /// collapsed line loops, simple loop rescue (slice graph search), closed loops allowing endpoint
+  /// touches, relaxed slice recovery, or no result (including cancelled calls).
+  std::uint64_t offsetStitchedResults = 0;
+  std::uint64_t offsetCollapsedLineResults = 0;
+  std::uint64_t offsetLoopRescueResults = 0;
+  std::uint64_t offsetEndpointTouchResults = 0;
+  std::uint64_t offsetRelaxedRecoveryResults = 0;
+  std::uint64_t offsetEmptyResults = 0;
+  /// Raw offset intersect contexts built (spatial indexes, self and dual intersects), one per
+  /// parallelOffset call that slices its raw offset, reused by the relaxed recovery passes.
+  std::uint64_t offsetIntersectContexts = 0;
+  /// orient2d evaluations (isLeft and isLeftOrEqual) and how many of them the floating point error
+  /// filter could not certify, falling back to the exact determinant.
+  std::uint64_t orientationPredicateCalls = 0;
+  std::uint64_t orientationExactFallbacks = 0;
+  /// compareLineDistance evaluations (intrLineSeg2Circle2 miss/tangent/secant classification) and
+  /// how many of them fell back to the exact comparison.
+  std::uint64_t lineDistanceComparisons = 0;
+  std::uint64_t lineDistanceExactFallbacks = 0;
+};
+
+/// True if the library was compiled with CAVC_ENABLE_STATS.
+#ifdef CAVC_ENABLE_STATS
+inline constexpr bool statsEnabled = true;
+#else
+inline constexpr bool statsEnabled = false;
+#endif
+
+namespace internal {
+inline Stats &threadStats() {
+  thread_local Stats stats;
+  return stats;
+}
+} // namespace internal
+
+/// Returns a copy of the current thread's counters.
+inline Stats statsSnapshot() { return internal::threadStats(); }
+
+/// Resets the current thread's counters to zero.
+inline void resetStats() { internal::threadStats() = Stats(); }
+} // namespace cavc
+
+#ifdef CAVC_ENABLE_STATS
+#define CAVC_STATS_ADD(counter, count)                                                             \
+  (::cavc::internal::threadStats().counter += static_cast<std::uint64_t>(count))
+#else
+#define CAVC_STATS_ADD(counter, count) ((void)0)
+#endif
+
+#define CAVC_STATS_INC(counter) CAVC_STATS_ADD(counter, 1)
+
+#endif // CAVC_STATS_HPP
@@ -0,0 +1,175 @@
+#ifndef CAVC_TRACING_HPP
+#define CAVC_TRACING_HPP
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <ostream>
+
+// Phase level tracing. Scopes (CAVC_TRACE_SCOPE) around the offset, offset islands and combine
+// phases record their start time, duration and thread to the installed TraceSink. Tracing is
+// compiled in only when CAVC_ENABLE_TRACING is defined (CMake option CAVC_ENABLE_TRACING),
+// otherwise the scope macro expands to nothing. When compiled in but no sink is installed each
+// scope costs one atomic load.
+//
+// The sink is process wide (not thread local) so phases running on worker threads (e.g.
+// ParallelOffsetIslands slice point and validation workers) are recorded with their own thread
+// id. ChromeTraceWriter writes the events as Chrome/Perfetto trace-event JSON (load the output in
+// chrome://tracing or ui.perfetto.dev).
+
+namespace cavc {
+/// One completed trace scope.
+struct TraceEvent {
+  /// Scope name (string literal).
+  char const *name;
+  /// Start time in microseconds since the first trace event of the process.
+  double startUs;
+  /// Duration in microseconds.
+  double durationUs;
+  /// Small sequential id of the thread that ran the scope (1 for the first traced thread).
+  std::uint32_t threadId;
+};
+
+/// Receives trace events, addEvent may be called concurrently from multiple threads.
+class TraceSink {
+public:
+  virtual ~TraceSink() = default;
+  virtual void addEvent(TraceEvent const &event) = 0;
+};
+
+/// True if the library was compiled with CAVC_ENABLE_TRACING.
+#ifdef CAVC_ENABLE_TRACING
+inline constexpr bool tracingEnabled = true;
+#else
+inline constexpr bool tracingEnabled = false;
+#endif
+
+namespace internal {
+inline std::atomic<TraceSink *> &traceSinkSlot() {
+  static std::atomic<TraceSink *> sink{nullptr};
+  return sink;
+}
+
+inline std::chrono::steady_clock::time_point traceEpoch() {
+  static std::chrono::steady_clock::time_point const epoch = std::chrono::steady_clock::now();
+  return epoch;
+}
+
+inline std::uint32_t traceThreadId() {
+  static std::atomic<std::uint32_t> nextId{1};
+  thread_local std::uint32_t const id = nextId.fetch_add(1, std::memory_order_relaxed);
+  return id;
+}
+
+/// RAII scope reporting its duration to the trace sink installed when the scope started.
+class TraceScope {
+public:
+  explicit TraceScope(char const *name)
+      : m_name(name), m_sink(traceSinkSlot().load(std::memory_order_acquire)) {
+    if (m_sink) {
+      m_start = std::chrono::steady_clock::now();
+    }
+  }
+
+  TraceScope(TraceScope const &) = delete;
+  TraceScope &operator=(TraceScope const &) = delete;
+
+  ~TraceScope() {
+    if (!m_sink) {
+      return;
+    }
+    auto const end = std::chrono::steady_clock::now();
+    using us = std::chrono::duration<double, std::micro>;
+    m_sink->addEvent({m_name, us(m_start - traceEpoch()).count(), us(end - m_start).count(),
+                      traceThreadId()});
+  }
+
+private:
+  char const *m_name;
+  TraceSink *m_sink;
+  std::chrono::steady_clock::time_point m_start;
+};
+} // namespace internal
+
+/// Installs sink as the process wide trace sink (null to stop tracing), returns the previous sink.
+/// The sink must outlive all scopes started while it is installed.
+inline TraceSink *setTraceSink(TraceSink *sink) {
+  // fix the time base before the first event
+  internal::traceEpoch();
+  return internal::traceSinkSlot().exchange(sink, std::memory_order_acq_rel);
+}
+
+/// Returns the installed trace sink (null if none).
+inline TraceSink *traceSink() { return internal::traceSinkSlot().load(std::memory_order_acquire); }
+
+/// Installs a trace sink for the lifetime of the scope, restoring the previous sink after.
+class ScopedTraceSink {
+public:
+  explicit ScopedTraceSink(TraceSink &sink) : m_previous(setTraceSink(&sink)) {}
+  ScopedTraceSink(ScopedTraceSink const &) = delete;
+  ScopedTraceSink &operator=(ScopedTraceSink const &) = delete;
+  ~ScopedTraceSink() { setTraceSink(m_previous); }
+
+private:
+  TraceSink *m_previous;
+};
+
+/// Trace sink writing Chrome/Perfetto trace-event JSON (complete "X" events) to a stream. The JSON
+/// array is closed by finish() (or the destructor), the stream must outlive the writer.
+class ChromeTraceWriter : public TraceSink {
+public:
+  explicit ChromeTraceWriter(std::ostream &os) : m_os(os) { m_os << "{\"traceEvents\":["; }
+  ChromeTraceWriter(ChromeTraceWriter const &) = delete;
+  ChromeTraceWriter &operator=(ChromeTraceWriter const &) = delete;
+  ~ChromeTraceWriter() override { finish(); }
+
+  void addEvent(TraceEvent const &event) override {
+    char buffer[96];
+    std::snprintf(buffer, sizeof(buffer), "\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+                  event.startUs, event.durationUs, static_cast<unsigned>(event.threadId));
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_finished) {
+      return;
+    }
+    // names are string literals from the library, no escaping needed
+    m_os << (m_eventCount == 0 ? "\n" : ",\n") << "{\"name\":\"" << event.name
+         << "\",\"cat\":\"cavc\",\"ph\":\"X\"," << buffer;
+    ++m_eventCount;
+  }
+
+  /// Closes the JSON document, later events are ignored.
+  void finish() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_finished) {
+      return;
+    }
+    m_os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    m_os.flush();
+    m_finished = true;
+  }
+
+  std::size_t eventCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_eventCount;
+  }
+
+private:
+  std::ostream &m_os;
+  mutable std::mutex m_mutex;
+  std::size_t m_eventCount = 0;
+  bool m_finished = false;
+};
+} // namespace cavc
+
+#define CAVC_TRACE_CONCAT_IMPL(a, b) a##b
+#define CAVC_TRACE_CONCAT(a, b) CAVC_TRACE_CONCAT_IMPL(a, b)
+
+#ifdef CAVC_ENABLE_TRACING
+#define CAVC_TRACE_SCOPE(name)                                                                     \
+  ::cavc::internal::TraceScope CAVC_TRACE_CONCAT(cavcTraceScope, __LINE__)(name)
+#else
+#define CAVC_TRACE_SCOPE(name) ((void)0)
+#endif
+
+#endif // CAVC_TRACING_HPP
@@ -264,8 +264,9 @@ template <std::size_t N, typename Real> Real normalize(Vector<Real, N> &v) {
   return length;
 }
 
-template <std::size_t N, typename Real> Real safeNormalize(Vector<Real, N> &v) {
-  if (fuzzyZero(v, utils::realThreshold<Real>())) {
+template <std::size_t N, typename Real>
+Real safeNormalize(Vector<Real, N> &v, Real epsilon = utils::realThreshold<Real>()) {
+  if (fuzzyZero(v, epsilon)) {
     v.makeZero();
     return Real(0);
   }
@@ -1,8 +1,10 @@
 #ifndef CAVC_VECTOR2_HPP
 #define CAVC_VECTOR2_HPP
 #include "mathutils.hpp"
+#include "predicates.hpp"
 #include "vector.hpp"
 #include <cmath>
+#include <utility>
 
 namespace cavc {
 template <typename Real> using Vector2 = Vector<Real, 2>;
@@ -20,9 +22,10 @@ template <typename Real> Vector2<Real> unitPerp(Vector2<Real> const &v) {
 }
 
 /// Normalized perpendicular vector to v, or zero if v is too small to normalize robustly.
-template <typename Real> Vector2<Real> safeUnitPerp(Vector2<Real> const &v) {
+template <typename Real>
+Vector2<Real> safeUnitPerp(Vector2<Real> const &v, Real epsilon = utils::realThreshold<Real>()) {
   Vector2<Real> result{-v.y(), v.x()};
-  if (fuzzyZero(result, utils::realThreshold<Real>())) {
+  if (fuzzyZero(result, epsilon)) {
     return Vector2<Real>::zero();
   }
   normalize(result);
@@ -85,18 +88,17 @@ Vector2<Real> closestPointOnLineSeg(Vector2<Real> const &p0, Vector2<Real> const
   return p0 + b * v;
 }
 
-/// Returns true if point is left of the line pointing in the direction of the vector (p1 - p0).
+/// Returns true if point is left of the line pointing in the direction of the vector (p1 - p0), the
+/// orientation test is exact (see orient2d).
 template <typename Real>
 bool isLeft(Vector2<Real> const &p0, Vector2<Real> const &p1, Vector2<Real> const &point) {
-  return (p1.x() - p0.x()) * (point.y() - p0.y()) - (p1.y() - p0.y()) * (point.x() - p0.x()) >
-         Real(0);
+  return orient2d(p0, p1, point) > Real(0);
 }
 
 /// Same as isLeft but uses <= operator rather than < for boundary inclusion.
 template <typename Real>
 bool isLeftOrEqual(Vector2<Real> const &p0, Vector2<Real> const &p1, Vector2<Real> const &point) {
-  return (p1.x() - p0.x()) * (point.y() - p0.y()) - (p1.y() - p0.y()) * (point.x() - p0.x()) >=
-         Real(0);
+  return orient2d(p0, p1, point) >= Real(0);
 }
 
 /// Returns true if point is left or fuzzy coincident with the line pointing in the direction of the
@@ -118,24 +120,41 @@ bool isRightOrCoincident(Vector2<Real> const &p0, Vector2<Real> const &p1,
 }
 
 /// Test if a point is within a arc sweep angle region defined by center, start, end, and bulge.
+/// The point is within the sweep if the direction from the center to the point is between the
+/// directions to the start and end (counter clockwise for a positive bulge, clockwise for a negative
+/// bulge). epsilon is an angle tolerance in radians applied past the counter clockwise most end of
+/// the sweep only (the arc end for a positive bulge, the arc start for a negative bulge), the same
+/// one sided tolerance as utils::angleIsWithinSweep. Uses cross and dot products against the
+/// center to start and center to end vectors (no trigonometric functions), which is valid since a
+/// polyline arc sweeps at most half a circle (|bulge| <= 1). Points on the clockwise most end of
+/// the sweep (within rounding) are decided by the sign of the cross product rather than by rounded
+/// angles, so results there may differ from the angle based test.
 template <typename Real>
 bool pointWithinArcSweepAngle(Vector2<Real> const &center, Vector2<Real> const &arcStart,
                               Vector2<Real> const &arcEnd, Real bulge, Vector2<Real> const &point,
                               Real epsilon = utils::realThreshold<Real>()) {
   CAVC_ASSERT(std::abs(bulge) > utils::realThreshold<Real>(), "expected arc");
   CAVC_ASSERT(std::abs(bulge) <= Real(1), "bulge should always be between -1 and 1");
-  Real startAngle = utils::normalizeRadians(angle(center, arcStart));
-  Real endAngle = utils::normalizeRadians(angle(center, arcEnd));
-  Real sweepAngle = utils::deltaAngle(startAngle, endAngle);
-
-  if (bulge < Real(0) && sweepAngle > Real(0)) {
-    sweepAngle -= utils::tau<Real>();
-  } else if (bulge > Real(0) && sweepAngle < Real(0)) {
-    sweepAngle += utils::tau<Real>();
+  // orient the sweep counter clockwise from sweepStart to sweepEnd
+  Vector2<Real> sweepStart = arcStart - center;
+  Vector2<Real> sweepEnd = arcEnd - center;
+  if (bulge < Real(0)) {
+    std::swap(sweepStart, sweepEnd);
+  }
+
+  Vector2<Real> const toPoint = point - center;
+  // both non negative when the point is left of (counter clockwise from) sweepStart and right of
+  // (clockwise from) sweepEnd, for a sweep of at most half a circle that is the sweep region
+  Real const startCross = perpDot(sweepStart, toPoint);
+  Real const endCross = perpDot(toPoint, sweepEnd);
+  if (startCross >= Real(0) && endCross >= Real(0)) {
+    return true;
   }
 
-  Real testAngle = utils::normalizeRadians(angle(center, point));
-  return utils::angleIsWithinSweep(startAngle, sweepAngle, testAngle, epsilon);
+  // outside the sweep, test if the point is past sweepEnd by at most epsilon, cross product is
+  // |a||b|sin(angle) so compare squares to avoid the vector lengths
+  return endCross < Real(0) && dot(sweepEnd, toPoint) > Real(0) &&
+         endCross * endCross <= epsilon * epsilon * dot(sweepEnd, sweepEnd) * dot(toPoint, toPoint);
 }
 } // namespace cavc
 
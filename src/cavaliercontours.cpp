@@ -1,13 +1,25 @@
 #include "cavaliercontours.h"
+#include "cavc/cancellation.hpp"
 #include "cavc/polylinecombine.hpp"
 #include "cavc/polylineoffset.hpp"
+#include "cavc/internal/parallel.hpp"
 #include "cavc/polylineoffsetislands.hpp"
+#include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdlib>
+#include <deque>
 #include <exception>
+#include <functional>
 #include <iostream>
 #include <limits>
 #include <memory>
+#include <mutex>
+#include <new>
 #include <span>
+#include <thread>
 
 #define CAVC_BEGIN_TRY_CATCH try {
 
@@ -18,25 +30,242 @@
     std::terminate();                                                                              \
   }
 
-struct cavc_pline {
-  cavc::Polyline<cavc_real> data;
+// allocator hooks set by cavc_set_allocator (null hooks use std::malloc/std::free)
+struct allocator_hooks {
+  cavc_malloc_fn malloc_fn = nullptr;
+  cavc_free_fn free_fn = nullptr;
+  void *user_data = nullptr;
+};
+
+static allocator_hooks &current_allocator_hooks() {
+  static allocator_hooks hooks;
+  return hooks;
+}
+
+// every hooked allocation is prefixed with the free hook it must be released with so memory
+// allocated before cavc_set_allocator is called again is still freed correctly
+struct alignas(std::max_align_t) allocation_header {
+  cavc_free_fn free_fn;
+  void *user_data;
+};
+
+static void *hooked_allocate(std::size_t size) {
+  allocator_hooks const hooks = current_allocator_hooks();
+  std::size_t const total_size = sizeof(allocation_header) + size;
+  void *memory = hooks.malloc_fn != nullptr ? hooks.malloc_fn(total_size, hooks.user_data)
+                                            : std::malloc(total_size);
+  if (memory == nullptr) {
+    throw std::bad_alloc();
+  }
+
+  auto *header = new (memory) allocation_header{hooks.free_fn, hooks.user_data};
+  return header + 1;
+}
+
+static void hooked_free(void *ptr) noexcept {
+  if (ptr == nullptr) {
+    return;
+  }
+
+  auto *header = static_cast<allocation_header *>(ptr) - 1;
+  if (header->free_fn != nullptr) {
+    header->free_fn(header, header->user_data);
+  } else {
+    std::free(header);
+  }
+}
+
+static void *arena_allocate(cavc_arena *arena, std::size_t size, std::size_t alignment);
+
+// std allocator that draws from an arena (deallocate is a no-op, memory is released on arena
+// reset) or from the allocator hooks when arena is null
+template <typename T> struct api_allocator {
+  using value_type = T;
+  cavc_arena *arena = nullptr;
+
+  api_allocator() noexcept = default;
+  explicit api_allocator(cavc_arena *p_arena) noexcept : arena(p_arena) {}
+  template <typename U>
+  api_allocator(api_allocator<U> const &other) noexcept : arena(other.arena) {}
+
+  T *allocate(std::size_t n) {
+    std::size_t const size = n * sizeof(T);
+    void *memory = arena != nullptr ? arena_allocate(arena, size, alignof(T)) : hooked_allocate(size);
+    return static_cast<T *>(memory);
+  }
+
+  void deallocate(T *ptr, std::size_t) noexcept {
+    if (arena == nullptr) {
+      hooked_free(ptr);
+    }
+  }
+
+  friend bool operator==(api_allocator const &a, api_allocator const &b) noexcept {
+    return a.arena == b.arena;
+  }
+};
+
+template <typename T> using api_vector = std::vector<T, api_allocator<T>>;
+
+// base of C API handle types, handles are allocated with the allocator hooks
+struct api_object {
+  static void *operator new(std::size_t size) { return hooked_allocate(size); }
+  static void operator delete(void *ptr) noexcept { hooked_free(ptr); }
+};
+
+struct cavc_arena : api_object {
+  struct block {
+    char *data;
+    std::size_t size;
+  };
+
+  std::size_t block_size;
+  // blocks are kept after reset and reused for the following allocations
+  api_vector<block> blocks;
+  std::size_t current_block = 0;
+  std::size_t current_offset = 0;
+  std::size_t bytes_used = 0;
+
+  explicit cavc_arena(std::size_t p_block_size) : block_size(p_block_size) {}
+  cavc_arena(cavc_arena const &) = delete;
+  cavc_arena &operator=(cavc_arena const &) = delete;
+
+  ~cavc_arena() {
+    for (auto const &b : blocks) {
+      hooked_free(b.data);
+    }
+  }
+
+  void *allocate(std::size_t size, std::size_t alignment) {
+    while (current_block < blocks.size()) {
+      if (void *result = allocate_in_current(size, alignment)) {
+        return result;
+      }
+      ++current_block;
+      current_offset = 0;
+    }
+
+    std::size_t const new_block_size = std::max(block_size, size + alignment);
+    blocks.push_back(block{static_cast<char *>(hooked_allocate(new_block_size)), new_block_size});
+    current_block = blocks.size() - 1;
+    current_offset = 0;
+    void *result = allocate_in_current(size, alignment);
+    CAVC_ASSERT(result != nullptr, "new arena block must fit allocation");
+    return result;
+  }
+
+  void reset() noexcept {
+    current_block = 0;
+    current_offset = 0;
+    bytes_used = 0;
+  }
+
+  std::size_t bytes_reserved() const noexcept {
+    std::size_t result = 0;
+    for (auto const &b : blocks) {
+      result += b.size;
+    }
+    return result;
+  }
+
+private:
+  void *allocate_in_current(std::size_t size, std::size_t alignment) {
+    block const &b = blocks[current_block];
+    std::size_t const address = reinterpret_cast<std::size_t>(b.data) + current_offset;
+    std::size_t const padding = (alignment - address % alignment) % alignment;
+    if (current_offset + padding + size > b.size) {
+      return nullptr;
+    }
+
+    void *result = b.data + current_offset + padding;
+    current_offset += padding + size;
+    bytes_used += padding + size;
+    return result;
+  }
+};
+
+static void *arena_allocate(cavc_arena *arena, std::size_t size, std::size_t alignment) {
+  return arena->allocate(size, alignment);
+}
+
+// vertex storage is allocated with the allocator hooks, algorithms read it through a view (see
+// to_cpp_view) or, where they only accept cavc::Polyline, through a temporary copy
+struct cavc_pline : api_object {
+  api_vector<cavc_vertex> vertexes;
+  bool is_closed = false;
+
   cavc_pline() = default;
-  cavc_pline(cavc::Polyline<cavc_real> &&p_data) noexcept : data(std::move(p_data)) {}
+  cavc_pline(cavc::Polyline<cavc_real> const &pline) : is_closed(pline.isClosed()) {
+    vertexes.reserve(pline.size());
+    for (auto const &v : pline.vertexes()) {
+      vertexes.push_back(cavc_vertex{v.x(), v.y(), v.bulge()});
+    }
+  }
 };
 
-struct cavc_pline_list {
-  std::vector<std::unique_ptr<cavc_pline>> data;
+struct cavc_pline_list : api_object {
+  api_vector<std::unique_ptr<cavc_pline>> data;
 };
 
-struct cavc_spatial_index {
+struct cavc_spatial_index : api_object {
   cavc::StaticSpatialIndex<cavc_real> data;
   uint32_t item_count;
   cavc_spatial_index(cavc::StaticSpatialIndex<cavc_real> &&p_data, uint32_t p_item_count) noexcept
       : data(std::move(p_data)), item_count(p_item_count) {}
 };
 
-struct cavc_offset_loop_topology {
-  std::vector<cavc_offset_loop_topology_node> nodes;
+struct cavc_offset_loop_topology : api_object {
+  api_vector<cavc_offset_loop_topology_node> nodes;
+};
+
+struct cavc_offset_islands_engine : api_object {
+  cavc::ParallelOffsetIslands<cavc_real> data;
+  // input loop set reused between compute calls
+  cavc::OffsetLoopSet<cavc_real> input;
+};
+
+struct cavc_pline_buffer : api_object {
+  // arena the buffer and its arrays are allocated in (null if allocated with the allocator hooks)
+  cavc_arena *arena;
+  api_vector<cavc_vertex> vertexes;
+  // polyline i has vertexes [offsets[i], offsets[i + 1]), always holds at least one entry (0)
+  api_vector<uint32_t> offsets;
+  api_vector<int> is_closed;
+  // index of the input (for batch functions) each polyline came from
+  api_vector<uint32_t> source_index;
+
+  explicit cavc_pline_buffer(cavc_arena *p_arena = nullptr)
+      : arena(p_arena), vertexes(api_allocator<cavc_vertex>(p_arena)),
+        offsets(api_allocator<uint32_t>(p_arena)), is_closed(api_allocator<int>(p_arena)),
+        source_index(api_allocator<uint32_t>(p_arena)) {
+    offsets.push_back(0);
+  }
+};
+
+struct cavc_job : api_object {
+  // references held by the handle and by the job pool (freed when both are released)
+  std::atomic<int> ref_count{2};
+  std::atomic<cavc_job_status> status{CAVC_JOB_PENDING};
+  cavc::CancellationToken token;
+  std::function<void(cavc_job &)> work;
+  cavc_job_callback callback;
+  void *user_data;
+  // written by the pool thread before finished is set
+  std::vector<cavc::Polyline<cavc_real>> results[2];
+  std::mutex mutex;
+  std::condition_variable finished_cv;
+  // set after the callback has returned
+  bool finished = false;
+
+  cavc_job(std::function<void(cavc_job &)> &&p_work, cavc_job_callback p_callback,
+           void *p_user_data)
+      : work(std::move(p_work)), callback(p_callback), user_data(p_user_data) {}
+
+  void release() {
+    if (ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      delete this;
+    }
+  }
 };
 
 static cavc_tolerances to_api_tolerances(cavc::utils::EpsilonConfig<cavc_real> const &config) {
@@ -142,32 +371,255 @@ static void move_to_list(std::vector<cavc::Polyline<cavc_real>> &&plines, cavc_p
   }
 }
 
+// helper to create a view over caller owned vertex data
+static cavc::PolylineView<cavc_real> to_cpp_view(cavc_vertex const *vertex_data,
+                                                 uint32_t vertex_count, int is_closed) {
+  if (vertex_data == nullptr || vertex_count == 0) {
+    return cavc::PolylineView<cavc_real>(0, is_closed != 0, nullptr, nullptr, nullptr, 0, 0, 0);
+  }
+
+  return cavc::PolylineView<cavc_real>(vertex_count, is_closed != 0, &vertex_data->x,
+                                       &vertex_data->y, &vertex_data->bulge, sizeof(cavc_vertex),
+                                       sizeof(cavc_vertex), sizeof(cavc_vertex));
+}
+
+// helper to create a view over the vertexes of cavc_pline
+static cavc::PolylineView<cavc_real> to_cpp_view(cavc_pline const *pline) {
+  return to_cpp_view(pline->vertexes.data(), static_cast<uint32_t>(pline->vertexes.size()),
+                     pline->is_closed ? 1 : 0);
+}
+
+// helper to copy cavc_pline into a polyline for algorithms that do not accept a view
+static cavc::Polyline<cavc_real> to_cpp_pline(cavc_pline const *pline) {
+  return cavc::toPolyline(to_cpp_view(pline));
+}
+
+// helper to resolve a caller given byte stride (0 means contiguous values)
+static std::size_t soa_stride(uint32_t stride) {
+  return stride == 0 ? sizeof(cavc_real) : static_cast<std::size_t>(stride);
+}
+
+// helper to create a view over caller owned separate x, y and bulge arrays
+static cavc::PolylineView<cavc_real> to_cpp_soa_view(cavc_real const *x, uint32_t x_stride,
+                                                     cavc_real const *y, uint32_t y_stride,
+                                                     cavc_real const *bulge, uint32_t bulge_stride,
+                                                     uint32_t vertex_count, int is_closed) {
+  if (vertex_count == 0) {
+    return cavc::PolylineView<cavc_real>(0, is_closed != 0, nullptr, nullptr, nullptr, 0, 0, 0);
+  }
+
+  return cavc::PolylineView<cavc_real>(vertex_count, is_closed != 0, x, y, bulge,
+                                       soa_stride(x_stride), soa_stride(y_stride),
+                                       soa_stride(bulge_stride));
+}
+
+// caller owned separate x, y and bulge output arrays (null arrays are skipped)
+struct soa_columns {
+  cavc_real *x;
+  std::size_t x_stride;
+  cavc_real *y;
+  std::size_t y_stride;
+  cavc_real *bulge;
+  std::size_t bulge_stride;
+
+  soa_columns(cavc_real *p_x, uint32_t p_x_stride, cavc_real *p_y, uint32_t p_y_stride,
+              cavc_real *p_bulge, uint32_t p_bulge_stride)
+      : x(p_x), x_stride(soa_stride(p_x_stride)), y(p_y), y_stride(soa_stride(p_y_stride)),
+        bulge(p_bulge), bulge_stride(soa_stride(p_bulge_stride)) {}
+
+  void write(std::size_t i, cavc_real vx, cavc_real vy, cavc_real vbulge) const {
+    write_value(x, x_stride, i, vx);
+    write_value(y, y_stride, i, vy);
+    write_value(bulge, bulge_stride, i, vbulge);
+  }
+
+private:
+  static void write_value(cavc_real *column, std::size_t stride, std::size_t i, cavc_real value) {
+    if (column != nullptr) {
+      *reinterpret_cast<cavc_real *>(reinterpret_cast<char *>(column) + i * stride) = value;
+    }
+  }
+};
+
+// helper to write cavc_pline vertexes into soa columns starting at index start
+static void write_soa(cavc_pline const *pline, std::size_t start, soa_columns const &columns) {
+  for (std::size_t i = 0; i < pline->vertexes.size(); ++i) {
+    cavc_vertex const &v = pline->vertexes[i];
+    columns.write(start + i, v.x, v.y, v.bulge);
+  }
+}
+
+// helper to create a view over polyline i of packed batch input
+static cavc::PolylineView<cavc_real> to_cpp_batch_view(cavc_vertex const *vertex_data,
+                                                       uint32_t const *offsets, std::size_t i,
+                                                       bool is_closed) {
+  CAVC_ASSERT(offsets[i] <= offsets[i + 1], "offsets must be non-decreasing");
+  return to_cpp_view(vertex_data + offsets[i], offsets[i + 1] - offsets[i], is_closed ? 1 : 0);
+}
+
+// helper to clear cavc_pline_buffer contents (keeping capacity)
+static void clear_buffer(cavc_pline_buffer *buffer) {
+  buffer->vertexes.clear();
+  buffer->offsets.clear();
+  buffer->offsets.push_back(0);
+  buffer->is_closed.clear();
+  buffer->source_index.clear();
+}
+
+// helper to append plines contiguously to cavc_pline_buffer
+static void append_to_buffer(std::vector<cavc::Polyline<cavc_real>> const &plines,
+                             std::size_t source_index, cavc_pline_buffer *buffer) {
+  std::size_t total_vertex_count = buffer->vertexes.size();
+  for (auto const &pline : plines) {
+    total_vertex_count += pline.size();
+  }
+
+  buffer->vertexes.reserve(total_vertex_count);
+  for (auto const &pline : plines) {
+    for (auto const &v : pline.vertexes()) {
+      buffer->vertexes.push_back(cavc_vertex{v.x(), v.y(), v.bulge()});
+    }
+    buffer->offsets.push_back(static_cast<uint32_t>(buffer->vertexes.size()));
+    buffer->is_closed.push_back(pline.isClosed() ? 1 : 0);
+    buffer->source_index.push_back(static_cast<uint32_t>(source_index));
+  }
+}
+
+// helper to write plines contiguously to cavc_pline_buffer (replacing contents, keeping capacity)
+static void write_to_buffer(std::vector<cavc::Polyline<cavc_real>> const &plines,
+                            cavc_pline_buffer *buffer) {
+  clear_buffer(buffer);
+  append_to_buffer(plines, 0, buffer);
+}
+
+// helper to copy a view into a reused polyline (avoids allocating once capacity is reached)
+static void assign_from_view(cavc::Polyline<cavc_real> &pline,
+                             cavc::PolylineView<cavc_real> const &view) {
+  pline.vertexes().clear();
+  pline.vertexes().reserve(view.size());
+  for (std::size_t i = 0; i < view.size(); ++i) {
+    pline.addVertex(view[i]);
+  }
+  pline.isClosed() = view.isClosed();
+}
+
+// helper to copy a view into cavc_pline (reusing its vertex capacity)
+static void assign_from_view(cavc_pline *pline, cavc::PolylineView<cavc_real> const &view) {
+  pline->vertexes.clear();
+  pline->vertexes.reserve(view.size());
+  for (std::size_t i = 0; i < view.size(); ++i) {
+    auto const v = view[i];
+    pline->vertexes.push_back(cavc_vertex{v.x(), v.y(), v.bulge()});
+  }
+  pline->is_closed = view.isClosed();
+}
+
+// helper to replace cavc_pline contents with a polyline (reusing its vertex capacity)
+static void assign_from_pline(cavc_pline *pline, cavc::Polyline<cavc_real> const &source) {
+  pline->vertexes.clear();
+  pline->vertexes.reserve(source.size());
+  for (auto const &v : source.vertexes()) {
+    pline->vertexes.push_back(cavc_vertex{v.x(), v.y(), v.bulge()});
+  }
+  pline->is_closed = source.isClosed();
+}
+
+static bool to_cpp_combine_mode(int combine_mode, cavc::PlineCombineMode &mode) {
+  switch (combine_mode) {
+  case 0:
+    mode = cavc::PlineCombineMode::Union;
+    return true;
+  case 1:
+    mode = cavc::PlineCombineMode::Exclude;
+    return true;
+  case 2:
+    mode = cavc::PlineCombineMode::Intersect;
+    return true;
+  case 3:
+    mode = cavc::PlineCombineMode::XOR;
+    return true;
+  }
+
+  return false;
+}
+
+static cavc_point_containment to_api_point_containment(cavc::PointContainment containment) {
+  switch (containment) {
+  case cavc::PointContainment::Outside:
+    return CAVC_POINT_OUTSIDE;
+  case cavc::PointContainment::Inside:
+    return CAVC_POINT_INSIDE;
+  case cavc::PointContainment::OnBoundary:
+    return CAVC_POINT_ON_BOUNDARY;
+  }
+  CAVC_ASSERT(false, "Unhandled point containment enum");
+  return CAVC_POINT_OUTSIDE;
+}
+
+// minimum number of points given to each worker in point batch functions
+constexpr std::size_t min_points_per_worker = 256;
+// minimum number of polylines given to each worker for extents
+constexpr std::size_t min_extents_per_worker = 64;
+// point batches at least this size build a spatial index to speed up the per point queries
+constexpr std::size_t min_points_for_index = 8;
+
+// helper to run fn(point_index, pline, spatial_index_or_null, query_stack) over every point of a
+// point batch on up to thread_count threads
+template <typename PointFn>
+static void for_each_batch_point(cavc_vertex const *vertex_data, uint32_t vertex_count,
+                                 int is_closed, uint32_t point_count, uint32_t thread_count,
+                                 PointFn &&fn) {
+  cavc::Polyline<cavc_real> pline;
+  assign_from_view(pline, to_cpp_view(vertex_data, vertex_count, is_closed));
+  std::unique_ptr<cavc::StaticSpatialIndex<cavc_real>> spatial_index;
+  if (pline.size() >= 2 && point_count >= min_points_for_index) {
+    spatial_index = std::make_unique<cavc::StaticSpatialIndex<cavc_real>>(
+        cavc::createApproxSpatialIndex(pline));
+  }
+
+  std::size_t const worker_count =
+      cavc::internal::parallelWorkerCount(point_count, min_points_per_worker, thread_count);
+  std::vector<std::vector<std::size_t>> query_stacks(worker_count);
+  auto run_point = [&](std::size_t i, std::size_t worker) {
+    fn(i, pline, spatial_index.get(), query_stacks[worker]);
+  };
+  cavc::internal::parallelFor<cavc_real>(point_count, worker_count, run_point);
+}
+
+// helper to run parallel offset over caller owned vertex data
+static std::vector<cavc::Polyline<cavc_real>>
+parallel_offset_view(cavc_vertex const *vertex_data, uint32_t vertex_count, int is_closed,
+                     cavc_real delta, cavc_parallel_offset_options const &options) {
+  if (!std::isfinite(delta) || !is_valid_parallel_offset_options(options)) {
+    return {};
+  }
+
+  return cavc::parallelOffset(to_cpp_view(vertex_data, vertex_count, is_closed), delta,
+                              to_cpp_parallel_offset_options(options));
+}
+
 // helper to copy vertex data to cavc_pline
 static void copy_to_pline(cavc_pline *api_pline, cavc_vertex const *vertex_data,
                           uint32_t vertex_count) {
-  api_pline->data.vertexes().clear();
-  api_pline->data.vertexes().reserve(vertex_count);
+  api_pline->vertexes.clear();
+  api_pline->vertexes.reserve(vertex_count);
 
   // Use std::span for safe buffer access
   if (vertex_data != nullptr && vertex_count > 0) {
     std::span<const cavc_vertex> vertices_span(vertex_data, vertex_count);
-    for (const auto &vertex : vertices_span) {
-      api_pline->data.addVertex(vertex.x, vertex.y, vertex.bulge);
-    }
+    api_pline->vertexes.insert(api_pline->vertexes.end(), vertices_span.begin(),
+                               vertices_span.end());
   }
 }
 
 // helper to copy to vertex_data from cavc_pline
 static void copy_to_vertex_data(cavc_pline const *api_pline, cavc_vertex *vertex_data) {
-  auto const &pline = api_pline->data;
-  uint32_t vertex_count = static_cast<uint32_t>(pline.size());
+  auto const &vertexes = api_pline->vertexes;
+  uint32_t vertex_count = static_cast<uint32_t>(vertexes.size());
 
   if (vertex_data != nullptr && vertex_count > 0) {
     std::span<cavc_vertex> output_span(vertex_data, vertex_count);
-    for (uint32_t i = 0; i < vertex_count; ++i) {
-      auto const &v = pline[i];
-      output_span[i] = cavc_vertex{v.x(), v.y(), v.bulge()};
-    }
+    std::copy(vertexes.begin(), vertexes.end(), output_span.begin());
   }
 }
 
@@ -206,34 +658,63 @@ to_api_topology_node(cavc::OffsetLoopTopologyNode<cavc_real> const &node) {
           parent_index};
 }
 
-static std::vector<cavc::OffsetLoop<cavc_real>> to_cpp_offset_loops(cavc_pline const *const *loops,
-                                                                    uint32_t loop_count) {
+// helper to copy api loops into offset loops (building their spatial indexes), result is cleared
+// first
+static void copy_to_offset_loops(cavc_pline const *const *loops, uint32_t loop_count,
+                                 std::vector<cavc::OffsetLoop<cavc_real>> &result) {
   CAVC_ASSERT(loop_count == 0 || loops != nullptr, "non-zero loop count requires loop pointer");
 
-  std::vector<cavc::OffsetLoop<cavc_real>> result;
+  result.clear();
   result.reserve(loop_count);
 
   for (uint32_t i = 0; i < loop_count; ++i) {
     CAVC_ASSERT(loops[i] != nullptr, "null loop pointer not allowed");
-    auto const &loop = loops[i]->data;
-    CAVC_ASSERT(loop.isClosed(), "offset topology requires closed loops");
-    CAVC_ASSERT(loop.size() > 1, "offset topology requires loops with at least 2 vertices");
+    CAVC_ASSERT(loops[i]->is_closed, "offset loops must be closed");
+    CAVC_ASSERT(loops[i]->vertexes.size() > 1, "offset loops must have at least 2 vertices");
 
-    result.push_back({static_cast<std::size_t>(i), loop, cavc::createApproxSpatialIndex(loop)});
+    auto loop = to_cpp_pline(loops[i]);
+    auto spatial_index = cavc::createApproxSpatialIndex(loop);
+    result.push_back({static_cast<std::size_t>(i), std::move(loop), std::move(spatial_index)});
   }
+}
 
+static std::vector<cavc::OffsetLoop<cavc_real>> to_cpp_offset_loops(cavc_pline const *const *loops,
+                                                                    uint32_t loop_count) {
+  std::vector<cavc::OffsetLoop<cavc_real>> result;
+  copy_to_offset_loops(loops, loop_count, result);
   return result;
 }
 
+// helper to move offset loop polylines to cavc_pline_list
+static void move_to_list(std::vector<cavc::OffsetLoop<cavc_real>> &&loops, cavc_pline_list *list) {
+  list->data.reserve(loops.size());
+
+  for (std::size_t i = 0; i < loops.size(); ++i) {
+    list->data.push_back(std::make_unique<cavc_pline>(std::move(loops[i].polyline)));
+  }
+}
+
 cavc_pline *cavc_pline_new(const cavc_vertex *vertex_data, uint32_t vertex_count, int is_closed) {
   CAVC_BEGIN_TRY_CATCH
   cavc_pline *result = new cavc_pline();
   if (vertex_data) {
     copy_to_pline(result, vertex_data, vertex_count);
   } else {
-    result->data.vertexes().reserve(vertex_count);
+    result->vertexes.reserve(vertex_count);
   }
-  result->data.isClosed() = is_closed;
+  result->is_closed = is_closed != 0;
+  return result;
+  CAVC_END_TRY_CATCH
+}
+
+cavc_pline *cavc_pline_new_soa(cavc_real const *x, uint32_t x_stride, cavc_real const *y,
+                               uint32_t y_stride, cavc_real const *bulge, uint32_t bulge_stride,
+                               uint32_t vertex_count, int is_closed) {
+  CAVC_ASSERT(vertex_count == 0 || (x && y), "null x or y not allowed");
+  CAVC_BEGIN_TRY_CATCH
+  cavc_pline *result = new cavc_pline();
+  assign_from_view(result, to_cpp_soa_view(x, x_stride, y, y_stride, bulge, bulge_stride,
+                                           vertex_count, is_closed));
   return result;
   CAVC_END_TRY_CATCH
 }
@@ -247,21 +728,28 @@ void cavc_pline_delete(cavc_pline *polyline) {
 uint32_t cavc_pline_capacity(cavc_pline const *pline) {
   CAVC_ASSERT(pline, "null pline not allowed");
   CAVC_BEGIN_TRY_CATCH
-  return static_cast<uint32_t>(pline->data.vertexes().capacity());
+  return static_cast<uint32_t>(pline->vertexes.capacity());
+  CAVC_END_TRY_CATCH
+}
+
+uint64_t cavc_pline_memory_usage(cavc_pline const *pline) {
+  CAVC_ASSERT(pline, "null pline not allowed");
+  CAVC_BEGIN_TRY_CATCH
+  return sizeof(cavc_pline) + pline->vertexes.capacity() * sizeof(cavc_vertex);
   CAVC_END_TRY_CATCH
 }
 
 void cavc_pline_set_capacity(cavc_pline *pline, uint32_t size) {
   CAVC_ASSERT(pline, "null pline not allowed");
   CAVC_BEGIN_TRY_CATCH
-  pline->data.vertexes().reserve(size);
+  pline->vertexes.reserve(size);
   CAVC_END_TRY_CATCH
 }
 
 uint32_t cavc_pline_vertex_count(cavc_pline const *pline) {
   CAVC_ASSERT(pline, "null pline not allowed");
   CAVC_BEGIN_TRY_CATCH
-  return static_cast<uint32_t>(pline->data.size());
+  return static_cast<uint32_t>(pline->vertexes.size());
   CAVC_END_TRY_CATCH
 }
 
@@ -272,10 +760,19 @@ void cavc_pline_vertex_data(cavc_pline const *pline, cavc_vertex *vertex_data) {
   CAVC_END_TRY_CATCH
 }
 
+void cavc_pline_vertex_data_soa(cavc_pline const *pline, cavc_real *x, uint32_t x_stride,
+                                cavc_real *y, uint32_t y_stride, cavc_real *bulge,
+                                uint32_t bulge_stride) {
+  CAVC_ASSERT(pline, "null pline not allowed");
+  CAVC_BEGIN_TRY_CATCH
+  write_soa(pline, 0, soa_columns(x, x_stride, y, y_stride, bulge, bulge_stride));
+  CAVC_END_TRY_CATCH
+}
+
 int cavc_pline_is_closed(cavc_pline const *pline) {
   CAVC_ASSERT(pline, "null pline not allowed");
   CAVC_BEGIN_TRY_CATCH
-  return pline->data.isClosed();
+  return pline->is_closed ? 1 : 0;
   CAVC_END_TRY_CATCH
 }
 
@@ -287,19 +784,30 @@ void cavc_pline_set_vertex_data(cavc_pline *pline, const cavc_vertex *vertex_dat
   CAVC_END_TRY_CATCH
 }
 
+void cavc_pline_set_vertex_data_soa(cavc_pline *pline, cavc_real const *x, uint32_t x_stride,
+                                    cavc_real const *y, uint32_t y_stride, cavc_real const *bulge,
+                                    uint32_t bulge_stride, uint32_t vertex_count) {
+  CAVC_ASSERT(pline, "null pline not allowed");
+  CAVC_ASSERT(vertex_count == 0 || (x && y), "null x or y not allowed");
+  CAVC_BEGIN_TRY_CATCH
+  assign_from_view(pline, to_cpp_soa_view(x, x_stride, y, y_stride, bulge, bulge_stride,
+                                          vertex_count, pline->is_closed ? 1 : 0));
+  CAVC_END_TRY_CATCH
+}
+
 void cavc_pline_add_vertex(cavc_pline *pline, cavc_vertex vertex) {
   CAVC_ASSERT(pline, "null pline not allowed");
   CAVC_BEGIN_TRY_CATCH
-  pline->data.addVertex(vertex.x, vertex.y, vertex.bulge);
+  pline->vertexes.push_back(vertex);
   CAVC_END_TRY_CATCH
 }
 
 void cavc_pline_remove_range(cavc_pline *pline, uint32_t start_index, uint32_t count) {
   CAVC_ASSERT(pline, "null pline not allowed");
-  CAVC_ASSERT(start_index < pline->data.size(), "start_index is out of vertexes range");
-  CAVC_ASSERT(start_index + count <= pline->data.size(), "count is out of vertexes range");
+  CAVC_ASSERT(start_index < pline->vertexes.size(), "start_index is out of vertexes range");
+  CAVC_ASSERT(start_index + count <= pline->vertexes.size(), "count is out of vertexes range");
   CAVC_BEGIN_TRY_CATCH
-  auto &vertexes = pline->data.vertexes();
+  auto &vertexes = pline->vertexes;
   auto start_it = vertexes.begin() + static_cast<std::ptrdiff_t>(start_index);
   vertexes.erase(start_it, start_it + static_cast<std::ptrdiff_t>(count));
   CAVC_END_TRY_CATCH
@@ -308,21 +816,23 @@ void cavc_pline_remove_range(cavc_pline *pline, uint32_t start_index, uint32_t c
 void cavc_pline_clear(cavc_pline *pline) {
   CAVC_ASSERT(pline, "null pline not allowed");
   CAVC_BEGIN_TRY_CATCH
-  pline->data.vertexes().clear();
+  pline->vertexes.clear();
   CAVC_END_TRY_CATCH
 }
 
 void cavc_pline_set_is_closed(cavc_pline *pline, int is_closed) {
   CAVC_ASSERT(pline, "null pline not allowed");
   CAVC_BEGIN_TRY_CATCH
-  pline->data.isClosed() = is_closed;
+  pline->is_closed = is_closed != 0;
   CAVC_END_TRY_CATCH
 }
 
 void cavc_pline_invert_direction(cavc_pline *pline) {
   CAVC_ASSERT(pline, "null pline not allowed");
   CAVC_BEGIN_TRY_CATCH
-  cavc::invertDirection(pline->data);
+  auto cpp_pline = to_cpp_pline(pline);
+  cavc::invertDirection(cpp_pline);
+  assign_from_pline(pline, cpp_pline);
   CAVC_END_TRY_CATCH
 }
 
@@ -331,14 +841,14 @@ void cavc_pline_prune_singularities(cavc_pline const *pline, cavc_real epsilon,
   CAVC_ASSERT(pline, "null pline not allowed");
   CAVC_ASSERT(output, "null output not allowed");
   CAVC_BEGIN_TRY_CATCH
-  *output = new cavc_pline(cavc::pruneSingularities(pline->data, epsilon));
+  *output = new cavc_pline(cavc::pruneSingularities(to_cpp_pline(pline), epsilon));
   CAVC_END_TRY_CATCH
 }
 
 void cavc_pline_remove_redundant(cavc_pline *pline, cavc_real epsilon) {
   CAVC_ASSERT(pline, "null pline not allowed");
   CAVC_BEGIN_TRY_CATCH
-  pline->data = cavc::removeRedundant(pline->data, epsilon);
+  assign_from_pline(pline, cavc::removeRedundant(to_cpp_view(pline), epsilon));
   CAVC_END_TRY_CATCH
 }
 
@@ -347,7 +857,7 @@ void cavc_pline_convert_arcs_to_lines(cavc_pline const *pline, cavc_real error,
   CAVC_ASSERT(pline, "null pline not allowed");
   CAVC_ASSERT(output, "null output not allowed");
   CAVC_BEGIN_TRY_CATCH
-  *output = new cavc_pline(cavc::convertArcsToLines(pline->data, error));
+  *output = new cavc_pline(cavc::convertArcsToLines(to_cpp_pline(pline), error));
   CAVC_END_TRY_CATCH
 }
 
@@ -357,7 +867,7 @@ void cavc_pline_normalize(cavc_pline const *pline, cavc_real epsilon,
   CAVC_ASSERT(output, "null output not allowed");
   CAVC_BEGIN_TRY_CATCH
   auto winding = to_cpp_closed_winding(closed_winding);
-  *output = new cavc_pline(cavc::normalizePolyline(pline->data, epsilon, winding));
+  *output = new cavc_pline(cavc::normalizePolyline(to_cpp_pline(pline), epsilon, winding));
   CAVC_END_TRY_CATCH
 }
 
@@ -392,16 +902,175 @@ cavc_pline *cavc_pline_list_release(cavc_pline_list *pline_list, uint32_t index)
   CAVC_END_TRY_CATCH
 }
 
+uint32_t cavc_pline_list_vertex_count(cavc_pline_list const *pline_list) {
+  CAVC_ASSERT(pline_list, "null pline_list not allowed");
+  CAVC_BEGIN_TRY_CATCH
+  std::size_t result = 0;
+  for (auto const &pline : pline_list->data) {
+    result += pline->vertexes.size();
+  }
+  return static_cast<uint32_t>(result);
+  CAVC_END_TRY_CATCH
+}
+
+uint64_t cavc_pline_list_memory_usage(cavc_pline_list const *pline_list) {
+  CAVC_ASSERT(pline_list, "null pline_list not allowed");
+  CAVC_BEGIN_TRY_CATCH
+  std::size_t result =
+      sizeof(cavc_pline_list) + pline_list->data.capacity() * sizeof(std::unique_ptr<cavc_pline>);
+  for (auto const &pline : pline_list->data) {
+    result += sizeof(cavc_pline) + pline->vertexes.capacity() * sizeof(cavc_vertex);
+  }
+  return result;
+  CAVC_END_TRY_CATCH
+}
+
+void cavc_pline_list_export_soa(cavc_pline_list const *pline_list, cavc_real *x,
+                                uint32_t x_stride, cavc_real *y, uint32_t y_stride,
+                                cavc_real *bulge, uint32_t bulge_stride, uint32_t *offsets,
+                                int *is_closed) {
+  CAVC_ASSERT(pline_list, "null pline_list not allowed");
+  CAVC_BEGIN_TRY_CATCH
+  soa_columns const columns(x, x_stride, y, y_stride, bulge, bulge_stride);
+  std::size_t const count = pline_list->data.size();
+  std::span<uint32_t> offsets_span(offsets, offsets == nullptr ? 0 : count + 1);
+  std::span<int> is_closed_span(is_closed, is_closed == nullptr ? 0 : count);
+  std::size_t start = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    cavc_pline const *pline = pline_list->data[i].get();
+    if (offsets != nullptr) {
+      offsets_span[i] = static_cast<uint32_t>(start);
+    }
+    if (is_closed != nullptr) {
+      is_closed_span[i] = pline->is_closed ? 1 : 0;
+    }
+    write_soa(pline, start, columns);
+    start += pline->vertexes.size();
+  }
+  if (offsets != nullptr) {
+    offsets_span[count] = static_cast<uint32_t>(start);
+  }
+  CAVC_END_TRY_CATCH
+}
+
+// cavc_pline_buffer APIs
+// -------------------------
+cavc_pline_buffer *cavc_pline_buffer_new(void) {
+  CAVC_BEGIN_TRY_CATCH
+  return new cavc_pline_buffer();
+  CAVC_END_TRY_CATCH
+}
+
+cavc_pline_buffer *cavc_pline_buffer_new_in_arena(cavc_arena *arena) {
+  CAVC_ASSERT(arena, "null arena not allowed");
+  CAVC_BEGIN_TRY_CATCH
+  void *memory = arena->allocate(sizeof(cavc_pline_buffer), alignof(cavc_pline_buffer));
+  return ::new (memory) cavc_pline_buffer(arena);
+  CAVC_END_TRY_CATCH
+}
+
+void cavc_pline_buffer_delete(cavc_pline_buffer *buffer) {
+  CAVC_BEGIN_TRY_CATCH
+  if (buffer != nullptr && buffer->arena != nullptr) {
+    // memory is released when the arena is reset or deleted
+    buffer->~cavc_pline_buffer();
+    return;
+  }
+  delete buffer;
+  CAVC_END_TRY_CATCH
+}
+
+uint32_t cavc_pline_buffer_count(cavc_pline_buffer const *buffer) {
+  CAVC_ASSERT(buffer, "null buffer not allowed");
+  CAVC_BEGIN_TRY_CATCH
+  return static_cast<uint32_t>(buffer->offsets.size() - 1);
+  CAVC_END_TRY_CATCH
+}
+
+uint32_t cavc_pline_buffer_vertex_count(cavc_pline_buffer const *buffer) {
+  CAVC_ASSERT(buffer, "null buffer not allowed");
+  CAVC_BEGIN_TRY_CATCH
+  return static_cast<uint32_t>(buffer->vertexes.size());
+  CAVC_END_TRY_CATCH
+}
+
+cavc_vertex const *cavc_pline_buffer_vertex_data(cavc_pline_buffer const *buffer) {
+  CAVC_ASSERT(buffer, "null buffer not allowed");
+  CAVC_BEGIN_TRY_CATCH
+  return buffer->vertexes.empty() ? nullptr : buffer->vertexes.data();
+  CAVC_END_TRY_CATCH
+}
+
+void cavc_pline_buffer_vertex_data_soa(cavc_pline_buffer const *buffer, cavc_real *x,
+                                       uint32_t x_stride, cavc_real *y, uint32_t y_stride,
+                                       cavc_real *bulge, uint32_t bulge_stride) {
+  CAVC_ASSERT(buffer, "null buffer not allowed");
+  CAVC_BEGIN_TRY_CATCH
+  soa_columns const columns(x, x_stride, y, y_stride, bulge, bulge_stride);
+  for (std::size_t i = 0; i < buffer->vertexes.size(); ++i) {
+    cavc_vertex const &v = buffer->vertexes[i];
+    columns.write(i, v.x, v.y, v.bulge);
+  }
+  CAVC_END_TRY_CATCH
+}
+
+uint32_t cavc_pline_buffer_source_index(cavc_pline_buffer const *buffer, uint32_t index) {
+  CAVC_ASSERT(buffer, "null buffer not allowed");
+  CAVC_ASSERT(index < buffer->source_index.size(), "index out of bounds");
+  CAVC_BEGIN_TRY_CATCH
+  return buffer->source_index[index];
+  CAVC_END_TRY_CATCH
+}
+
+uint32_t const *cavc_pline_buffer_offsets(cavc_pline_buffer const *buffer) {
+  CAVC_ASSERT(buffer, "null buffer not allowed");
+  CAVC_BEGIN_TRY_CATCH
+  return buffer->offsets.data();
+  CAVC_END_TRY_CATCH
+}
+
+int cavc_pline_buffer_is_closed(cavc_pline_buffer const *buffer, uint32_t index) {
+  CAVC_ASSERT(buffer, "null buffer not allowed");
+  CAVC_ASSERT(index < buffer->is_closed.size(), "index out of bounds");
+  CAVC_BEGIN_TRY_CATCH
+  return buffer->is_closed[index];
+  CAVC_END_TRY_CATCH
+}
+
+int cavc_pline_buffer_copy_to(cavc_pline_buffer const *buffer, cavc_vertex *vertex_out,
+                              uint32_t vertex_capacity, uint32_t *offsets_out,
+                              uint32_t offsets_capacity, int *is_closed_out) {
+  CAVC_ASSERT(buffer, "null buffer not allowed");
+  CAVC_ASSERT(vertex_out || vertex_capacity == 0, "null vertex_out not allowed");
+  CAVC_ASSERT(offsets_out || offsets_capacity == 0, "null offsets_out not allowed");
+  CAVC_BEGIN_TRY_CATCH
+  if (buffer->vertexes.size() > vertex_capacity || buffer->offsets.size() > offsets_capacity) {
+    return 0;
+  }
+
+  std::copy(buffer->vertexes.begin(), buffer->vertexes.end(), vertex_out);
+  std::copy(buffer->offsets.begin(), buffer->offsets.end(), offsets_out);
+  if (is_closed_out != nullptr) {
+    std::copy(buffer->is_closed.begin(), buffer->is_closed.end(), is_closed_out);
+  }
+
+  return 1;
+  CAVC_END_TRY_CATCH
+}
+
 // cavc_spatial_index APIs
 // -------------------------
+
 cavc_spatial_index *cavc_spatial_index_create(cavc_pline const *pline) {
   CAVC_ASSERT(pline, "null pline not allowed");
-  CAVC_ASSERT(pline->data.size() > 1,
+  CAVC_ASSERT(pline->vertexes.size() > 1,
               "need at least 2 vertexes to form segments for spatial index");
   CAVC_BEGIN_TRY_CATCH
+  std::size_t const vertex_count = pline->vertexes.size();
   uint32_t segment_count =
-      static_cast<uint32_t>(pline->data.isClosed() ? pline->data.size() : pline->data.size() - 1);
-  return new cavc_spatial_index(cavc::createApproxSpatialIndex(pline->data), segment_count);
+      static_cast<uint32_t>(pline->is_closed ? vertex_count : vertex_count - 1);
+  return new cavc_spatial_index(cavc::createApproxSpatialIndex(to_cpp_pline(pline)),
+                                segment_count);
   CAVC_END_TRY_CATCH
 }
 
@@ -418,6 +1087,13 @@ uint32_t cavc_spatial_index_item_count(cavc_spatial_index const *spatial_index)
   CAVC_END_TRY_CATCH
 }
 
+uint64_t cavc_spatial_index_memory_usage(cavc_spatial_index const *spatial_index) {
+  CAVC_ASSERT(spatial_index, "null spatial_index not allowed");
+  CAVC_BEGIN_TRY_CATCH
+  return sizeof(cavc_spatial_index) + spatial_index->data.memoryUsage();
+  CAVC_END_TRY_CATCH
+}
+
 uint32_t cavc_spatial_index_query_count(cavc_spatial_index const *spatial_index, cavc_real min_x,
                                         cavc_real min_y, cavc_real max_x, cavc_real max_y) {
   CAVC_ASSERT(spatial_index, "null spatial_index not allowed");
@@ -487,6 +1163,53 @@ cavc_offset_loop_topology_get(cavc_offset_loop_topology const *topology, uint32_
   CAVC_END_TRY_CATCH
 }
 
+// cavc_offset_islands_engine APIs
+// -------------------------
+cavc_offset_islands_engine *cavc_offset_islands_engine_new(void) {
+  CAVC_BEGIN_TRY_CATCH
+  return new cavc_offset_islands_engine();
+  CAVC_END_TRY_CATCH
+}
+
+void cavc_offset_islands_engine_delete(cavc_offset_islands_engine *engine) {
+  CAVC_BEGIN_TRY_CATCH
+  delete engine;
+  CAVC_END_TRY_CATCH
+}
+
+void cavc_offset_islands_engine_set_max_threads(cavc_offset_islands_engine *engine,
+                                                uint32_t max_threads) {
+  CAVC_ASSERT(engine, "null engine not allowed");
+  CAVC_BEGIN_TRY_CATCH
+  engine->data.setMaxThreads(max_threads);
+  CAVC_END_TRY_CATCH
+}
+
+void cavc_offset_islands_engine_compute(cavc_offset_islands_engine *engine,
+                                        cavc_pline const *const *ccw_loops,
+                                        uint32_t ccw_loop_count, cavc_pline const *const *cw_loops,
+                                        uint32_t cw_loop_count, cavc_real offset_delta,
+                                        cavc_pline_list **ccw_output,
+                                        cavc_pline_list **cw_output) {
+  CAVC_ASSERT(engine, "null engine not allowed");
+  CAVC_ASSERT(ccw_output, "null ccw_output not allowed");
+  CAVC_ASSERT(cw_output, "null cw_output not allowed");
+  CAVC_BEGIN_TRY_CATCH
+  *ccw_output = new cavc_pline_list();
+  *cw_output = new cavc_pline_list();
+  if (!std::isfinite(offset_delta)) {
+    return;
+  }
+
+  copy_to_offset_loops(ccw_loops, ccw_loop_count, engine->input.ccwLoops);
+  copy_to_offset_loops(cw_loops, cw_loop_count, engine->input.cwLoops);
+
+  auto results = engine->data.compute(engine->input, offset_delta);
+  move_to_list(std::move(results.ccwLoops), *ccw_output);
+  move_to_list(std::move(results.cwLoops), *cw_output);
+  CAVC_END_TRY_CATCH
+}
+
 cavc_parallel_offset_options cavc_parallel_offset_default_options(void) {
   CAVC_BEGIN_TRY_CATCH
   return cavc_parallel_offset_options{0, CAVC_OFFSET_JOIN_ROUND, CAVC_OFFSET_END_CAP_ROUND, 4.0};
@@ -504,36 +1227,79 @@ void cavc_parallel_offset(cavc_pline const *pline, cavc_real delta, cavc_pline_l
   }
 
   auto cpp_options = to_cpp_parallel_offset_options(options);
-  auto results = cavc::parallelOffset(pline->data, delta, cpp_options);
+  auto results = cavc::parallelOffset(to_cpp_view(pline), delta, cpp_options);
   move_to_list(std::move(results), *output);
   CAVC_END_TRY_CATCH
 }
 
+void cavc_parallel_offset_view(cavc_vertex const *vertex_data, uint32_t vertex_count,
+                               int is_closed, cavc_real delta,
+                               cavc_parallel_offset_options options,
+                               cavc_pline_buffer *output) {
+  CAVC_ASSERT(vertex_data || vertex_count == 0, "null vertex_data not allowed");
+  CAVC_ASSERT(output, "null output not allowed");
+  CAVC_BEGIN_TRY_CATCH
+  write_to_buffer(parallel_offset_view(vertex_data, vertex_count, is_closed, delta, options),
+                  output);
+  CAVC_END_TRY_CATCH
+}
+
+int cavc_parallel_offset_view_to(cavc_vertex const *vertex_data, uint32_t vertex_count,
+                                 int is_closed, cavc_real delta,
+                                 cavc_parallel_offset_options options, cavc_vertex *vertex_out,
+                                 uint32_t vertex_capacity, uint32_t *offsets_out,
+                                 uint32_t offsets_capacity, int *is_closed_out,
+                                 uint32_t *pline_count, uint32_t *total_vertex_count,
+                                 cavc_pline_buffer *overflow) {
+  CAVC_ASSERT(vertex_data || vertex_count == 0, "null vertex_data not allowed");
+  CAVC_ASSERT(vertex_out || vertex_capacity == 0, "null vertex_out not allowed");
+  CAVC_ASSERT(offsets_out || offsets_capacity == 0, "null offsets_out not allowed");
+  CAVC_ASSERT(pline_count, "null pline_count not allowed");
+  CAVC_ASSERT(total_vertex_count, "null total_vertex_count not allowed");
+  CAVC_BEGIN_TRY_CATCH
+  auto results = parallel_offset_view(vertex_data, vertex_count, is_closed, delta, options);
+  std::size_t required_vertexes = 0;
+  for (auto const &pline : results) {
+    required_vertexes += pline.size();
+  }
+
+  *pline_count = static_cast<uint32_t>(results.size());
+  *total_vertex_count = static_cast<uint32_t>(required_vertexes);
+  if (required_vertexes > vertex_capacity || results.size() + 1 > offsets_capacity) {
+    // keep the result so the caller can copy it out without recomputing the offset
+    if (overflow != nullptr) {
+      write_to_buffer(results, overflow);
+    }
+    return 0;
+  }
+
+  std::span<cavc_vertex> vertex_span(vertex_out, vertex_capacity);
+  std::span<uint32_t> offsets_span(offsets_out, offsets_capacity);
+  std::size_t vertex_index = 0;
+  offsets_span[0] = 0;
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    for (auto const &v : results[i].vertexes()) {
+      vertex_span[vertex_index++] = cavc_vertex{v.x(), v.y(), v.bulge()};
+    }
+    offsets_span[i + 1] = static_cast<uint32_t>(vertex_index);
+    if (is_closed_out != nullptr) {
+      is_closed_out[i] = results[i].isClosed() ? 1 : 0;
+    }
+  }
+
+  return 1;
+  CAVC_END_TRY_CATCH
+}
+
 void cavc_combine_plines(cavc_pline const *pline_a, cavc_pline const *pline_b, int combine_mode,
                          cavc_pline_list **remaining, cavc_pline_list **subtracted) {
   CAVC_ASSERT(pline_a, "null pline_a not allowed");
   CAVC_ASSERT(pline_b, "null pline_b not allowed");
   CAVC_ASSERT(combine_mode >= 0 && combine_mode <= 3, "combine_mode must be 0, 1, 2, or 3");
   CAVC_BEGIN_TRY_CATCH
-  cavc::PlineCombineMode mode;
-  switch (combine_mode) {
-  case 0:
-    mode = cavc::PlineCombineMode::Union;
-    break;
-  case 1:
-    mode = cavc::PlineCombineMode::Exclude;
-    break;
-  case 2:
-    mode = cavc::PlineCombineMode::Intersect;
-    break;
-  case 3:
-    mode = cavc::PlineCombineMode::XOR;
-    break;
-  default:
-    mode = cavc::PlineCombineMode::Union;
-    break;
-  }
-  auto results = cavc::combinePolylines(pline_a->data, pline_b->data, mode);
+  cavc::PlineCombineMode mode = cavc::PlineCombineMode::Union;
+  to_cpp_combine_mode(combine_mode, mode);
+  auto results = cavc::combinePolylines(to_cpp_pline(pline_a), to_cpp_pline(pline_b), mode);
 
   *remaining = new cavc_pline_list();
   *subtracted = new cavc_pline_list();
@@ -542,24 +1308,162 @@ void cavc_combine_plines(cavc_pline const *pline_a, cavc_pline const *pline_b, i
   CAVC_END_TRY_CATCH
 }
 
+void cavc_parallel_offset_batch(cavc_vertex const *vertex_data, uint32_t const *offsets,
+                                int const *is_closed, uint32_t pline_count, cavc_real delta,
+                                cavc_parallel_offset_options options, uint32_t thread_count,
+                                cavc_pline_buffer *output) {
+  CAVC_ASSERT(offsets, "null offsets not allowed");
+  CAVC_ASSERT(vertex_data || offsets[pline_count] == 0, "null vertex_data not allowed");
+  CAVC_ASSERT(is_closed || pline_count == 0, "null is_closed not allowed");
+  CAVC_ASSERT(output, "null output not allowed");
+  CAVC_BEGIN_TRY_CATCH
+  clear_buffer(output);
+  if (!std::isfinite(delta) || !is_valid_parallel_offset_options(options)) {
+    return;
+  }
+
+  auto const cpp_options = to_cpp_parallel_offset_options(options);
+  auto const eps = cavc::utils::currentEpsilonConfig<cavc_real>();
+  std::vector<std::vector<cavc::Polyline<cavc_real>>> results(pline_count);
+  std::size_t const worker_count =
+      cavc::internal::parallelWorkerCount(pline_count, 1, thread_count);
+  auto offset_pline = [&](std::size_t i, std::size_t) {
+    auto view = to_cpp_batch_view(vertex_data, offsets, i, is_closed[i] != 0);
+    results[i] = cavc::parallelOffset(view, delta, cpp_options, eps);
+  };
+  cavc::internal::parallelFor<cavc_real>(pline_count, worker_count, offset_pline);
+
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    append_to_buffer(results[i], i, output);
+  }
+  CAVC_END_TRY_CATCH
+}
+
+void cavc_combine_plines_batch(cavc_vertex const *vertex_data_a, uint32_t const *offsets_a,
+                               cavc_vertex const *vertex_data_b, uint32_t const *offsets_b,
+                               uint32_t pair_count, int combine_mode, uint32_t thread_count,
+                               cavc_pline_buffer *remaining, cavc_pline_buffer *subtracted) {
+  CAVC_ASSERT(offsets_a && offsets_b, "null offsets not allowed");
+  CAVC_ASSERT(vertex_data_a || offsets_a[pair_count] == 0, "null vertex_data_a not allowed");
+  CAVC_ASSERT(vertex_data_b || offsets_b[pair_count] == 0, "null vertex_data_b not allowed");
+  CAVC_ASSERT(combine_mode >= 0 && combine_mode <= 3, "combine_mode must be 0, 1, 2, or 3");
+  CAVC_ASSERT(remaining, "null remaining not allowed");
+  CAVC_ASSERT(subtracted, "null subtracted not allowed");
+  CAVC_BEGIN_TRY_CATCH
+  clear_buffer(remaining);
+  clear_buffer(subtracted);
+  cavc::PlineCombineMode mode;
+  if (!to_cpp_combine_mode(combine_mode, mode)) {
+    return;
+  }
+
+  auto const eps = cavc::utils::currentEpsilonConfig<cavc_real>();
+  std::vector<cavc::CombineResult<cavc_real>> results(pair_count);
+  std::size_t const worker_count =
+      cavc::internal::parallelWorkerCount(pair_count, 1, thread_count);
+  std::vector<cavc::Polyline<cavc_real>> scratch_a(worker_count);
+  std::vector<cavc::Polyline<cavc_real>> scratch_b(worker_count);
+  auto combine_pair = [&](std::size_t i, std::size_t worker) {
+    assign_from_view(scratch_a[worker], to_cpp_batch_view(vertex_data_a, offsets_a, i, true));
+    assign_from_view(scratch_b[worker], to_cpp_batch_view(vertex_data_b, offsets_b, i, true));
+    results[i] = cavc::combinePolylines(scratch_a[worker], scratch_b[worker], mode, eps);
+  };
+  cavc::internal::parallelFor<cavc_real>(pair_count, worker_count, combine_pair);
+
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    append_to_buffer(results[i].remaining, i, remaining);
+    append_to_buffer(results[i].subtracted, i, subtracted);
+  }
+  CAVC_END_TRY_CATCH
+}
+
+void cavc_get_extents_batch(cavc_vertex const *vertex_data, uint32_t const *offsets,
+                            int const *is_closed, uint32_t pline_count, uint32_t thread_count,
+                            cavc_real *extents_out) {
+  CAVC_ASSERT(offsets, "null offsets not allowed");
+  CAVC_ASSERT(vertex_data || offsets[pline_count] == 0, "null vertex_data not allowed");
+  CAVC_ASSERT(is_closed || pline_count == 0, "null is_closed not allowed");
+  CAVC_ASSERT(extents_out || pline_count == 0, "null extents_out not allowed");
+  CAVC_BEGIN_TRY_CATCH
+  std::size_t const worker_count =
+      cavc::internal::parallelWorkerCount(pline_count, min_extents_per_worker, thread_count);
+  std::vector<cavc::Polyline<cavc_real>> scratch(worker_count);
+  std::span<cavc_real> output_span(extents_out, std::size_t(4) * pline_count);
+  auto extents_of_pline = [&](std::size_t i, std::size_t worker) {
+    assign_from_view(scratch[worker], to_cpp_batch_view(vertex_data, offsets, i, is_closed[i] != 0));
+    auto result = cavc::getExtents(scratch[worker]);
+    output_span[4 * i] = result.xMin;
+    output_span[4 * i + 1] = result.yMin;
+    output_span[4 * i + 2] = result.xMax;
+    output_span[4 * i + 3] = result.yMax;
+  };
+  cavc::internal::parallelFor<cavc_real>(pline_count, worker_count, extents_of_pline);
+  CAVC_END_TRY_CATCH
+}
+
+void cavc_get_winding_numbers(cavc_vertex const *vertex_data, uint32_t vertex_count,
+                              int is_closed, cavc_point const *points, uint32_t point_count,
+                              uint32_t thread_count, int *winding_numbers_out) {
+  CAVC_ASSERT(vertex_data || vertex_count == 0, "null vertex_data not allowed");
+  CAVC_ASSERT(points || point_count == 0, "null points not allowed");
+  CAVC_ASSERT(winding_numbers_out || point_count == 0, "null winding_numbers_out not allowed");
+  CAVC_BEGIN_TRY_CATCH
+  std::span<int> output_span(winding_numbers_out, point_count);
+  for_each_batch_point(vertex_data, vertex_count, is_closed, point_count, thread_count,
+                       [&](std::size_t i, cavc::Polyline<cavc_real> const &pline,
+                           cavc::StaticSpatialIndex<cavc_real> const *spatial_index,
+                           std::vector<std::size_t> &query_stack) {
+                         cavc::Vector2<cavc_real> const pt(points[i].x, points[i].y);
+                         output_span[i] =
+                             spatial_index == nullptr
+                                 ? cavc::getWindingNumber(pline, pt)
+                                 : cavc::getWindingNumber(pline, *spatial_index, pt, query_stack);
+                       });
+  CAVC_END_TRY_CATCH
+}
+
+void cavc_get_point_containments(cavc_vertex const *vertex_data, uint32_t vertex_count,
+                                 int is_closed, cavc_point const *points, uint32_t point_count,
+                                 cavc_real boundary_epsilon, uint32_t thread_count,
+                                 cavc_point_containment *containment_out) {
+  CAVC_ASSERT(vertex_data || vertex_count == 0, "null vertex_data not allowed");
+  CAVC_ASSERT(points || point_count == 0, "null points not allowed");
+  CAVC_ASSERT(containment_out || point_count == 0, "null containment_out not allowed");
+  CAVC_BEGIN_TRY_CATCH
+  std::span<cavc_point_containment> output_span(containment_out, point_count);
+  for_each_batch_point(
+      vertex_data, vertex_count, is_closed, point_count, thread_count,
+      [&](std::size_t i, cavc::Polyline<cavc_real> const &pline,
+          cavc::StaticSpatialIndex<cavc_real> const *spatial_index,
+          std::vector<std::size_t> &query_stack) {
+        cavc::Vector2<cavc_real> const pt(points[i].x, points[i].y);
+        output_span[i] = to_api_point_containment(
+            spatial_index == nullptr
+                ? cavc::getPointContainment(pline, pt, boundary_epsilon)
+                : cavc::getPointContainment(pline, *spatial_index, pt, boundary_epsilon,
+                                            query_stack));
+      });
+  CAVC_END_TRY_CATCH
+}
+
 cavc_real cavc_get_path_length(cavc_pline const *pline) {
   CAVC_ASSERT(pline, "null pline not allowed");
   CAVC_BEGIN_TRY_CATCH
-  return cavc::getPathLength(pline->data);
+  return cavc::getPathLength(to_cpp_pline(pline));
   CAVC_END_TRY_CATCH
 }
 
 cavc_real cavc_get_area(cavc_pline const *pline) {
   CAVC_ASSERT(pline, "null pline not allowed");
   CAVC_BEGIN_TRY_CATCH
-  return cavc::getArea(pline->data);
+  return cavc::getArea(to_cpp_pline(pline));
   CAVC_END_TRY_CATCH
 }
 
 int cavc_get_winding_number(cavc_pline const *pline, cavc_point point) {
   CAVC_ASSERT(pline, "null pline not allowed");
   CAVC_BEGIN_TRY_CATCH
-  return cavc::getWindingNumber(pline->data, cavc::Vector2<cavc_real>(point.x, point.y));
+  return cavc::getWindingNumber(to_cpp_pline(pline), cavc::Vector2<cavc_real>(point.x, point.y));
   CAVC_END_TRY_CATCH
 }
 
@@ -567,18 +1471,8 @@ cavc_point_containment cavc_get_point_containment(cavc_pline const *pline, cavc_
                                                   cavc_real boundary_epsilon) {
   CAVC_ASSERT(pline, "null pline not allowed");
   CAVC_BEGIN_TRY_CATCH
-  auto containment = cavc::getPointContainment(
-      pline->data, cavc::Vector2<cavc_real>(point.x, point.y), boundary_epsilon);
-  switch (containment) {
-  case cavc::PointContainment::Outside:
-    return CAVC_POINT_OUTSIDE;
-  case cavc::PointContainment::Inside:
-    return CAVC_POINT_INSIDE;
-  case cavc::PointContainment::OnBoundary:
-    return CAVC_POINT_ON_BOUNDARY;
-  }
-  CAVC_ASSERT(false, "Unhandled point containment enum");
-  return CAVC_POINT_OUTSIDE;
+  return to_api_point_containment(cavc::getPointContainment(
+      to_cpp_pline(pline), cavc::Vector2<cavc_real>(point.x, point.y), boundary_epsilon));
   CAVC_END_TRY_CATCH
 }
 
@@ -586,7 +1480,7 @@ void cavc_get_extents(cavc_pline const *pline, cavc_real *min_x, cavc_real *min_
                       cavc_real *max_y) {
   CAVC_ASSERT(pline, "null pline not allowed");
   CAVC_BEGIN_TRY_CATCH
-  auto result = cavc::getExtents(pline->data);
+  auto result = cavc::getExtents(to_cpp_pline(pline));
   *min_x = result.xMin;
   *min_y = result.yMin;
   *max_x = result.xMax;
@@ -598,10 +1492,10 @@ void cavc_get_closest_point(cavc_pline const *pline, cavc_point input_point,
                             uint32_t *closest_start_index, cavc_point *closest_point,
                             cavc_real *distance) {
   CAVC_ASSERT(pline, "null pline not allowed");
-  CAVC_ASSERT(pline->data.size() != 0, "empty pline not allowed");
+  CAVC_ASSERT(!pline->vertexes.empty(), "empty pline not allowed");
   CAVC_BEGIN_TRY_CATCH
   cavc::ClosestPoint<cavc_real> closestPoint(
-      pline->data, cavc::Vector2<cavc_real>(input_point.x, input_point.y));
+      to_cpp_pline(pline), cavc::Vector2<cavc_real>(input_point.x, input_point.y));
   *closest_start_index = static_cast<uint32_t>(closestPoint.index());
   *closest_point = cavc_point{closestPoint.point().x(), closestPoint.point().y()};
   *distance = closestPoint.distance();
@@ -627,3 +1521,350 @@ void cavc_reset_tolerances(void) {
   cavc::utils::resetEpsilonConfig<cavc_real>();
   CAVC_END_TRY_CATCH
 }
+
+void cavc_set_allocator(cavc_malloc_fn malloc_fn, cavc_free_fn free_fn, void *user_data) {
+  CAVC_ASSERT((malloc_fn == nullptr) == (free_fn == nullptr),
+              "malloc_fn and free_fn must both be set or both be null");
+  CAVC_BEGIN_TRY_CATCH
+  current_allocator_hooks() = allocator_hooks{malloc_fn, free_fn, user_data};
+  CAVC_END_TRY_CATCH
+}
+
+cavc_arena *cavc_arena_new(uint32_t block_size) {
+  CAVC_BEGIN_TRY_CATCH
+  constexpr std::size_t default_block_size = 64 * 1024;
+  return new cavc_arena(block_size == 0 ? default_block_size : block_size);
+  CAVC_END_TRY_CATCH
+}
+
+void cavc_arena_delete(cavc_arena *arena) {
+  CAVC_BEGIN_TRY_CATCH
+  delete arena;
+  CAVC_END_TRY_CATCH
+}
+
+void cavc_arena_reset(cavc_arena *arena) {
+  CAVC_ASSERT(arena, "null arena not allowed");
+  CAVC_BEGIN_TRY_CATCH
+  arena->reset();
+  CAVC_END_TRY_CATCH
+}
+
+uint64_t cavc_arena_bytes_used(cavc_arena const *arena) {
+  CAVC_ASSERT(arena, "null arena not allowed");
+  CAVC_BEGIN_TRY_CATCH
+  return arena->bytes_used;
+  CAVC_END_TRY_CATCH
+}
+
+uint64_t cavc_arena_bytes_reserved(cavc_arena const *arena) {
+  CAVC_ASSERT(arena, "null arena not allowed");
+  CAVC_BEGIN_TRY_CATCH
+  return arena->bytes_reserved();
+  CAVC_END_TRY_CATCH
+}
+
+// thread pool that runs submitted cavc_job's in submission order
+class job_pool {
+public:
+  explicit job_pool(std::size_t thread_count) {
+    m_threads.reserve(thread_count);
+    for (std::size_t i = 0; i < thread_count; ++i) {
+      m_threads.emplace_back([this] { run(); });
+    }
+  }
+
+  job_pool(job_pool const &) = delete;
+  job_pool &operator=(job_pool const &) = delete;
+
+  // cancels pending jobs and waits for all threads to finish
+  ~job_pool() {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stopping = true;
+      for (cavc_job *job : m_queue) {
+        job->token.requestCancel();
+      }
+    }
+    m_queue_cv.notify_all();
+    for (auto &thread : m_threads) {
+      thread.join();
+    }
+  }
+
+  void submit(cavc_job *job) {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (m_stopping) {
+        job->token.requestCancel();
+      }
+      m_queue.push_back(job);
+    }
+    m_queue_cv.notify_one();
+  }
+
+private:
+  void run() {
+    while (true) {
+      cavc_job *job = nullptr;
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_queue_cv.wait(lock, [&] { return m_stopping || !m_queue.empty(); });
+        if (m_queue.empty()) {
+          return;
+        }
+        job = m_queue.front();
+        m_queue.pop_front();
+      }
+      execute(*job);
+    }
+  }
+
+  static void execute(cavc_job &job) {
+    CAVC_BEGIN_TRY_CATCH
+    if (job.token.check() == cavc::OperationStatus::Completed) {
+      job.status.store(CAVC_JOB_RUNNING);
+      cavc::ScopedCancellationToken cancel_scope(&job.token);
+      job.work(job);
+    }
+
+    // status is only recorded by a check that stopped the job, a job that finished before
+    // observing a cancel request (or its deadline) keeps its results
+    cavc_job_status final_status = CAVC_JOB_COMPLETED;
+    if (job.token.status() == cavc::OperationStatus::Cancelled) {
+      final_status = CAVC_JOB_CANCELLED;
+    } else if (job.token.status() == cavc::OperationStatus::TimedOut) {
+      final_status = CAVC_JOB_TIMED_OUT;
+    }
+    if (final_status != CAVC_JOB_COMPLETED) {
+      // results of a cancelled or timed out job may be incomplete
+      job.results[0].clear();
+      job.results[1].clear();
+    }
+    job.work = nullptr;
+    job.status.store(final_status);
+    if (job.callback != nullptr) {
+      job.callback(&job, final_status, job.user_data);
+    }
+    {
+      std::lock_guard<std::mutex> lock(job.mutex);
+      job.finished = true;
+    }
+    job.finished_cv.notify_all();
+    job.release();
+    CAVC_END_TRY_CATCH
+  }
+
+  std::vector<std::thread> m_threads;
+  std::deque<cavc_job *> m_queue;
+  std::mutex m_mutex;
+  std::condition_variable m_queue_cv;
+  bool m_stopping = false;
+};
+
+static std::mutex &job_pool_mutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+static std::unique_ptr<job_pool> &current_job_pool() {
+  static std::unique_ptr<job_pool> pool;
+  return pool;
+}
+
+// helper to create a job and submit it to the job pool (creating the pool if needed), the deadline
+// is set before the job is queued so it always applies
+static cavc_job *submit_job(std::function<void(cavc_job &)> &&work, uint32_t timeout_ms,
+                            cavc_job_callback callback, void *user_data) {
+  // tolerances in effect when submitting are used by the job
+  auto const eps = cavc::utils::currentEpsilonConfig<cavc_real>();
+  auto *job = new cavc_job(
+      [eps, work = std::move(work)](cavc_job &j) {
+        cavc::utils::ScopedEpsilonContext<cavc_real> eps_context(eps);
+        work(j);
+      },
+      callback, user_data);
+  if (timeout_ms != CAVC_JOB_NO_TIMEOUT) {
+    job->token.setTimeout(std::chrono::milliseconds(timeout_ms));
+  }
+
+  std::lock_guard<std::mutex> lock(job_pool_mutex());
+  auto &pool = current_job_pool();
+  if (!pool) {
+    pool = std::make_unique<job_pool>(cavc::internal::hardwareThreadCount());
+  }
+  pool->submit(job);
+  return job;
+}
+
+// helper to copy api offset loops (must be closed with at least 2 vertexes) into polylines
+static std::vector<cavc::Polyline<cavc_real>>
+copy_offset_loop_plines(cavc_pline const *const *loops, uint32_t count) {
+  CAVC_ASSERT(count == 0 || loops != nullptr, "non-zero loop count requires loop pointer");
+  std::vector<cavc::Polyline<cavc_real>> result;
+  result.reserve(count);
+  for (uint32_t i = 0; i < count; ++i) {
+    CAVC_ASSERT(loops[i] != nullptr, "null loop pointer not allowed");
+    CAVC_ASSERT(loops[i]->is_closed, "offset loops must be closed");
+    CAVC_ASSERT(loops[i]->vertexes.size() > 1, "offset loops must have at least 2 vertices");
+    result.push_back(to_cpp_pline(loops[i]));
+  }
+  return result;
+}
+
+// the previous pool is destroyed (joining its threads) after job_pool_mutex is released so job
+// callbacks that submit follow up jobs while it is stopping do not deadlock
+void cavc_job_pool_init(uint32_t thread_count) {
+  CAVC_BEGIN_TRY_CATCH
+  std::unique_ptr<job_pool> previous;
+  {
+    std::lock_guard<std::mutex> lock(job_pool_mutex());
+    auto &pool = current_job_pool();
+    previous = std::move(pool);
+    pool = std::make_unique<job_pool>(thread_count == 0 ? cavc::internal::hardwareThreadCount()
+                                                        : thread_count);
+  }
+  previous.reset();
+  CAVC_END_TRY_CATCH
+}
+
+void cavc_job_pool_shutdown(void) {
+  CAVC_BEGIN_TRY_CATCH
+  std::unique_ptr<job_pool> previous;
+  {
+    std::lock_guard<std::mutex> lock(job_pool_mutex());
+    previous = std::move(current_job_pool());
+  }
+  previous.reset();
+  CAVC_END_TRY_CATCH
+}
+
+cavc_job *cavc_job_submit_parallel_offset(cavc_pline const *pline, cavc_real delta,
+                                          cavc_parallel_offset_options options,
+                                          uint32_t timeout_ms, cavc_job_callback callback,
+                                          void *user_data) {
+  CAVC_ASSERT(pline, "null pline not allowed");
+  CAVC_BEGIN_TRY_CATCH
+  return submit_job(
+      [input = to_cpp_pline(pline), delta, options](cavc_job &job) {
+        if (!std::isfinite(delta) || !is_valid_parallel_offset_options(options)) {
+          return;
+        }
+        job.results[0] =
+            cavc::parallelOffset(input, delta, to_cpp_parallel_offset_options(options));
+      },
+      timeout_ms, callback, user_data);
+  CAVC_END_TRY_CATCH
+}
+
+cavc_job *cavc_job_submit_combine_plines(cavc_pline const *pline_a, cavc_pline const *pline_b,
+                                         int combine_mode, uint32_t timeout_ms,
+                                         cavc_job_callback callback, void *user_data) {
+  CAVC_ASSERT(pline_a, "null pline_a not allowed");
+  CAVC_ASSERT(pline_b, "null pline_b not allowed");
+  CAVC_ASSERT(combine_mode >= 0 && combine_mode <= 3, "combine_mode must be 0, 1, 2, or 3");
+  CAVC_BEGIN_TRY_CATCH
+  cavc::PlineCombineMode mode = cavc::PlineCombineMode::Union;
+  to_cpp_combine_mode(combine_mode, mode);
+  return submit_job(
+      [a = to_cpp_pline(pline_a), b = to_cpp_pline(pline_b), mode](cavc_job &job) {
+        auto results = cavc::combinePolylines(a, b, mode);
+        job.results[0] = std::move(results.remaining);
+        job.results[1] = std::move(results.subtracted);
+      },
+      timeout_ms, callback, user_data);
+  CAVC_END_TRY_CATCH
+}
+
+cavc_job *cavc_job_submit_offset_islands(cavc_pline const *const *ccw_loops,
+                                         uint32_t ccw_loop_count,
+                                         cavc_pline const *const *cw_loops, uint32_t cw_loop_count,
+                                         cavc_real offset_delta, uint32_t max_threads,
+                                         uint32_t timeout_ms, cavc_job_callback callback,
+                                         void *user_data) {
+  CAVC_BEGIN_TRY_CATCH
+  auto ccw_plines = copy_offset_loop_plines(ccw_loops, ccw_loop_count);
+  auto cw_plines = copy_offset_loop_plines(cw_loops, cw_loop_count);
+
+  return submit_job(
+      [ccw_plines = std::move(ccw_plines), cw_plines = std::move(cw_plines), offset_delta,
+       max_threads](cavc_job &job) mutable {
+        if (!std::isfinite(offset_delta)) {
+          return;
+        }
+
+        // spatial indexes are built by the job rather than the submitting thread
+        auto to_offset_loops = [](std::vector<cavc::Polyline<cavc_real>> &plines,
+                                  std::vector<cavc::OffsetLoop<cavc_real>> &loops) {
+          loops.reserve(plines.size());
+          for (std::size_t i = 0; i < plines.size(); ++i) {
+            auto index = cavc::createApproxSpatialIndex(plines[i]);
+            loops.push_back({i, std::move(plines[i]), std::move(index)});
+          }
+        };
+
+        cavc::OffsetLoopSet<cavc_real> input;
+        to_offset_loops(ccw_plines, input.ccwLoops);
+        to_offset_loops(cw_plines, input.cwLoops);
+
+        cavc::ParallelOffsetIslands<cavc_real> islands;
+        islands.setMaxThreads(max_threads);
+        auto results = islands.compute(input, offset_delta);
+        for (auto &loop : results.ccwLoops) {
+          job.results[0].push_back(std::move(loop.polyline));
+        }
+        for (auto &loop : results.cwLoops) {
+          job.results[1].push_back(std::move(loop.polyline));
+        }
+      },
+      timeout_ms, callback, user_data);
+  CAVC_END_TRY_CATCH
+}
+
+cavc_job_status cavc_job_poll(cavc_job const *job) {
+  CAVC_ASSERT(job, "null job not allowed");
+  CAVC_BEGIN_TRY_CATCH
+  return job->status.load();
+  CAVC_END_TRY_CATCH
+}
+
+cavc_job_status cavc_job_wait(cavc_job *job) {
+  CAVC_ASSERT(job, "null job not allowed");
+  CAVC_BEGIN_TRY_CATCH
+  std::unique_lock<std::mutex> lock(job->mutex);
+  job->finished_cv.wait(lock, [&] { return job->finished; });
+  return job->status.load();
+  CAVC_END_TRY_CATCH
+}
+
+void cavc_job_cancel(cavc_job *job) {
+  CAVC_ASSERT(job, "null job not allowed");
+  CAVC_BEGIN_TRY_CATCH
+  job->token.requestCancel();
+  CAVC_END_TRY_CATCH
+}
+
+cavc_pline_list *cavc_job_release_result(cavc_job *job, uint32_t index) {
+  CAVC_ASSERT(job, "null job not allowed");
+  CAVC_ASSERT(index < 2, "index must be 0 or 1");
+  CAVC_ASSERT(job->status.load() == CAVC_JOB_COMPLETED || job->status.load() == CAVC_JOB_CANCELLED ||
+                  job->status.load() == CAVC_JOB_TIMED_OUT,
+              "job must be finished");
+  CAVC_BEGIN_TRY_CATCH
+  std::lock_guard<std::mutex> lock(job->mutex);
+  auto *result = new cavc_pline_list();
+  move_to_list(std::move(job->results[index]), result);
+  job->results[index].clear();
+  return result;
+  CAVC_END_TRY_CATCH
+}
+
+void cavc_job_delete(cavc_job *job) {
+  CAVC_BEGIN_TRY_CATCH
+  if (job == nullptr) {
+    return;
+  }
+  job->token.requestCancel();
+  job->release();
+  CAVC_END_TRY_CATCH
+}
@@ -0,0 +1,136 @@
+#include "allocationtracking.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace {
+std::atomic<std::uint64_t> allocationCount{0};
+std::atomic<std::uint64_t> allocatedBytes{0};
+std::atomic<std::uint64_t> liveBytes{0};
+std::atomic<std::uint64_t> peakLiveBytes{0};
+std::atomic<std::uint64_t> liveBytesAtReset{0};
+
+// every allocation is prefixed with a header holding the requested size so deallocation can
+// update the live bytes (unsized operator delete does not receive the size)
+constexpr std::size_t defaultHeaderSize = alignof(std::max_align_t);
+
+std::size_t headerSize(std::size_t alignment) { return std::max(defaultHeaderSize, alignment); }
+
+void recordAllocation(std::size_t size) {
+  allocationCount.fetch_add(1, std::memory_order_relaxed);
+  allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+  std::uint64_t const live = liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+  std::uint64_t peak = peakLiveBytes.load(std::memory_order_relaxed);
+  while (live > peak &&
+         !peakLiveBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+  }
+}
+
+void *trackedAllocate(std::size_t size, std::size_t alignment) {
+  std::size_t const header = headerSize(alignment);
+  void *block;
+  if (alignment <= defaultHeaderSize) {
+    block = std::malloc(header + size);
+  } else {
+    // aligned_alloc requires the size to be a multiple of the alignment
+    std::size_t const total = (header + size + alignment - 1) / alignment * alignment;
+#ifdef _MSC_VER
+    block = _aligned_malloc(total, alignment);
+#else
+    block = std::aligned_alloc(alignment, total);
+#endif
+  }
+
+  if (block == nullptr) {
+    return nullptr;
+  }
+
+  auto *userPtr = static_cast<unsigned char *>(block) + header;
+  *reinterpret_cast<std::size_t *>(userPtr - sizeof(std::size_t)) = size;
+  recordAllocation(size);
+  return userPtr;
+}
+
+void *trackedAllocateOrThrow(std::size_t size, std::size_t alignment) {
+  while (true) {
+    if (void *ptr = trackedAllocate(size, alignment)) {
+      return ptr;
+    }
+
+    std::new_handler handler = std::get_new_handler();
+    if (handler == nullptr) {
+      throw std::bad_alloc();
+    }
+    handler();
+  }
+}
+
+void trackedFree(void *ptr, std::size_t alignment) {
+  if (ptr == nullptr) {
+    return;
+  }
+
+  auto *userPtr = static_cast<unsigned char *>(ptr);
+  std::size_t const size = *reinterpret_cast<std::size_t *>(userPtr - sizeof(std::size_t));
+  liveBytes.fetch_sub(size, std::memory_order_relaxed);
+  void *block = userPtr - headerSize(alignment);
+#ifdef _MSC_VER
+  if (alignment > defaultHeaderSize) {
+    _aligned_free(block);
+    return;
+  }
+#endif
+  std::free(block);
+}
+} // namespace
+
+void resetAllocationStats() {
+  allocationCount.store(0, std::memory_order_relaxed);
+  allocatedBytes.store(0, std::memory_order_relaxed);
+  std::uint64_t const live = liveBytes.load(std::memory_order_relaxed);
+  liveBytesAtReset.store(live, std::memory_order_relaxed);
+  peakLiveBytes.store(live, std::memory_order_relaxed);
+}
+
+AllocationStats allocationStats() {
+  std::uint64_t const peak = peakLiveBytes.load(std::memory_order_relaxed);
+  std::uint64_t const atReset = liveBytesAtReset.load(std::memory_order_relaxed);
+  return {allocationCount.load(std::memory_order_relaxed),
+          allocatedBytes.load(std::memory_order_relaxed), peak > atReset ? peak - atReset : 0};
+}
+
+void *operator new(std::size_t size) { return trackedAllocateOrThrow(size, 0); }
+void *operator new[](std::size_t size) { return trackedAllocateOrThrow(size, 0); }
+void *operator new(std::size_t size, std::nothrow_t const &) noexcept {
+  return trackedAllocate(size, 0);
+}
+void *operator new[](std::size_t size, std::nothrow_t const &) noexcept {
+  return trackedAllocate(size, 0);
+}
+void *operator new(std::size_t size, std::align_val_t alignment) {
+  return trackedAllocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+  return trackedAllocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void *ptr) noexcept { trackedFree(ptr, 0); }
+void operator delete[](void *ptr) noexcept { trackedFree(ptr, 0); }
+void operator delete(void *ptr, std::size_t) noexcept { trackedFree(ptr, 0); }
+void operator delete[](void *ptr, std::size_t) noexcept { trackedFree(ptr, 0); }
+void operator delete(void *ptr, std::nothrow_t const &) noexcept { trackedFree(ptr, 0); }
+void operator delete[](void *ptr, std::nothrow_t const &) noexcept { trackedFree(ptr, 0); }
+void operator delete(void *ptr, std::align_val_t alignment) noexcept {
+  trackedFree(ptr, static_cast<std::size_t>(alignment));
+}
+void operator delete[](void *ptr, std::align_val_t alignment) noexcept {
+  trackedFree(ptr, static_cast<std::size_t>(alignment));
+}
+void operator delete(void *ptr, std::size_t, std::align_val_t alignment) noexcept {
+  trackedFree(ptr, static_cast<std::size_t>(alignment));
+}
+void operator delete[](void *ptr, std::size_t, std::align_val_t alignment) noexcept {
+  trackedFree(ptr, static_cast<std::size_t>(alignment));
+}
@@ -0,0 +1,37 @@
+#ifndef CAVC_ALLOCATIONTRACKING_H
+#define CAVC_ALLOCATIONTRACKING_H
+#include <benchmark/benchmark.h>
+#include <cstdint>
+
+// Global operator new/delete replacements that count allocations (allocationtracking.cpp, linked
+// into every benchmark executable by add_benchmark). Counts cover all threads and shared
+// libraries loaded into the process (e.g. the C API library).
+
+struct AllocationStats {
+  // operator new calls since the last reset
+  std::uint64_t allocationCount;
+  // bytes requested by operator new since the last reset
+  std::uint64_t allocatedBytes;
+  // highest live (allocated and not yet freed) bytes since the last reset, relative to the live
+  // bytes at the time of the reset
+  std::uint64_t peakLiveBytes;
+};
+
+void resetAllocationStats();
+AllocationStats allocationStats();
+
+// Reports allocations and bytes per iteration and peak live bytes as user counters, call
+// resetAllocationStats() right before the timing loop.
+inline void reportAllocationCounters(benchmark::State &state) {
+  AllocationStats const stats = allocationStats();
+  state.counters["allocs"] =
+      benchmark::Counter(static_cast<double>(stats.allocationCount), benchmark::Counter::kAvgIterations);
+  state.counters["allocBytes"] =
+      benchmark::Counter(static_cast<double>(stats.allocatedBytes), benchmark::Counter::kAvgIterations,
+                         benchmark::Counter::OneK::kIs1024);
+  state.counters["peakLiveBytes"] =
+      benchmark::Counter(static_cast<double>(stats.peakLiveBytes), benchmark::Counter::kDefaults,
+                         benchmark::Counter::OneK::kIs1024);
+}
+
+#endif // CAVC_ALLOCATIONTRACKING_H
@@ -0,0 +1,155 @@
+#include "cavc/plinesegment.hpp"
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Arc sweep predicate and the intrPlineSegs line-arc and arc-arc paths that filter their candidate
+// points with it. BM_arcSweepAngleBased times the previous formulation of pointWithinArcSweepAngle
+// (three atan2 calls plus angle normalization per test, kept here as the before reference) against
+// the current cross/dot product formulation on the same points.
+
+namespace {
+using cavc::PlineVertex;
+using cavc::Vector2;
+
+// previous angle based pointWithinArcSweepAngle
+bool angleBasedPointWithinArcSweep(Vector2<double> const &center, Vector2<double> const &arcStart,
+                                   Vector2<double> const &arcEnd, double bulge,
+                                   Vector2<double> const &point, double epsilon) {
+  double startAngle = cavc::utils::normalizeRadians(cavc::angle(center, arcStart));
+  double endAngle = cavc::utils::normalizeRadians(cavc::angle(center, arcEnd));
+  double sweepAngle = cavc::utils::deltaAngle(startAngle, endAngle);
+  if (bulge < 0.0 && sweepAngle > 0.0) {
+    sweepAngle -= cavc::utils::tau<double>();
+  } else if (bulge > 0.0 && sweepAngle < 0.0) {
+    sweepAngle += cavc::utils::tau<double>();
+  }
+
+  double testAngle = cavc::utils::normalizeRadians(cavc::angle(center, point));
+  return cavc::utils::angleIsWithinSweep(startAngle, sweepAngle, testAngle, epsilon);
+}
+
+struct SweepCase {
+  Vector2<double> center;
+  Vector2<double> arcStart;
+  Vector2<double> arcEnd;
+  double bulge;
+  Vector2<double> point;
+};
+
+// arcs of varying sweep and direction around a unit circle with test points all around them
+std::vector<SweepCase> makeSweepCases(std::size_t count) {
+  std::vector<SweepCase> result;
+  result.reserve(count);
+  Vector2<double> const center(2.0, -1.0);
+  for (std::size_t i = 0; i < count; ++i) {
+    double const t = static_cast<double>(i);
+    double const bulge = (i % 2 == 0 ? 1.0 : -1.0) * (0.05 + 0.9 * std::fmod(0.37 * t, 1.0));
+    double const startAngle = std::fmod(0.91 * t, cavc::utils::tau<double>());
+    double const endAngle = startAngle + 4.0 * std::atan(bulge);
+    double const testAngle = std::fmod(1.73 * t, cavc::utils::tau<double>());
+    result.push_back({center, cavc::pointOnCircle(1.0, center, startAngle),
+                      cavc::pointOnCircle(1.0, center, endAngle), bulge,
+                      cavc::pointOnCircle(1.0 + 0.01 * std::fmod(t, 5.0), center, testAngle)});
+  }
+  return result;
+}
+
+void BM_arcSweepAngleBased(benchmark::State &state) {
+  auto const cases = makeSweepCases(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    std::size_t count = 0;
+    for (auto const &c : cases) {
+      count += angleBasedPointWithinArcSweep(c.center, c.arcStart, c.arcEnd, c.bulge, c.point,
+                                             cavc::utils::realPrecision<double>());
+    }
+    benchmark::DoNotOptimize(count);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_arcSweepCrossProduct(benchmark::State &state) {
+  auto const cases = makeSweepCases(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    std::size_t count = 0;
+    for (auto const &c : cases) {
+      count += cavc::pointWithinArcSweepAngle(c.center, c.arcStart, c.arcEnd, c.bulge, c.point,
+                                              cavc::utils::realPrecision<double>());
+    }
+    benchmark::DoNotOptimize(count);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// segments from a closed wavy circle (alternating line and arc segments) and a copy shifted so
+// most segment pairs near the overlap region intersect
+struct SegmentPairs {
+  std::vector<PlineVertex<double>> lines;
+  std::vector<PlineVertex<double>> arcs;
+  std::vector<PlineVertex<double>> otherArcs;
+};
+
+SegmentPairs makeSegmentPairs(std::size_t count) {
+  SegmentPairs result;
+  auto addSegments = [&](std::vector<PlineVertex<double>> &target, double bulge, double shift) {
+    for (std::size_t i = 0; i < count; ++i) {
+      double const a1 = static_cast<double>(i) * cavc::utils::tau<double>() /
+                        static_cast<double>(count);
+      double const a2 = a1 + 3.0 * cavc::utils::tau<double>() / static_cast<double>(count);
+      target.emplace_back(cavc::pointOnCircle(10.0, Vector2<double>(shift, 0.0), a1), bulge);
+      target.emplace_back(cavc::pointOnCircle(10.0, Vector2<double>(shift, 0.0), a2), 0.0);
+    }
+  };
+  addSegments(result.lines, 0.0, 0.1);
+  addSegments(result.arcs, 0.3, 0.0);
+  addSegments(result.otherArcs, -0.2, 0.15);
+  return result;
+}
+
+void intrPlineSegsPairs(benchmark::State &state, std::vector<PlineVertex<double>> const &vSegs,
+                        std::vector<PlineVertex<double>> const &uSegs) {
+  for (auto _ : state) {
+    std::size_t intersectCount = 0;
+    for (std::size_t i = 0; i + 1 < vSegs.size(); i += 2) {
+      auto const result = cavc::intrPlineSegs(vSegs[i], vSegs[i + 1], uSegs[i], uSegs[i + 1]);
+      intersectCount += result.intrType != cavc::PlineSegIntrType::NoIntersect;
+    }
+    benchmark::DoNotOptimize(intersectCount);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(vSegs.size() / 2));
+}
+
+void BM_intrPlineSegsLineArc(benchmark::State &state) {
+  auto const pairs = makeSegmentPairs(static_cast<std::size_t>(state.range(0)));
+  intrPlineSegsPairs(state, pairs.lines, pairs.arcs);
+}
+
+void BM_intrPlineSegsArcArc(benchmark::State &state) {
+  auto const pairs = makeSegmentPairs(static_cast<std::size_t>(state.range(0)));
+  intrPlineSegsPairs(state, pairs.arcs, pairs.otherArcs);
+}
+
+void BM_closestPointOnArcSeg(benchmark::State &state) {
+  auto const pairs = makeSegmentPairs(static_cast<std::size_t>(state.range(0)));
+  auto const &arcs = pairs.arcs;
+  Vector2<double> const point(1.0, 2.0);
+  for (auto _ : state) {
+    double sum = 0.0;
+    for (std::size_t i = 0; i + 1 < arcs.size(); i += 2) {
+      sum += cavc::closestPointOnSeg(arcs[i], arcs[i + 1], point).x();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(arcs.size() / 2));
+}
+} // namespace
+
+BENCHMARK(BM_arcSweepAngleBased)->Arg(1024)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_arcSweepCrossProduct)->Arg(1024)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_intrPlineSegsLineArc)->Arg(1024)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_intrPlineSegsArcArc)->Arg(1024)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_closestPointOnArcSeg)->Arg(1024)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
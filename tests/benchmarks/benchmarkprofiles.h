@@ -1,6 +1,18 @@
+#include "allocationtracking.h"
+#include "benchmarkstats.h"
 #include "cavc/polyline.hpp"
+#include "polylinefactory.hpp"
 #include <benchmark/benchmark.h>
 
+// upper bound of the synthetic profile vertex count ranges (set by the build, see
+// CAVC_BENCHMARK_SYNTHETIC_MAX_VERTEXES in tests/benchmarks/CMakeLists.txt)
+#ifndef CAVC_SYNTHETIC_MAX_VERTEXES
+#define CAVC_SYNTHETIC_MAX_VERTEXES 100000
+#endif
+
+// fixed seed so every run (and every benchmark executable) sees the same synthetic inputs
+#define CAVC_SYNTHETIC_SEED 0x5EEDull
+
 struct TestProfile {
   std::size_t offsetCount;
   double offsetDelta;
@@ -152,6 +164,53 @@ inline TestProfile pathologicalProfile1(std::size_t segmentCount, double arcsToL
   return TestProfile(30, 1, std::move(pline));
 }
 
+inline cavc::Polyline<double> vertexesToPolyline(std::vector<cavc_vertex> const &vertexes,
+                                                 bool isClosed) {
+  cavc::Polyline<double> pline;
+  pline.isClosed() = isClosed;
+  pline.vertexes().reserve(vertexes.size());
+  for (auto const &v : vertexes) {
+    pline.addVertex(static_cast<double>(v.x), static_cast<double>(v.y),
+                    static_cast<double>(v.bulge));
+  }
+
+  return pline;
+}
+
+// synthetic profiles take the vertex count and arc percentage (benchmark args) and use a small
+// offset count since the inputs are large, offset delta is relative to the ~1 unit segment length
+inline TestProfile gearProfile(std::size_t vertexCount, std::size_t arcPercent) {
+  return TestProfile(2, 0.25,
+                     vertexesToPolyline(PolylineFactory::createGear(
+                                            vertexCount, static_cast<cavc_real>(arcPercent) / 100,
+                                            CAVC_SYNTHETIC_SEED),
+                                        true));
+}
+
+inline TestProfile coastlineProfile(std::size_t vertexCount, std::size_t arcPercent) {
+  return TestProfile(2, 0.25,
+                     vertexesToPolyline(PolylineFactory::createFractalCoastline(
+                                            vertexCount, static_cast<cavc_real>(arcPercent) / 100,
+                                            CAVC_SYNTHETIC_SEED),
+                                        true));
+}
+
+inline TestProfile spiralProfile(std::size_t vertexCount, std::size_t arcPercent) {
+  return TestProfile(2, 0.25,
+                     vertexesToPolyline(PolylineFactory::createSpiral(
+                                            vertexCount, static_cast<cavc_real>(arcPercent) / 100,
+                                            CAVC_SYNTHETIC_SEED),
+                                        false));
+}
+
+inline TestProfile randomWalkProfile(std::size_t vertexCount, std::size_t arcPercent) {
+  return TestProfile(2, 0.25,
+                     vertexesToPolyline(PolylineFactory::createRandomWalk(
+                                            vertexCount, static_cast<cavc_real>(arcPercent) / 100,
+                                            CAVC_SYNTHETIC_SEED),
+                                        false));
+}
+
 struct NoSetup {
   NoSetup(TestProfile const &) {}
 };
@@ -159,10 +218,14 @@ struct NoSetup {
 #define CAVC_BENCH_BODY(setupFunc, func)                                                           \
   auto setup = setupFunc(profile);                                                                 \
   state.counters["vertexCount"] = static_cast<double>(profile.pline.size());                       \
+  cavc::resetStats();                                                                              \
+  resetAllocationStats();                                                                          \
   for (auto _ : state) {                                                                           \
     (void)_;                                                                                       \
     func(setup, profile);                                                                          \
-  }
+  }                                                                                                \
+  reportAllocationCounters(state);                                                                 \
+  reportStatsCounters(state);
 
 #define CAVC_CREATE_SQUARE_BM(name, setupFunc, func, unit)                                         \
   static void BM_##name##Square(benchmark::State &state) {                                         \
@@ -249,6 +312,32 @@ struct NoSetup {
   }                                                                                                \
   BENCHMARK(BM_##name##Pathological1NoArcs)->Unit(unit)->Arg(10)->Arg(25)->Arg(50)->Arg(100);
 
+// synthetic profile benchmarks run over a range of vertex counts (args: vertex count, arc
+// percentage) and report the complexity so scaling curves can be tracked
+#define CAVC_SYNTHETIC_BM(name, shape, profileFunc, setupFunc, func, unit)                         \
+  static void BM_##name##shape(benchmark::State &state) {                                          \
+    auto profile = profileFunc(static_cast<std::size_t>(state.range(0)),                          \
+                               static_cast<std::size_t>(state.range(1)));                          \
+    CAVC_BENCH_BODY(setupFunc, func)                                                               \
+    state.SetComplexityN(static_cast<int64_t>(profile.pline.size()));                           \
+  }                                                                                                \
+  BENCHMARK(BM_##name##shape)                                                                      \
+      ->Unit(unit)                                                                                 \
+      ->ArgsProduct({benchmark::CreateRange(1000, CAVC_SYNTHETIC_MAX_VERTEXES, 10), {0, 50}})      \
+      ->Complexity();
+
+#define CAVC_CREATE_GEAR_BM(name, setupFunc, func, unit)                                           \
+  CAVC_SYNTHETIC_BM(name, Gear, gearProfile, setupFunc, func, unit)
+
+#define CAVC_CREATE_COASTLINE_BM(name, setupFunc, func, unit)                                      \
+  CAVC_SYNTHETIC_BM(name, Coastline, coastlineProfile, setupFunc, func, unit)
+
+#define CAVC_CREATE_SPIRAL_BM(name, setupFunc, func, unit)                                         \
+  CAVC_SYNTHETIC_BM(name, Spiral, spiralProfile, setupFunc, func, unit)
+
+#define CAVC_CREATE_RANDOMWALK_BM(name, setupFunc, func, unit)                                     \
+  CAVC_SYNTHETIC_BM(name, RandomWalk, randomWalkProfile, setupFunc, func, unit)
+
 #define CAVC_CREATE_BENCHMARKS(name, setupFunc, func, unit)                                        \
   CAVC_CREATE_SQUARE_BM(name, setupFunc, func, unit)                                               \
   CAVC_CREATE_DIAMOND_BM(name, setupFunc, func, unit)                                              \
@@ -258,6 +347,17 @@ struct NoSetup {
   CAVC_CREATE_PROFILE2_BM(name, setupFunc, func, unit)                                             \
   CAVC_CREATE_PATHOLOGICAL1_BM(name, setupFunc, func, unit)
 
+// closed synthetic profiles, kept out of CAVC_CREATE_BENCHMARKS since the full vertex count ranges
+// take long to run, only added where the scaling curve is tracked
+#define CAVC_CREATE_CLOSED_SYNTHETIC_BENCHMARKS(name, setupFunc, func, unit)                       \
+  CAVC_CREATE_GEAR_BM(name, setupFunc, func, unit)                                                 \
+  CAVC_CREATE_COASTLINE_BM(name, setupFunc, func, unit)
+
+// open synthetic profiles, only for functions accepting open polylines
+#define CAVC_CREATE_OPEN_SYNTHETIC_BENCHMARKS(name, setupFunc, func, unit)                         \
+  CAVC_CREATE_SPIRAL_BM(name, setupFunc, func, unit)                                               \
+  CAVC_CREATE_RANDOMWALK_BM(name, setupFunc, func, unit)
+
 #define CAVC_CREATE_NO_ARCS_BENCHMARKS(name, setupFunc, func, arcsToLinesError, unit)              \
   CAVC_CREATE_CIRCLE_NO_ARCS_BM(name, setupFunc, func, arcsToLinesError, unit)                     \
   CAVC_CREATE_ROUNDEDRECT_NO_ARCS_BM(name, setupFunc, func, arcsToLinesError, unit)                \
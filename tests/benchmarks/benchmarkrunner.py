@@ -0,0 +1,263 @@
+#!/usr/bin/env python3
+"""Runs the CavalierContours benchmark executables and compares results against a baseline.
+
+Every benchmark executable in the build directory is run with a fixed filter, min time and repetition count, results are
+merged into a single Google Benchmark JSON file. When a baseline JSON file (previous output of
+this script) is given, per case deltas of the median time are printed and the script exits with
+status 1 if any case is significantly slower.
+
+A case is significantly slower when its median time increased by more than the noise threshold:
+max(--threshold, --noise-factor * (baseline cv + current cv)) where cv is the coefficient of
+variation (stddev / mean) over the repetitions.
+
+Typical use (see the benchmark_baseline and benchmark_compare targets in CMakeLists.txt):
+  benchmarkrunner.py --build-dir build --output baseline.json
+  benchmarkrunner.py --build-dir build --output current.json --baseline baseline.json
+  benchmarkrunner.py --compare-only current.json --baseline baseline.json
+"""
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+import tempfile
+
+# profile shapes from benchmarkprofiles.h plus the smallest synthetic size, the full synthetic
+# ranges take too long for routine comparisons
+PROFILE_FILTER = (
+    r"(Square|Diamond|Circle|RoundedRect|Profile1|Profile2|Pathological1)(NoArcs)?(/|$)"
+    r"|(Gear|Coastline|Spiral|RandomWalk)/1000/"
+)
+
+# cases without arguments plus the smallest synthetic size
+SMALLEST_SYNTHETIC_FILTER = r"^[^/]*$|/1000/"
+
+# filter for executables found in the build directory that have no entry below
+DEFAULT_FILTER = "."
+
+# executable name -> benchmark filter, every executable added with add_benchmark in CMakeLists.txt
+DEFAULT_SUITES = {
+    "offsetbenchmarks": PROFILE_FILTER,
+    "combinebenchmarks": PROFILE_FILTER,
+    "extentsbenchmarks": PROFILE_FILTER,
+    "windingnumberbenchmarks": PROFILE_FILTER,
+    "areabenchmarks": PROFILE_FILTER,
+    "pathlengthbenchmarks": PROFILE_FILTER,
+    "spatialindexbenchmarks": PROFILE_FILTER,
+    "crossapibenchmarks": PROFILE_FILTER,
+    "clipperbenchmarks": PROFILE_FILTER,
+    "offsethardeningbenchmarks": SMALLEST_SYNTHETIC_FILTER,
+    "offsetislandsbenchmarks": (r"Indices(Scalar|Batch)/|LargeScale/|PerforatedPlate/1000$"
+                                r"|SyntheticPlate/100/|ComputeSteps/"),
+    "memorybenchmarks": r"(Offset|Polylines|SpatialIndex)/1000/|Islands/100/",
+    "epsilonbenchmarks": r"/1000$",
+    "offsetfuzzbenchmarks": DEFAULT_FILTER,
+    "arcsweepbenchmarks": DEFAULT_FILTER,
+    "capibatchbenchmarks": DEFAULT_FILTER,
+    "throughputbenchmarks": DEFAULT_FILTER,
+}
+
+EXIT_REGRESSION = 1
+EXIT_ERROR = 2
+
+
+def executable_path(build_dir, name):
+    for candidate in (name, name + ".exe"):
+        path = os.path.join(build_dir, candidate)
+        if os.path.isfile(path):
+            return path
+    return None
+
+
+def run_suite(path, name, bench_filter, min_time, repetitions):
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        out_path = os.path.join(tmp_dir, name + ".json")
+        command = [
+            path,
+            "--benchmark_filter=" + bench_filter,
+            "--benchmark_min_time=" + min_time,
+            "--benchmark_repetitions=" + str(repetitions),
+            "--benchmark_report_aggregates_only=true",
+            "--benchmark_out_format=json",
+            "--benchmark_out=" + out_path,
+        ]
+        print("running " + " ".join(command), flush=True)
+        subprocess.run(command, check=True, stdout=subprocess.DEVNULL)
+        with open(out_path, "r", encoding="utf-8") as f:
+            return json.load(f)
+
+
+def discover_suites(build_dir):
+    """Returns DEFAULT_SUITES plus any other *benchmarks executable in build_dir."""
+    suites = dict(DEFAULT_SUITES)
+    if os.path.isdir(build_dir):
+        for entry in sorted(os.listdir(build_dir)):
+            name = entry[:-len(".exe")] if entry.endswith(".exe") else entry
+            if (name.endswith("benchmarks") and name not in suites
+                    and os.access(os.path.join(build_dir, entry), os.X_OK)):
+                suites[name] = DEFAULT_FILTER
+    return suites
+
+
+def run_benchmarks(args):
+    merged = {"context": None, "benchmarks": []}
+    suites = discover_suites(args.build_dir)
+    names = args.suite if args.suite else list(suites)
+    for name in names:
+        path = executable_path(args.build_dir, name)
+        if path is None:
+            # optional executables (clipper, C API) are not always built
+            if args.suite:
+                print("warning: benchmark executable '%s' not found in %s, skipped"
+                      % (name, args.build_dir))
+            continue
+        bench_filter = suites.get(name, DEFAULT_FILTER)
+        result = run_suite(path, name, bench_filter, args.min_time, args.repetitions)
+        if merged["context"] is None:
+            merged["context"] = result.get("context")
+        for bench in result.get("benchmarks", []):
+            bench["executable"] = name
+            merged["benchmarks"].append(bench)
+    return merged
+
+
+def load_json(path):
+    with open(path, "r", encoding="utf-8") as f:
+        return json.load(f)
+
+
+def summarize(result):
+    """Returns {case name: (median time ns, cv)} from aggregate entries."""
+    to_ns = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+    stats = {}
+    for bench in result.get("benchmarks", []):
+        # complexity (BigO/RMS) and cv aggregates are not times
+        if (bench.get("run_type") != "aggregate"
+                or bench.get("aggregate_name") not in ("mean", "median", "stddev")):
+            continue
+        key = bench.get("executable", "") + ":" + bench["run_name"]
+        entry = stats.setdefault(key, {})
+        entry[bench["aggregate_name"]] = bench["real_time"] * to_ns.get(bench.get("time_unit"), 1.0)
+
+    summary = {}
+    for key, entry in stats.items():
+        if "median" not in entry:
+            continue
+        mean = entry.get("mean", entry["median"])
+        cv = entry.get("stddev", 0.0) / mean if mean > 0.0 else 0.0
+        summary[key] = (entry["median"], cv)
+    return summary
+
+
+def format_time(ns):
+    for unit, scale in (("s", 1e9), ("ms", 1e6), ("us", 1e3)):
+        if ns >= scale:
+            return "%.3f %s" % (ns / scale, unit)
+    return "%.1f ns" % ns
+
+
+def compare(baseline, current, threshold, noise_factor):
+    base_summary = summarize(baseline)
+    curr_summary = summarize(current)
+    slower = []
+    faster = 0
+    name_width = max([len(k) for k in curr_summary] + [10])
+    print()
+    print("%-*s %12s %12s %9s %9s  %s" % (name_width, "case", "baseline", "current", "delta",
+                                          "noise", "status"))
+    for key in sorted(curr_summary):
+        curr_time, curr_cv = curr_summary[key]
+        if key not in base_summary:
+            print("%-*s %12s %12s %9s %9s  %s" % (name_width, key, "-", format_time(curr_time),
+                                                  "-", "-", "new"))
+            continue
+        base_time, base_cv = base_summary[key]
+        delta = (curr_time - base_time) / base_time if base_time > 0.0 else 0.0
+        noise = max(threshold, noise_factor * (base_cv + curr_cv))
+        if delta > noise:
+            status = "SLOWER"
+            slower.append(key)
+        elif delta < -noise:
+            status = "faster"
+            faster += 1
+        else:
+            status = "~"
+        print("%-*s %12s %12s %+8.1f%% %8.1f%%  %s" % (name_width, key, format_time(base_time),
+                                                       format_time(curr_time), delta * 100.0,
+                                                       noise * 100.0, status))
+
+    missing = sorted(set(base_summary) - set(curr_summary))
+    for key in missing:
+        print("%-*s %12s %12s %9s %9s  %s" % (name_width, key,
+                                              format_time(base_summary[key][0]), "-", "-", "-",
+                                              "missing"))
+
+    print()
+    print("%d cases compared, %d significantly slower, %d significantly faster, %d missing"
+          % (len(curr_summary) - len(set(curr_summary) - set(base_summary)), len(slower), faster,
+             len(missing)))
+    return slower
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--build-dir", default=".",
+                        help="directory containing the benchmark executables")
+    parser.add_argument("--suite", action="append",
+                        help="only run this executable (may be repeated), default runs every "
+                        "*benchmarks executable in --build-dir")
+    parser.add_argument("--min-time", default="0.1",
+                        help="--benchmark_min_time passed to each executable")
+    parser.add_argument("--repetitions", type=int, default=5,
+                        help="repetitions per case (median and stddev are compared)")
+    parser.add_argument("--output", help="write merged benchmark JSON to this file")
+    parser.add_argument("--baseline", help="baseline JSON to compare against")
+    parser.add_argument("--compare-only", metavar="CURRENT_JSON",
+                        help="compare an existing result file instead of running benchmarks")
+    parser.add_argument("--threshold", type=float, default=5.0,
+                        help="minimum slowdown in percent reported as significant")
+    parser.add_argument("--noise-factor", type=float, default=2.0,
+                        help="multiple of the summed coefficients of variation treated as noise")
+    args = parser.parse_args()
+
+    if args.repetitions < 2:
+        parser.error("--repetitions must be at least 2 (stddev is needed for noise thresholds)")
+
+    try:
+        if args.compare_only:
+            current = load_json(args.compare_only)
+        else:
+            current = run_benchmarks(args)
+            if not current["benchmarks"]:
+                print("error: no benchmarks were run (check --build-dir)")
+                return EXIT_ERROR
+    except (OSError, subprocess.CalledProcessError, ValueError) as e:
+        print("error: %s" % e)
+        return EXIT_ERROR
+
+    if args.output:
+        with open(args.output, "w", encoding="utf-8") as f:
+            json.dump(current, f, indent=2)
+        print("wrote %s" % args.output)
+
+    if not args.baseline:
+        return 0
+
+    if not os.path.isfile(args.baseline):
+        print("error: baseline '%s' does not exist (create it with --output)" % args.baseline)
+        return EXIT_ERROR
+
+    slower = compare(load_json(args.baseline), current, args.threshold / 100.0,
+                     args.noise_factor)
+    if slower:
+        print("significant slowdowns:")
+        for key in slower:
+            print("  " + key)
+        return EXIT_REGRESSION
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
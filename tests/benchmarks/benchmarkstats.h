@@ -0,0 +1,30 @@
+#ifndef CAVC_BENCHMARKSTATS_H
+#define CAVC_BENCHMARKSTATS_H
+#include "cavc/stats.hpp"
+#include <benchmark/benchmark.h>
+
+// Reports the hot path counters (cavc/stats.hpp) accumulated on the benchmark thread as per
+// iteration user counters, call cavc::resetStats() right before the timing loop. Does nothing
+// unless the library is built with CAVC_ENABLE_STATS.
+inline void reportStatsCounters(benchmark::State &state) {
+  if constexpr (cavc::statsEnabled) {
+    cavc::Stats const stats = cavc::statsSnapshot();
+    auto add = [&](char const *name, std::uint64_t value) {
+      state.counters[name] =
+          benchmark::Counter(static_cast<double>(value), benchmark::Counter::kAvgIterations);
+    };
+    add("indexNodes", stats.spatialIndexNodesVisited);
+    add("indexBoxes", stats.spatialIndexBoxesTested);
+    add("intrLineLine", stats.intrLineLineCalls);
+    add("intrLineArc", stats.intrLineArcCalls);
+    add("intrArcLine", stats.intrArcLineCalls);
+    add("intrArcArc", stats.intrArcArcCalls);
+    add("pointValidForOffset", stats.pointValidForOffsetCalls);
+    add("fuzzyEqual", stats.fuzzyEqualCalls);
+    add("stitchVertexes", stats.stitchVertexesAppended);
+  } else {
+    (void)state;
+  }
+}
+
+#endif // CAVC_BENCHMARKSTATS_H
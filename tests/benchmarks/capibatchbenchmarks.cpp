@@ -0,0 +1,159 @@
+#include "cavaliercontours.h"
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// Compares one C API call per polyline/point against the batch C API functions on many small
+// inputs (where per call overhead dominates).
+
+namespace {
+// packed small closed polylines (8 vertex rounded squares) laid out on a grid
+struct PackedInput {
+  std::vector<cavc_vertex> vertexes;
+  std::vector<uint32_t> offsets{0};
+  std::vector<int> is_closed;
+  std::vector<cavc_pline *> plines;
+
+  explicit PackedInput(std::size_t pline_count) {
+    for (std::size_t i = 0; i < pline_count; ++i) {
+      double x = static_cast<double>(i % 100) * 20.0;
+      double y = static_cast<double>(i / 100) * 20.0;
+      std::vector<cavc_vertex> const pline = {
+          {x, y, 0.0},          {x + 8.0, y, 0.4142}, {x + 10.0, y + 2.0, 0.0},
+          {x + 10.0, y + 8.0, 0.4142}, {x + 8.0, y + 10.0, 0.0}, {x + 2.0, y + 10.0, 0.4142},
+          {x, y + 8.0, 0.0},    {x, y + 2.0, 0.4142}};
+      vertexes.insert(vertexes.end(), pline.begin(), pline.end());
+      offsets.push_back(static_cast<uint32_t>(vertexes.size()));
+      is_closed.push_back(1);
+      plines.push_back(cavc_pline_new(pline.data(), static_cast<uint32_t>(pline.size()), 1));
+    }
+  }
+
+  ~PackedInput() {
+    for (cavc_pline *pline : plines) {
+      cavc_pline_delete(pline);
+    }
+  }
+
+  PackedInput(PackedInput const &) = delete;
+  PackedInput &operator=(PackedInput const &) = delete;
+
+  uint32_t count() const { return static_cast<uint32_t>(is_closed.size()); }
+};
+
+// wavy closed polyline with a grid of query points over its extents
+struct PointInput {
+  std::vector<cavc_vertex> vertexes;
+  std::vector<cavc_point> points;
+  cavc_pline *pline;
+
+  PointInput(std::size_t vertex_count, std::size_t point_count) {
+    for (std::size_t i = 0; i < vertex_count; ++i) {
+      double angle = static_cast<double>(i) * 6.283185307179586 / static_cast<double>(vertex_count);
+      double radius = i % 2 == 0 ? 10.0 : 9.0;
+      vertexes.push_back({radius * std::cos(angle), radius * std::sin(angle), 0.0});
+    }
+    std::size_t const side = static_cast<std::size_t>(std::sqrt(static_cast<double>(point_count)));
+    for (std::size_t i = 0; i < side; ++i) {
+      for (std::size_t j = 0; j < side; ++j) {
+        points.push_back({-11.0 + 22.0 * static_cast<double>(i) / static_cast<double>(side),
+                          -11.0 + 22.0 * static_cast<double>(j) / static_cast<double>(side)});
+      }
+    }
+    pline = cavc_pline_new(vertexes.data(), static_cast<uint32_t>(vertexes.size()), 1);
+  }
+
+  ~PointInput() { cavc_pline_delete(pline); }
+
+  PointInput(PointInput const &) = delete;
+  PointInput &operator=(PointInput const &) = delete;
+};
+
+void BM_offsetPerCall(benchmark::State &state) {
+  PackedInput const input(static_cast<std::size_t>(state.range(0)));
+  cavc_parallel_offset_options const options = cavc_parallel_offset_default_options();
+  for (auto _ : state) {
+    for (cavc_pline *pline : input.plines) {
+      cavc_pline_list *result = nullptr;
+      cavc_parallel_offset(pline, 0.5, &result, options);
+      cavc_pline_list_delete(result);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_offsetBatch(benchmark::State &state) {
+  PackedInput const input(static_cast<std::size_t>(state.range(0)));
+  cavc_parallel_offset_options const options = cavc_parallel_offset_default_options();
+  cavc_pline_buffer *output = cavc_pline_buffer_new();
+  uint32_t const thread_count = static_cast<uint32_t>(state.range(1));
+  for (auto _ : state) {
+    cavc_parallel_offset_batch(input.vertexes.data(), input.offsets.data(),
+                               input.is_closed.data(), input.count(), 0.5, options, thread_count,
+                               output);
+  }
+  cavc_pline_buffer_delete(output);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_extentsPerCall(benchmark::State &state) {
+  PackedInput const input(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    double sum = 0.0;
+    for (cavc_pline *pline : input.plines) {
+      cavc_real min_x, min_y, max_x, max_y;
+      cavc_get_extents(pline, &min_x, &min_y, &max_x, &max_y);
+      sum += max_x - min_x;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_extentsBatch(benchmark::State &state) {
+  PackedInput const input(static_cast<std::size_t>(state.range(0)));
+  std::vector<cavc_real> extents(4 * input.plines.size());
+  uint32_t const thread_count = static_cast<uint32_t>(state.range(1));
+  for (auto _ : state) {
+    cavc_get_extents_batch(input.vertexes.data(), input.offsets.data(), input.is_closed.data(),
+                           input.count(), thread_count, extents.data());
+    benchmark::DoNotOptimize(extents.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_windingNumberPerCall(benchmark::State &state) {
+  PointInput const input(static_cast<std::size_t>(state.range(0)), 10000);
+  for (auto _ : state) {
+    int sum = 0;
+    for (cavc_point const &pt : input.points) {
+      sum += cavc_get_winding_number(input.pline, pt);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(input.points.size()));
+}
+
+void BM_windingNumberBatch(benchmark::State &state) {
+  PointInput const input(static_cast<std::size_t>(state.range(0)), 10000);
+  std::vector<int> winding_numbers(input.points.size());
+  uint32_t const thread_count = static_cast<uint32_t>(state.range(1));
+  for (auto _ : state) {
+    cavc_get_winding_numbers(input.vertexes.data(), static_cast<uint32_t>(input.vertexes.size()),
+                             1, input.points.data(), static_cast<uint32_t>(input.points.size()),
+                             thread_count, winding_numbers.data());
+    benchmark::DoNotOptimize(winding_numbers.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(input.points.size()));
+}
+} // namespace
+
+BENCHMARK(BM_offsetPerCall)->Arg(1000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_offsetBatch)->Args({1000, 1})->Args({1000, 0})->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_extentsPerCall)->Arg(10000);
+BENCHMARK(BM_extentsBatch)->Args({10000, 1})->Args({10000, 0});
+BENCHMARK(BM_windingNumberPerCall)->Arg(16)->Arg(1000);
+BENCHMARK(BM_windingNumberBatch)->Args({16, 1})->Args({1000, 1})->Args({1000, 0});
+
+BENCHMARK_MAIN();
@@ -0,0 +1,237 @@
+#include "cavaliercontours.h"
+#include "cavc/polylinecombine.hpp"
+#include "cavc/polylineoffset.hpp"
+#include "profileio.h"
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Times parallelOffset, combinePolylines, getExtents and getWindingNumber through the header only
+// C++ API and through the C API shared library on identical inputs with the same Google Benchmark
+// statistics, so the C API (FFI) overhead can be read off directly. Inputs are the standard
+// profiles or a profile file in the neutral text format (--profiles=<file>, see profileio.h and
+// profileexport) so the numbers can be reproduced on any machine and compared against other
+// implementations run on the same file.
+//
+// Benchmark names are <operation>/<profile>/<api> with api cpp or capi. Loop bodies match
+// offsetbenchmarks, combinebenchmarks (16 shifted copies, all 4 modes), extentsbenchmarks and
+// windingnumberbenchmarks (100 point grid). C API results are deleted inside the timed loop the
+// same as C++ results are destroyed.
+
+namespace {
+struct PlineDeleter {
+  void operator()(cavc_pline *pline) const { cavc_pline_delete(pline); }
+};
+using CPlinePtr = std::unique_ptr<cavc_pline, PlineDeleter>;
+
+CPlinePtr toCPline(cavc::Polyline<double> const &pline) {
+  std::vector<cavc_vertex> vertexes;
+  vertexes.reserve(pline.size());
+  for (auto const &v : pline.vertexes()) {
+    vertexes.push_back({v.x(), v.y(), v.bulge()});
+  }
+  return CPlinePtr(cavc_pline_new(vertexes.data(), static_cast<uint32_t>(vertexes.size()),
+                                  pline.isClosed() ? 1 : 0));
+}
+
+// shared inputs of one profile for both APIs
+struct ProfileInputs {
+  std::string name;
+  TestProfile profile;
+  CPlinePtr cPline;
+  std::vector<cavc::Polyline<double>> shiftedPlines;
+  std::vector<CPlinePtr> cShiftedPlines;
+  std::vector<cavc::Vector2<double>> testPts;
+
+  explicit ProfileInputs(NamedProfile const &named)
+      : name(named.name), profile(named.profile), cPline(toCPline(named.profile.pline)) {
+    auto extents = cavc::getExtents(profile.pline);
+    double halfWidth = (extents.xMax - extents.xMin) / 2.0;
+    double halfHeight = (extents.yMax - extents.yMin) / 2.0;
+
+    // same shifted copies as combinebenchmarks
+    std::size_t const shiftedCount = 16;
+    for (std::size_t i = 0; i < shiftedCount; ++i) {
+      double angle =
+          static_cast<double>(i) / static_cast<double>(shiftedCount) * cavc::utils::tau<double>();
+      auto shifted = profile.pline;
+      cavc::translatePolyline(shifted, {halfWidth * std::cos(angle), halfHeight * std::sin(angle)});
+      cShiftedPlines.push_back(toCPline(shifted));
+      shiftedPlines.push_back(std::move(shifted));
+    }
+
+    // same point grid as windingnumberbenchmarks
+    extents.expand(halfWidth);
+    double width = extents.xMax - extents.xMin;
+    double height = extents.yMax - extents.yMin;
+    std::size_t const gridDim = 10;
+    for (std::size_t i = 0; i < gridDim; ++i) {
+      for (std::size_t j = 0; j < gridDim; ++j) {
+        double x = static_cast<double>(i) / (gridDim - 1) * width + extents.xMin;
+        double y = static_cast<double>(j) / (gridDim - 1) * height + extents.yMin;
+        testPts.emplace_back(x, y);
+      }
+    }
+  }
+};
+
+void offsetCpp(benchmark::State &state, ProfileInputs const *inputs) {
+  auto const &profile = inputs->profile;
+  for (auto _ : state) {
+    (void)_;
+    for (std::size_t i = 1; i <= profile.offsetCount; ++i) {
+      double offset = static_cast<double>(i) * profile.offsetDelta;
+      benchmark::DoNotOptimize(cavc::parallelOffset(profile.pline, offset));
+      benchmark::DoNotOptimize(cavc::parallelOffset(profile.pline, -offset));
+    }
+  }
+}
+
+void offsetCApi(benchmark::State &state, ProfileInputs const *inputs) {
+  auto const &profile = inputs->profile;
+  cavc_parallel_offset_options const options = cavc_parallel_offset_default_options();
+  for (auto _ : state) {
+    (void)_;
+    for (std::size_t i = 1; i <= profile.offsetCount; ++i) {
+      double offset = static_cast<double>(i) * profile.offsetDelta;
+      cavc_pline_list *results = nullptr;
+      cavc_parallel_offset(inputs->cPline.get(), offset, &results, options);
+      cavc_pline_list_delete(results);
+      cavc_parallel_offset(inputs->cPline.get(), -offset, &results, options);
+      cavc_pline_list_delete(results);
+    }
+  }
+}
+
+void combineCpp(benchmark::State &state, ProfileInputs const *inputs) {
+  cavc::PlineCombineMode const modes[] = {
+      cavc::PlineCombineMode::Union, cavc::PlineCombineMode::Exclude,
+      cavc::PlineCombineMode::Intersect, cavc::PlineCombineMode::XOR};
+  for (auto _ : state) {
+    (void)_;
+    for (auto const &shifted : inputs->shiftedPlines) {
+      for (auto mode : modes) {
+        benchmark::DoNotOptimize(cavc::combinePolylines(inputs->profile.pline, shifted, mode));
+      }
+    }
+  }
+}
+
+void combineCApi(benchmark::State &state, ProfileInputs const *inputs) {
+  for (auto _ : state) {
+    (void)_;
+    for (auto const &shifted : inputs->cShiftedPlines) {
+      for (int mode = 0; mode < 4; ++mode) {
+        cavc_pline_list *remaining = nullptr;
+        cavc_pline_list *subtracted = nullptr;
+        cavc_combine_plines(inputs->cPline.get(), shifted.get(), mode, &remaining, &subtracted);
+        cavc_pline_list_delete(remaining);
+        cavc_pline_list_delete(subtracted);
+      }
+    }
+  }
+}
+
+void extentsCpp(benchmark::State &state, ProfileInputs const *inputs) {
+  for (auto _ : state) {
+    (void)_;
+    benchmark::DoNotOptimize(cavc::getExtents(inputs->profile.pline));
+  }
+}
+
+void extentsCApi(benchmark::State &state, ProfileInputs const *inputs) {
+  for (auto _ : state) {
+    (void)_;
+    cavc_real minX, minY, maxX, maxY;
+    cavc_get_extents(inputs->cPline.get(), &minX, &minY, &maxX, &maxY);
+    benchmark::DoNotOptimize(minX);
+    benchmark::DoNotOptimize(maxY);
+  }
+}
+
+void windingNumberCpp(benchmark::State &state, ProfileInputs const *inputs) {
+  for (auto _ : state) {
+    (void)_;
+    for (auto const &pt : inputs->testPts) {
+      benchmark::DoNotOptimize(cavc::getWindingNumber(inputs->profile.pline, pt));
+    }
+  }
+}
+
+void windingNumberCApi(benchmark::State &state, ProfileInputs const *inputs) {
+  for (auto _ : state) {
+    (void)_;
+    for (auto const &pt : inputs->testPts) {
+      benchmark::DoNotOptimize(cavc_get_winding_number(inputs->cPline.get(), {pt.x(), pt.y()}));
+    }
+  }
+}
+
+void registerPair(char const *operation, ProfileInputs const *inputs,
+                  void (*cppFunc)(benchmark::State &, ProfileInputs const *),
+                  void (*cApiFunc)(benchmark::State &, ProfileInputs const *),
+                  benchmark::TimeUnit unit) {
+  std::string const prefix = std::string(operation) + "/" + inputs->name + "/";
+  benchmark::RegisterBenchmark((prefix + "cpp").c_str(), cppFunc, inputs)->Unit(unit);
+  benchmark::RegisterBenchmark((prefix + "capi").c_str(), cApiFunc, inputs)->Unit(unit);
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  // strip --profiles=<file> before handing the arguments to google benchmark
+  char const *profilesFlag = "--profiles=";
+  char const *profilesPath = nullptr;
+  int argCount = 0;
+  for (int i = 0; i < argc; ++i) {
+    if (std::strncmp(argv[i], profilesFlag, std::strlen(profilesFlag)) == 0) {
+      profilesPath = argv[i] + std::strlen(profilesFlag);
+      continue;
+    }
+    argv[argCount++] = argv[i];
+  }
+
+  std::vector<NamedProfile> profiles;
+  if (profilesPath) {
+    std::ifstream file(profilesPath);
+    std::string error;
+    if (!file) {
+      std::cerr << "failed to open profile file '" << profilesPath << "'\n";
+      return 1;
+    }
+    if (!readProfiles(file, profiles, error)) {
+      std::cerr << "failed to read profile file '" << profilesPath << "': " << error << "\n";
+      return 1;
+    }
+  } else {
+    profiles = standardProfiles();
+  }
+
+  // inputs must outlive the registered benchmarks
+  std::vector<std::unique_ptr<ProfileInputs>> inputs;
+  for (auto const &named : profiles) {
+    inputs.push_back(std::make_unique<ProfileInputs>(named));
+  }
+
+  for (auto const &input : inputs) {
+    registerPair("offset", input.get(), offsetCpp, offsetCApi, benchmark::kMillisecond);
+    registerPair("extents", input.get(), extentsCpp, extentsCApi, benchmark::kNanosecond);
+    // combine and winding number only apply to closed polylines
+    if (input->profile.pline.isClosed()) {
+      registerPair("combine", input.get(), combineCpp, combineCApi, benchmark::kMicrosecond);
+      registerPair("windingNumber", input.get(), windingNumberCpp, windingNumberCApi,
+                   benchmark::kMicrosecond);
+    }
+  }
+
+  benchmark::Initialize(&argCount, argv);
+  if (benchmark::ReportUnrecognizedArguments(argCount, argv)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
@@ -0,0 +1,166 @@
+#include "cavc/polylineintersects.hpp"
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+// Compares reading tolerances from the global atomic config inside hot loops against reading them
+// once per call (explicit EpsilonConfig context passed to the entry point). The accessor benchmarks
+// compare the default accessor path (per thread context check, then the global atomic load) with
+// the previous accessor that only loaded the global atomic.
+
+namespace {
+using cavc::AABB;
+using cavc::Polyline;
+using cavc::utils::EpsilonConfig;
+
+// closed polyline approximating a circle with alternating line and arc segments
+Polyline<double> makeWavyCircle(std::size_t vertex_count, double radius, double center_x) {
+  Polyline<double> pline;
+  pline.isClosed() = true;
+  for (std::size_t i = 0; i < vertex_count; ++i) {
+    double angle =
+        static_cast<double>(i) * cavc::utils::tau<double>() / static_cast<double>(vertex_count);
+    double bulge = i % 2 == 0 ? 0.0 : 0.1;
+    pline.addVertex(center_x + radius * std::cos(angle), radius * std::sin(angle), bulge);
+  }
+  return pline;
+}
+
+void BM_segmentBoxesGlobalEpsilon(benchmark::State &state) {
+  auto const pline = makeWavyCircle(static_cast<std::size_t>(state.range(0)), 10.0, 0.0);
+  for (auto _ : state) {
+    double sum = 0.0;
+    pline.visitSegIndices([&](std::size_t i, std::size_t j) {
+      // default epsilon argument loads the global tolerance for every segment
+      AABB<double> box = cavc::createFastApproxBoundingBox(pline[i], pline[j]);
+      sum += box.xMax - box.xMin;
+      return true;
+    });
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_segmentBoxesExplicitEpsilon(benchmark::State &state) {
+  auto const pline = makeWavyCircle(static_cast<std::size_t>(state.range(0)), 10.0, 0.0);
+  for (auto _ : state) {
+    EpsilonConfig<double> const eps = cavc::utils::currentEpsilonConfig<double>();
+    double sum = 0.0;
+    pline.visitSegIndices([&](std::size_t i, std::size_t j) {
+      AABB<double> box = cavc::createFastApproxBoundingBox(pline[i], pline[j], eps.realPrecision);
+      sum += box.xMax - box.xMin;
+      return true;
+    });
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_fuzzyEqualGlobalEpsilon(benchmark::State &state) {
+  auto const pline = makeWavyCircle(static_cast<std::size_t>(state.range(0)), 10.0, 0.0);
+  for (auto _ : state) {
+    std::size_t count = 0;
+    for (std::size_t i = 1; i < pline.size(); ++i) {
+      count += cavc::fuzzyEqual(pline[i - 1].pos(), pline[i].pos()) ? 1 : 0;
+    }
+    benchmark::DoNotOptimize(count);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_fuzzyEqualExplicitEpsilon(benchmark::State &state) {
+  auto const pline = makeWavyCircle(static_cast<std::size_t>(state.range(0)), 10.0, 0.0);
+  for (auto _ : state) {
+    double const threshold = cavc::utils::currentEpsilonConfig<double>().realThreshold;
+    std::size_t count = 0;
+    for (std::size_t i = 1; i < pline.size(); ++i) {
+      count += cavc::fuzzyEqual(pline[i - 1].pos(), pline[i].pos(), threshold) ? 1 : 0;
+    }
+    benchmark::DoNotOptimize(count);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// tolerance accessor as it was before per thread contexts were added (global atomic load only)
+double baselineRealThreshold() {
+  return cavc::utils::epsilonConfig<double>().realThreshold.load(std::memory_order_relaxed);
+}
+
+void BM_realThresholdAccessorDefault(benchmark::State &state) {
+  auto const pline = makeWavyCircle(static_cast<std::size_t>(state.range(0)), 10.0, 0.0);
+  for (auto _ : state) {
+    std::size_t count = 0;
+    for (std::size_t i = 1; i < pline.size(); ++i) {
+      count += cavc::utils::fuzzyEqual(pline[i - 1].x(), pline[i].x(),
+                                       cavc::utils::realThreshold<double>())
+                   ? 1
+                   : 0;
+    }
+    benchmark::DoNotOptimize(count);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_realThresholdAccessorBaseline(benchmark::State &state) {
+  auto const pline = makeWavyCircle(static_cast<std::size_t>(state.range(0)), 10.0, 0.0);
+  for (auto _ : state) {
+    std::size_t count = 0;
+    for (std::size_t i = 1; i < pline.size(); ++i) {
+      count += cavc::utils::fuzzyEqual(pline[i - 1].x(), pline[i].x(), baselineRealThreshold())
+                   ? 1
+                   : 0;
+    }
+    benchmark::DoNotOptimize(count);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+struct IntersectsSetup {
+  Polyline<double> pline1;
+  Polyline<double> pline2;
+  cavc::StaticSpatialIndex<double> index1;
+
+  explicit IntersectsSetup(std::size_t vertex_count)
+      : pline1(makeWavyCircle(vertex_count, 10.0, 0.0)),
+        pline2(makeWavyCircle(vertex_count, 10.0, 5.0)),
+        index1(cavc::createApproxSpatialIndex(pline1)) {}
+};
+
+void BM_findIntersectsGlobalEpsilon(benchmark::State &state) {
+  IntersectsSetup const setup(static_cast<std::size_t>(state.range(0)));
+  cavc::PlineIntersectsResult<double> result;
+  for (auto _ : state) {
+    result.intersects.clear();
+    result.coincidentIntersects.clear();
+    cavc::findIntersects(setup.pline1, setup.pline2, setup.index1, result);
+    benchmark::DoNotOptimize(result.intersects.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_findIntersectsExplicitEpsilon(benchmark::State &state) {
+  IntersectsSetup const setup(static_cast<std::size_t>(state.range(0)));
+  EpsilonConfig<double> const eps = cavc::utils::getEpsilonConfig<double>();
+  cavc::PlineIntersectsResult<double> result;
+  for (auto _ : state) {
+    result.intersects.clear();
+    result.coincidentIntersects.clear();
+    cavc::findIntersects(setup.pline1, setup.pline2, setup.index1, result, eps);
+    benchmark::DoNotOptimize(result.intersects.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+} // namespace
+
+BENCHMARK(BM_segmentBoxesGlobalEpsilon)->Arg(1000)->Arg(100000);
+BENCHMARK(BM_segmentBoxesExplicitEpsilon)->Arg(1000)->Arg(100000);
+BENCHMARK(BM_fuzzyEqualGlobalEpsilon)->Arg(1000)->Arg(100000);
+BENCHMARK(BM_fuzzyEqualExplicitEpsilon)->Arg(1000)->Arg(100000);
+BENCHMARK(BM_realThresholdAccessorDefault)->Arg(1000)->Arg(100000);
+BENCHMARK(BM_realThresholdAccessorBaseline)->Arg(1000)->Arg(100000);
+BENCHMARK(BM_findIntersectsGlobalEpsilon)->Arg(1000)->Arg(10000);
+BENCHMARK(BM_findIntersectsExplicitEpsilon)->Arg(1000)->Arg(10000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,117 @@
+#include "benchmarkprofiles.h"
+#include "cavc/polylinecombine.hpp"
+#include "cavc/polylineoffset.hpp"
+#include "cavc/polylineoffsetislands.hpp"
+#include <benchmark/benchmark.h>
+
+// Memory footprint per input vertex of each pipeline (args: input size, arc percentage):
+// - peakBytesPerVertex: peak live heap bytes while the operation runs (working set plus result,
+//   relative to the live bytes before the call, measured by the allocation tracking new/delete)
+// - resultBytesPerVertex: memoryUsage() of the result
+// - inputBytesPerVertex: memoryUsage() of the input (plus its spatial index where one is used)
+
+namespace {
+void reportFootprint(benchmark::State &state, std::size_t inputVertexCount,
+                     std::size_t inputBytes, std::size_t resultBytes) {
+  double const vertexCount = static_cast<double>(inputVertexCount);
+  state.counters["vertexCount"] = vertexCount;
+  state.counters["peakBytesPerVertex"] =
+      static_cast<double>(allocationStats().peakLiveBytes) / vertexCount;
+  state.counters["resultBytesPerVertex"] = static_cast<double>(resultBytes) / vertexCount;
+  state.counters["inputBytesPerVertex"] = static_cast<double>(inputBytes) / vertexCount;
+}
+
+TestProfile syntheticProfile(benchmark::State const &state) {
+  return coastlineProfile(static_cast<std::size_t>(state.range(0)),
+                          static_cast<std::size_t>(state.range(1)));
+}
+
+void BM_memoryParallelOffset(benchmark::State &state) {
+  auto profile = syntheticProfile(state);
+  std::size_t resultBytes = 0;
+  resetAllocationStats();
+  for (auto _ : state) {
+    (void)_;
+    auto results = cavc::parallelOffset(profile.pline, profile.offsetDelta);
+    resultBytes = cavc::internal::elementsMemoryUsage(results);
+    benchmark::DoNotOptimize(results);
+  }
+
+  reportFootprint(state, profile.pline.size(), profile.pline.memoryUsage(), resultBytes);
+}
+
+void BM_memoryCombinePolylines(benchmark::State &state) {
+  auto profile = syntheticProfile(state);
+  auto extents = cavc::getExtents(profile.pline);
+  auto shifted = profile.pline;
+  cavc::translatePolyline(shifted, {0.25 * (extents.xMax - extents.xMin), 0.0});
+  std::size_t resultBytes = 0;
+  resetAllocationStats();
+  for (auto _ : state) {
+    (void)_;
+    auto result = cavc::combinePolylines(profile.pline, shifted, cavc::PlineCombineMode::Union);
+    resultBytes = result.memoryUsage();
+    benchmark::DoNotOptimize(result);
+  }
+
+  reportFootprint(state, profile.pline.size() + shifted.size(),
+                  profile.pline.memoryUsage() + shifted.memoryUsage(), resultBytes);
+}
+
+void BM_memorySpatialIndex(benchmark::State &state) {
+  auto profile = syntheticProfile(state);
+  std::size_t resultBytes = 0;
+  resetAllocationStats();
+  for (auto _ : state) {
+    (void)_;
+    auto index = cavc::createApproxSpatialIndex(profile.pline);
+    resultBytes = index.memoryUsage();
+    benchmark::DoNotOptimize(index);
+  }
+
+  reportFootprint(state, profile.pline.size(), profile.pline.memoryUsage(), resultBytes);
+}
+
+// args: hole count (16 vertexes per hole), arc percentage
+void BM_memoryParallelOffsetIslands(benchmark::State &state) {
+  auto loops = PolylineFactory::createPerforatedPlate(
+      static_cast<std::size_t>(state.range(0)), 16,
+      static_cast<cavc_real>(state.range(1)) / 100, CAVC_SYNTHETIC_SEED);
+  cavc::OffsetLoopSet<double> input;
+  std::size_t vertexCount = 0;
+  for (std::size_t i = 0; i < loops.size(); ++i) {
+    auto pline = vertexesToPolyline(loops[i], true);
+    vertexCount += pline.size();
+    auto index = cavc::createApproxSpatialIndex(pline);
+    auto &target = i == 0 ? input.ccwLoops : input.cwLoops;
+    target.push_back({0, std::move(pline), std::move(index)});
+  }
+
+  cavc::ParallelOffsetIslands<double> algorithm;
+  std::size_t resultBytes = 0;
+  resetAllocationStats();
+  for (auto _ : state) {
+    (void)_;
+    auto result = algorithm.compute(input, 0.5);
+    resultBytes = result.memoryUsage();
+    benchmark::DoNotOptimize(result);
+  }
+
+  reportFootprint(state, vertexCount, input.memoryUsage(), resultBytes);
+}
+} // namespace
+
+BENCHMARK(BM_memoryParallelOffset)
+    ->ArgsProduct({benchmark::CreateRange(1000, CAVC_SYNTHETIC_MAX_VERTEXES, 10), {0, 50}})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_memoryCombinePolylines)
+    ->ArgsProduct({benchmark::CreateRange(1000, CAVC_SYNTHETIC_MAX_VERTEXES, 10), {0, 50}})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_memorySpatialIndex)
+    ->ArgsProduct({benchmark::CreateRange(1000, CAVC_SYNTHETIC_MAX_VERTEXES, 10), {0, 50}})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_memoryParallelOffsetIslands)
+    ->ArgsProduct({benchmark::CreateRange(10, 1000, 10), {0, 50}})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -13,6 +13,8 @@ static void offset(NoSetup, TestProfile const &profile) {
 }
 
 CAVC_CREATE_BENCHMARKS(offset, NoSetup, offset, benchmark::kMillisecond)
+CAVC_CREATE_CLOSED_SYNTHETIC_BENCHMARKS(offset, NoSetup, offset, benchmark::kMillisecond)
+CAVC_CREATE_OPEN_SYNTHETIC_BENCHMARKS(offset, NoSetup, offset, benchmark::kMillisecond)
 
 CAVC_CREATE_NO_ARCS_BENCHMARKS(offset, NoSetup, offset, arcError, benchmark::kMillisecond)
 
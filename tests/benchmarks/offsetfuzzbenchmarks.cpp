@@ -0,0 +1,292 @@
+#include "cavc/polylineoffset.hpp"
+#include "cavc/stats.hpp"
+#include "tests/tests/parallel_offset_fuzz_corpus.hpp"
+#include "tests/tests/shape_offset_self_intersect_case.hpp"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Times every case of the parallel offset fuzz regression corpus (plus the reported self
+// intersecting shape case) individually, reports case time percentiles, which result path
+// (primary stitch or one of the fallbacks) the cases took, and flags cases slower than the time
+// budget (--case_budget_us=N, default 1000). Built with CAVC_ENABLE_STATS to detect the result
+// path and the orientation and line distance predicate exact fallback rates, so absolute times
+// include the counter overhead.
+
+namespace {
+using fuzzcorpus::Pline;
+
+double caseBudgetUs = 1000.0;
+
+enum class OffsetPath : std::size_t {
+  Stitched,
+  CollapsedLine,
+  LoopRescue,
+  EndpointTouch,
+  RelaxedRecovery,
+  Empty,
+  Count
+};
+
+constexpr std::array<char const *, static_cast<std::size_t>(OffsetPath::Count)> offsetPathNames =
+    {"pathStitched",      "pathCollapsedLine",   "pathLoopRescue",
+     "pathEndpointTouch", "pathRelaxedRecovery", "pathEmpty"};
+
+OffsetPath pathTaken(cavc::Stats const &before, cavc::Stats const &after) {
+  if (after.offsetStitchedResults != before.offsetStitchedResults) {
+    return OffsetPath::Stitched;
+  }
+  if (after.offsetCollapsedLineResults != before.offsetCollapsedLineResults) {
+    return OffsetPath::CollapsedLine;
+  }
+  if (after.offsetLoopRescueResults != before.offsetLoopRescueResults) {
+    return OffsetPath::LoopRescue;
+  }
+  if (after.offsetEndpointTouchResults != before.offsetEndpointTouchResults) {
+    return OffsetPath::EndpointTouch;
+  }
+  if (after.offsetRelaxedRecoveryResults != before.offsetRelaxedRecoveryResults) {
+    return OffsetPath::RelaxedRecovery;
+  }
+  return OffsetPath::Empty;
+}
+
+struct OffsetCase {
+  std::string name;
+  Pline input;
+  double offset;
+  cavc::ParallelOffsetOptions<double> options;
+};
+
+char const *joinName(cavc::OffsetJoinType joinType) {
+  switch (joinType) {
+  case cavc::OffsetJoinType::Round:
+    return "round";
+  case cavc::OffsetJoinType::Miter:
+    return "miter";
+  case cavc::OffsetJoinType::Bevel:
+    return "bevel";
+  }
+  return "?";
+}
+
+char const *endCapName(cavc::OffsetEndCapType endCapType) {
+  switch (endCapType) {
+  case cavc::OffsetEndCapType::Round:
+    return "round";
+  case cavc::OffsetEndCapType::Square:
+    return "square";
+  case cavc::OffsetEndCapType::Butt:
+    return "butt";
+  }
+  return "?";
+}
+
+std::vector<OffsetCase> openCorpus(Pline (*generator)(std::uint32_t), char const *name) {
+  std::vector<OffsetCase> cases;
+  for (std::uint32_t seed : fuzzcorpus::openSeeds) {
+    Pline input = generator(seed);
+    for (auto joinType : fuzzcorpus::joinTypes) {
+      for (auto endCapType : fuzzcorpus::endCapTypes) {
+        for (double offset : fuzzcorpus::openOffsets) {
+          cavc::ParallelOffsetOptions<double> options;
+          options.joinType = joinType;
+          options.endCapType = endCapType;
+          options.miterLimit = 5.0;
+          cases.push_back({std::string(name) + " seed=" + std::to_string(seed) +
+                               " join=" + joinName(joinType) + " cap=" + endCapName(endCapType) +
+                               " offset=" + std::to_string(offset),
+                           input, offset, options});
+        }
+      }
+    }
+  }
+  return cases;
+}
+
+std::vector<OffsetCase> closedCorpus(Pline (*generator)(std::uint32_t), char const *name) {
+  std::vector<OffsetCase> cases;
+  for (std::uint32_t seed : fuzzcorpus::closedSeeds) {
+    Pline input = generator(seed);
+    for (auto joinType : fuzzcorpus::joinTypes) {
+      for (double offset : fuzzcorpus::closedOffsets) {
+        cavc::ParallelOffsetOptions<double> options;
+        options.joinType = joinType;
+        options.miterLimit = 5.0;
+        cases.push_back({std::string(name) + " seed=" + std::to_string(seed) +
+                             " join=" + joinName(joinType) + " offset=" + std::to_string(offset),
+                         input, offset, options});
+      }
+    }
+  }
+  return cases;
+}
+
+std::vector<OffsetCase> shapeSelfIntersectCorpus() {
+  Pline input;
+  input.isClosed() = true;
+  for (auto const &v : makeShapeOffsetSelfIntersectInputVertexes()) {
+    input.addVertex(static_cast<double>(v.x), static_cast<double>(v.y),
+                    static_cast<double>(v.bulge));
+  }
+
+  std::vector<OffsetCase> cases;
+  for (auto joinType : fuzzcorpus::joinTypes) {
+    for (double offset : {-2.0, -0.125, 0.125, 2.0}) {
+      cavc::ParallelOffsetOptions<double> options;
+      options.joinType = joinType;
+      options.miterLimit = 5.0;
+      cases.push_back({std::string("shapeSelfIntersect join=") + joinName(joinType) +
+                           " offset=" + std::to_string(offset),
+                       input, offset, options});
+    }
+  }
+  return cases;
+}
+
+double percentile(std::vector<double> sorted, double p) {
+  if (sorted.empty()) {
+    return 0.0;
+  }
+  std::sort(sorted.begin(), sorted.end());
+  std::size_t index = static_cast<std::size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+  return sorted[std::min(index, sorted.size() - 1)];
+}
+
+void runCorpus(benchmark::State &state, std::vector<OffsetCase> const &cases) {
+  using clock = std::chrono::steady_clock;
+  std::vector<double> caseTimesUs;
+  caseTimesUs.reserve(cases.size());
+  std::vector<double> worstCaseUs(cases.size(), 0.0);
+  std::vector<OffsetPath> casePaths(cases.size(), OffsetPath::Empty);
+  cavc::Stats const corpusBefore = cavc::statsSnapshot();
+
+  for (auto _ : state) {
+    (void)_;
+    for (std::size_t i = 0; i < cases.size(); ++i) {
+      auto const &offsetCase = cases[i];
+      cavc::Stats const before = cavc::statsSnapshot();
+      auto const start = clock::now();
+      auto results = cavc::parallelOffset(offsetCase.input, offsetCase.offset, offsetCase.options);
+      auto const end = clock::now();
+      benchmark::DoNotOptimize(results);
+      casePaths[i] = pathTaken(before, cavc::statsSnapshot());
+      double const us = std::chrono::duration<double, std::micro>(end - start).count();
+      caseTimesUs.push_back(us);
+      worstCaseUs[i] = std::max(worstCaseUs[i], us);
+    }
+  }
+
+  cavc::Stats const corpusAfter = cavc::statsSnapshot();
+  double const orientCalls = static_cast<double>(corpusAfter.orientationPredicateCalls -
+                                                 corpusBefore.orientationPredicateCalls);
+  double const orientFallbacks = static_cast<double>(corpusAfter.orientationExactFallbacks -
+                                                     corpusBefore.orientationExactFallbacks);
+  double const lineDistCalls = static_cast<double>(corpusAfter.lineDistanceComparisons -
+                                                   corpusBefore.lineDistanceComparisons);
+  double const lineDistFallbacks = static_cast<double>(corpusAfter.lineDistanceExactFallbacks -
+                                                       corpusBefore.lineDistanceExactFallbacks);
+
+  std::array<std::size_t, static_cast<std::size_t>(OffsetPath::Count)> pathCounts{};
+  std::size_t overBudgetCount = 0;
+  for (std::size_t i = 0; i < cases.size(); ++i) {
+    ++pathCounts[static_cast<std::size_t>(casePaths[i])];
+    if (worstCaseUs[i] > caseBudgetUs) {
+      ++overBudgetCount;
+      std::fprintf(stderr, "over budget (%.1f us > %.1f us): %s [%s]\n", worstCaseUs[i],
+                   caseBudgetUs, cases[i].name.c_str(),
+                   offsetPathNames[static_cast<std::size_t>(casePaths[i])]);
+    }
+  }
+
+  double sum = 0.0;
+  for (double us : caseTimesUs) {
+    sum += us;
+  }
+
+  state.counters["cases"] = static_cast<double>(cases.size());
+  state.counters["meanCaseUs"] =
+      caseTimesUs.empty() ? 0.0 : sum / static_cast<double>(caseTimesUs.size());
+  state.counters["p50CaseUs"] = percentile(caseTimesUs, 0.5);
+  state.counters["p99CaseUs"] = percentile(caseTimesUs, 0.99);
+  state.counters["maxCaseUs"] = *std::max_element(worstCaseUs.begin(), worstCaseUs.end());
+  state.counters["overBudget"] = static_cast<double>(overBudgetCount);
+  for (std::size_t i = 0; i < pathCounts.size(); ++i) {
+    state.counters[offsetPathNames[i]] = static_cast<double>(pathCounts[i]);
+  }
+  // orientation and line distance predicate calls per corpus pass and the fraction needing the
+  // exact fallback
+  double const passes =
+      static_cast<double>(std::max<benchmark::IterationCount>(state.iterations(), 1));
+  state.counters["orientCalls"] = orientCalls / passes;
+  state.counters["orientFallbackRate"] = orientCalls == 0.0 ? 0.0 : orientFallbacks / orientCalls;
+  state.counters["lineDistCalls"] = lineDistCalls / passes;
+  state.counters["lineDistFallbackRate"] =
+      lineDistCalls == 0.0 ? 0.0 : lineDistFallbacks / lineDistCalls;
+}
+
+void BM_offsetFuzzOpenMixed(benchmark::State &state) {
+  static auto const cases = openCorpus(fuzzcorpus::makeOpenMixedPolyline, "openMixed");
+  runCorpus(state, cases);
+}
+
+void BM_offsetFuzzOpenNearDegenerate(benchmark::State &state) {
+  static auto const cases =
+      openCorpus(fuzzcorpus::makeNearDegenerateOpenPolyline, "openNearDegenerate");
+  runCorpus(state, cases);
+}
+
+void BM_offsetFuzzClosedConvexNgon(benchmark::State &state) {
+  static auto const cases = closedCorpus(fuzzcorpus::makeConvexNgon, "closedConvexNgon");
+  runCorpus(state, cases);
+}
+
+void BM_offsetFuzzClosedConcaveStar(benchmark::State &state) {
+  static auto const cases = closedCorpus(fuzzcorpus::makeConcaveStar, "closedConcaveStar");
+  runCorpus(state, cases);
+}
+
+void BM_offsetFuzzClosedArcHeavy(benchmark::State &state) {
+  static auto const cases = closedCorpus(fuzzcorpus::makeArcHeavyClosedPolyline, "closedArcHeavy");
+  runCorpus(state, cases);
+}
+
+void BM_offsetFuzzShapeSelfIntersect(benchmark::State &state) {
+  static auto const cases = shapeSelfIntersectCorpus();
+  runCorpus(state, cases);
+}
+} // namespace
+
+BENCHMARK(BM_offsetFuzzOpenMixed)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_offsetFuzzOpenNearDegenerate)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_offsetFuzzClosedConvexNgon)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_offsetFuzzClosedConcaveStar)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_offsetFuzzClosedArcHeavy)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_offsetFuzzShapeSelfIntersect)->Unit(benchmark::kMillisecond);
+
+int main(int argc, char **argv) {
+  // strip --case_budget_us=N before handing the arguments to google benchmark
+  char const *budgetFlag = "--case_budget_us=";
+  int argCount = 0;
+  for (int i = 0; i < argc; ++i) {
+    if (std::strncmp(argv[i], budgetFlag, std::strlen(budgetFlag)) == 0) {
+      caseBudgetUs = std::atof(argv[i] + std::strlen(budgetFlag));
+      continue;
+    }
+    argv[argCount++] = argv[i];
+  }
+
+  benchmark::Initialize(&argCount, argv);
+  if (benchmark::ReportUnrecognizedArguments(argCount, argv)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
@@ -1,4 +1,7 @@
+#include "benchmarkprofiles.h"
+#include "benchmarkstats.h"
 #include "cavc/polylineoffset.hpp"
+#include "polylinefactory.hpp"
 #include <benchmark/benchmark.h>
 #include <cmath>
 #include <vector>
@@ -50,6 +53,23 @@ cavc::Polyline<double> makeOpenArcPolyline() {
   return p;
 }
 
+// seeded synthetic inputs for join/end-cap scaling (args: vertex count, arc percentage)
+cavc::Polyline<double> makeSyntheticGear(benchmark::State const &state) {
+  return vertexesToPolyline(
+      PolylineFactory::createGear(static_cast<std::size_t>(state.range(0)),
+                                  static_cast<cavc_real>(state.range(1)) / 100,
+                                  CAVC_SYNTHETIC_SEED),
+      true);
+}
+
+cavc::Polyline<double> makeSyntheticSpiral(benchmark::State const &state) {
+  return vertexesToPolyline(
+      PolylineFactory::createSpiral(static_cast<std::size_t>(state.range(0)),
+                                    static_cast<cavc_real>(state.range(1)) / 100,
+                                    CAVC_SYNTHETIC_SEED),
+      false);
+}
+
 static void BM_roundJoinArcHeavyClosed(benchmark::State &state) {
   auto input = makeArcHeavyLoop();
   cavc::ParallelOffsetOptions<double> options;
@@ -101,6 +121,33 @@ static void BM_buttEndCapOpenArc(benchmark::State &state) {
   }
 }
 
+static void BM_miterJoinSyntheticGearClosed(benchmark::State &state) {
+  auto input = makeSyntheticGear(state);
+  cavc::ParallelOffsetOptions<double> options;
+  options.joinType = cavc::OffsetJoinType::Miter;
+  options.miterLimit = 5.0;
+  cavc::resetStats();
+  for (auto _ : state) {
+    auto results = cavc::parallelOffset(input, -0.25, options);
+    benchmark::DoNotOptimize(results);
+  }
+  reportStatsCounters(state);
+  state.SetComplexityN(static_cast<int64_t>(input.size()));
+}
+
+static void BM_squareEndCapSyntheticSpiralOpen(benchmark::State &state) {
+  auto input = makeSyntheticSpiral(state);
+  cavc::ParallelOffsetOptions<double> options;
+  options.endCapType = cavc::OffsetEndCapType::Square;
+  cavc::resetStats();
+  for (auto _ : state) {
+    auto results = cavc::parallelOffset(input, -0.25, options);
+    benchmark::DoNotOptimize(results);
+  }
+  reportStatsCounters(state);
+  state.SetComplexityN(static_cast<int64_t>(input.size()));
+}
+
 } // namespace
 
 BENCHMARK(BM_roundJoinArcHeavyClosed)->Unit(benchmark::kMicrosecond);
@@ -108,5 +155,13 @@ BENCHMARK(BM_miterJoinRectangleClosed)->Unit(benchmark::kMicrosecond);
 BENCHMARK(BM_bevelJoinConcaveClosed)->Unit(benchmark::kMicrosecond);
 BENCHMARK(BM_squareEndCapOpenArc)->Unit(benchmark::kMicrosecond);
 BENCHMARK(BM_buttEndCapOpenArc)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_miterJoinSyntheticGearClosed)
+    ->ArgsProduct({benchmark::CreateRange(1000, 100000, 10), {0, 50}})
+    ->Complexity()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_squareEndCapSyntheticSpiralOpen)
+    ->ArgsProduct({benchmark::CreateRange(1000, 100000, 10), {0, 50}})
+    ->Complexity()
+    ->Unit(benchmark::kMillisecond);
 
 BENCHMARK_MAIN();
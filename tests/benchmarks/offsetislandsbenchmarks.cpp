@@ -1,4 +1,8 @@
+#include "allocationtracking.h"
+#include "benchmarkprofiles.h"
+#include "benchmarkstats.h"
 #include "cavc/polylineoffsetislands.hpp"
+#include "polylinefactory.hpp"
 #include <benchmark/benchmark.h>
 #include <cmath>
 #include <cstddef>
@@ -74,6 +78,59 @@ OffsetLoopSet<double> createGridOffsetLoopSet(std::size_t grid_size) {
   return result;
 }
 
+// single plate with loop_count - 1 round holes (perforated sheet)
+OffsetLoopSet<double> createPerforatedPlateLoopSet(std::size_t loop_count) {
+  CAVC_ASSERT(loop_count >= 2, "loop_count must be >= 2");
+  std::size_t const hole_count = loop_count - 1;
+  std::size_t const cols =
+      static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(hole_count))));
+  double const pitch = 10.0;
+  double const plate_size = static_cast<double>(cols) * pitch;
+
+  OffsetLoopSet<double> result;
+  result.ccwLoops.push_back(
+      makeOffsetLoop(makeAxisAlignedRect(0.0, 0.0, plate_size, plate_size, false), 0));
+  result.cwLoops.reserve(hole_count);
+  for (std::size_t i = 0; i < hole_count; ++i) {
+    double center_x = (static_cast<double>(i % cols) + 0.5) * pitch;
+    double center_y = (static_cast<double>(i / cols) + 0.5) * pitch;
+    auto hole = makeNgonLoop(16, 3.0, center_x, center_y);
+    cavc::invertDirection(hole);
+    result.cwLoops.push_back(makeOffsetLoop(std::move(hole), 0));
+  }
+
+  return result;
+}
+
+// seeded perforated plate from PolylineFactory (jittered hole sizes/positions, mixed arcs)
+OffsetLoopSet<double> createSyntheticPlateLoopSet(std::size_t hole_count,
+                                                  std::size_t arc_percent) {
+  auto loops = PolylineFactory::createPerforatedPlate(
+      hole_count, 16, static_cast<cavc_real>(arc_percent) / 100, CAVC_SYNTHETIC_SEED);
+  OffsetLoopSet<double> result;
+  result.cwLoops.reserve(hole_count);
+  for (std::size_t i = 0; i < loops.size(); ++i) {
+    auto loop = vertexesToPolyline(loops[i], true);
+    if (i == 0) {
+      result.ccwLoops.push_back(makeOffsetLoop(std::move(loop), 0));
+    } else {
+      result.cwLoops.push_back(makeOffsetLoop(std::move(loop), 0));
+    }
+  }
+
+  return result;
+}
+
+// stats counters are thread local (see cavc/stats.hpp), when they are compiled in run the islands
+// work on the benchmark thread so reportStatsCounters sees all of it (timings are then serial)
+ParallelOffsetIslands<double> makeIslandsAlgorithm() {
+  ParallelOffsetIslands<double> algorithm;
+  if constexpr (cavc::statsEnabled) {
+    algorithm.setMaxThreads(1);
+  }
+  return algorithm;
+}
+
 struct BatchIndexSetup {
   std::vector<Polyline<double>> loops;
 
@@ -102,6 +159,7 @@ static void BM_createApproxSpatialIndicesScalar(benchmark::State &state) {
   state.counters["loopCount"] = static_cast<double>(loop_count);
   state.counters["vertexCount"] = static_cast<double>(vertex_count);
 
+  resetAllocationStats();
   for (auto _ : state) {
     (void)_;
     std::vector<StaticSpatialIndex<double>> indexes;
@@ -111,6 +169,7 @@ static void BM_createApproxSpatialIndicesScalar(benchmark::State &state) {
     }
     benchmark::DoNotOptimize(indexes);
   }
+  reportAllocationCounters(state);
 }
 
 static void BM_createApproxSpatialIndicesBatch(benchmark::State &state) {
@@ -121,11 +180,13 @@ static void BM_createApproxSpatialIndicesBatch(benchmark::State &state) {
   state.counters["loopCount"] = static_cast<double>(loop_count);
   state.counters["vertexCount"] = static_cast<double>(vertex_count);
 
+  resetAllocationStats();
   for (auto _ : state) {
     (void)_;
     auto indexes = cavc::createApproxSpatialIndices(setup.loops);
     benchmark::DoNotOptimize(indexes);
   }
+  reportAllocationCounters(state);
 }
 
 static void BM_buildOffsetLoopTopologyLargeScale(benchmark::State &state) {
@@ -142,19 +203,83 @@ static void BM_buildOffsetLoopTopologyLargeScale(benchmark::State &state) {
   }
 }
 
+static void BM_buildOffsetLoopTopologyPerforatedPlate(benchmark::State &state) {
+  std::size_t loop_count = static_cast<std::size_t>(state.range(0));
+  OffsetLoopSet<double> input = createPerforatedPlateLoopSet(loop_count);
+
+  state.counters["loopCount"] = static_cast<double>(loop_count);
+
+  for (auto _ : state) {
+    (void)_;
+    auto topology = cavc::buildOffsetLoopTopology(input);
+    benchmark::DoNotOptimize(topology);
+  }
+}
+
 static void BM_parallelOffsetIslandsComputeLargeScale(benchmark::State &state) {
   std::size_t grid_size = static_cast<std::size_t>(state.range(0));
   OffsetLoopSet<double> input = createGridOffsetLoopSet(grid_size);
-  ParallelOffsetIslands<double> algorithm;
+  ParallelOffsetIslands<double> algorithm = makeIslandsAlgorithm();
 
   state.counters["outerLoopCount"] = static_cast<double>(input.ccwLoops.size());
   state.counters["holeLoopCount"] = static_cast<double>(input.cwLoops.size());
 
+  cavc::resetStats();
+  resetAllocationStats();
   for (auto _ : state) {
     (void)_;
     auto result = algorithm.compute(input, 1.0);
     benchmark::DoNotOptimize(result);
   }
+  reportAllocationCounters(state);
+  reportStatsCounters(state);
+}
+
+static void BM_parallelOffsetIslandsComputeSyntheticPlate(benchmark::State &state) {
+  std::size_t hole_count = static_cast<std::size_t>(state.range(0));
+  OffsetLoopSet<double> input =
+      createSyntheticPlateLoopSet(hole_count, static_cast<std::size_t>(state.range(1)));
+  ParallelOffsetIslands<double> algorithm = makeIslandsAlgorithm();
+
+  state.counters["holeLoopCount"] = static_cast<double>(hole_count);
+
+  cavc::resetStats();
+  resetAllocationStats();
+  for (auto _ : state) {
+    (void)_;
+    auto result = algorithm.compute(input, 0.5);
+    benchmark::DoNotOptimize(result);
+  }
+  reportAllocationCounters(state);
+  reportStatsCounters(state);
+  state.SetComplexityN(static_cast<int64_t>(hole_count));
+}
+
+static void BM_parallelOffsetIslandsComputeSteps(benchmark::State &state) {
+  std::size_t step_count = static_cast<std::size_t>(state.range(0));
+  // single large pocket boundary with a few islands so many steps produce loops
+  OffsetLoopSet<double> input;
+  input.ccwLoops.push_back(
+      makeOffsetLoop(makeAxisAlignedRect(0.0, 0.0, 4000.0, 3000.0, false), 0));
+  input.cwLoops.push_back(
+      makeOffsetLoop(makeAxisAlignedRect(600.0, 600.0, 1200.0, 1100.0, true), 1));
+  input.cwLoops.push_back(
+      makeOffsetLoop(makeAxisAlignedRect(2500.0, 1400.0, 3100.0, 2200.0, true), 2));
+  ParallelOffsetIslands<double> algorithm;
+
+  std::size_t loop_count = 0;
+  for (auto _ : state) {
+    (void)_;
+    loop_count = 0;
+    std::size_t steps = algorithm.computeSteps(
+        input, 5.0, step_count, [&](std::size_t, OffsetLoopSet<double> const &step_result) {
+          loop_count += step_result.ccwLoops.size() + step_result.cwLoops.size();
+        });
+    benchmark::DoNotOptimize(steps);
+  }
+
+  state.counters["stepCount"] = static_cast<double>(step_count);
+  state.counters["totalLoopCount"] = static_cast<double>(loop_count);
 }
 
 BENCHMARK(BM_createApproxSpatialIndicesScalar)
@@ -175,11 +300,26 @@ BENCHMARK(BM_buildOffsetLoopTopologyLargeScale)
     ->Arg(16)
     ->Unit(benchmark::kMillisecond);
 
+BENCHMARK(BM_buildOffsetLoopTopologyPerforatedPlate)
+    ->Arg(100)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Unit(benchmark::kMillisecond);
+
 BENCHMARK(BM_parallelOffsetIslandsComputeLargeScale)
     ->Arg(4)
     ->Arg(8)
     ->Arg(12)
     ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_parallelOffsetIslandsComputeSyntheticPlate)
+    ->ArgsProduct({benchmark::CreateRange(10, 10000, 10), {0, 50}})
+    ->Complexity()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_parallelOffsetIslandsComputeSteps)
+    ->Arg(10)
+    ->Arg(50)
+    ->Arg(150)
+    ->Unit(benchmark::kMillisecond);
 } // namespace
 
 BENCHMARK_MAIN();
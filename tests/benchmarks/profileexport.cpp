@@ -0,0 +1,23 @@
+#include "profileio.h"
+#include <fstream>
+#include <iostream>
+
+// Writes the standard benchmark profiles in the neutral text format (see profileio.h) to the file
+// given as the first argument (or stdout), used as input for crossapibenchmarks and for
+// benchmarking other implementations on identical inputs.
+int main(int argc, char **argv) {
+  auto const profiles = standardProfiles();
+  if (argc < 2) {
+    writeProfiles(std::cout, profiles);
+    return 0;
+  }
+
+  std::ofstream file(argv[1]);
+  if (!file) {
+    std::cerr << "failed to open '" << argv[1] << "' for writing\n";
+    return 1;
+  }
+
+  writeProfiles(file, profiles);
+  return file ? 0 : 1;
+}
@@ -0,0 +1,141 @@
+#ifndef CAVC_PROFILEIO_H
+#define CAVC_PROFILEIO_H
+#include "benchmarkprofiles.h"
+#include <cstdio>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Benchmark profiles (benchmarkprofiles.h) in a neutral plain text format so other
+// implementations (and other language bindings) can be benchmarked on identical inputs.
+//
+// Format (whitespace separated, lines starting with '#' are comments):
+//   cavc_profiles 1
+//   profile <name> <offset count> <offset delta> <closed 0/1> <vertex count>
+//   <x> <y> <bulge>            (vertex count lines)
+//   ... (next profile)
+//
+// Numbers are written with 17 significant digits so they round trip exactly as doubles. The
+// offset benchmark loop for a profile is: for i in 1..offset count, offset by +i * delta and
+// -i * delta.
+
+struct NamedProfile {
+  std::string name;
+  TestProfile profile;
+};
+
+// arc to line conversion error used by the NoArcs profile variants (same as the benchmarks)
+constexpr double noArcsError = 0.01;
+
+// The benchmarkprofiles.h profiles using the same names as the benchmark suffixes (the synthetic
+// profiles at the smallest range size).
+inline std::vector<NamedProfile> standardProfiles() {
+  std::size_t const pathologicalSegmentCounts[] = {10, 25, 50, 100};
+  std::size_t const arcPercents[] = {0, 50};
+  std::vector<NamedProfile> result;
+  result.push_back({"Square", square()});
+  result.push_back({"Diamond", diamond()});
+  result.push_back({"Circle", circle()});
+  result.push_back({"RoundedRect", roundedRectangle()});
+  result.push_back({"Profile1", profile1()});
+  result.push_back({"Profile2", profile2()});
+  for (std::size_t segmentCount : pathologicalSegmentCounts) {
+    result.push_back({"Pathological1/" + std::to_string(segmentCount),
+                      pathologicalProfile1(segmentCount)});
+  }
+  result.push_back({"CircleNoArcs", circle(noArcsError)});
+  result.push_back({"RoundedRectNoArcs", roundedRectangle(noArcsError)});
+  result.push_back({"Profile1NoArcs", profile1(noArcsError)});
+  result.push_back({"Profile2NoArcs", profile2(noArcsError)});
+  for (std::size_t segmentCount : pathologicalSegmentCounts) {
+    result.push_back({"Pathological1NoArcs/" + std::to_string(segmentCount),
+                      pathologicalProfile1(segmentCount, noArcsError)});
+  }
+  for (std::size_t arcPercent : arcPercents) {
+    std::string suffix = "/1000/" + std::to_string(arcPercent);
+    result.push_back({"Gear" + suffix, gearProfile(1000, arcPercent)});
+    result.push_back({"Coastline" + suffix, coastlineProfile(1000, arcPercent)});
+    result.push_back({"Spiral" + suffix, spiralProfile(1000, arcPercent)});
+    result.push_back({"RandomWalk" + suffix, randomWalkProfile(1000, arcPercent)});
+  }
+
+  return result;
+}
+
+inline void writeProfiles(std::ostream &os, std::vector<NamedProfile> const &profiles) {
+  auto formatReal = [](double value) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+    return std::string(buffer);
+  };
+
+  os << "cavc_profiles 1\n";
+  for (auto const &named : profiles) {
+    auto const &profile = named.profile;
+    os << "profile " << named.name << ' ' << profile.offsetCount << ' '
+       << formatReal(profile.offsetDelta) << ' ' << (profile.pline.isClosed() ? 1 : 0) << ' '
+       << profile.pline.size() << '\n';
+    for (auto const &v : profile.pline.vertexes()) {
+      os << formatReal(v.x()) << ' ' << formatReal(v.y()) << ' ' << formatReal(v.bulge()) << '\n';
+    }
+  }
+}
+
+// Reads profiles written by writeProfiles, returns false (with error set) on malformed input.
+inline bool readProfiles(std::istream &is, std::vector<NamedProfile> &profiles, std::string &error) {
+  // strip comment lines
+  std::stringstream content;
+  std::string line;
+  while (std::getline(is, line)) {
+    if (!line.empty() && line[0] == '#') {
+      continue;
+    }
+    content << line << '\n';
+  }
+
+  std::string magic;
+  int version = 0;
+  if (!(content >> magic >> version) || magic != "cavc_profiles" || version != 1) {
+    error = "missing 'cavc_profiles 1' header";
+    return false;
+  }
+
+  std::string keyword;
+  while (content >> keyword) {
+    if (keyword != "profile") {
+      error = "expected 'profile', found '" + keyword + "'";
+      return false;
+    }
+
+    std::string name;
+    std::size_t offsetCount = 0;
+    double offsetDelta = 0.0;
+    int isClosed = 0;
+    std::size_t vertexCount = 0;
+    if (!(content >> name >> offsetCount >> offsetDelta >> isClosed >> vertexCount)) {
+      error = "malformed profile header after '" + name + "'";
+      return false;
+    }
+
+    cavc::Polyline<double> pline;
+    pline.isClosed() = isClosed != 0;
+    pline.vertexes().reserve(vertexCount);
+    for (std::size_t i = 0; i < vertexCount; ++i) {
+      double x, y, bulge;
+      if (!(content >> x >> y >> bulge)) {
+        error = "profile '" + name + "' has fewer than " + std::to_string(vertexCount) +
+                " vertexes";
+        return false;
+      }
+      pline.addVertex(x, y, bulge);
+    }
+
+    profiles.push_back({name, TestProfile(offsetCount, offsetDelta, std::move(pline))});
+  }
+
+  return true;
+}
+
+#endif // CAVC_PROFILEIO_H
@@ -7,6 +7,8 @@ static void createIndex(NoSetup, TestProfile const &profile) {
 }
 
 CAVC_CREATE_BENCHMARKS(createIndex, NoSetup, createIndex, benchmark::kMicrosecond)
+CAVC_CREATE_OPEN_SYNTHETIC_BENCHMARKS(createIndex, NoSetup, createIndex,
+                                      benchmark::kMicrosecond)
 CAVC_CREATE_NO_ARCS_BENCHMARKS(createIndex, NoSetup, createIndex, 0.01, benchmark::kMicrosecond)
 
 struct QuerySetup {
@@ -30,6 +32,8 @@ static void queryIndexReuseStack(QuerySetup &setup, TestProfile const &profile)
 
 CAVC_CREATE_BENCHMARKS(queryIndexReuseStack, QuerySetup, queryIndexReuseStack,
                        benchmark::kMicrosecond)
+CAVC_CREATE_OPEN_SYNTHETIC_BENCHMARKS(queryIndexReuseStack, QuerySetup, queryIndexReuseStack,
+                                      benchmark::kMicrosecond)
 CAVC_CREATE_NO_ARCS_BENCHMARKS(queryIndexReuseStack, QuerySetup, queryIndexReuseStack, 0.01,
                                benchmark::kMicrosecond)
 
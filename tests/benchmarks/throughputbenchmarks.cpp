@@ -0,0 +1,241 @@
+#include "benchmarkprofiles.h"
+#include "cavc/polylinecombine.hpp"
+#include "cavc/polylineoffset.hpp"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Multi-threaded throughput of parallelOffset, combinePolylines and point containment queries.
+// Every benchmark runs on 1..N threads (N = hardware threads, at least 2) over one shared read only
+// corpus, each thread cycles through the corpus starting at a different item. Reports operations
+// per second (ops) over all threads and the scaling efficiency: ops / (threads * single thread
+// ops), 1 means perfect scaling, lower values show contention (shared atomics, allocator, false
+// sharing).
+//
+// This executable does not link the allocation tracking operator new/delete (its shared counters
+// would add contention of their own). The scaling efficiency is added to the console output and
+// to --benchmark_out json or console files (--benchmark_format is ignored, use --benchmark_out for
+// machine readable results).
+
+namespace {
+struct ThroughputCorpus {
+  std::vector<TestProfile> profiles;
+  // profiles[i] translated by half its extents for combine operations
+  std::vector<cavc::Polyline<double>> shiftedPlines;
+  std::vector<cavc::StaticSpatialIndex<double>> spatialIndexes;
+  // query points over each profile's extents
+  std::vector<std::vector<cavc::Vector2<double>>> queryPoints;
+};
+
+// points per containment operation batch
+constexpr std::size_t queryPointsPerProfile = 256;
+
+ThroughputCorpus const &corpus() {
+  static ThroughputCorpus const result = [] {
+    ThroughputCorpus c;
+    c.profiles.push_back(roundedRectangle());
+    c.profiles.push_back(profile1());
+    c.profiles.push_back(profile2());
+    c.profiles.push_back(pathologicalProfile1(50));
+    c.profiles.push_back(gearProfile(2000, 50));
+    c.profiles.push_back(coastlineProfile(2000, 50));
+
+    for (auto const &profile : c.profiles) {
+      auto extents = cavc::getExtents(profile.pline);
+      double width = extents.xMax - extents.xMin;
+      double height = extents.yMax - extents.yMin;
+
+      auto shifted = profile.pline;
+      cavc::translatePolyline(shifted, {0.5 * width, 0.25 * height});
+      c.shiftedPlines.push_back(std::move(shifted));
+
+      c.spatialIndexes.push_back(cavc::createApproxSpatialIndex(profile.pline));
+
+      std::vector<cavc::Vector2<double>> points;
+      points.reserve(queryPointsPerProfile);
+      std::size_t const gridSize = 16;
+      for (std::size_t i = 0; i < gridSize; ++i) {
+        for (std::size_t j = 0; j < gridSize; ++j) {
+          points.emplace_back(
+              extents.xMin + width * (static_cast<double>(i) + 0.5) / static_cast<double>(gridSize),
+              extents.yMin +
+                  height * (static_cast<double>(j) + 0.5) / static_cast<double>(gridSize));
+        }
+      }
+      c.queryPoints.push_back(std::move(points));
+    }
+
+    return c;
+  }();
+
+  return result;
+}
+
+int maxBenchmarkThreads() {
+  return std::max(2, static_cast<int>(std::thread::hardware_concurrency()));
+}
+
+// corpus item index for the current iteration, threads start at different items so they do not
+// all work on the same input at the same time
+struct CorpusCursor {
+  std::size_t index;
+  std::size_t count;
+  CorpusCursor(benchmark::State const &state, std::size_t count)
+      : index(static_cast<std::size_t>(state.thread_index()) % count), count(count) {}
+  std::size_t next() {
+    std::size_t result = index;
+    index = (index + 1) % count;
+    return result;
+  }
+};
+
+void reportOps(benchmark::State &state, std::size_t ops) {
+  // counters are summed over threads and divided by the (real) time giving total ops per second
+  state.counters["ops"] = benchmark::Counter(static_cast<double>(ops), benchmark::Counter::kIsRate);
+}
+
+void BM_throughputParallelOffset(benchmark::State &state) {
+  auto const &c = corpus();
+  CorpusCursor cursor(state, c.profiles.size());
+  std::size_t ops = 0;
+  for (auto _ : state) {
+    (void)_;
+    auto const &profile = c.profiles[cursor.next()];
+    auto results = cavc::parallelOffset(profile.pline, profile.offsetDelta);
+    benchmark::DoNotOptimize(results);
+    ++ops;
+  }
+
+  reportOps(state, ops);
+}
+
+void BM_throughputCombinePolylines(benchmark::State &state) {
+  auto const &c = corpus();
+  CorpusCursor cursor(state, c.profiles.size());
+  std::size_t ops = 0;
+  for (auto _ : state) {
+    (void)_;
+    std::size_t i = cursor.next();
+    auto result = cavc::combinePolylines(c.profiles[i].pline, c.shiftedPlines[i],
+                                         cavc::PlineCombineMode::Union);
+    benchmark::DoNotOptimize(result);
+    ++ops;
+  }
+
+  reportOps(state, ops);
+}
+
+void BM_throughputPointContainment(benchmark::State &state) {
+  auto const &c = corpus();
+  CorpusCursor cursor(state, c.profiles.size());
+  std::vector<std::size_t> queryStack;
+  std::size_t ops = 0;
+  for (auto _ : state) {
+    (void)_;
+    std::size_t i = cursor.next();
+    for (auto const &pt : c.queryPoints[i]) {
+      auto containment =
+          cavc::getPointContainment(c.profiles[i].pline, c.spatialIndexes[i], pt, 1e-5, queryStack);
+      benchmark::DoNotOptimize(containment);
+    }
+    ops += c.queryPoints[i].size();
+  }
+
+  reportOps(state, ops);
+}
+
+// reporter adding the scalingEfficiency counter to Base's output, single thread ops per second are
+// recorded per benchmark (and args) and must be reported first (ThreadRange starts at 1)
+template <typename Base> class ScalingEfficiencyReporter : public Base {
+public:
+  using Run = typename Base::Run;
+
+  void ReportRuns(std::vector<Run> const &reports) override {
+    std::vector<Run> withEfficiency = reports;
+    for (auto &run : withEfficiency) {
+      auto opsIt = run.counters.find("ops");
+      if (run.error_occurred || opsIt == run.counters.end()) {
+        continue;
+      }
+
+      std::string key = run.run_name.function_name + "/" + run.run_name.args + "/" +
+                        run.aggregate_name;
+      if (run.threads == 1) {
+        m_singleThreadOps[key] = opsIt->second.value;
+      }
+
+      auto baseIt = m_singleThreadOps.find(key);
+      if (baseIt != m_singleThreadOps.end() && baseIt->second > 0.0) {
+        run.counters["scalingEfficiency"] =
+            opsIt->second.value / (static_cast<double>(run.threads) * baseIt->second);
+      }
+    }
+
+    Base::ReportRuns(withEfficiency);
+  }
+
+private:
+  std::map<std::string, double> m_singleThreadOps;
+};
+
+// --benchmark_out file format if a file is requested (read before benchmark::Initialize removes
+// the flags), empty otherwise
+std::string benchmarkOutFormat(int argc, char **argv) {
+  std::string const outFlag = "--benchmark_out=";
+  std::string const formatFlag = "--benchmark_out_format=";
+  bool hasOut = false;
+  std::string format = "json";
+  for (int i = 1; i < argc; ++i) {
+    std::string const arg = argv[i];
+    if (arg.compare(0, outFlag.size(), outFlag) == 0) {
+      hasOut = arg.size() > outFlag.size();
+    } else if (arg.compare(0, formatFlag.size(), formatFlag) == 0) {
+      format = arg.substr(formatFlag.size());
+    }
+  }
+
+  return hasOut ? format : std::string();
+}
+} // namespace
+
+BENCHMARK(BM_throughputParallelOffset)
+    ->ThreadRange(1, maxBenchmarkThreads())
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_throughputCombinePolylines)
+    ->ThreadRange(1, maxBenchmarkThreads())
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_throughputPointContainment)
+    ->ThreadRange(1, maxBenchmarkThreads())
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+int main(int argc, char **argv) {
+  std::string const outFormat = benchmarkOutFormat(argc, argv);
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+
+  // corpus construction is not part of the first measured run
+  corpus();
+
+  ScalingEfficiencyReporter<benchmark::ConsoleReporter> displayReporter;
+  if (outFormat == "json") {
+    ScalingEfficiencyReporter<benchmark::JSONReporter> fileReporter;
+    benchmark::RunSpecifiedBenchmarks(&displayReporter, &fileReporter);
+  } else if (outFormat == "console") {
+    ScalingEfficiencyReporter<benchmark::ConsoleReporter> fileReporter;
+    benchmark::RunSpecifiedBenchmarks(&displayReporter, &fileReporter);
+  } else {
+    // no output file (or csv, which is written without the scalingEfficiency counter)
+    benchmark::RunSpecifiedBenchmarks(&displayReporter);
+  }
+
+  benchmark::Shutdown();
+  return 0;
+}
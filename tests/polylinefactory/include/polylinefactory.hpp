@@ -2,6 +2,8 @@
 #define CAVC_POLYLINEFACTORY_HPP
 
 #include "cavaliercontours.h"
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -18,6 +20,34 @@ public:
   static std::vector<cavc_vertex> createCircle(cavc_real radius, cavc_point center,
                                                cavc_real vertexRotAngle, bool isCW);
   static cavc_pline_ptr vertexesToPline(std::vector<cavc_vertex> const &vertexes, bool isClosed);
+
+  // Synthetic workload generators. All are deterministic for a given seed (same output on every
+  // platform), arcRatio is the fraction of segments that are arcs (0 = all lines, 1 = all arcs).
+  // Shapes are scaled so the average segment length is about 1 regardless of vertexCount (feature
+  // density stays constant as vertexCount grows).
+
+  // Closed counter clockwise gear/spline like contour (teeth with seeded radial noise).
+  static std::vector<cavc_vertex> createGear(std::size_t vertexCount, cavc_real arcRatio,
+                                             uint64_t seed);
+
+  // Closed counter clockwise fractal coastline (sum of octaves of seeded radial noise).
+  static std::vector<cavc_vertex> createFractalCoastline(std::size_t vertexCount,
+                                                         cavc_real arcRatio, uint64_t seed);
+
+  // Open counter clockwise archimedean spiral with seeded jitter in the turn spacing.
+  static std::vector<cavc_vertex> createSpiral(std::size_t vertexCount, cavc_real arcRatio,
+                                               uint64_t seed);
+
+  // Open random walk path (self intersecting for larger vertexCount).
+  static std::vector<cavc_vertex> createRandomWalk(std::size_t vertexCount, cavc_real arcRatio,
+                                                   uint64_t seed);
+
+  // Perforated plate: element 0 is the counter clockwise plate outline, the rest are holeCount
+  // clockwise holes (each with vertexesPerHole vertexes, at least 2) with seeded size and position
+  // jitter on a grid, holes never overlap each other or the outline.
+  static std::vector<std::vector<cavc_vertex>>
+  createPerforatedPlate(std::size_t holeCount, std::size_t vertexesPerHole, cavc_real arcRatio,
+                        uint64_t seed);
 };
 
 #endif // CAVC_POLYLINEPATHFACTORY_HPP
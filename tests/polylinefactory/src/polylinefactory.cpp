@@ -1,4 +1,5 @@
 #include "polylinefactory.hpp"
+#include <algorithm>
 #include <cmath>
 
 static cavc_point pointOnCircle(cavc_real radius, cavc_point center, cavc_real angle) {
@@ -7,6 +8,53 @@ static cavc_point pointOnCircle(cavc_real radius, cavc_point center, cavc_real a
 
 inline static cavc_real PI() { return 3.14159265358979323846264338327950288; }
 
+namespace {
+// splitmix64 generator, used instead of <random> engines/distributions so generated shapes are
+// identical across standard library implementations
+class SeededRandom {
+public:
+  explicit SeededRandom(uint64_t seed) : m_state(seed) {}
+
+  uint64_t next() {
+    uint64_t z = (m_state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+  }
+
+  // uniform in [0, 1)
+  cavc_real uniform() { return static_cast<cavc_real>(next() >> 11) * 0x1.0p-53; }
+
+  // uniform in [min, max)
+  cavc_real uniform(cavc_real min, cavc_real max) { return min + (max - min) * uniform(); }
+
+  bool chance(cavc_real probability) { return uniform() < probability; }
+
+private:
+  uint64_t m_state;
+};
+
+// closed loop through points at the radii given (evenly spaced angles, counter clockwise), arc
+// segments get a small bulge so adjacent segments never cross
+std::vector<cavc_vertex> radialLoop(std::vector<cavc_real> const &radii, cavc_real arcRatio,
+                                    SeededRandom &rng) {
+  std::vector<cavc_vertex> result;
+  result.reserve(radii.size());
+  cavc_real const angleStep = 2.0 * PI() / static_cast<cavc_real>(radii.size());
+  for (std::size_t i = 0; i < radii.size(); ++i) {
+    cavc_point pt = pointOnCircle(radii[i], {0.0, 0.0}, static_cast<cavc_real>(i) * angleStep);
+    cavc_real bulge = rng.chance(arcRatio) ? rng.uniform(-0.1, 0.1) : 0.0;
+    result.push_back({pt.x, pt.y, bulge});
+  }
+  return result;
+}
+
+// radius giving an average segment length of 1 for vertexCount evenly spaced vertexes
+cavc_real unitSegmentRadius(std::size_t vertexCount) {
+  return static_cast<cavc_real>(vertexCount) / (2.0 * PI());
+}
+} // namespace
+
 std::vector<cavc_vertex> PolylineFactory::createCircle(cavc_real radius, cavc_point center,
                                                        cavc_real vertexRotAngle, bool isCW) {
   std::vector<cavc_vertex> result;
@@ -26,3 +74,136 @@ cavc_pline_ptr PolylineFactory::vertexesToPline(std::vector<cavc_vertex> const &
   return cavc_pline_ptr(
       cavc_pline_new(&vertexes[0], static_cast<uint32_t>(vertexes.size()), isClosed));
 }
+
+std::vector<cavc_vertex> PolylineFactory::createGear(std::size_t vertexCount, cavc_real arcRatio,
+                                                     uint64_t seed) {
+  vertexCount = std::max<std::size_t>(vertexCount, 8);
+  SeededRandom rng(seed);
+  cavc_real const baseRadius = unitSegmentRadius(vertexCount);
+  // each tooth spans 8 vertexes: 3 on the tip, 1 down flank, 3 in the root, 1 up flank
+  std::vector<cavc_real> radii(vertexCount);
+  for (std::size_t i = 0; i < vertexCount; ++i) {
+    std::size_t const toothPos = i % 8;
+    cavc_real const toothHeight = toothPos < 3 ? 1.5 : (toothPos == 3 || toothPos == 7 ? 0.75 : 0.0);
+    radii[i] = baseRadius + toothHeight + rng.uniform(-0.1, 0.1);
+  }
+
+  return radialLoop(radii, arcRatio, rng);
+}
+
+std::vector<cavc_vertex> PolylineFactory::createFractalCoastline(std::size_t vertexCount,
+                                                                 cavc_real arcRatio,
+                                                                 uint64_t seed) {
+  vertexCount = std::max<std::size_t>(vertexCount, 8);
+  SeededRandom rng(seed);
+  cavc_real const baseRadius = unitSegmentRadius(vertexCount);
+  // octave k has frequency 2^k and amplitude proportional to 1 / 2^k (brownian like roughness),
+  // total relative amplitude stays below 0.6 so the radius is always positive (simple loop)
+  struct Octave {
+    cavc_real frequency;
+    cavc_real amplitude;
+    cavc_real phase;
+  };
+  std::vector<Octave> octaves;
+  for (cavc_real frequency = 2.0; frequency <= static_cast<cavc_real>(vertexCount) / 4.0;
+       frequency *= 2.0) {
+    octaves.push_back({frequency, 0.6 / frequency, rng.uniform(0.0, 2.0 * PI())});
+  }
+
+  std::vector<cavc_real> radii(vertexCount);
+  cavc_real const angleStep = 2.0 * PI() / static_cast<cavc_real>(vertexCount);
+  for (std::size_t i = 0; i < vertexCount; ++i) {
+    cavc_real const angle = static_cast<cavc_real>(i) * angleStep;
+    cavc_real offset = 0.0;
+    for (auto const &octave : octaves) {
+      offset += octave.amplitude * std::sin(octave.frequency * angle + octave.phase);
+    }
+    radii[i] = baseRadius * (1.0 + offset);
+  }
+
+  return radialLoop(radii, arcRatio, rng);
+}
+
+std::vector<cavc_vertex> PolylineFactory::createSpiral(std::size_t vertexCount, cavc_real arcRatio,
+                                                       uint64_t seed) {
+  vertexCount = std::max<std::size_t>(vertexCount, 2);
+  SeededRandom rng(seed);
+  // r = turnSpacing * angle / (2 * pi), vertexes placed about 1 apart along the curve
+  cavc_real const turnSpacing = 4.0;
+  cavc_real const startRadius = 2.0;
+  std::vector<cavc_vertex> result;
+  result.reserve(vertexCount);
+  cavc_real angle = 2.0 * PI() * startRadius / turnSpacing;
+  for (std::size_t i = 0; i < vertexCount; ++i) {
+    cavc_real const radius = turnSpacing * angle / (2.0 * PI());
+    cavc_point const pt = pointOnCircle(radius, {0.0, 0.0}, angle);
+    cavc_real const angleStep = rng.uniform(0.9, 1.1) / radius;
+    // bulge following the spiral's curvature (arc sweep about equal to the angle step)
+    cavc_real const bulge = rng.chance(arcRatio) ? std::tan(angleStep / 4.0) : 0.0;
+    result.push_back({pt.x, pt.y, bulge});
+    angle += angleStep;
+  }
+
+  return result;
+}
+
+std::vector<cavc_vertex> PolylineFactory::createRandomWalk(std::size_t vertexCount,
+                                                           cavc_real arcRatio, uint64_t seed) {
+  vertexCount = std::max<std::size_t>(vertexCount, 2);
+  SeededRandom rng(seed);
+  std::vector<cavc_vertex> result;
+  result.reserve(vertexCount);
+  cavc_point pt{0.0, 0.0};
+  cavc_real heading = rng.uniform(0.0, 2.0 * PI());
+  for (std::size_t i = 0; i < vertexCount; ++i) {
+    cavc_real const bulge = rng.chance(arcRatio) ? rng.uniform(-0.5, 0.5) : 0.0;
+    result.push_back({pt.x, pt.y, bulge});
+    heading += rng.uniform(-0.5 * PI(), 0.5 * PI());
+    cavc_real const stepLength = rng.uniform(0.5, 1.5);
+    pt = pointOnCircle(stepLength, pt, heading);
+  }
+
+  return result;
+}
+
+std::vector<std::vector<cavc_vertex>>
+PolylineFactory::createPerforatedPlate(std::size_t holeCount, std::size_t vertexesPerHole,
+                                       cavc_real arcRatio, uint64_t seed) {
+  vertexesPerHole = std::max<std::size_t>(vertexesPerHole, 2);
+  SeededRandom rng(seed);
+  std::size_t const cols = std::max<std::size_t>(
+      static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<cavc_real>(holeCount)))), 1);
+  std::size_t const rows = (holeCount + cols - 1) / cols;
+  cavc_real const pitch = 10.0;
+  cavc_real const width = static_cast<cavc_real>(cols) * pitch;
+  cavc_real const height = static_cast<cavc_real>(std::max<std::size_t>(rows, 1)) * pitch;
+
+  std::vector<std::vector<cavc_vertex>> result;
+  result.reserve(holeCount + 1);
+  result.push_back({{0.0, 0.0, 0.0}, {width, 0.0, 0.0}, {width, height, 0.0}, {0.0, height, 0.0}});
+
+  for (std::size_t i = 0; i < holeCount; ++i) {
+    // radius + jitter stays within the cell (leaves at least 1 unit between holes)
+    cavc_real const radius = rng.uniform(2.0, 3.5);
+    cavc_real const maxJitter = 0.5 * pitch - radius - 0.5;
+    cavc_point const center{
+        (static_cast<cavc_real>(i % cols) + 0.5) * pitch + rng.uniform(-maxJitter, maxJitter),
+        (static_cast<cavc_real>(i / cols) + 0.5) * pitch + rng.uniform(-maxJitter, maxJitter)};
+    std::vector<cavc_vertex> hole;
+    if (vertexesPerHole == 2) {
+      hole = createCircle(radius, center, rng.uniform(0.0, PI()), true);
+    } else {
+      // clockwise polygon, arc segments bulge outward (still inside the circumscribed circle)
+      hole.reserve(vertexesPerHole);
+      cavc_real const angleStep = 2.0 * PI() / static_cast<cavc_real>(vertexesPerHole);
+      cavc_real const arcBulge = -std::tan(angleStep / 4.0);
+      for (std::size_t j = 0; j < vertexesPerHole; ++j) {
+        cavc_point const pt = pointOnCircle(radius, center, -static_cast<cavc_real>(j) * angleStep);
+        hole.push_back({pt.x, pt.y, rng.chance(arcRatio) ? arcBulge : 0.0});
+      }
+    }
+    result.push_back(std::move(hole));
+  }
+
+  return result;
+}
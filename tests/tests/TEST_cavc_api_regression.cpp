@@ -1,12 +1,19 @@
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cmath>
-#include <memory>
+#include <condition_variable>
+#include <cstdlib>
 #include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 #include <cavc/polyline.hpp>
 #include <cavc/polylineintersects.hpp>
 #include <cavc/polylineoffset.hpp>
+#include <cavc/polylineoffsetislands.hpp>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -46,6 +53,9 @@ using PlinePtr = std::unique_ptr<cavc_pline, PlineDeleter>;
 using PlineListPtr = std::unique_ptr<cavc_pline_list, PlineListDeleter>;
 using SpatialIndexPtr = std::unique_ptr<cavc_spatial_index, void (*)(cavc_spatial_index *)>;
 using TopologyPtr = std::unique_ptr<cavc_offset_loop_topology, TopologyDeleter>;
+using IslandsEnginePtr =
+    std::unique_ptr<cavc_offset_islands_engine, void (*)(cavc_offset_islands_engine *)>;
+using PlineBufferPtr = std::unique_ptr<cavc_pline_buffer, void (*)(cavc_pline_buffer *)>;
 
 std::vector<cavc_vertex> readVertexes(cavc_pline const *pline) {
   uint32_t count = cavc_pline_vertex_count(pline);
@@ -1550,6 +1560,32 @@ TEST(CApiRegression, SpatialIndexClosedPolylineQueryAndItemCount) {
   EXPECT_THAT(all_hits, t::Pointwise(t::Eq(), expected_all));
 }
 
+TEST(CApiRegression, MemoryUsageCoversNestedObjects) {
+  std::vector<cavc_vertex> square = {
+      {0.0, 0.0, 0.0}, {4.0, 0.0, 0.0}, {4.0, 2.0, 0.0}, {0.0, 2.0, 0.0}};
+  PlinePtr c_pline(plineFromVertexes(square, true));
+  uint64_t const pline_usage = cavc_pline_memory_usage(c_pline.get());
+  EXPECT_GE(pline_usage, 4 * sizeof(cavc_vertex));
+
+  // C API index wraps the C++ index built from the same polyline
+  cavc::Polyline<double> pline;
+  pline.isClosed() = true;
+  for (auto const &v : square) {
+    pline.addVertex(v.x, v.y, v.bulge);
+  }
+  std::size_t const spatialIndexUsage = cavc::createApproxSpatialIndex(pline).memoryUsage();
+  SpatialIndexPtr index(cavc_spatial_index_create(c_pline.get()), cavc_spatial_index_delete);
+  EXPECT_GT(cavc_spatial_index_memory_usage(index.get()), spatialIndexUsage);
+
+  cavc_pline_list *raw_results = nullptr;
+  cavc_parallel_offset(c_pline.get(), 0.5, &raw_results, defaultParallelOffsetOptions());
+  PlineListPtr results(raw_results);
+  ASSERT_EQ(cavc_pline_list_count(results.get()), 1u);
+  uint64_t const result_pline_usage =
+      cavc_pline_memory_usage(cavc_pline_list_get(results.get(), 0));
+  EXPECT_GT(cavc_pline_list_memory_usage(results.get()), result_pline_usage);
+}
+
 TEST(CApiRegression, SpatialIndexOpenPolylineQueryAndItemCount) {
   std::vector<cavc_vertex> open_rect = {
       {0.0, 0.0, 0.0}, {4.0, 0.0, 0.0}, {4.0, 2.0, 0.0}, {0.0, 2.0, 0.0}};
@@ -1673,6 +1709,23 @@ TEST(CApiRegression, RemoveRedundantSimplifiesInPlace) {
   EXPECT_EQ(cavc_pline_is_closed(pline.get()), 0);
 }
 
+TEST(CApiRegression, RemoveRedundantMergedHalfCircleArcBulgeStaysInRange) {
+  // two arcs on the unit circle sweeping just over a half circle (within epsilon) are merged
+  const cavc_real pi = 3.14159265358979323846;
+  const cavc_real endAngle = pi + 1e-7;
+  std::vector<cavc_vertex> arcs = {{1.0, 0.0, std::tan(pi / 8.0)},
+                                   {0.0, 1.0, std::tan((endAngle - pi / 2.0) / 4.0)},
+                                   {std::cos(endAngle), std::sin(endAngle), 0.0}};
+  PlinePtr pline(plineFromVertexes(arcs, false));
+
+  cavc_pline_remove_redundant(pline.get(), 1e-5);
+
+  std::vector<cavc_vertex> actual = readVertexes(pline.get());
+  ASSERT_EQ(actual.size(), 2u);
+  EXPECT_LE(std::abs(actual[0].bulge), 1.0);
+  EXPECT_NEAR(actual[0].bulge, 1.0, 1e-12);
+}
+
 TEST(CApiRegression, ConvertArcsToLinesProducesLineSegments) {
   const cavc_real radius = 2.0;
   std::vector<cavc_vertex> circle = {{0.0, 0.0, 1.0}, {2.0 * radius, 0.0, 1.0}};
@@ -1855,6 +1908,73 @@ TEST(CApiRegression, OffsetLoopTopologySupportsOuterOnlyInput) {
   EXPECT_EQ(node1.parent_index, CAVC_OFFSET_LOOP_NO_PARENT);
 }
 
+TEST(CApiRegression, OffsetIslandsEngineComputeMatchesCppAndIsReusable) {
+  auto outer_vertexes = makeAxisAlignedRectLoopVertexes(0.0, 0.0, 30.0, 20.0, false);
+  auto island_a_vertexes = makeAxisAlignedRectLoopVertexes(5.0, 5.0, 10.0, 10.0, true);
+  auto island_b_vertexes = makeAxisAlignedRectLoopVertexes(11.0, 5.0, 16.0, 10.0, true);
+
+  PlinePtr outer(plineFromVertexes(outer_vertexes, true));
+  PlinePtr island_a(plineFromVertexes(island_a_vertexes, true));
+  PlinePtr island_b(plineFromVertexes(island_b_vertexes, true));
+  cavc_pline const *ccw_loops[] = {outer.get()};
+  cavc_pline const *cw_loops[] = {island_a.get(), island_b.get()};
+
+  // expected result from the C++ API
+  cavc::OffsetLoopSet<cavc_real> cpp_input;
+  for (auto const *loop : ccw_loops) {
+    auto pline = toCppPolyline(loop);
+    auto spatial_index = cavc::createApproxSpatialIndex(pline);
+    cpp_input.ccwLoops.push_back({0, std::move(pline), std::move(spatial_index)});
+  }
+  for (auto const *loop : cw_loops) {
+    auto pline = toCppPolyline(loop);
+    auto spatial_index = cavc::createApproxSpatialIndex(pline);
+    cpp_input.cwLoops.push_back({0, std::move(pline), std::move(spatial_index)});
+  }
+  cavc::ParallelOffsetIslands<cavc_real> cpp_algorithm;
+  auto expected = cpp_algorithm.compute(cpp_input, 1.0);
+  // islands are 1 apart so their offsets merge into a single island
+  ASSERT_EQ(expected.ccwLoops.size(), 1u);
+  ASSERT_EQ(expected.cwLoops.size(), 1u);
+
+  IslandsEnginePtr engine(cavc_offset_islands_engine_new(), cavc_offset_islands_engine_delete);
+  ASSERT_NE(engine.get(), nullptr);
+  for (uint32_t max_threads : {1u, 0u, 4u}) {
+    cavc_offset_islands_engine_set_max_threads(engine.get(), max_threads);
+    cavc_pline_list *raw_ccw = nullptr;
+    cavc_pline_list *raw_cw = nullptr;
+    cavc_offset_islands_engine_compute(engine.get(), ccw_loops, 1, cw_loops, 2, 1.0, &raw_ccw,
+                                       &raw_cw);
+    PlineListPtr ccw_results(raw_ccw);
+    PlineListPtr cw_results(raw_cw);
+    ASSERT_NE(ccw_results.get(), nullptr);
+    ASSERT_NE(cw_results.get(), nullptr);
+    ASSERT_EQ(cavc_pline_list_count(ccw_results.get()), expected.ccwLoops.size());
+    ASSERT_EQ(cavc_pline_list_count(cw_results.get()), expected.cwLoops.size());
+
+    cavc_pline const *ccw_result = cavc_pline_list_get(ccw_results.get(), 0);
+    cavc_pline const *cw_result = cavc_pline_list_get(cw_results.get(), 0);
+    EXPECT_EQ(cavc_pline_is_closed(ccw_result), 1);
+    EXPECT_EQ(cavc_pline_is_closed(cw_result), 1);
+    EXPECT_NEAR(cavc_get_area(ccw_result), cavc::getArea(expected.ccwLoops[0].polyline), 1e-9);
+    EXPECT_NEAR(cavc_get_area(cw_result), cavc::getArea(expected.cwLoops[0].polyline), 1e-9);
+    EXPECT_LT(cavc_get_area(cw_result), 0.0);
+  }
+
+  // non-finite delta produces empty lists
+  cavc_pline_list *raw_ccw = nullptr;
+  cavc_pline_list *raw_cw = nullptr;
+  cavc_offset_islands_engine_compute(engine.get(), ccw_loops, 1, cw_loops, 2,
+                                     std::numeric_limits<cavc_real>::quiet_NaN(), &raw_ccw,
+                                     &raw_cw);
+  PlineListPtr ccw_results(raw_ccw);
+  PlineListPtr cw_results(raw_cw);
+  ASSERT_NE(ccw_results.get(), nullptr);
+  ASSERT_NE(cw_results.get(), nullptr);
+  EXPECT_EQ(cavc_pline_list_count(ccw_results.get()), 0u);
+  EXPECT_EQ(cavc_pline_list_count(cw_results.get()), 0u);
+}
+
 TEST(CApiRegression, TolerancesSetGetResetRoundTrip) {
   cavc_tolerances defaults{};
   cavc_get_tolerances(&defaults);
@@ -1882,6 +2002,790 @@ TEST(CApiRegression, TolerancesSetGetResetRoundTrip) {
   EXPECT_EQ(after_reset.offset_threshold, defaults.offset_threshold);
 }
 
+TEST(CApiRegression, ParallelOffsetViewMatchesPlineApiAndReusesBuffer) {
+  std::vector<cavc_vertex> const shape = makeShapeOffsetSelfIntersectInputVertexes();
+  std::vector<cavc_vertex> const open_line = {
+      {0.0, 0.0, 0.0}, {10.0, 0.0, 0.5}, {15.0, 5.0, 0.0}, {15.0, 10.0, 0.0}};
+  PlineBufferPtr buffer(cavc_pline_buffer_new(), cavc_pline_buffer_delete);
+  ASSERT_NE(buffer.get(), nullptr);
+  EXPECT_EQ(cavc_pline_buffer_count(buffer.get()), 0u);
+  EXPECT_EQ(cavc_pline_buffer_vertex_count(buffer.get()), 0u);
+  EXPECT_EQ(cavc_pline_buffer_offsets(buffer.get())[0], 0u);
+
+  auto checkMatches = [&](std::vector<cavc_vertex> const &input, bool is_closed, cavc_real delta) {
+    PlinePtr pline(plineFromVertexes(input, is_closed));
+    cavc_pline_list *raw_expected = nullptr;
+    cavc_parallel_offset(pline.get(), delta, &raw_expected, defaultParallelOffsetOptions());
+    PlineListPtr expected(raw_expected);
+
+    cavc_parallel_offset_view(input.data(), static_cast<uint32_t>(input.size()),
+                              is_closed ? 1 : 0, delta, defaultParallelOffsetOptions(),
+                              buffer.get());
+
+    uint32_t const count = cavc_pline_list_count(expected.get());
+    ASSERT_GT(count, 0u);
+    ASSERT_EQ(cavc_pline_buffer_count(buffer.get()), count);
+    uint32_t const *offsets = cavc_pline_buffer_offsets(buffer.get());
+    cavc_vertex const *vertexes = cavc_pline_buffer_vertex_data(buffer.get());
+    EXPECT_EQ(offsets[count], cavc_pline_buffer_vertex_count(buffer.get()));
+    for (uint32_t i = 0; i < count; ++i) {
+      cavc_pline const *expected_pline = cavc_pline_list_get(expected.get(), i);
+      std::vector<cavc_vertex> expected_vertexes = readVertexes(expected_pline);
+      ASSERT_EQ(offsets[i + 1] - offsets[i], expected_vertexes.size());
+      EXPECT_EQ(cavc_pline_buffer_is_closed(buffer.get(), i), cavc_pline_is_closed(expected_pline));
+      for (std::size_t j = 0; j < expected_vertexes.size(); ++j) {
+        cavc_vertex const &v = vertexes[offsets[i] + j];
+        EXPECT_EQ(v.x, expected_vertexes[j].x);
+        EXPECT_EQ(v.y, expected_vertexes[j].y);
+        EXPECT_EQ(v.bulge, expected_vertexes[j].bulge);
+      }
+    }
+  };
+
+  checkMatches(shape, true, 0.125);
+  checkMatches(open_line, false, 1.0);
+  checkMatches(shape, true, -0.125);
+
+  // invalid delta produces empty output
+  cavc_parallel_offset_view(shape.data(), static_cast<uint32_t>(shape.size()), 1,
+                            std::numeric_limits<cavc_real>::quiet_NaN(),
+                            defaultParallelOffsetOptions(), buffer.get());
+  EXPECT_EQ(cavc_pline_buffer_count(buffer.get()), 0u);
+  EXPECT_EQ(cavc_pline_buffer_vertex_count(buffer.get()), 0u);
+}
+
+TEST(CApiRegression, ParallelOffsetViewToReportsRequiredSizesAndWritesCallerArrays) {
+  std::vector<cavc_vertex> const shape = makeShapeOffsetSelfIntersectInputVertexes();
+  uint32_t const input_count = static_cast<uint32_t>(shape.size());
+  uint32_t pline_count = 0;
+  uint32_t total_vertex_count = 0;
+  EXPECT_EQ(cavc_parallel_offset_view_to(shape.data(), input_count, 1, 0.125,
+                                         defaultParallelOffsetOptions(), nullptr, 0, nullptr, 0,
+                                         nullptr, &pline_count, &total_vertex_count, nullptr),
+            0);
+  ASSERT_GT(pline_count, 0u);
+  ASSERT_GT(total_vertex_count, 0u);
+
+  std::vector<cavc_vertex> vertexes(total_vertex_count);
+  std::vector<uint32_t> offsets(pline_count + 1);
+  std::vector<int> is_closed(pline_count);
+  EXPECT_EQ(cavc_parallel_offset_view_to(
+                shape.data(), input_count, 1, 0.125, defaultParallelOffsetOptions(),
+                vertexes.data(), total_vertex_count, offsets.data(),
+                static_cast<uint32_t>(offsets.size()), is_closed.data(), &pline_count,
+                &total_vertex_count, nullptr),
+            1);
+
+  PlineBufferPtr buffer(cavc_pline_buffer_new(), cavc_pline_buffer_delete);
+  cavc_parallel_offset_view(shape.data(), input_count, 1, 0.125, defaultParallelOffsetOptions(),
+                            buffer.get());
+  ASSERT_EQ(cavc_pline_buffer_count(buffer.get()), pline_count);
+  ASSERT_EQ(cavc_pline_buffer_vertex_count(buffer.get()), total_vertex_count);
+  for (uint32_t i = 0; i <= pline_count; ++i) {
+    EXPECT_EQ(offsets[i], cavc_pline_buffer_offsets(buffer.get())[i]);
+  }
+  for (uint32_t i = 0; i < pline_count; ++i) {
+    EXPECT_EQ(is_closed[i], cavc_pline_buffer_is_closed(buffer.get(), i));
+  }
+  cavc_vertex const *buffer_vertexes = cavc_pline_buffer_vertex_data(buffer.get());
+  for (uint32_t i = 0; i < total_vertex_count; ++i) {
+    EXPECT_EQ(vertexes[i].x, buffer_vertexes[i].x);
+    EXPECT_EQ(vertexes[i].y, buffer_vertexes[i].y);
+    EXPECT_EQ(vertexes[i].bulge, buffer_vertexes[i].bulge);
+  }
+}
+
+TEST(CApiRegression, ParallelOffsetViewToKeepsResultThatDoesNotFit) {
+  std::vector<cavc_vertex> const shape = makeShapeOffsetSelfIntersectInputVertexes();
+  uint32_t const input_count = static_cast<uint32_t>(shape.size());
+  PlineBufferPtr expected(cavc_pline_buffer_new(), cavc_pline_buffer_delete);
+  cavc_parallel_offset_view(shape.data(), input_count, 1, 0.125, defaultParallelOffsetOptions(),
+                            expected.get());
+  uint32_t const expected_count = cavc_pline_buffer_count(expected.get());
+  uint32_t const expected_vertex_count = cavc_pline_buffer_vertex_count(expected.get());
+  ASSERT_GT(expected_count, 0u);
+
+  // too small arrays leave them untouched and keep the result in the overflow buffer
+  std::vector<cavc_vertex> small_vertexes(1, cavc_vertex{-1.0, -1.0, -1.0});
+  std::vector<uint32_t> small_offsets(2, 7u);
+  uint32_t pline_count = 0;
+  uint32_t total_vertex_count = 0;
+  PlineBufferPtr overflow(cavc_pline_buffer_new(), cavc_pline_buffer_delete);
+  EXPECT_EQ(cavc_parallel_offset_view_to(
+                shape.data(), input_count, 1, 0.125, defaultParallelOffsetOptions(),
+                small_vertexes.data(), 1, small_offsets.data(), 2, nullptr, &pline_count,
+                &total_vertex_count, overflow.get()),
+            0);
+  EXPECT_EQ(pline_count, expected_count);
+  EXPECT_EQ(total_vertex_count, expected_vertex_count);
+  EXPECT_EQ(small_vertexes[0].x, -1.0);
+  EXPECT_EQ(small_offsets[0], 7u);
+  ASSERT_EQ(cavc_pline_buffer_count(overflow.get()), expected_count);
+  ASSERT_EQ(cavc_pline_buffer_vertex_count(overflow.get()), expected_vertex_count);
+
+  // copy out of the overflow buffer once arrays of the reported sizes are allocated
+  std::vector<cavc_vertex> vertexes(total_vertex_count);
+  std::vector<uint32_t> offsets(pline_count + 1);
+  std::vector<int> is_closed(pline_count);
+  EXPECT_EQ(cavc_pline_buffer_copy_to(overflow.get(), vertexes.data(), total_vertex_count - 1,
+                                      offsets.data(), pline_count + 1, is_closed.data()),
+            0);
+  EXPECT_EQ(cavc_pline_buffer_copy_to(overflow.get(), vertexes.data(), total_vertex_count,
+                                      offsets.data(), pline_count + 1, is_closed.data()),
+            1);
+  for (uint32_t i = 0; i <= pline_count; ++i) {
+    EXPECT_EQ(offsets[i], cavc_pline_buffer_offsets(expected.get())[i]);
+  }
+  for (uint32_t i = 0; i < pline_count; ++i) {
+    EXPECT_EQ(is_closed[i], cavc_pline_buffer_is_closed(expected.get(), i));
+  }
+  cavc_vertex const *expected_vertexes = cavc_pline_buffer_vertex_data(expected.get());
+  for (uint32_t i = 0; i < total_vertex_count; ++i) {
+    EXPECT_EQ(vertexes[i].x, expected_vertexes[i].x);
+    EXPECT_EQ(vertexes[i].y, expected_vertexes[i].y);
+    EXPECT_EQ(vertexes[i].bulge, expected_vertexes[i].bulge);
+  }
+}
+
+namespace {
+// packs polylines into one contiguous vertex array plus offsets (batch function input layout)
+struct PackedPlines {
+  std::vector<cavc_vertex> vertexes;
+  std::vector<uint32_t> offsets{0};
+  std::vector<int> is_closed;
+
+  void add(std::vector<cavc_vertex> const &pline, bool closed) {
+    vertexes.insert(vertexes.end(), pline.begin(), pline.end());
+    offsets.push_back(static_cast<uint32_t>(vertexes.size()));
+    is_closed.push_back(closed ? 1 : 0);
+  }
+
+  uint32_t count() const { return static_cast<uint32_t>(is_closed.size()); }
+};
+
+std::vector<cavc_vertex> makeSquareVertexes(cavc_real x, cavc_real y, cavc_real size) {
+  return {{x, y, 0.0}, {x + size, y, 0.0}, {x + size, y + size, 0.5}, {x, y + size, 0.0}};
+}
+
+// expects buffer polylines with source index `source` to equal the polylines in list
+void expectBufferRangeMatchesList(cavc_pline_buffer const *buffer, uint32_t &buffer_index,
+                                  uint32_t source, cavc_pline_list const *list) {
+  uint32_t const *offsets = cavc_pline_buffer_offsets(buffer);
+  cavc_vertex const *vertexes = cavc_pline_buffer_vertex_data(buffer);
+  for (uint32_t i = 0; i < cavc_pline_list_count(list); ++i, ++buffer_index) {
+    ASSERT_LT(buffer_index, cavc_pline_buffer_count(buffer));
+    EXPECT_EQ(cavc_pline_buffer_source_index(buffer, buffer_index), source);
+    cavc_pline const *expected_pline = cavc_pline_list_get(list, i);
+    std::vector<cavc_vertex> expected_vertexes = readVertexes(expected_pline);
+    ASSERT_EQ(offsets[buffer_index + 1] - offsets[buffer_index], expected_vertexes.size());
+    EXPECT_EQ(cavc_pline_buffer_is_closed(buffer, buffer_index),
+              cavc_pline_is_closed(expected_pline));
+    for (std::size_t j = 0; j < expected_vertexes.size(); ++j) {
+      cavc_vertex const &v = vertexes[offsets[buffer_index] + j];
+      EXPECT_EQ(v.x, expected_vertexes[j].x);
+      EXPECT_EQ(v.y, expected_vertexes[j].y);
+      EXPECT_EQ(v.bulge, expected_vertexes[j].bulge);
+    }
+  }
+}
+
+void expectBuffersEqual(cavc_pline_buffer const *a, cavc_pline_buffer const *b) {
+  ASSERT_EQ(cavc_pline_buffer_count(a), cavc_pline_buffer_count(b));
+  ASSERT_EQ(cavc_pline_buffer_vertex_count(a), cavc_pline_buffer_vertex_count(b));
+  for (uint32_t i = 0; i <= cavc_pline_buffer_count(a); ++i) {
+    EXPECT_EQ(cavc_pline_buffer_offsets(a)[i], cavc_pline_buffer_offsets(b)[i]);
+  }
+  for (uint32_t i = 0; i < cavc_pline_buffer_count(a); ++i) {
+    EXPECT_EQ(cavc_pline_buffer_source_index(a, i), cavc_pline_buffer_source_index(b, i));
+    EXPECT_EQ(cavc_pline_buffer_is_closed(a, i), cavc_pline_buffer_is_closed(b, i));
+  }
+  for (uint32_t i = 0; i < cavc_pline_buffer_vertex_count(a); ++i) {
+    EXPECT_EQ(cavc_pline_buffer_vertex_data(a)[i].x, cavc_pline_buffer_vertex_data(b)[i].x);
+    EXPECT_EQ(cavc_pline_buffer_vertex_data(a)[i].y, cavc_pline_buffer_vertex_data(b)[i].y);
+    EXPECT_EQ(cavc_pline_buffer_vertex_data(a)[i].bulge,
+              cavc_pline_buffer_vertex_data(b)[i].bulge);
+  }
+}
+} // namespace
+
+TEST(CApiRegression, ParallelOffsetBatchMatchesSingleCallsForAnyThreadCount) {
+  PackedPlines input;
+  input.add(makeShapeOffsetSelfIntersectInputVertexes(), true);
+  input.add({{0.0, 0.0, 0.0}, {10.0, 0.0, 0.5}, {15.0, 5.0, 0.0}, {15.0, 10.0, 0.0}}, false);
+  input.add({}, false);
+  for (int i = 0; i < 6; ++i) {
+    input.add(makeSquareVertexes(20.0 * i, 0.0, 5.0 + i), true);
+  }
+
+  PlineBufferPtr serial(cavc_pline_buffer_new(), cavc_pline_buffer_delete);
+  PlineBufferPtr threaded(cavc_pline_buffer_new(), cavc_pline_buffer_delete);
+  cavc_parallel_offset_batch(input.vertexes.data(), input.offsets.data(), input.is_closed.data(),
+                             input.count(), 0.125, defaultParallelOffsetOptions(), 1,
+                             serial.get());
+  cavc_parallel_offset_batch(input.vertexes.data(), input.offsets.data(), input.is_closed.data(),
+                             input.count(), 0.125, defaultParallelOffsetOptions(), 4,
+                             threaded.get());
+  expectBuffersEqual(serial.get(), threaded.get());
+
+  uint32_t buffer_index = 0;
+  for (uint32_t i = 0; i < input.count(); ++i) {
+    std::vector<cavc_vertex> vertexes(input.vertexes.begin() + input.offsets[i],
+                                      input.vertexes.begin() + input.offsets[i + 1]);
+    PlinePtr pline(plineFromVertexes(vertexes, input.is_closed[i] != 0));
+    cavc_pline_list *raw_expected = nullptr;
+    cavc_parallel_offset(pline.get(), 0.125, &raw_expected, defaultParallelOffsetOptions());
+    PlineListPtr expected(raw_expected);
+    expectBufferRangeMatchesList(serial.get(), buffer_index, i, expected.get());
+  }
+  EXPECT_EQ(buffer_index, cavc_pline_buffer_count(serial.get()));
+
+  // invalid delta produces empty output
+  cavc_parallel_offset_batch(input.vertexes.data(), input.offsets.data(), input.is_closed.data(),
+                             input.count(), std::numeric_limits<cavc_real>::infinity(),
+                             defaultParallelOffsetOptions(), 0, serial.get());
+  EXPECT_EQ(cavc_pline_buffer_count(serial.get()), 0u);
+}
+
+TEST(CApiRegression, CombinePlinesBatchMatchesSingleCalls) {
+  PackedPlines a;
+  PackedPlines b;
+  for (int i = 0; i < 5; ++i) {
+    a.add(makeSquareVertexes(0.0, 0.0, 10.0), true);
+    b.add(makeSquareVertexes(2.0 * i, 3.0, 6.0), true);
+  }
+
+  for (int mode = 0; mode < 4; ++mode) {
+    PlineBufferPtr remaining(cavc_pline_buffer_new(), cavc_pline_buffer_delete);
+    PlineBufferPtr subtracted(cavc_pline_buffer_new(), cavc_pline_buffer_delete);
+    cavc_combine_plines_batch(a.vertexes.data(), a.offsets.data(), b.vertexes.data(),
+                              b.offsets.data(), a.count(), mode, 1, remaining.get(),
+                              subtracted.get());
+
+    PlineBufferPtr remaining_threaded(cavc_pline_buffer_new(), cavc_pline_buffer_delete);
+    PlineBufferPtr subtracted_threaded(cavc_pline_buffer_new(), cavc_pline_buffer_delete);
+    cavc_combine_plines_batch(a.vertexes.data(), a.offsets.data(), b.vertexes.data(),
+                              b.offsets.data(), a.count(), mode, 3, remaining_threaded.get(),
+                              subtracted_threaded.get());
+    expectBuffersEqual(remaining.get(), remaining_threaded.get());
+    expectBuffersEqual(subtracted.get(), subtracted_threaded.get());
+
+    uint32_t remaining_index = 0;
+    uint32_t subtracted_index = 0;
+    for (uint32_t i = 0; i < a.count(); ++i) {
+      PlinePtr pline_a(plineFromVertexes(
+          {a.vertexes.begin() + a.offsets[i], a.vertexes.begin() + a.offsets[i + 1]}, true));
+      PlinePtr pline_b(plineFromVertexes(
+          {b.vertexes.begin() + b.offsets[i], b.vertexes.begin() + b.offsets[i + 1]}, true));
+      cavc_pline_list *raw_remaining = nullptr;
+      cavc_pline_list *raw_subtracted = nullptr;
+      cavc_combine_plines(pline_a.get(), pline_b.get(), mode, &raw_remaining, &raw_subtracted);
+      PlineListPtr expected_remaining(raw_remaining);
+      PlineListPtr expected_subtracted(raw_subtracted);
+      expectBufferRangeMatchesList(remaining.get(), remaining_index, i, expected_remaining.get());
+      expectBufferRangeMatchesList(subtracted.get(), subtracted_index, i,
+                                   expected_subtracted.get());
+    }
+    EXPECT_EQ(remaining_index, cavc_pline_buffer_count(remaining.get()));
+    EXPECT_EQ(subtracted_index, cavc_pline_buffer_count(subtracted.get()));
+  }
+}
+
+TEST(CApiRegression, ExtentsBatchMatchesSingleCalls) {
+  PackedPlines input;
+  for (int i = 0; i < 300; ++i) {
+    input.add(makeSquareVertexes(1.5 * i, -0.5 * i, 1.0 + 0.01 * i), i % 3 != 0);
+  }
+  input.add({}, false);
+
+  std::vector<cavc_real> serial(4 * input.count());
+  std::vector<cavc_real> threaded(4 * input.count());
+  cavc_get_extents_batch(input.vertexes.data(), input.offsets.data(), input.is_closed.data(),
+                         input.count(), 1, serial.data());
+  cavc_get_extents_batch(input.vertexes.data(), input.offsets.data(), input.is_closed.data(),
+                         input.count(), 4, threaded.data());
+  EXPECT_EQ(serial, threaded);
+
+  for (uint32_t i = 0; i < input.count(); ++i) {
+    PlinePtr pline(plineFromVertexes({input.vertexes.begin() + input.offsets[i],
+                                      input.vertexes.begin() + input.offsets[i + 1]},
+                                     input.is_closed[i] != 0));
+    cavc_real min_x, min_y, max_x, max_y;
+    cavc_get_extents(pline.get(), &min_x, &min_y, &max_x, &max_y);
+    EXPECT_EQ(serial[4 * i], min_x);
+    EXPECT_EQ(serial[4 * i + 1], min_y);
+    EXPECT_EQ(serial[4 * i + 2], max_x);
+    EXPECT_EQ(serial[4 * i + 3], max_y);
+  }
+}
+
+TEST(CApiRegression, PointBatchesMatchSingleCalls) {
+  std::vector<cavc_vertex> const shape = makeShapeOffsetSelfIntersectInputVertexes();
+  PlinePtr pline(plineFromVertexes(shape, true));
+  cavc_real min_x, min_y, max_x, max_y;
+  cavc_get_extents(pline.get(), &min_x, &min_y, &max_x, &max_y);
+
+  // grid over the extents plus every vertex (on boundary)
+  std::vector<cavc_point> points;
+  for (int i = 0; i <= 40; ++i) {
+    for (int j = 0; j <= 40; ++j) {
+      points.push_back({min_x - 1.0 + (max_x - min_x + 2.0) * i / 40.0,
+                        min_y - 1.0 + (max_y - min_y + 2.0) * j / 40.0});
+    }
+  }
+  for (auto const &v : shape) {
+    points.push_back({v.x, v.y});
+  }
+  uint32_t const point_count = static_cast<uint32_t>(points.size());
+  uint32_t const vertex_count = static_cast<uint32_t>(shape.size());
+
+  for (uint32_t thread_count : {1u, 4u}) {
+    std::vector<int> winding_numbers(points.size());
+    cavc_get_winding_numbers(shape.data(), vertex_count, 1, points.data(), point_count,
+                             thread_count, winding_numbers.data());
+    std::vector<cavc_point_containment> containments(points.size());
+    cavc_get_point_containments(shape.data(), vertex_count, 1, points.data(), point_count, 1e-5,
+                                thread_count, containments.data());
+    for (std::size_t i = 0; i < points.size(); ++i) {
+      EXPECT_EQ(winding_numbers[i], cavc_get_winding_number(pline.get(), points[i]));
+      EXPECT_EQ(containments[i], cavc_get_point_containment(pline.get(), points[i], 1e-5));
+    }
+  }
+
+  // small batches take the unindexed path
+  std::vector<cavc_point_containment> containments(2);
+  cavc_get_point_containments(shape.data(), vertex_count, 1, points.data() + point_count - 2, 2,
+                              1e-5, 0, containments.data());
+  EXPECT_EQ(containments[0], CAVC_POINT_ON_BOUNDARY);
+  EXPECT_EQ(containments[1], CAVC_POINT_ON_BOUNDARY);
+}
+
+TEST(CApiRegression, PlineSoaRoundTripMatchesInterleavedData) {
+  std::vector<cavc_vertex> const shape = makeShapeOffsetSelfIntersectInputVertexes();
+  std::vector<cavc_real> xs;
+  std::vector<cavc_real> ys;
+  std::vector<cavc_real> bulges;
+  for (auto const &v : shape) {
+    xs.push_back(v.x);
+    ys.push_back(v.y);
+    bulges.push_back(v.bulge);
+  }
+  uint32_t const count = static_cast<uint32_t>(shape.size());
+
+  PlinePtr expected(plineFromVertexes(shape, true));
+  PlinePtr pline(cavc_pline_new_soa(xs.data(), 0, ys.data(), 0, bulges.data(), 0, count, 1));
+  EXPECT_EQ(cavc_pline_is_closed(pline.get()), 1);
+  std::vector<cavc_vertex> const vertexes = readVertexes(pline.get());
+  ASSERT_EQ(vertexes.size(), shape.size());
+  for (std::size_t i = 0; i < shape.size(); ++i) {
+    EXPECT_EQ(vertexes[i].x, shape[i].x);
+    EXPECT_EQ(vertexes[i].y, shape[i].y);
+    EXPECT_EQ(vertexes[i].bulge, shape[i].bulge);
+  }
+
+  // strided output (every other value of a shared array) and skipped bulge column
+  std::vector<cavc_real> xy(2 * shape.size(), -1.0);
+  cavc_pline_vertex_data_soa(pline.get(), xy.data(), 2 * sizeof(cavc_real), xy.data() + 1,
+                             2 * sizeof(cavc_real), nullptr, 0);
+  for (std::size_t i = 0; i < shape.size(); ++i) {
+    EXPECT_EQ(xy[2 * i], shape[i].x);
+    EXPECT_EQ(xy[2 * i + 1], shape[i].y);
+  }
+
+  // strided input from the interleaved array and null bulge (all zero)
+  cavc_pline_set_vertex_data_soa(pline.get(), &shape[0].x, sizeof(cavc_vertex), &shape[0].y,
+                                 sizeof(cavc_vertex), nullptr, 0, count);
+  EXPECT_EQ(cavc_pline_is_closed(pline.get()), 1);
+  std::vector<cavc_real> out_bulges(shape.size(), -1.0);
+  cavc_pline_vertex_data_soa(pline.get(), nullptr, 0, nullptr, 0, out_bulges.data(), 0);
+  EXPECT_THAT(out_bulges, t::Each(0.0));
+
+  PlinePtr empty(cavc_pline_new_soa(nullptr, 0, nullptr, 0, nullptr, 0, 0, 0));
+  EXPECT_EQ(cavc_pline_vertex_count(empty.get()), 0u);
+}
+
+TEST(CApiRegression, PlineListAndBufferExportSoaMatchInterleavedData) {
+  std::vector<cavc_vertex> const shape = makeShapeOffsetSelfIntersectInputVertexes();
+  PlinePtr pline(plineFromVertexes(shape, true));
+  cavc_pline_list *raw_results = nullptr;
+  cavc_parallel_offset(pline.get(), -0.125, &raw_results, defaultParallelOffsetOptions());
+  PlineListPtr results(raw_results);
+  uint32_t const count = cavc_pline_list_count(results.get());
+  uint32_t const vertex_count = cavc_pline_list_vertex_count(results.get());
+  ASSERT_GT(count, 0u);
+
+  std::vector<cavc_real> xs(vertex_count);
+  std::vector<cavc_real> ys(vertex_count);
+  std::vector<cavc_real> bulges(vertex_count);
+  std::vector<uint32_t> offsets(count + 1);
+  std::vector<int> is_closed(count);
+  cavc_pline_list_export_soa(results.get(), xs.data(), 0, ys.data(), 0, bulges.data(), 0,
+                             offsets.data(), is_closed.data());
+  EXPECT_EQ(offsets[0], 0u);
+  EXPECT_EQ(offsets[count], vertex_count);
+  for (uint32_t i = 0; i < count; ++i) {
+    cavc_pline const *result = cavc_pline_list_get(results.get(), i);
+    std::vector<cavc_vertex> const expected = readVertexes(result);
+    ASSERT_EQ(offsets[i + 1] - offsets[i], expected.size());
+    EXPECT_EQ(is_closed[i], cavc_pline_is_closed(result));
+    for (std::size_t j = 0; j < expected.size(); ++j) {
+      EXPECT_EQ(xs[offsets[i] + j], expected[j].x);
+      EXPECT_EQ(ys[offsets[i] + j], expected[j].y);
+      EXPECT_EQ(bulges[offsets[i] + j], expected[j].bulge);
+    }
+  }
+
+  PlineBufferPtr buffer(cavc_pline_buffer_new(), cavc_pline_buffer_delete);
+  cavc_parallel_offset_view(shape.data(), static_cast<uint32_t>(shape.size()), 1, -0.125,
+                            defaultParallelOffsetOptions(), buffer.get());
+  ASSERT_EQ(cavc_pline_buffer_vertex_count(buffer.get()), vertex_count);
+  std::vector<cavc_real> buffer_xs(vertex_count);
+  std::vector<cavc_real> buffer_ys(vertex_count);
+  std::vector<cavc_real> buffer_bulges(vertex_count);
+  cavc_pline_buffer_vertex_data_soa(buffer.get(), buffer_xs.data(), 0, buffer_ys.data(), 0,
+                                    buffer_bulges.data(), 0);
+  EXPECT_EQ(buffer_xs, xs);
+  EXPECT_EQ(buffer_ys, ys);
+  EXPECT_EQ(buffer_bulges, bulges);
+}
+
+namespace {
+struct CountingAllocator {
+  std::size_t malloc_count = 0;
+  std::size_t free_count = 0;
+
+  static void *allocate(size_t size, void *user_data) {
+    ++static_cast<CountingAllocator *>(user_data)->malloc_count;
+    return std::malloc(size);
+  }
+
+  static void free(void *ptr, void *user_data) {
+    ++static_cast<CountingAllocator *>(user_data)->free_count;
+    std::free(ptr);
+  }
+};
+} // namespace
+
+TEST(CApiRegression, AllocatorHooksAreUsedForHandlesAndFreedWithMatchingHook) {
+  std::vector<cavc_vertex> const shape = makeShapeOffsetSelfIntersectInputVertexes();
+  CountingAllocator counter;
+  cavc_set_allocator(&CountingAllocator::allocate, &CountingAllocator::free, &counter);
+  PlinePtr pline(plineFromVertexes(shape, true));
+  cavc_pline_list *raw_results = nullptr;
+  cavc_parallel_offset(pline.get(), 0.125, &raw_results, defaultParallelOffsetOptions());
+  PlineListPtr results(raw_results);
+  PlineBufferPtr buffer(cavc_pline_buffer_new(), cavc_pline_buffer_delete);
+  cavc_parallel_offset_view(shape.data(), static_cast<uint32_t>(shape.size()), 1, 0.125,
+                            defaultParallelOffsetOptions(), buffer.get());
+  std::size_t const malloc_count = counter.malloc_count;
+  EXPECT_GT(malloc_count, 3u);
+
+  // objects allocated with the hooks are freed with them after the hooks are reset
+  cavc_set_allocator(nullptr, nullptr, nullptr);
+  PlinePtr default_pline(plineFromVertexes(shape, true));
+  EXPECT_EQ(counter.malloc_count, malloc_count);
+  pline.reset();
+  results.reset();
+  buffer.reset();
+  default_pline.reset();
+  EXPECT_EQ(counter.free_count, counter.malloc_count);
+}
+
+TEST(CApiRegression, AllocatorHooksAreUsedForPlineVertexStorage) {
+  std::vector<cavc_vertex> const shape = makeShapeOffsetSelfIntersectInputVertexes();
+  PlinePtr expected(plineFromVertexes(shape, true));
+  CountingAllocator counter;
+  cavc_set_allocator(&CountingAllocator::allocate, &CountingAllocator::free, &counter);
+  PlinePtr pline(cavc_pline_new(nullptr, 0, 1));
+  std::size_t const handle_malloc_count = counter.malloc_count;
+  cavc_pline_set_capacity(pline.get(), 1024);
+  EXPECT_EQ(counter.malloc_count, handle_malloc_count + 1);
+  cavc_pline_set_vertex_data(pline.get(), shape.data(), static_cast<uint32_t>(shape.size()));
+  EXPECT_EQ(counter.malloc_count, handle_malloc_count + 1);
+  EXPECT_EQ(cavc_pline_vertex_count(pline.get()), shape.size());
+  EXPECT_EQ(cavc_get_area(pline.get()), cavc_get_area(expected.get()));
+
+  cavc_set_allocator(nullptr, nullptr, nullptr);
+  pline.reset();
+  EXPECT_EQ(counter.free_count, counter.malloc_count);
+}
+
+TEST(CApiRegression, ArenaBufferMatchesDefaultBufferAndResetReusesBlocks) {
+  std::vector<cavc_vertex> const shape = makeShapeOffsetSelfIntersectInputVertexes();
+  uint32_t const count = static_cast<uint32_t>(shape.size());
+  PlineBufferPtr expected(cavc_pline_buffer_new(), cavc_pline_buffer_delete);
+  cavc_parallel_offset_view(shape.data(), count, 1, -0.125, defaultParallelOffsetOptions(),
+                            expected.get());
+
+  CountingAllocator counter;
+  cavc_set_allocator(&CountingAllocator::allocate, &CountingAllocator::free, &counter);
+  cavc_arena *arena = cavc_arena_new(1024);
+  EXPECT_EQ(cavc_arena_bytes_used(arena), 0u);
+  EXPECT_EQ(cavc_arena_bytes_reserved(arena), 0u);
+
+  uint64_t reserved = 0;
+  for (int pass = 0; pass < 2; ++pass) {
+    cavc_pline_buffer *buffer = cavc_pline_buffer_new_in_arena(arena);
+    cavc_parallel_offset_view(shape.data(), count, 1, -0.125, defaultParallelOffsetOptions(),
+                              buffer);
+    EXPECT_GT(cavc_arena_bytes_used(arena),
+              cavc_pline_buffer_vertex_count(buffer) * sizeof(cavc_vertex));
+    ASSERT_EQ(cavc_pline_buffer_count(buffer), cavc_pline_buffer_count(expected.get()));
+    ASSERT_EQ(cavc_pline_buffer_vertex_count(buffer),
+              cavc_pline_buffer_vertex_count(expected.get()));
+    for (uint32_t i = 0; i < cavc_pline_buffer_vertex_count(buffer); ++i) {
+      EXPECT_EQ(cavc_pline_buffer_vertex_data(buffer)[i].x,
+                cavc_pline_buffer_vertex_data(expected.get())[i].x);
+      EXPECT_EQ(cavc_pline_buffer_vertex_data(buffer)[i].y,
+                cavc_pline_buffer_vertex_data(expected.get())[i].y);
+    }
+
+    cavc_arena_reset(arena);
+    EXPECT_EQ(cavc_arena_bytes_used(arena), 0u);
+    if (pass == 0) {
+      reserved = cavc_arena_bytes_reserved(arena);
+      EXPECT_GT(reserved, 0u);
+    } else {
+      // same work after reset reuses the existing blocks
+      EXPECT_EQ(cavc_arena_bytes_reserved(arena), reserved);
+    }
+  }
+
+  cavc_arena_delete(arena);
+  cavc_set_allocator(nullptr, nullptr, nullptr);
+  EXPECT_GT(counter.malloc_count, 0u);
+  EXPECT_EQ(counter.free_count, counter.malloc_count);
+}
+
+namespace {
+struct JobDeleter {
+  void operator()(cavc_job *job) const { cavc_job_delete(job); }
+};
+
+using JobPtr = std::unique_ptr<cavc_job, JobDeleter>;
+
+struct JobCallbackRecord {
+  std::atomic<int> call_count{0};
+  std::atomic<int> last_status{-1};
+
+  static void record(cavc_job *, cavc_job_status status, void *user_data) {
+    auto *self = static_cast<JobCallbackRecord *>(user_data);
+    self->last_status = status;
+    ++self->call_count;
+  }
+};
+
+void expectListsEqual(cavc_pline_list const *a, cavc_pline_list const *b) {
+  ASSERT_EQ(cavc_pline_list_count(a), cavc_pline_list_count(b));
+  for (uint32_t i = 0; i < cavc_pline_list_count(a); ++i) {
+    std::vector<cavc_vertex> const va = readVertexes(cavc_pline_list_get(a, i));
+    std::vector<cavc_vertex> const vb = readVertexes(cavc_pline_list_get(b, i));
+    ASSERT_EQ(va.size(), vb.size());
+    for (std::size_t j = 0; j < va.size(); ++j) {
+      EXPECT_EQ(va[j].x, vb[j].x);
+      EXPECT_EQ(va[j].y, vb[j].y);
+      EXPECT_EQ(va[j].bulge, vb[j].bulge);
+    }
+  }
+}
+} // namespace
+
+TEST(CApiRegression, JobsMatchSynchronousCallsAndInvokeCallbackOnce) {
+  cavc_job_pool_init(2);
+  std::vector<cavc_vertex> const shape = makeShapeOffsetSelfIntersectInputVertexes();
+  PlinePtr pline(plineFromVertexes(shape, true));
+  PlinePtr square(plineFromVertexes(makeAxisAlignedRectLoopVertexes(0.0, 0.0, 10.0, 10.0, false),
+                                    true));
+  PlinePtr other(plineFromVertexes(makeAxisAlignedRectLoopVertexes(5.0, 5.0, 15.0, 15.0, false),
+                                   true));
+
+  JobCallbackRecord offset_record;
+  JobPtr offset_job(cavc_job_submit_parallel_offset(
+      pline.get(), 0.125, defaultParallelOffsetOptions(), CAVC_JOB_NO_TIMEOUT,
+      &JobCallbackRecord::record, &offset_record));
+  JobCallbackRecord combine_record;
+  JobPtr combine_job(cavc_job_submit_combine_plines(square.get(), other.get(), 1,
+                                                    CAVC_JOB_NO_TIMEOUT,
+                                                    &JobCallbackRecord::record, &combine_record));
+  cavc_pline const *ccw_loops[] = {square.get()};
+  JobPtr islands_job(
+      cavc_job_submit_offset_islands(ccw_loops, 1, nullptr, 0, 1.0, 1, CAVC_JOB_NO_TIMEOUT,
+                                     nullptr, nullptr));
+  // inputs were copied so they may be modified after submitting
+  cavc_pline_clear(pline.get());
+
+  EXPECT_EQ(cavc_job_wait(offset_job.get()), CAVC_JOB_COMPLETED);
+  EXPECT_EQ(cavc_job_poll(offset_job.get()), CAVC_JOB_COMPLETED);
+  EXPECT_EQ(offset_record.call_count, 1);
+  EXPECT_EQ(offset_record.last_status, CAVC_JOB_COMPLETED);
+  PlinePtr original(plineFromVertexes(shape, true));
+  cavc_pline_list *raw_expected = nullptr;
+  cavc_parallel_offset(original.get(), 0.125, &raw_expected, defaultParallelOffsetOptions());
+  PlineListPtr expected(raw_expected);
+  PlineListPtr offset_result(cavc_job_release_result(offset_job.get(), 0));
+  expectListsEqual(offset_result.get(), expected.get());
+  // results may only be released once
+  PlineListPtr released_again(cavc_job_release_result(offset_job.get(), 0));
+  EXPECT_EQ(cavc_pline_list_count(released_again.get()), 0u);
+
+  EXPECT_EQ(cavc_job_wait(combine_job.get()), CAVC_JOB_COMPLETED);
+  EXPECT_EQ(combine_record.call_count, 1);
+  cavc_pline_list *raw_remaining = nullptr;
+  cavc_pline_list *raw_subtracted = nullptr;
+  cavc_combine_plines(square.get(), other.get(), 1, &raw_remaining, &raw_subtracted);
+  PlineListPtr expected_remaining(raw_remaining);
+  PlineListPtr expected_subtracted(raw_subtracted);
+  PlineListPtr remaining(cavc_job_release_result(combine_job.get(), 0));
+  PlineListPtr subtracted(cavc_job_release_result(combine_job.get(), 1));
+  expectListsEqual(remaining.get(), expected_remaining.get());
+  expectListsEqual(subtracted.get(), expected_subtracted.get());
+
+  EXPECT_EQ(cavc_job_wait(islands_job.get()), CAVC_JOB_COMPLETED);
+  IslandsEnginePtr engine(cavc_offset_islands_engine_new(), cavc_offset_islands_engine_delete);
+  cavc_pline_list *raw_ccw = nullptr;
+  cavc_pline_list *raw_cw = nullptr;
+  cavc_offset_islands_engine_compute(engine.get(), ccw_loops, 1, nullptr, 0, 1.0, &raw_ccw,
+                                     &raw_cw);
+  PlineListPtr expected_ccw(raw_ccw);
+  PlineListPtr expected_cw(raw_cw);
+  PlineListPtr ccw(cavc_job_release_result(islands_job.get(), 0));
+  PlineListPtr cw(cavc_job_release_result(islands_job.get(), 1));
+  expectListsEqual(ccw.get(), expected_ccw.get());
+  expectListsEqual(cw.get(), expected_cw.get());
+  cavc_job_pool_shutdown();
+}
+
+TEST(CApiRegression, JobCancelledWhilePendingDoesNotRun) {
+  cavc_job_pool_init(1);
+  PlinePtr square(plineFromVertexes(makeAxisAlignedRectLoopVertexes(0.0, 0.0, 10.0, 10.0, false),
+                                    true));
+
+  // first job's callback blocks the only pool thread until released
+  struct Gate {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool open = false;
+  } gate;
+  auto blocking_callback = [](cavc_job *, cavc_job_status, void *user_data) {
+    auto *g = static_cast<Gate *>(user_data);
+    std::unique_lock<std::mutex> lock(g->mutex);
+    g->cv.wait(lock, [&] { return g->open; });
+  };
+  JobPtr blocking_job(cavc_job_submit_parallel_offset(
+      square.get(), 1.0, defaultParallelOffsetOptions(), CAVC_JOB_NO_TIMEOUT, blocking_callback,
+      &gate));
+
+  JobCallbackRecord record;
+  JobPtr cancelled_job(cavc_job_submit_parallel_offset(
+      square.get(), 1.0, defaultParallelOffsetOptions(), CAVC_JOB_NO_TIMEOUT,
+      &JobCallbackRecord::record, &record));
+  EXPECT_EQ(cavc_job_poll(cancelled_job.get()), CAVC_JOB_PENDING);
+  cavc_job_cancel(cancelled_job.get());
+
+  // deleting an unfinished job cancels it without blocking
+  JobCallbackRecord deleted_record;
+  cavc_job_delete(cavc_job_submit_parallel_offset(
+      square.get(), 1.0, defaultParallelOffsetOptions(), CAVC_JOB_NO_TIMEOUT,
+      &JobCallbackRecord::record, &deleted_record));
+
+  {
+    std::lock_guard<std::mutex> lock(gate.mutex);
+    gate.open = true;
+  }
+  gate.cv.notify_all();
+
+  EXPECT_EQ(cavc_job_wait(blocking_job.get()), CAVC_JOB_COMPLETED);
+  EXPECT_EQ(cavc_job_wait(cancelled_job.get()), CAVC_JOB_CANCELLED);
+  EXPECT_EQ(record.call_count, 1);
+  EXPECT_EQ(record.last_status, CAVC_JOB_CANCELLED);
+  PlineListPtr result(cavc_job_release_result(cancelled_job.get(), 0));
+  EXPECT_EQ(cavc_pline_list_count(result.get()), 0u);
+
+  // shutdown waits for the queue to drain
+  cavc_job_pool_shutdown();
+  EXPECT_EQ(deleted_record.call_count, 1);
+  EXPECT_EQ(deleted_record.last_status, CAVC_JOB_CANCELLED);
+}
+
+TEST(CApiRegression, JobTimeoutGivesTimedOutStatus) {
+  cavc_job_pool_init(1);
+  PlinePtr square(plineFromVertexes(makeAxisAlignedRectLoopVertexes(0.0, 0.0, 10.0, 10.0, false),
+                                    true));
+
+  // first job's callback blocks the only pool thread until released
+  struct Gate {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool open = false;
+  } gate;
+  auto blocking_callback = [](cavc_job *, cavc_job_status, void *user_data) {
+    auto *g = static_cast<Gate *>(user_data);
+    std::unique_lock<std::mutex> lock(g->mutex);
+    g->cv.wait(lock, [&] { return g->open; });
+  };
+  JobPtr blocking_job(cavc_job_submit_parallel_offset(
+      square.get(), 1.0, defaultParallelOffsetOptions(), 3600000, blocking_callback, &gate));
+
+  JobCallbackRecord record;
+  JobPtr timed_out_job(cavc_job_submit_parallel_offset(
+      square.get(), 1.0, defaultParallelOffsetOptions(), 0, &JobCallbackRecord::record, &record));
+
+  {
+    std::lock_guard<std::mutex> lock(gate.mutex);
+    gate.open = true;
+  }
+  gate.cv.notify_all();
+
+  EXPECT_EQ(cavc_job_wait(blocking_job.get()), CAVC_JOB_COMPLETED);
+  EXPECT_EQ(cavc_job_wait(timed_out_job.get()), CAVC_JOB_TIMED_OUT);
+  EXPECT_EQ(record.call_count, 1);
+  EXPECT_EQ(record.last_status, CAVC_JOB_TIMED_OUT);
+  PlineListPtr result(cavc_job_release_result(timed_out_job.get(), 0));
+  EXPECT_EQ(cavc_pline_list_count(result.get()), 0u);
+  cavc_job_pool_shutdown();
+}
+
+TEST(CApiRegression, JobCallbackMaySubmitWhilePoolShutsDown) {
+  cavc_job_pool_init(1);
+  PlinePtr square(plineFromVertexes(makeAxisAlignedRectLoopVertexes(0.0, 0.0, 10.0, 10.0, false),
+                                    true));
+
+  // callback waits until shutdown has started, then submits a follow up job
+  struct FollowUp {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool open = false;
+    cavc_pline const *input = nullptr;
+    cavc_job *job = nullptr;
+  } follow_up;
+  follow_up.input = square.get();
+  auto submitting_callback = [](cavc_job *, cavc_job_status, void *user_data) {
+    auto *f = static_cast<FollowUp *>(user_data);
+    std::unique_lock<std::mutex> lock(f->mutex);
+    f->cv.wait(lock, [&] { return f->open; });
+    f->job = cavc_job_submit_parallel_offset(f->input, 1.0, defaultParallelOffsetOptions(),
+                                             CAVC_JOB_NO_TIMEOUT, nullptr, nullptr);
+  };
+  JobPtr first_job(cavc_job_submit_parallel_offset(square.get(), 1.0,
+                                                   defaultParallelOffsetOptions(),
+                                                   CAVC_JOB_NO_TIMEOUT, submitting_callback,
+                                                   &follow_up));
+
+  std::thread shutdown_thread([] { cavc_job_pool_shutdown(); });
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  {
+    std::lock_guard<std::mutex> lock(follow_up.mutex);
+    follow_up.open = true;
+  }
+  follow_up.cv.notify_all();
+  shutdown_thread.join();
+
+  EXPECT_EQ(cavc_job_wait(first_job.get()), CAVC_JOB_COMPLETED);
+  ASSERT_NE(follow_up.job, nullptr);
+  JobPtr second_job(follow_up.job);
+  EXPECT_EQ(cavc_job_wait(second_job.get()), CAVC_JOB_COMPLETED);
+  cavc_job_pool_shutdown();
+}
+
 TEST(CApiRegression, ParallelOffsetReportedShapeCaseReproducesSelfIntersection) {
   const std::vector<cavc_vertex> input_vertexes = makeShapeOffsetSelfIntersectInputVertexes();
   ASSERT_EQ(input_vertexes.size(), 249u);
@@ -0,0 +1,141 @@
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "cavc/cancellation.hpp"
+#include "cavc/internal/parallel.hpp"
+#include "cavc/polylinecombine.hpp"
+#include "cavc/polylineoffset.hpp"
+#include "cavc/polylineoffsetislands.hpp"
+#include "cpp_test_helpers.hpp"
+#include "shape_offset_self_intersect_case.hpp"
+
+namespace {
+using cavc::Polyline;
+
+Polyline<double> makeShapeCase() {
+  Polyline<double> pline;
+  pline.isClosed() = true;
+  for (auto const &v : makeShapeOffsetSelfIntersectInputVertexes()) {
+    pline.addVertex(v.x, v.y, v.bulge);
+  }
+  return pline;
+}
+} // namespace
+
+TEST(cavc_cancellation, TokenStopsOffsetCombineAndIslands) {
+  Polyline<double> const shape = makeShapeCase();
+  Polyline<double> const square = makeAxisAlignedRect(0.0, 0.0, 10.0, 10.0);
+  Polyline<double> const other = makeAxisAlignedRect(5.0, 5.0, 15.0, 15.0);
+  cavc::OffsetLoopSet<double> islands_input;
+  islands_input.ccwLoops.push_back({0, square, cavc::createApproxSpatialIndex(square)});
+  cavc::ParallelOffsetIslands<double> islands;
+
+  cavc::CancellationToken token;
+  {
+    // token installed but not cancelled has no effect
+    cavc::ScopedCancellationToken scope(&token);
+    EXPECT_FALSE(cavc::parallelOffset(shape, double(0.125)).empty());
+    EXPECT_FALSE(cavc::combinePolylines(square, other, cavc::PlineCombineMode::Union)
+                     .remaining.empty());
+    EXPECT_EQ(islands.compute(islands_input, double(1.0)).ccwLoops.size(), 1u);
+  }
+
+  token.requestCancel();
+  {
+    cavc::ScopedCancellationToken scope(&token);
+    EXPECT_TRUE(cavc::parallelOffset(shape, double(0.125)).empty());
+    EXPECT_TRUE(cavc::combinePolylines(square, other, cavc::PlineCombineMode::Union)
+                    .remaining.empty());
+    EXPECT_TRUE(islands.compute(islands_input, double(1.0)).ccwLoops.empty());
+  }
+
+  // previous (no) token restored
+  EXPECT_EQ(cavc::internal::activeCancellationToken(), nullptr);
+  EXPECT_FALSE(cavc::parallelOffset(shape, double(0.125)).empty());
+}
+
+TEST(cavc_cancellation, DeadlineReportsTimedOutStatus) {
+  Polyline<double> const shape = makeShapeCase();
+  Polyline<double> const square = makeAxisAlignedRect(0.0, 0.0, 10.0, 10.0);
+  Polyline<double> const other = makeAxisAlignedRect(5.0, 5.0, 15.0, 15.0);
+  cavc::OffsetLoopSet<double> islands_input;
+  islands_input.ccwLoops.push_back({0, square, cavc::createApproxSpatialIndex(square)});
+  cavc::ParallelOffsetIslands<double> islands;
+
+  std::vector<cavc::Polyline<double>> offset_result;
+  cavc::CombineResult<double> combine_result;
+  cavc::OffsetLoopSet<double> islands_result;
+  auto runAll = [&](cavc::CancellationToken const &token) {
+    return cavc::runCancellable(token, [&] {
+      offset_result = cavc::parallelOffset(shape, double(0.125));
+      combine_result = cavc::combinePolylines(square, other, cavc::PlineCombineMode::Union);
+      islands_result = islands.compute(islands_input, double(1.0));
+    });
+  };
+
+  // generous budget completes normally
+  cavc::CancellationToken token;
+  token.setTimeout(std::chrono::hours(1));
+  EXPECT_TRUE(token.hasDeadline());
+  EXPECT_EQ(runAll(token), cavc::OperationStatus::Completed);
+  EXPECT_FALSE(offset_result.empty());
+  EXPECT_FALSE(combine_result.remaining.empty());
+  EXPECT_EQ(islands_result.ccwLoops.size(), 1u);
+
+  // expired budget gives empty results and a timed out (not cancelled) status
+  token.setDeadline(cavc::CancellationToken::Clock::now() - std::chrono::milliseconds(1));
+  EXPECT_EQ(runAll(token), cavc::OperationStatus::TimedOut);
+  EXPECT_FALSE(token.isCancelled());
+  EXPECT_TRUE(offset_result.empty());
+  EXPECT_TRUE(combine_result.remaining.empty());
+  EXPECT_TRUE(islands_result.ccwLoops.empty());
+
+  // reset clears the deadline and recorded status, cancellation reports cancelled
+  token.reset();
+  EXPECT_FALSE(token.hasDeadline());
+  EXPECT_EQ(token.status(), cavc::OperationStatus::Completed);
+  token.requestCancel();
+  token.setDeadline(cavc::CancellationToken::Clock::now() - std::chrono::milliseconds(1));
+  EXPECT_EQ(runAll(token), cavc::OperationStatus::Cancelled);
+  EXPECT_TRUE(offset_result.empty());
+}
+
+TEST(cavc_cancellation, PollAndParallelForStopAtLoopGranularity) {
+  cavc::CancellationToken token;
+  cavc::ScopedCancellationToken scope(&token);
+  cavc::internal::CancellationPoll poll(4);
+  EXPECT_FALSE(poll());
+  token.requestCancel();
+  int calls = 0;
+  while (!poll()) {
+    ++calls;
+  }
+  EXPECT_LT(calls, 4);
+  // stays stopped
+  EXPECT_TRUE(poll());
+  EXPECT_EQ(token.status(), cavc::OperationStatus::Cancelled);
+
+  // tasks after the token stops the operation are skipped, spawned workers see the token
+  for (std::size_t worker_count : {std::size_t(1), std::size_t(4)}) {
+    cavc::CancellationToken loop_token;
+    cavc::ScopedCancellationToken loop_scope(&loop_token);
+    std::atomic<std::size_t> tasks_run{0};
+    std::atomic<int> workers_with_token{0};
+    cavc::internal::parallelFor<double>(1000, worker_count, [&](std::size_t i, std::size_t) {
+      if (cavc::internal::activeCancellationToken() == &loop_token) {
+        ++workers_with_token;
+      }
+      if (i == 0) {
+        loop_token.setDeadline(cavc::CancellationToken::Clock::now());
+      }
+      ++tasks_run;
+    });
+    EXPECT_LT(tasks_run.load(), 1000u);
+    EXPECT_EQ(workers_with_token.load(), static_cast<int>(tasks_run.load()));
+    EXPECT_EQ(loop_token.status(), cavc::OperationStatus::TimedOut);
+  }
+}
@@ -1,12 +1,16 @@
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cmath>
 #include <cstddef>
+#include <stdexcept>
 #include <vector>
 
 #include <gtest/gtest.h>
 
+#include "cavc/internal/parallel.hpp"
 #include "cavc/polylineoffsetislands.hpp"
+#include "cpp_test_helpers.hpp"
 
 namespace {
 using cavc::createApproxSpatialIndex;
@@ -31,22 +35,6 @@ struct LoopProperties {
   double maxY;
 };
 
-OffsetLoop<double> makeAxisAlignedRectLoop(double min_x, double min_y, double max_x, double max_y,
-                                           bool clockwise, std::size_t parent_index) {
-  Polyline<double> loop;
-  loop.addVertex(min_x, min_y, 0.0);
-  loop.addVertex(max_x, min_y, 0.0);
-  loop.addVertex(max_x, max_y, 0.0);
-  loop.addVertex(min_x, max_y, 0.0);
-  loop.isClosed() = true;
-  if (clockwise) {
-    invertDirection(loop);
-  }
-
-  auto spatial_index = createApproxSpatialIndex(loop);
-  return {parent_index, std::move(loop), std::move(spatial_index)};
-}
-
 OffsetLoop<double> makeLoop(std::initializer_list<std::array<double, 3>> vertexes,
                             std::size_t parent_index = 0) {
   Polyline<double> loop;
@@ -229,6 +217,189 @@ TEST(OffsetIslands, ComputeHandlesIssue66SliceValidationRegression) {
   EXPECT_NEAR(actual[1].pathLength, expected[1].pathLength, 1e-5);
 }
 
+TEST(OffsetIslands, ComputeResultIndependentOfThreadCount) {
+  // grid of islands inside a boundary so many offset loop pairs intersect
+  OffsetLoopSet<double> input;
+  input.ccwLoops.push_back(makeAxisAlignedRectLoop(0.0, 0.0, 40.0, 40.0, false, 0));
+  for (std::size_t row = 0; row < 6; ++row) {
+    for (std::size_t col = 0; col < 6; ++col) {
+      double const min_x = 3.0 + 6.0 * static_cast<double>(col);
+      double const min_y = 3.0 + 6.0 * static_cast<double>(row);
+      input.cwLoops.push_back(
+          makeAxisAlignedRectLoop(min_x, min_y, min_x + 4.0, min_y + 4.0, true, 0));
+    }
+  }
+
+  ParallelOffsetIslands<double> serial;
+  serial.setMaxThreads(1);
+  OffsetLoopSet<double> expected = serial.compute(input, 1.2);
+
+  ParallelOffsetIslands<double> threaded;
+  threaded.setMaxThreads(4);
+  for (int run = 0; run < 3; ++run) {
+    OffsetLoopSet<double> actual = threaded.compute(input, 1.2);
+    ASSERT_EQ(actual.ccwLoops.size(), expected.ccwLoops.size());
+    ASSERT_EQ(actual.cwLoops.size(), expected.cwLoops.size());
+    for (std::size_t i = 0; i < expected.ccwLoops.size(); ++i) {
+      expectLoopPropertiesNear(describeLoop(actual.ccwLoops[i]),
+                               describeLoop(expected.ccwLoops[i]), 0.0);
+    }
+    for (std::size_t i = 0; i < expected.cwLoops.size(); ++i) {
+      expectLoopPropertiesNear(describeLoop(actual.cwLoops[i]), describeLoop(expected.cwLoops[i]),
+                               0.0);
+    }
+  }
+}
+
+TEST(OffsetIslands, ParallelForRethrowsWorkerExceptionOnCallingThread) {
+  // worker threads stop taking tasks once one throws, the exception reaches the caller
+  for (std::size_t worker_count : {std::size_t(1), std::size_t(4)}) {
+    std::atomic<std::size_t> tasks_run{0};
+    auto task = [&](std::size_t i, std::size_t) {
+      ++tasks_run;
+      if (i == 3) {
+        throw std::runtime_error("task failed");
+      }
+    };
+    EXPECT_THROW(cavc::internal::parallelFor<double>(1000, worker_count, task),
+                 std::runtime_error);
+    EXPECT_LT(tasks_run.load(), 1000u);
+  }
+}
+
+TEST(OffsetIslands, ComputeStepsMatchesRepeatedCompute) {
+  OffsetLoopSet<double> input;
+  input.ccwLoops.push_back(makeAxisAlignedRectLoop(0.0, 0.0, 30.0, 20.0, false, 0));
+  input.cwLoops.push_back(makeAxisAlignedRectLoop(5.0, 5.0, 10.0, 10.0, true, 0));
+  input.cwLoops.push_back(makeAxisAlignedRectLoop(18.0, 6.0, 24.0, 12.0, true, 0));
+
+  std::vector<OffsetLoopSet<double>> expected;
+  {
+    ParallelOffsetIslands<double> algorithm;
+    OffsetLoopSet<double> current = algorithm.compute(input, 0.75);
+    while (!current.ccwLoops.empty() || !current.cwLoops.empty()) {
+      OffsetLoopSet<double> next = algorithm.compute(current, 0.75);
+      expected.push_back(std::move(current));
+      current = std::move(next);
+    }
+  }
+  ASSERT_GT(expected.size(), 3u);
+
+  ParallelOffsetIslands<double> algorithm;
+  std::size_t visited = 0;
+  std::size_t steps = algorithm.computeSteps(
+      input, 0.75, 100, [&](std::size_t step_index, OffsetLoopSet<double> const &step_result) {
+        EXPECT_EQ(step_index, visited);
+        ++visited;
+        if (step_index >= expected.size()) {
+          EXPECT_TRUE(step_result.ccwLoops.empty() && step_result.cwLoops.empty());
+          return;
+        }
+        auto const &expected_step = expected[step_index];
+        ASSERT_EQ(step_result.ccwLoops.size(), expected_step.ccwLoops.size());
+        ASSERT_EQ(step_result.cwLoops.size(), expected_step.cwLoops.size());
+        for (std::size_t i = 0; i < expected_step.ccwLoops.size(); ++i) {
+          expectLoopPropertiesNear(describeLoop(step_result.ccwLoops[i]),
+                                   describeLoop(expected_step.ccwLoops[i]), 0.0);
+        }
+        for (std::size_t i = 0; i < expected_step.cwLoops.size(); ++i) {
+          expectLoopPropertiesNear(describeLoop(step_result.cwLoops[i]),
+                                   describeLoop(expected_step.cwLoops[i]), 0.0);
+        }
+      });
+
+  // final step produces no loops and stops stepping
+  EXPECT_EQ(steps, expected.size() + 1);
+  EXPECT_EQ(visited, steps);
+
+  // sink returning false stops early
+  std::size_t stopped_steps = algorithm.computeSteps(
+      input, 0.75, 100, [](std::size_t step_index, OffsetLoopSet<double> const &) {
+        return step_index < 1;
+      });
+  EXPECT_EQ(stopped_steps, 2u);
+}
+
+TEST(OffsetIslands, IndexedPointContainmentMatchesUnindexed) {
+  // loop with arcs bulging in both directions
+  OffsetLoop<double> loop = makeLoop({
+      {0.0, 0.0, 0.5},
+      {10.0, 0.0, 0.0},
+      {10.0, 6.0, -0.6},
+      {6.0, 10.0, 0.0},
+      {0.0, 10.0, 1.0},
+      {0.0, 4.0, 0.0},
+  });
+
+  std::vector<std::size_t> query_stack;
+  for (int yi = -30; yi <= 130; ++yi) {
+    for (int xi = -30; xi <= 130; ++xi) {
+      cavc::Vector2<double> point(0.1 * xi, 0.1 * yi);
+      auto expected = cavc::getPointContainment(loop.polyline, point, 1e-5);
+      auto actual =
+          cavc::getPointContainment(loop.polyline, loop.spatialIndex, point, 1e-5, query_stack);
+      ASSERT_EQ(actual, expected) << "point: " << point.x() << ", " << point.y();
+    }
+  }
+}
+
+TEST(OffsetIslands, BuildTopologyPerforatedPlateIndependentOfThreadCount) {
+  OffsetLoopSet<double> loop_set;
+  loop_set.ccwLoops.push_back(makeAxisAlignedRectLoop(0.0, 0.0, 200.0, 200.0, false, 0));
+  for (std::size_t row = 0; row < 20; ++row) {
+    for (std::size_t col = 0; col < 20; ++col) {
+      double const min_x = 2.0 + 10.0 * static_cast<double>(col);
+      double const min_y = 2.0 + 10.0 * static_cast<double>(row);
+      loop_set.cwLoops.push_back(
+          makeAxisAlignedRectLoop(min_x, min_y, min_x + 6.0, min_y + 6.0, true, 0));
+      // island inside every other hole
+      if ((row + col) % 2 == 0) {
+        loop_set.ccwLoops.push_back(
+            makeAxisAlignedRectLoop(min_x + 2.0, min_y + 2.0, min_x + 4.0, min_y + 4.0, false, 0));
+      }
+    }
+  }
+
+  auto serial = cavc::buildOffsetLoopTopology(loop_set, 1e-5, 1);
+  auto threaded = cavc::buildOffsetLoopTopology(loop_set, 1e-5, 4);
+  ASSERT_EQ(serial.size(), threaded.size());
+  ASSERT_EQ(serial.size(), 1u + 400u + 200u);
+
+  EXPECT_EQ(serial[0].parentIndex, kNoParentOffsetLoop);
+  for (std::size_t i = 0; i < serial.size(); ++i) {
+    EXPECT_EQ(serial[i].role, threaded[i].role);
+    EXPECT_EQ(serial[i].sourceIndex, threaded[i].sourceIndex);
+    EXPECT_EQ(serial[i].parentIndex, threaded[i].parentIndex);
+    if (i == 0) {
+      continue;
+    }
+    // holes belong to the plate, islands belong to the hole around them
+    ASSERT_NE(serial[i].parentIndex, kNoParentOffsetLoop);
+    if (serial[i].role == OffsetLoopRole::Hole) {
+      EXPECT_EQ(serial[i].parentIndex, 0u);
+    } else {
+      EXPECT_EQ(serial[serial[i].parentIndex].role, OffsetLoopRole::Hole);
+    }
+  }
+}
+
+TEST(OffsetIslands, LoopSetMemoryUsageCoversLoopsAndSpatialIndexes) {
+  Polyline<double> pline;
+  pline.isClosed() = true;
+  pline.addVertex(0.0, 0.0, 0.0);
+  pline.addVertex(4.0, 0.0, 0.0);
+  pline.addVertex(4.0, 2.0, 0.0);
+  pline.addVertex(0.0, 2.0, 0.0);
+
+  auto spatialIndex = createApproxSpatialIndex(pline);
+  std::size_t const spatialIndexUsage = spatialIndex.memoryUsage();
+  OffsetLoopSet<double> loopSet;
+  loopSet.ccwLoops.push_back({0, pline, std::move(spatialIndex)});
+  EXPECT_EQ(loopSet.memoryUsage(), loopSet.ccwLoops.capacity() * sizeof(OffsetLoop<double>) +
+                                       loopSet.ccwLoops[0].polyline.memoryUsage() +
+                                       spatialIndexUsage);
+}
+
 int main(int argc, char **argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
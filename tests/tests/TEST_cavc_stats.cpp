@@ -0,0 +1,180 @@
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "cavc/polylinecombine.hpp"
+#include "cavc/polylineoffset.hpp"
+#include "cavc/stats.hpp"
+#include "cpp_test_helpers.hpp"
+#include "parallel_offset_fuzz_corpus.hpp"
+
+// built with CAVC_ENABLE_STATS defined (see tests/tests/CMakeLists.txt)
+static_assert(cavc::statsEnabled, "TEST_cavc_stats must be compiled with CAVC_ENABLE_STATS");
+
+using cavc::Polyline;
+
+TEST(cavc_stats, SpatialIndexQueryCountsNodesAndBoxes) {
+  cavc::StaticSpatialIndex<double> index(100);
+  for (std::size_t i = 0; i < 100; ++i) {
+    double x = static_cast<double>(i);
+    index.add(x, 0.0, x + 0.5, 0.5);
+  }
+  index.finish();
+
+  cavc::resetStats();
+  std::vector<std::size_t> results;
+  index.query(10.1, 0.1, 10.2, 0.2, results);
+  cavc::Stats stats = cavc::statsSnapshot();
+
+  ASSERT_EQ(results.size(), 1u);
+  // root to leaf path at least, every visited node tests at least one box
+  EXPECT_GE(stats.spatialIndexNodesVisited, 2u);
+  EXPECT_GE(stats.spatialIndexBoxesTested, stats.spatialIndexNodesVisited);
+  EXPECT_LT(stats.spatialIndexBoxesTested, 100u);
+}
+
+TEST(cavc_stats, IntrPlineSegsCountsBySegmentTypePair) {
+  cavc::PlineVertex<double> l1(0.0, 0.0, 0.0);
+  cavc::PlineVertex<double> l2(2.0, 0.0, 0.0);
+  cavc::PlineVertex<double> a1(1.0, -1.0, 1.0);
+  cavc::PlineVertex<double> a2(1.0, 1.0, 0.0);
+
+  cavc::resetStats();
+  cavc::intrPlineSegs(l1, l2, l1, l2);
+  cavc::intrPlineSegs(l1, l2, a1, a2);
+  cavc::intrPlineSegs(l1, l2, a1, a2);
+  cavc::intrPlineSegs(a1, a2, l1, l2);
+  cavc::intrPlineSegs(a1, a2, a1, a2);
+  cavc::Stats stats = cavc::statsSnapshot();
+
+  EXPECT_EQ(stats.intrLineLineCalls, 1u);
+  EXPECT_EQ(stats.intrLineArcCalls, 2u);
+  EXPECT_EQ(stats.intrArcLineCalls, 1u);
+  EXPECT_EQ(stats.intrArcArcCalls, 1u);
+}
+
+TEST(cavc_stats, OffsetAndCombineCountHotPaths) {
+  Polyline<double> pline = makeRoundedSquare();
+
+  cavc::resetStats();
+  auto offsetResults = cavc::parallelOffset(pline, 1.0);
+  cavc::Stats offsetStats = cavc::statsSnapshot();
+  ASSERT_EQ(offsetResults.size(), 1u);
+  EXPECT_GT(offsetStats.pointValidForOffsetCalls, 0u);
+  EXPECT_GT(offsetStats.fuzzyEqualCalls, 0u);
+  EXPECT_GT(offsetStats.spatialIndexNodesVisited, 0u);
+  EXPECT_GE(offsetStats.stitchVertexesAppended, offsetResults[0].size());
+
+  Polyline<double> shifted = pline;
+  cavc::translatePolyline(shifted, {5.0, 5.0});
+  cavc::resetStats();
+  auto combineResult = cavc::combinePolylines(pline, shifted, cavc::PlineCombineMode::Union);
+  cavc::Stats combineStats = cavc::statsSnapshot();
+  ASSERT_EQ(combineResult.remaining.size(), 1u);
+  EXPECT_GT(combineStats.intrLineLineCalls + combineStats.intrLineArcCalls +
+                combineStats.intrArcLineCalls + combineStats.intrArcArcCalls,
+            0u);
+  EXPECT_GE(combineStats.stitchVertexesAppended, combineResult.remaining[0].size());
+}
+
+TEST(cavc_stats, OffsetCountsResultPath) {
+  Polyline<double> pline = makeRoundedSquare();
+
+  cavc::resetStats();
+  auto results = cavc::parallelOffset(pline, 1.0);
+  ASSERT_EQ(results.size(), 1u);
+  // offset inward past the polyline's half width collapses everything
+  auto collapsed = cavc::parallelOffset(pline, 100.0);
+  EXPECT_TRUE(collapsed.empty());
+
+  cavc::Stats stats = cavc::statsSnapshot();
+  EXPECT_EQ(stats.offsetStitchedResults, 1u);
+  EXPECT_EQ(stats.offsetEmptyResults, 1u);
+  EXPECT_EQ(stats.offsetCollapsedLineResults + stats.offsetLoopRescueResults +
+                stats.offsetEndpointTouchResults + stats.offsetRelaxedRecoveryResults,
+            0u);
+}
+
+TEST(cavc_stats, RelaxedRecoveryReusesIntersectContext) {
+  // miter join open offset that only succeeds through the relaxed slice recovery passes
+  cavc::ParallelOffsetOptions<double> options;
+  options.joinType = cavc::OffsetJoinType::Miter;
+  Polyline<double> pline = fuzzcorpus::makeOpenMixedPolyline(fuzzcorpus::openSeeds[0]);
+
+  cavc::resetStats();
+  auto results = cavc::parallelOffset(pline, -0.65, options);
+  EXPECT_EQ(results.size(), 1u);
+
+  cavc::Stats stats = cavc::statsSnapshot();
+  ASSERT_EQ(stats.offsetRelaxedRecoveryResults, 1u);
+  // primary and relaxed passes share one set of spatial indexes and intersects
+  EXPECT_EQ(stats.offsetIntersectContexts, 1u);
+
+  cavc::resetStats();
+  cavc::parallelOffset(makeRoundedSquare(), 1.0);
+  EXPECT_EQ(cavc::statsSnapshot().offsetIntersectContexts, 1u);
+}
+
+TEST(cavc_stats, OrientationCountsExactFallbacks) {
+  using cavc::Vector2;
+  cavc::resetStats();
+  // well separated points are certified by the error filter
+  EXPECT_TRUE(cavc::isLeft(Vector2<double>(0.0, 0.0), Vector2<double>(1.0, 0.0),
+                           Vector2<double>(0.5, 1.0)));
+  cavc::Stats stats = cavc::statsSnapshot();
+  EXPECT_EQ(stats.orientationPredicateCalls, 1u);
+  EXPECT_EQ(stats.orientationExactFallbacks, 0u);
+
+  // collinear points with inexact coordinates need the exact determinant
+  EXPECT_TRUE(cavc::isLeftOrEqual(Vector2<double>(0.1, 0.1), Vector2<double>(0.3, 0.3),
+                                  Vector2<double>(0.7, 0.7)));
+  stats = cavc::statsSnapshot();
+  EXPECT_EQ(stats.orientationPredicateCalls, 2u);
+  EXPECT_EQ(stats.orientationExactFallbacks, 1u);
+}
+
+TEST(cavc_stats, LineDistanceCountsExactFallbacks) {
+  using cavc::Vector2;
+  cavc::resetStats();
+  // a circle well clear of the segment is certified a miss by the error filter
+  auto miss = cavc::intrLineSeg2Circle2(Vector2<double>(0.0, 0.0), Vector2<double>(4.0, 0.0), 1.0,
+                                        Vector2<double>(2.0, 5.0));
+  EXPECT_EQ(miss.numIntersects, 0);
+  cavc::Stats stats = cavc::statsSnapshot();
+  EXPECT_EQ(stats.lineDistanceComparisons, 1u);
+  EXPECT_EQ(stats.lineDistanceExactFallbacks, 0u);
+
+  // a center exactly at the classification distance needs the exact comparison
+  cavc::resetStats();
+  EXPECT_EQ(cavc::compareLineDistance(Vector2<double>(0.0, 0.0), Vector2<double>(3.0, 4.0),
+                                      Vector2<double>(-4.0, 3.0), 5.0),
+            0);
+  stats = cavc::statsSnapshot();
+  EXPECT_EQ(stats.lineDistanceComparisons, 1u);
+  EXPECT_EQ(stats.lineDistanceExactFallbacks, 1u);
+}
+
+TEST(cavc_stats, ResetAndThreadLocality) {
+  cavc::resetStats();
+  cavc::parallelOffset(makeRoundedSquare(), 1.0);
+  EXPECT_GT(cavc::statsSnapshot().fuzzyEqualCalls, 0u);
+
+  // work on another thread is not counted on this thread
+  cavc::Stats otherThreadStats;
+  std::thread worker([&] {
+    cavc::resetStats();
+    cavc::parallelOffset(makeRoundedSquare(), 1.0);
+    otherThreadStats = cavc::statsSnapshot();
+  });
+  std::uint64_t const before = cavc::statsSnapshot().fuzzyEqualCalls;
+  worker.join();
+  EXPECT_EQ(cavc::statsSnapshot().fuzzyEqualCalls, before);
+  EXPECT_GT(otherThreadStats.fuzzyEqualCalls, 0u);
+
+  cavc::resetStats();
+  cavc::Stats stats = cavc::statsSnapshot();
+  EXPECT_EQ(stats.fuzzyEqualCalls, 0u);
+  EXPECT_EQ(stats.spatialIndexNodesVisited, 0u);
+  EXPECT_EQ(stats.pointValidForOffsetCalls, 0u);
+}
@@ -0,0 +1,138 @@
+#include <algorithm>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "cavc/polylinecombine.hpp"
+#include "cavc/polylineoffset.hpp"
+#include "cavc/polylineoffsetislands.hpp"
+#include "cavc/tracing.hpp"
+#include "cpp_test_helpers.hpp"
+
+// built with CAVC_ENABLE_TRACING defined (see tests/tests/CMakeLists.txt)
+static_assert(cavc::tracingEnabled, "TEST_cavc_tracing must be compiled with CAVC_ENABLE_TRACING");
+
+namespace {
+class CollectingSink : public cavc::TraceSink {
+public:
+  void addEvent(cavc::TraceEvent const &event) override {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    events.push_back(event);
+  }
+
+  std::vector<cavc::TraceEvent const *> named(std::string const &name) const {
+    std::vector<cavc::TraceEvent const *> result;
+    for (auto const &event : events) {
+      if (name == event.name) {
+        result.push_back(&event);
+      }
+    }
+    return result;
+  }
+
+  std::vector<cavc::TraceEvent> events;
+
+private:
+  std::mutex m_mutex;
+};
+} // namespace
+
+TEST(cavc_tracing, OffsetPhasesNestInsideOffsetScope) {
+  CollectingSink sink;
+  {
+    cavc::ScopedTraceSink scopedSink(sink);
+    cavc::parallelOffset(makeRoundedSquare(), 1.0);
+  }
+
+  auto offsetEvents = sink.named("parallelOffset");
+  ASSERT_EQ(offsetEvents.size(), 1u);
+  auto const &outer = *offsetEvents[0];
+  for (char const *phase :
+       {"createRawOffsetPline", "slicesFromRawOffset", "stitchOffsetSlicesTogether",
+        "allSelfIntersects"}) {
+    auto phaseEvents = sink.named(phase);
+    ASSERT_FALSE(phaseEvents.empty()) << phase;
+    for (auto const *event : phaseEvents) {
+      EXPECT_EQ(event->threadId, outer.threadId);
+      EXPECT_GE(event->startUs, outer.startUs);
+      EXPECT_LE(event->startUs + event->durationUs, outer.startUs + outer.durationUs + 1e-3);
+    }
+  }
+}
+
+TEST(cavc_tracing, NoEventsWithoutSinkAndScopedSinkRestores) {
+  CollectingSink outer;
+  CollectingSink inner;
+  ASSERT_EQ(cavc::traceSink(), nullptr);
+  {
+    cavc::ScopedTraceSink outerScope(outer);
+    {
+      cavc::ScopedTraceSink innerScope(inner);
+      EXPECT_EQ(cavc::traceSink(), &inner);
+    }
+    EXPECT_EQ(cavc::traceSink(), &outer);
+  }
+  EXPECT_EQ(cavc::traceSink(), nullptr);
+
+  cavc::parallelOffset(makeRoundedSquare(), 1.0);
+  EXPECT_TRUE(outer.events.empty());
+  EXPECT_TRUE(inner.events.empty());
+}
+
+TEST(cavc_tracing, ChromeTraceWriterWritesCompleteEvents) {
+  std::ostringstream os;
+  std::size_t eventCount = 0;
+  {
+    cavc::ChromeTraceWriter writer(os);
+    cavc::ScopedTraceSink scopedSink(writer);
+    cavc::combinePolylines(makeRoundedSquare(), makeRoundedSquare(5.0, 5.0),
+                           cavc::PlineCombineMode::Union);
+    eventCount = writer.eventCount();
+  }
+
+  std::string const json = os.str();
+  EXPECT_GT(eventCount, 0u);
+  EXPECT_EQ(json.rfind("{\"traceEvents\":[", 0), 0u);
+  EXPECT_NE(json.find("\"name\":\"combinePolylines\""), std::string::npos);
+  EXPECT_NE(json.find("\"name\":\"processForCombine\""), std::string::npos);
+  EXPECT_NE(json.find("\"ph\":\"X\""), std::string::npos);
+  EXPECT_NE(json.find("\"tid\":"), std::string::npos);
+  EXPECT_EQ(json.substr(json.size() - 2), "}\n");
+  EXPECT_EQ(static_cast<std::size_t>(std::count(json.begin(), json.end(), '{')),
+            eventCount + 1);
+}
+
+TEST(cavc_tracing, OffsetIslandsWorkerThreadsHaveOwnThreadIds) {
+  cavc::OffsetLoopSet<double> input;
+  input.ccwLoops.push_back(makeAxisAlignedRectLoop(0.0, 0.0, 40.0, 40.0, false));
+  for (std::size_t row = 0; row < 6; ++row) {
+    for (std::size_t col = 0; col < 6; ++col) {
+      double const minX = 3.0 + 6.0 * static_cast<double>(col);
+      double const minY = 3.0 + 6.0 * static_cast<double>(row);
+      input.cwLoops.push_back(makeAxisAlignedRectLoop(minX, minY, minX + 4.0, minY + 4.0, true));
+    }
+  }
+
+  cavc::ParallelOffsetIslands<double> algorithm;
+  algorithm.setMaxThreads(4);
+  CollectingSink sink;
+  {
+    cavc::ScopedTraceSink scopedSink(sink);
+    algorithm.compute(input, 1.2);
+  }
+
+  ASSERT_EQ(sink.named("ParallelOffsetIslands::compute").size(), 1u);
+  ASSERT_EQ(sink.named("ParallelOffsetIslands::createSlicePoints").size(), 1u);
+  EXPECT_FALSE(sink.named("findIntersects").empty());
+
+  std::set<std::uint32_t> workerThreads;
+  for (auto const *event : sink.named("parallelFor worker")) {
+    workerThreads.insert(event->threadId);
+  }
+  // each worker (calling thread plus spawned threads) runs on a distinct thread
+  EXPECT_GT(workerThreads.size(), 1u);
+}
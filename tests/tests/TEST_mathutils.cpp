@@ -0,0 +1,111 @@
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "cavc/mathutils.hpp"
+#include "cavc/polylinecombine.hpp"
+#include "cavc/polylineoffset.hpp"
+#include "shape_offset_self_intersect_case.hpp"
+
+TEST(MathUtilsTests, ScopedEpsilonContextOverridesGlobalAndRestores) {
+  auto const defaults = cavc::utils::getEpsilonConfig<double>();
+  cavc::utils::EpsilonConfig<double> outer{2e-7, 3e-6, 4e-5, 5e-5};
+  cavc::utils::EpsilonConfig<double> inner{3e-7, 4e-6, 5e-5, 6e-5};
+  {
+    cavc::utils::ScopedEpsilonContext<double> outerContext(outer);
+    EXPECT_EQ(cavc::utils::realPrecision<double>(), outer.realPrecision);
+    {
+      cavc::utils::ScopedEpsilonContext<double> innerContext(inner);
+      EXPECT_EQ(cavc::utils::realThreshold<double>(), inner.realThreshold);
+      EXPECT_EQ(cavc::utils::realPrecision<double>(), inner.realPrecision);
+      EXPECT_EQ(cavc::utils::sliceJoinThreshold<double>(), inner.sliceJoinThreshold);
+      EXPECT_EQ(cavc::utils::offsetThreshold<double>(), inner.offsetThreshold);
+    }
+    EXPECT_EQ(cavc::utils::offsetThreshold<double>(), outer.offsetThreshold);
+    // global config is untouched by contexts
+    EXPECT_EQ(cavc::utils::getEpsilonConfig<double>().realPrecision, defaults.realPrecision);
+  }
+
+  EXPECT_EQ(cavc::utils::realPrecision<double>(), defaults.realPrecision);
+  EXPECT_EQ(cavc::utils::activeEpsilonContext<double>(), nullptr);
+}
+
+TEST(MathUtilsTests, ExplicitEpsilonConfigMatchesGlobalConfigPerThread) {
+  cavc::Polyline<double> pline;
+  pline.isClosed() = true;
+  for (auto const &v : makeShapeOffsetSelfIntersectInputVertexes()) {
+    pline.addVertex(v.x, v.y, v.bulge);
+  }
+
+  cavc::Polyline<double> plineB;
+  plineB.isClosed() = true;
+  plineB.addVertex(-5.0, -5.0, 0.0);
+  plineB.addVertex(5.0, -5.0, 0.0);
+  plineB.addVertex(5.0, 5.0, 1.0);
+  plineB.addVertex(-5.0, 5.0, 0.0);
+
+  auto const defaults = cavc::utils::getEpsilonConfig<double>();
+  cavc::utils::EpsilonConfig<double> const custom{1e-7, 1e-3, 1e-2, 5e-2};
+
+  auto const sameResults = [](std::vector<cavc::Polyline<double>> const &lhs,
+                              std::vector<cavc::Polyline<double>> const &rhs) {
+    if (lhs.size() != rhs.size()) {
+      return false;
+    }
+    for (std::size_t i = 0; i < lhs.size(); ++i) {
+      if (lhs[i].isClosed() != rhs[i].isClosed() || lhs[i].size() != rhs[i].size()) {
+        return false;
+      }
+      for (std::size_t j = 0; j < lhs[i].size(); ++j) {
+        if (lhs[i][j].pos() != rhs[i][j].pos() || lhs[i][j].bulge() != rhs[i][j].bulge()) {
+          return false;
+        }
+      }
+    }
+    return true;
+  };
+
+  auto runAll = [&](auto &&offsetFn, auto &&combineFn) {
+    std::vector<cavc::Polyline<double>> result = offsetFn(pline, 0.5);
+    auto offsetB = offsetFn(plineB, -0.25);
+    result.insert(result.end(), offsetB.begin(), offsetB.end());
+    auto combined = combineFn(plineB, pline);
+    result.insert(result.end(), combined.remaining.begin(), combined.remaining.end());
+    result.insert(result.end(), combined.subtracted.begin(), combined.subtracted.end());
+    return result;
+  };
+
+  auto runGlobal = [&] {
+    return runAll(
+        [](auto const &p, double d) { return cavc::parallelOffset(p, d); },
+        [](auto const &a, auto const &b) {
+          return cavc::combinePolylines(a, b, cavc::PlineCombineMode::Union);
+        });
+  };
+
+  auto runExplicit = [&](cavc::utils::EpsilonConfig<double> const &eps) {
+    return runAll(
+        [&](auto const &p, double d) { return cavc::parallelOffset(p, d, {}, eps); },
+        [&](auto const &a, auto const &b) {
+          return cavc::combinePolylines(a, b, cavc::PlineCombineMode::Union, eps);
+        });
+  };
+
+  auto const defaultReference = runGlobal();
+  cavc::utils::setEpsilonConfig(custom);
+  auto const customReference = runGlobal();
+  cavc::utils::resetEpsilonConfig<double>();
+
+  EXPECT_TRUE(sameResults(runExplicit(defaults), defaultReference));
+  EXPECT_TRUE(sameResults(runExplicit(custom), customReference));
+
+  // two threads using different tolerances at the same time
+  std::vector<cavc::Polyline<double>> threadCustomResult;
+  std::thread customThread([&] { threadCustomResult = runExplicit(custom); });
+  auto const threadDefaultResult = runExplicit(defaults);
+  customThread.join();
+  EXPECT_TRUE(sameResults(threadDefaultResult, defaultReference));
+  EXPECT_TRUE(sameResults(threadCustomResult, customReference));
+}
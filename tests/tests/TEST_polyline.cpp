@@ -0,0 +1,139 @@
+#include <cstddef>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "cavc/polyline.hpp"
+#include "cavc/polylineoffset.hpp"
+
+TEST(PolylineTests, ArcGeometryCacheMatchesUncachedFunctions) {
+  cavc::Polyline<double> pline;
+  pline.isClosed() = true;
+  pline.addVertex(0.0, 0.0, 0.0);
+  pline.addVertex(10.0, 0.0, 0.9);
+  pline.addVertex(10.0, 6.0, -0.4);
+  pline.addVertex(5.0, 8.0, 0.25);
+  pline.addVertex(0.0, 8.0, 0.0);
+
+  cavc::ArcGeometryCache<double> arcCache(pline);
+  ASSERT_EQ(arcCache.size(), pline.size());
+  EXPECT_FALSE(arcCache[0].isArc());
+  EXPECT_TRUE(arcCache[1].isArc());
+  EXPECT_FALSE(arcCache[4].isArc());
+  EXPECT_GE(arcCache.memoryUsage(), pline.size() * sizeof(cavc::ArcGeometry<double>));
+
+  auto const extents = cavc::getExtents(pline);
+  auto const cachedExtents = cavc::getExtents(pline, arcCache);
+  EXPECT_EQ(cachedExtents.xMin, extents.xMin);
+  EXPECT_EQ(cachedExtents.yMin, extents.yMin);
+  EXPECT_EQ(cachedExtents.xMax, extents.xMax);
+  EXPECT_EQ(cachedExtents.yMax, extents.yMax);
+  EXPECT_NEAR(cavc::getArea(pline, arcCache), cavc::getArea(pline), 1e-9);
+
+  auto const spatialIndex = cavc::createApproxSpatialIndex(pline);
+  std::vector<std::size_t> queryStack;
+  auto expectSameWindingNumber = [&](cavc::Vector2<double> const &point) {
+    EXPECT_EQ(cavc::getWindingNumber(pline, arcCache, point), cavc::getWindingNumber(pline, point));
+    EXPECT_EQ(cavc::getWindingNumber(pline, arcCache, spatialIndex, point, queryStack),
+              cavc::getWindingNumber(pline, spatialIndex, point, queryStack));
+  };
+  for (double x = -3.0; x <= 17.0; x += 0.7) {
+    for (double y = -3.0; y <= 11.0; y += 0.7) {
+      cavc::Vector2<double> const point(x, y);
+      cavc::ClosestPoint<double> const closest(pline, point);
+      cavc::ClosestPoint<double> const cachedClosest(pline, arcCache, point);
+      EXPECT_EQ(cachedClosest.index(), closest.index());
+      EXPECT_TRUE(cavc::fuzzyEqual(cachedClosest.point(), closest.point(), 1e-12));
+      expectSameWindingNumber(point);
+    }
+  }
+
+  // points just either side of each segment midpoint (cached circle test decides the arc cases)
+  for (std::size_t i = 0; i < pline.size(); ++i) {
+    std::size_t const j = cavc::utils::nextWrappingIndex(i, pline);
+    cavc::Vector2<double> const midpoint = cavc::segMidpoint(pline[i], pline[j]);
+    cavc::Vector2<double> towardsCentroid = cavc::Vector2<double>(5.0, 4.0) - midpoint;
+    cavc::normalize(towardsCentroid);
+    expectSameWindingNumber(midpoint + 1e-6 * towardsCentroid);
+    expectSameWindingNumber(midpoint - 1e-6 * towardsCentroid);
+  }
+
+  // segment level functions against a polyline crossing every segment
+  cavc::Polyline<double> other = pline;
+  cavc::translatePolyline(other, {2.5, 1.5});
+  cavc::ArcGeometryCache<double> otherCache(other);
+  for (std::size_t i = 0; i < pline.size(); ++i) {
+    std::size_t const j = cavc::utils::nextWrappingIndex(i, pline);
+    for (std::size_t k = 0; k < other.size(); ++k) {
+      std::size_t const l = cavc::utils::nextWrappingIndex(k, other);
+      auto const intr = cavc::intrPlineSegs(pline[i], pline[j], other[k], other[l]);
+      auto const cachedIntr = cavc::intrPlineSegs(pline[i], pline[j], arcCache[i], other[k],
+                                                  other[l], otherCache[k]);
+      ASSERT_EQ(cachedIntr.intrType, intr.intrType);
+      if (intr.intrType != cavc::PlineSegIntrType::NoIntersect) {
+        EXPECT_TRUE(cavc::fuzzyEqual(cachedIntr.point1, intr.point1, 1e-12));
+      }
+    }
+
+    auto const midpoint = cavc::segMidpoint(pline[i], pline[j]);
+    auto const split = cavc::splitAtPoint(pline[i], pline[j], midpoint);
+    auto const cachedSplit = cavc::splitAtPoint(pline[i], pline[j], arcCache[i], midpoint);
+    EXPECT_NEAR(cachedSplit.updatedStart.bulge(), split.updatedStart.bulge(), 1e-12);
+    EXPECT_NEAR(cachedSplit.splitVertex.bulge(), split.splitVertex.bulge(), 1e-12);
+  }
+
+  auto const rawSegs = cavc::internal::createUntrimmedOffsetSegments(pline, 0.5);
+  auto const cachedRawSegs = cavc::internal::createUntrimmedOffsetSegments(pline, arcCache, 0.5);
+  ASSERT_EQ(cachedRawSegs.size(), rawSegs.size());
+  for (std::size_t i = 0; i < rawSegs.size(); ++i) {
+    EXPECT_EQ(cachedRawSegs[i].v1.x(), rawSegs[i].v1.x());
+    EXPECT_EQ(cachedRawSegs[i].v1.y(), rawSegs[i].v1.y());
+    EXPECT_EQ(cachedRawSegs[i].v2.x(), rawSegs[i].v2.x());
+    EXPECT_EQ(cachedRawSegs[i].v2.y(), rawSegs[i].v2.y());
+    EXPECT_EQ(cachedRawSegs[i].collapsedArc, rawSegs[i].collapsedArc);
+  }
+
+  // rebuilding for a modified polyline picks up the change
+  pline[1].bulge() = 0.0;
+  arcCache.build(pline);
+  EXPECT_FALSE(arcCache[1].isArc());
+  EXPECT_NEAR(cavc::getArea(pline, arcCache), cavc::getArea(pline), 1e-9);
+}
+
+TEST(PolylineTests, MemoryUsageCoversVertexCapacity) {
+  cavc::Polyline<double> pline;
+  pline.isClosed() = true;
+  pline.vertexes().reserve(8);
+  pline.addVertex(0.0, 0.0, 0.0);
+  pline.addVertex(4.0, 0.0, 0.0);
+  pline.addVertex(4.0, 2.0, 0.0);
+  pline.addVertex(0.0, 2.0, 0.0);
+  EXPECT_EQ(pline.memoryUsage(), 8 * sizeof(cavc::PlineVertex<double>));
+}
+
+TEST(PolylineTests, PolylineViewSupportsSeparateComponentArrays) {
+  std::vector<double> xs = {0.0, 5.0, 5.0, 10.0, 10.0, 0.0};
+  std::vector<double> ys = {0.0, 0.0, 0.0, 0.0, 10.0, 10.0};
+  cavc::PolylineView<double> view(xs.size(), true, xs.data(), ys.data(), nullptr, sizeof(double),
+                                  sizeof(double), 0);
+  cavc::Polyline<double> pline = cavc::toPolyline(view);
+  ASSERT_EQ(pline.size(), xs.size());
+  EXPECT_EQ(pline[3].x(), 10.0);
+  EXPECT_EQ(pline[4].y(), 10.0);
+  EXPECT_EQ(pline[4].bulge(), 0.0);
+
+  auto fromView = cavc::removeRedundant(view);
+  auto fromPline = cavc::removeRedundant(pline);
+  ASSERT_EQ(fromView.size(), fromPline.size());
+  EXPECT_EQ(fromView.size(), 4u);
+  for (std::size_t i = 0; i < fromView.size(); ++i) {
+    EXPECT_EQ(fromView[i].pos(), fromPline[i].pos());
+    EXPECT_EQ(fromView[i].bulge(), fromPline[i].bulge());
+  }
+
+  auto viewOffsets = cavc::parallelOffset(view, 1.0);
+  auto plineOffsets = cavc::parallelOffset(pline, 1.0);
+  ASSERT_EQ(viewOffsets.size(), plineOffsets.size());
+  ASSERT_EQ(viewOffsets.size(), 1u);
+  EXPECT_EQ(viewOffsets[0].size(), plineOffsets[0].size());
+}
@@ -0,0 +1,21 @@
+#include <cstddef>
+
+#include <gtest/gtest.h>
+
+#include "cavc/polylinecombine.hpp"
+
+TEST(PolylineCombineTests, CombineResultMemoryUsageCoversResultPolylines) {
+  cavc::Polyline<double> pline;
+  pline.isClosed() = true;
+  pline.addVertex(0.0, 0.0, 0.0);
+  pline.addVertex(4.0, 0.0, 0.0);
+  pline.addVertex(4.0, 2.0, 0.0);
+  pline.addVertex(0.0, 2.0, 0.0);
+
+  cavc::CombineResult<double> combineResult;
+  combineResult.remaining.push_back(pline);
+  combineResult.remaining.back().vertexes().shrink_to_fit();
+  EXPECT_EQ(combineResult.memoryUsage(),
+            combineResult.remaining.capacity() * sizeof(cavc::Polyline<double>) +
+                4 * sizeof(cavc::PlineVertex<double>));
+}
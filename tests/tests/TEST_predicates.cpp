@@ -0,0 +1,69 @@
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "cavc/predicates.hpp"
+#include "cavc/vector2.hpp"
+
+TEST(PredicatesTests, Orient2dSignIsExact) {
+  using cavc::Vector2;
+  // points with x == y lie exactly on the line y = x even though the coordinates are not exactly
+  // representable decimals, points one ulp above or below it are strictly left or right
+  for (double a : {0.1, 0.3, 1.7, 12.25, 1e3 / 3.0}) {
+    for (double b : {0.7, 2.9, 17.1, 1e5 / 7.0}) {
+      for (double c : {0.2, 5.3, 1e4 / 3.0}) {
+        Vector2<double> const p0(a, a);
+        Vector2<double> const p1(b, b);
+        Vector2<double> const onLine(c, c);
+        EXPECT_EQ(cavc::orient2d(p0, p1, onLine), 0.0) << a << " " << b << " " << c;
+        EXPECT_FALSE(cavc::isLeft(p0, p1, onLine));
+        EXPECT_TRUE(cavc::isLeftOrEqual(p0, p1, onLine));
+
+        Vector2<double> const above(c, std::nextafter(c, 1e9));
+        Vector2<double> const below(c, std::nextafter(c, -1e9));
+        bool const ascending = b > a;
+        EXPECT_EQ(cavc::isLeft(p0, p1, above), ascending) << a << " " << b << " " << c;
+        EXPECT_EQ(cavc::isLeft(p0, p1, below), !ascending) << a << " " << b << " " << c;
+        EXPECT_EQ(cavc::orient2d(p0, p1, above) > 0.0, ascending);
+        EXPECT_EQ(cavc::orient2d(p0, p1, below) < 0.0, ascending);
+      }
+    }
+  }
+
+  // well separated points return the plain floating point determinant
+  Vector2<double> const p0(1.0, 2.0);
+  Vector2<double> const p1(4.0, 3.0);
+  Vector2<double> const point(2.0, 5.0);
+  EXPECT_EQ(cavc::orient2d(p0, p1, point), 3.0 * 3.0 - 1.0 * 1.0);
+  EXPECT_EQ(cavc::orient2d(p1, p0, point), -8.0);
+}
+
+TEST(PredicatesTests, CompareLineDistanceIsExact) {
+  using cavc::Vector2;
+  // (-4, 3) is exactly 5 from the line through (0, 0) and (3, 4), one ulp either side of the
+  // distance decides the comparison
+  Vector2<double> const p0(0.0, 0.0);
+  Vector2<double> const p1(3.0, 4.0);
+  Vector2<double> const point(-4.0, 3.0);
+  EXPECT_EQ(cavc::compareLineDistance(p0, p1, point, 5.0), 0);
+  EXPECT_EQ(cavc::compareLineDistance(p0, p1, point, std::nextafter(5.0, 10.0)), -1);
+  EXPECT_EQ(cavc::compareLineDistance(p0, p1, point, std::nextafter(5.0, 0.0)), 1);
+  EXPECT_EQ(cavc::compareLineDistance(p1, p0, point, 5.0), 0);
+
+  // points on the line y = x with inexact coordinates are at distance zero, one ulp off it is not
+  for (double a : {0.1, 1.7, 1e3 / 3.0}) {
+    for (double c : {0.2, 5.3, 1e4 / 3.0}) {
+      Vector2<double> const q0(a, a);
+      Vector2<double> const q1(a + 2.9, a + 2.9);
+      EXPECT_EQ(cavc::compareLineDistance(q0, q1, Vector2<double>(c, c), 0.0), 0) << a << " " << c;
+      EXPECT_EQ(cavc::compareLineDistance(q0, q1, Vector2<double>(c, std::nextafter(c, 1e9)), 0.0),
+                1)
+          << a << " " << c;
+      EXPECT_EQ(cavc::compareLineDistance(q0, q1, Vector2<double>(c, c), 1e-100), -1);
+    }
+  }
+
+  // well separated distances are decided by the floating point filter
+  EXPECT_EQ(cavc::compareLineDistance(p0, p1, point, 4.0), 1);
+  EXPECT_EQ(cavc::compareLineDistance(p0, p1, point, 6.0), -1);
+}
@@ -238,6 +238,36 @@ TEST(StaticSpatialIndexTests, query) {
   ASSERT_THAT(queryResults, t::UnorderedPointwise(t::Eq(), expectedIndexes));
 }
 
+TEST(StaticSpatialIndexTests, reset_reuses_storage) {
+  auto index = createIndex();
+  std::size_t const initialMemory = index.memoryUsage();
+
+  // smaller index reuses the existing storage
+  index.reset(14);
+  for (std::size_t i = 0; i < 4 * 14; i += 4) {
+    index.add(testData[i], testData[i + 1], testData[i + 2], testData[i + 3]);
+  }
+  index.finish();
+  EXPECT_EQ(index.memoryUsage(), initialMemory);
+  std::vector<std::size_t> queryResults;
+  index.query(40, 40, 60, 60, queryResults);
+  std::vector<std::size_t> smallResults;
+  createSmallIndex().query(40, 40, 60, 60, smallResults);
+  ASSERT_THAT(queryResults, t::UnorderedPointwise(t::Eq(), smallResults));
+
+  // back to the full data set
+  index.reset(testData.size() / 4);
+  for (std::size_t i = 0; i < testData.size(); i += 4) {
+    index.add(testData[i], testData[i + 1], testData[i + 2], testData[i + 3]);
+  }
+  index.finish();
+  EXPECT_EQ(index.memoryUsage(), initialMemory);
+  queryResults.clear();
+  index.query(40, 40, 60, 60, queryResults);
+  std::vector<std::size_t> expectedIndexes = {6, 29, 31, 75};
+  ASSERT_THAT(queryResults, t::UnorderedPointwise(t::Eq(), expectedIndexes));
+}
+
 TEST(StaticSpatialIndexTests, visitQuery) {
   auto index = createIndex();
 
@@ -317,6 +347,17 @@ TEST(StaticSpatialIndexTests, query_with_degenerate_global_extents) {
   }
 }
 
+TEST(StaticSpatialIndexTests, memoryUsage_covers_boxes_and_indices) {
+  cavc::StaticSpatialIndex<double> index(4);
+  index.add(0.0, 0.0, 4.0, 0.0);
+  index.add(4.0, 0.0, 4.0, 2.0);
+  index.add(0.0, 2.0, 4.0, 2.0);
+  index.add(0.0, 0.0, 0.0, 2.0);
+  index.finish();
+  // 4 leaf boxes plus a root node
+  EXPECT_GE(index.memoryUsage(), 5 * (4 * sizeof(double) + sizeof(std::size_t)));
+}
+
 int main(int argc, char **argv) {
   t::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
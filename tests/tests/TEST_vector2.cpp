@@ -0,0 +1,50 @@
+#include <algorithm>
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "cavc/vector2.hpp"
+
+TEST(Vector2Tests, PointWithinArcSweepAngleMatchesAngleSweep) {
+  using cavc::Vector2;
+  Vector2<double> const center(1.5, -2.0);
+  double const radius = 3.0;
+  double const epsilon = 1e-5;
+  for (double bulge : {0.05, 0.4, 0.999, 1.0, -0.05, -0.4, -1.0}) {
+    for (double startAngle = 0.1; startAngle < cavc::utils::tau<double>(); startAngle += 0.7) {
+      double const sweepAngle = 4.0 * std::atan(bulge);
+      Vector2<double> const arcStart = cavc::pointOnCircle(radius, center, startAngle);
+      Vector2<double> const arcEnd = cavc::pointOnCircle(radius, center, startAngle + sweepAngle);
+
+      // points clearly inside or outside the sweep match the angle based test
+      for (double testAngle = 0.0; testAngle < cavc::utils::tau<double>(); testAngle += 0.05) {
+        double const fromStart =
+            cavc::utils::normalizeRadians(sweepAngle > 0.0 ? testAngle - startAngle
+                                                           : startAngle - testAngle);
+        if (std::abs(fromStart) < 1e-3 || std::abs(fromStart - std::abs(sweepAngle)) < 1e-3 ||
+            cavc::utils::tau<double>() - fromStart < 1e-3) {
+          continue;
+        }
+        bool const expected = fromStart < std::abs(sweepAngle);
+        for (double distance : {0.5, radius, 10.0}) {
+          Vector2<double> const point = cavc::pointOnCircle(distance, center, testAngle);
+          EXPECT_EQ(cavc::pointWithinArcSweepAngle(center, arcStart, arcEnd, bulge, point, epsilon),
+                    expected)
+              << "bulge " << bulge << " start " << startAngle << " test " << testAngle;
+        }
+      }
+
+      // epsilon is an angle tolerance past the counter clockwise most end of the sweep only
+      double const ccwEnd = std::max(startAngle, startAngle + sweepAngle);
+      double const cwEnd = std::min(startAngle, startAngle + sweepAngle);
+      auto within = [&](double testAngle) {
+        return cavc::pointWithinArcSweepAngle(center, arcStart, arcEnd, bulge,
+                                              cavc::pointOnCircle(radius, center, testAngle),
+                                              epsilon);
+      };
+      EXPECT_TRUE(within(ccwEnd + 0.5 * epsilon));
+      EXPECT_FALSE(within(ccwEnd + 2.0 * epsilon));
+      EXPECT_FALSE(within(cwEnd - 0.5 * epsilon));
+    }
+  }
+}
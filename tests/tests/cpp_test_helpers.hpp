@@ -0,0 +1,48 @@
+#ifndef CAVC_CPP_TEST_HELPERS_HPP
+#define CAVC_CPP_TEST_HELPERS_HPP
+#include <cstddef>
+#include <utility>
+
+#include "cavc/polyline.hpp"
+#include "cavc/polylineoffsetislands.hpp"
+
+// shared polyline fixtures for tests using the C++ API
+
+// closed axis aligned rectangle, counter clockwise unless clockwise is true
+inline cavc::Polyline<double> makeAxisAlignedRect(double min_x, double min_y, double max_x,
+                                                  double max_y, bool clockwise = false) {
+  cavc::Polyline<double> pline;
+  pline.isClosed() = true;
+  pline.addVertex(min_x, min_y, 0.0);
+  pline.addVertex(max_x, min_y, 0.0);
+  pline.addVertex(max_x, max_y, 0.0);
+  pline.addVertex(min_x, max_y, 0.0);
+  if (clockwise) {
+    cavc::invertDirection(pline);
+  }
+  return pline;
+}
+
+// offset loop (with its spatial index) for an axis aligned rectangle
+inline cavc::OffsetLoop<double> makeAxisAlignedRectLoop(double min_x, double min_y, double max_x,
+                                                        double max_y, bool clockwise,
+                                                        std::size_t parent_index = 0) {
+  cavc::Polyline<double> loop = makeAxisAlignedRect(min_x, min_y, max_x, max_y, clockwise);
+  auto spatial_index = cavc::createApproxSpatialIndex(loop);
+  return {parent_index, std::move(loop), std::move(spatial_index)};
+}
+
+// closed 12 x 10 counter clockwise square with one corner rounded by a quarter arc (radius 2),
+// translated by (x, y)
+inline cavc::Polyline<double> makeRoundedSquare(double x = 0.0, double y = 0.0) {
+  cavc::Polyline<double> pline;
+  pline.isClosed() = true;
+  pline.addVertex(x, y, 0.0);
+  pline.addVertex(x + 10.0, y, 0.4142135623730951);
+  pline.addVertex(x + 12.0, y + 2.0, 0.0);
+  pline.addVertex(x + 12.0, y + 10.0, 0.0);
+  pline.addVertex(x, y + 10.0, 0.0);
+  return pline;
+}
+
+#endif // CAVC_CPP_TEST_HELPERS_HPP
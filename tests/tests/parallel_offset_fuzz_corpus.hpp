@@ -0,0 +1,113 @@
+#ifndef CAVC_PARALLEL_OFFSET_FUZZ_CORPUS_HPP
+#define CAVC_PARALLEL_OFFSET_FUZZ_CORPUS_HPP
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <random>
+
+#include <cavc/polyline.hpp>
+#include <cavc/polylineoffset.hpp>
+
+// Fixed seed parallel offset corpus shared by the fuzz regression tests and the offset fuzz
+// benchmarks (tests/benchmarks/offsetfuzzbenchmarks.cpp).
+
+namespace fuzzcorpus {
+using Pline = cavc::Polyline<double>;
+
+inline constexpr std::array<std::uint32_t, 6> openSeeds = {17u, 29u, 43u, 71u, 113u, 191u};
+inline constexpr std::array<double, 4> openOffsets = {-0.65, -0.2, 0.2, 0.65};
+inline constexpr std::array<std::uint32_t, 6> closedSeeds = {23u, 37u, 59u, 89u, 131u, 197u};
+inline constexpr std::array<double, 4> closedOffsets = {-0.5, -0.15, 0.15, 0.5};
+inline constexpr std::array<cavc::OffsetJoinType, 3> joinTypes = {
+    cavc::OffsetJoinType::Round, cavc::OffsetJoinType::Miter, cavc::OffsetJoinType::Bevel};
+inline constexpr std::array<cavc::OffsetEndCapType, 3> endCapTypes = {
+    cavc::OffsetEndCapType::Round, cavc::OffsetEndCapType::Square, cavc::OffsetEndCapType::Butt};
+
+inline Pline makeOpenMixedPolyline(std::uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> stepDist(0.5, 1.8);
+  std::uniform_real_distribution<double> yDist(-0.8, 0.8);
+  std::uniform_real_distribution<double> bulgeDist(-0.45, 0.45);
+
+  Pline pline;
+  double x = 0.0;
+  double y = 0.0;
+  for (int i = 0; i < 7; ++i) {
+    double bulge = (i % 2 == 0) ? bulgeDist(rng) : 0.0;
+    pline.addVertex(x, y, bulge);
+    x += stepDist(rng);
+    y += yDist(rng);
+  }
+  pline.lastVertex().bulge() = 0.0;
+  return pline;
+}
+
+inline Pline makeConvexNgon(std::uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> radiusJitter(-0.45, 0.45);
+  std::uniform_real_distribution<double> centerJitter(-0.2, 0.2);
+
+  Pline pline;
+  pline.isClosed() = true;
+  constexpr int vertexCount = 9;
+  double const cx = centerJitter(rng);
+  double const cy = centerJitter(rng);
+  for (int i = 0; i < vertexCount; ++i) {
+    double const angle = static_cast<double>(i) * cavc::utils::tau<double>() /
+                         static_cast<double>(vertexCount);
+    double const radius = 5.0 + radiusJitter(rng);
+    pline.addVertex(cx + radius * std::cos(angle), cy + radius * std::sin(angle), 0.0);
+  }
+  return pline;
+}
+
+inline Pline makeConcaveStar(std::uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> jitter(-0.15, 0.15);
+
+  Pline pline;
+  pline.isClosed() = true;
+  constexpr int vertexCount = 10;
+  for (int i = 0; i < vertexCount; ++i) {
+    double const angle = static_cast<double>(i) * cavc::utils::tau<double>() /
+                         static_cast<double>(vertexCount);
+    double const radius = ((i % 2) == 0 ? 5.0 : 2.6) + jitter(rng);
+    pline.addVertex(radius * std::cos(angle), radius * std::sin(angle), 0.0);
+  }
+  return pline;
+}
+
+inline Pline makeArcHeavyClosedPolyline(std::uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> radiusJitter(-0.25, 0.25);
+  std::uniform_real_distribution<double> bulgeJitter(-0.08, 0.08);
+
+  Pline pline;
+  pline.isClosed() = true;
+  constexpr int vertexCount = 8;
+  for (int i = 0; i < vertexCount; ++i) {
+    double const angle = static_cast<double>(i) * cavc::utils::tau<double>() /
+                         static_cast<double>(vertexCount);
+    double const radius = 4.0 + radiusJitter(rng);
+    double const bulge = 0.18 + bulgeJitter(rng);
+    pline.addVertex(radius * std::cos(angle), radius * std::sin(angle), bulge);
+  }
+  return pline;
+}
+
+inline Pline makeNearDegenerateOpenPolyline(std::uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> jitter(-1e-7, 1e-7);
+
+  Pline pline;
+  pline.addVertex(0.0, 0.0, 0.0);
+  pline.addVertex(jitter(rng), jitter(rng), 0.0);
+  pline.addVertex(1.0, 0.0, 0.25);
+  pline.addVertex(2.0, 0.3, -0.2);
+  pline.addVertex(3.1, -0.2, 0.0);
+  return pline;
+}
+} // namespace fuzzcorpus
+
+#endif // CAVC_PARALLEL_OFFSET_FUZZ_CORPUS_HPP